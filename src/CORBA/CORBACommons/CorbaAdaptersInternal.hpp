@@ -3,10 +3,14 @@
 
 #include <vector>
 
+#include <ace/Timer_Queuefwd.h>
+
 #include <Logger/Logger.hpp>
 
 #include <CORBACommons/CorbaAdapters.hpp>
 
+class ACE_Reactor_Impl;
+
 
 namespace CORBACommons
 {
@@ -88,6 +92,21 @@ namespace CORBACommons
   static const unsigned PARTS = 8;
   static_assert(!(CORBACommons::PARTS & (PARTS - 1)),
     "PARTS is not a power of 2");
+
+  /**
+   * Reactor waiting in select() over DESCRIPTORS by PARTS threads
+   * @return reactor or 0 on failure
+   */
+  ACE_Reactor_Impl*
+  create_reactor_impl(ACE_Timer_Queue* tq) throw ();
+
+  /**
+   * Reactor waiting in edge triggered epoll by a leader thread,
+   * a descriptor is dispatched by one thread until resumed
+   * @return reactor or 0 on failure
+   */
+  ACE_Reactor_Impl*
+  create_epoll_reactor_impl(ACE_Timer_Queue* tq) throw ();
 }
 
 namespace CORBACommons::PropertiesHandling
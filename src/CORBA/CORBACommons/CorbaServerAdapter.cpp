@@ -70,9 +70,6 @@ namespace
 
 namespace CORBACommons
 {
-  ACE_Reactor_Impl*
-  create_reactor_impl(ACE_Timer_Queue* tq) throw ();
-
   //
   // Data for control of number of unoccupied threads per orb
   //
@@ -580,7 +577,8 @@ namespace CORBACommons
     }
 
     TAO_Default_Resource_Factory::custom_reactor_impl_factory =
-      &create_reactor_impl;
+      corba_config_.epoll_reactor ? &create_epoll_reactor_impl :
+        &create_reactor_impl;
 
     init_env_();
   }
@@ -48,6 +48,8 @@ namespace CORBACommons
     size_t stack_size;
     bool orb_per_endpoint;
     bool custom_reactor;
+    // custom reactor waits in epoll instead of select (see EpollReactor.cpp)
+    bool epoll_reactor;
     EndpointConfigs endpoints;
   };
 
@@ -261,7 +263,7 @@ namespace CORBACommons
   inline
   CorbaConfig::CorbaConfig() /*throw (eh::Exception)*/
     : thread_pool(1), min_threads(0), normal_threads(0), stack_size(0),
-      orb_per_endpoint(true), custom_reactor(true)
+      orb_per_endpoint(true), custom_reactor(true), epoll_reactor(false)
   {
   }
 
@@ -0,0 +1,1051 @@
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <new>
+
+#include <ace/TP_Reactor.h>
+
+#include <Sync/Semaphore.hpp>
+
+#include <Generics/Descriptors.hpp>
+#include <Generics/TAlloc.hpp>
+
+#include "CorbaAdaptersInternal.hpp"
+
+
+namespace
+{
+  class EpollReactor : public ACE_Reactor_Impl
+  {
+  public:
+    explicit
+    EpollReactor(ACE_Timer_Queue* tq) throw ();
+    virtual
+    ~EpollReactor() throw ();
+
+    virtual
+    int
+    open(size_t, bool = false, ACE_Sig_Handler* = 0, ACE_Timer_Queue* = 0,
+      int = 0, ACE_Reactor_Notify* = 0) throw ();
+    virtual
+    int
+    current_info(ACE_HANDLE, size_t&) throw ();
+    virtual
+    int
+    set_sig_handler(ACE_Sig_Handler*) throw ();
+    virtual
+    int
+    timer_queue(ACE_Timer_Queue *) throw ();
+    virtual
+    ACE_Timer_Queue*
+    timer_queue() const throw ();
+    virtual
+    int
+    close() throw ();
+    virtual
+    int
+    work_pending(const ACE_Time_Value& = ACE_Time_Value::zero) throw ();
+    virtual
+    int
+    handle_events(ACE_Time_Value* max_wait_time = 0) throw ();
+    virtual
+    int
+    alertable_handle_events(ACE_Time_Value* = 0) throw ();
+    virtual
+    int
+    handle_events(ACE_Time_Value&) throw ();
+    virtual
+    int
+    alertable_handle_events(ACE_Time_Value&) throw ();
+    virtual
+    int
+    deactivated() throw ();
+    virtual
+    void
+    deactivate(int do_stop) throw ();
+    virtual
+    int
+    register_handler(ACE_Event_Handler* event_handler,
+      ACE_Reactor_Mask mask) throw ();
+    virtual
+    int
+    register_handler(ACE_HANDLE, ACE_Event_Handler*, ACE_Reactor_Mask)
+      throw ();
+    virtual
+    int
+    register_handler(ACE_HANDLE, ACE_HANDLE, ACE_Event_Handler*,
+      ACE_Reactor_Mask) throw ();
+    virtual
+    int
+    register_handler(const ACE_Handle_Set&, ACE_Event_Handler*,
+      ACE_Reactor_Mask) throw ();
+    virtual
+    int
+    register_handler(int, ACE_Event_Handler*, ACE_Sig_Action*,
+      ACE_Event_Handler** = 0, ACE_Sig_Action* = 0) throw ();
+    virtual
+    int
+    register_handler(const ACE_Sig_Set&, ACE_Event_Handler*,
+      ACE_Sig_Action* = 0) throw ();
+    virtual
+    int
+    remove_handler(ACE_Event_Handler*, ACE_Reactor_Mask) throw ();
+    virtual
+    int
+    remove_handler(ACE_HANDLE handle, ACE_Reactor_Mask mask) throw ();
+    virtual
+    int
+    remove_handler(const ACE_Handle_Set&, ACE_Reactor_Mask) throw ();
+    virtual
+    int
+    remove_handler(int, ACE_Sig_Action*, ACE_Sig_Action* = 0, int = -1)
+      throw ();
+    virtual
+    int
+    remove_handler(const ACE_Sig_Set&) throw ();
+    virtual
+    int
+    suspend_handler(ACE_Event_Handler*) throw ();
+    virtual
+    int
+    suspend_handler(ACE_HANDLE) throw ();
+    virtual
+    int
+    suspend_handler(const ACE_Handle_Set&) throw ();
+    virtual
+    int
+    suspend_handlers() throw ();
+    virtual
+    int
+    resume_handler(ACE_Event_Handler*) throw ();
+    virtual
+    int
+    resume_handler(ACE_HANDLE handle) throw ();
+    virtual
+    int
+    resume_handler(const ACE_Handle_Set&) throw ();
+    virtual
+    int
+    resume_handlers() throw ();
+    virtual
+    int
+    resumable_handler() throw ();
+    virtual
+    bool
+    uses_event_associations() throw ();
+    virtual
+    long
+    schedule_timer(ACE_Event_Handler*, const void*,
+      const ACE_Time_Value&, const ACE_Time_Value& = ACE_Time_Value::zero)
+      throw ();
+    virtual
+    int
+    reset_timer_interval(long, const ACE_Time_Value&) throw ();
+    virtual
+    int
+    cancel_timer(ACE_Event_Handler*, int = 1) throw ();
+    virtual
+    int
+    cancel_timer(long, const void** = 0, int = 1) throw ();
+    virtual
+    int
+    schedule_wakeup(ACE_Event_Handler*, ACE_Reactor_Mask) throw ();
+    virtual
+    int
+    schedule_wakeup(ACE_HANDLE, ACE_Reactor_Mask) throw ();
+    virtual
+    int
+    cancel_wakeup(ACE_Event_Handler*, ACE_Reactor_Mask) throw ();
+    virtual
+    int
+    cancel_wakeup(ACE_HANDLE, ACE_Reactor_Mask) throw ();
+    virtual
+    int
+    notify(ACE_Event_Handler* event_handler = 0,
+      ACE_Reactor_Mask mask = ACE_Event_Handler::EXCEPT_MASK,
+      ACE_Time_Value* max_wait_time = 0) throw ();
+    virtual
+    void
+    max_notify_iterations(int) throw ();
+    virtual
+    int
+    max_notify_iterations() throw ();
+    virtual
+    int
+    purge_pending_notifications(ACE_Event_Handler* = 0,
+      ACE_Reactor_Mask = ACE_Event_Handler::ALL_EVENTS_MASK) throw ();
+    virtual
+    ACE_Event_Handler*
+    find_handler(ACE_HANDLE) throw ();
+    virtual
+    int
+    handler(ACE_HANDLE, ACE_Reactor_Mask, ACE_Event_Handler** = 0) throw ();
+    virtual
+    int
+    handler(int, ACE_Event_Handler** = 0) throw ();
+    virtual
+    bool
+    initialized() throw ();
+    virtual
+    size_t
+    size() const throw ();
+    virtual
+    ACE_Lock&
+    lock() throw ();
+    virtual
+    void
+    wakeup_all_threads() throw ();
+    virtual
+    int
+    owner(ACE_thread_t, ACE_thread_t* = 0) throw ();
+    virtual
+    int
+    owner(ACE_thread_t*) throw ();
+    virtual
+    bool
+    restart() throw ();
+    virtual
+    bool
+    restart(bool) throw ();
+    virtual
+    void
+    requeue_position(int) throw ();
+    virtual
+    int
+    requeue_position() throw ();
+    virtual
+    int
+    mask_ops(ACE_Event_Handler*, ACE_Reactor_Mask, int) throw ();
+    virtual
+    int
+    mask_ops(ACE_HANDLE, ACE_Reactor_Mask, int) throw ();
+    virtual
+    int
+    ready_ops(ACE_Event_Handler*, ACE_Reactor_Mask, int) throw ();
+    virtual
+    int
+    ready_ops(ACE_HANDLE, ACE_Reactor_Mask, int) throw ();
+    virtual
+    void
+    dump() const throw ();
+
+  private:
+    struct Slot
+    {
+      ACE_Event_Handler* handler;
+    };
+
+    enum
+    {
+      // Table of descriptors up to CHUNK_SIZE * MAX_CHUNKS (16M)
+      // allocated by chunks on registration
+      CHUNK_SIZE = 4096,
+      MAX_CHUNKS = 4096,
+      MAX_EVENTS = 64,
+      LOCKS_MASK = CORBACommons::PARTS - 1
+    };
+
+    typedef std::list<ACE_Event_Handler*,
+      Generics::TAlloc::Aggregated<ACE_Event_Handler*, CORBACommons::DESCRIPTORS>> Next;
+
+    /**
+     * Call under lock_(fd)
+     * @param create allocate the chunk holding the slot
+     * @return slot of the descriptor, 0 if there is no one
+     */
+    Slot*
+    slot_(int fd, bool create) throw ();
+
+    Sync::PosixMutex&
+    lock_(int fd) throw ();
+
+    /**
+     * Arms the descriptor for a single edge triggered event, the thread
+     * got it owns the descriptor until it is armed again.
+     * @param op EPOLL_CTL_ADD or EPOLL_CTL_MOD
+     */
+    int
+    arm_(int fd, int op) throw ();
+
+    void
+    push_(ACE_Event_Handler* const* handlers, unsigned count) throw ();
+
+    ACE_Event_Handler*
+    pop_() throw ();
+
+    /**
+     * Waits for ready descriptors and queues their handlers,
+     * call with leader_ locked
+     * @return number of handlers queued
+     */
+    unsigned
+    lead_() throw ();
+
+    void
+    dispatch_(ACE_Event_Handler* eh) throw ();
+
+    const int epoll_;
+    Generics::NonBlockingReadPipe pipe_;
+
+    std::atomic<Slot*> chunks_[MAX_CHUNKS];
+    Sync::PosixMutex chunks_lock_;
+    Sync::PosixMutex locks_[CORBACommons::PARTS];
+
+    Sync::PosixMutex leader_;
+    std::atomic<bool> in_wait_;
+
+    Sync::PosixMutex queue_;
+    Sync::Semaphore sem_;
+    Next next_;
+
+    std::atomic<bool> exit_;
+    std::atomic<int> waiters_;
+  };
+
+
+  EpollReactor::EpollReactor(ACE_Timer_Queue* tq) throw ()
+    : epoll_(epoll_create1(EPOLL_CLOEXEC)), in_wait_(false), sem_(0),
+      exit_(false), waiters_(0)
+  {
+    delete tq;
+
+    for (unsigned i = 0; i < MAX_CHUNKS; i++)
+    {
+      chunks_[i].store(0, std::memory_order_relaxed);
+    }
+
+    if (epoll_ >= 0)
+    {
+      // Level triggered, wakes the leader until it reads the pipe
+      epoll_event event;
+      event.events = EPOLLIN;
+      event.data.u64 = 0;
+      event.data.fd = pipe_.read_descriptor();
+      epoll_ctl(epoll_, EPOLL_CTL_ADD, pipe_.read_descriptor(), &event);
+    }
+  }
+
+  EpollReactor::~EpollReactor() throw ()
+  {
+    for (unsigned i = 0; i < MAX_CHUNKS; i++)
+    {
+      delete [] chunks_[i].load(std::memory_order_relaxed);
+    }
+
+    if (epoll_ >= 0)
+    {
+      ::close(epoll_);
+    }
+  }
+
+  EpollReactor::Slot*
+  EpollReactor::slot_(int fd, bool create) throw ()
+  {
+    if (fd < 0 || static_cast<unsigned>(fd) >= CHUNK_SIZE * MAX_CHUNKS)
+    {
+      return 0;
+    }
+
+    std::atomic<Slot*>& chunk = chunks_[fd / CHUNK_SIZE];
+    Slot* slots = chunk.load(std::memory_order_acquire);
+    if (!slots && create)
+    {
+      Sync::PosixGuard guard(chunks_lock_);
+      slots = chunk.load(std::memory_order_relaxed);
+      if (!slots)
+      {
+        slots = new (std::nothrow) Slot[CHUNK_SIZE]();
+        chunk.store(slots, std::memory_order_release);
+      }
+    }
+
+    return slots ? slots + fd % CHUNK_SIZE : 0;
+  }
+
+  Sync::PosixMutex&
+  EpollReactor::lock_(int fd) throw ()
+  {
+    return locks_[fd & LOCKS_MASK];
+  }
+
+  int
+  EpollReactor::arm_(int fd, int op) throw ()
+  {
+    epoll_event event;
+    event.events = EPOLLIN | EPOLLET | EPOLLONESHOT;
+    event.data.u64 = 0;
+    event.data.fd = fd;
+    return epoll_ctl(epoll_, op, fd, &event);
+  }
+
+  void
+  EpollReactor::push_(ACE_Event_Handler* const* handlers, unsigned count)
+    throw ()
+  {
+    Sync::PosixGuard guard(queue_);
+    for (unsigned i = 0; i < count; i++)
+    {
+      next_.push_back(handlers[i]);
+    }
+  }
+
+  ACE_Event_Handler*
+  EpollReactor::pop_() throw ()
+  {
+    Sync::PosixGuard guard(queue_);
+    if (next_.empty())
+    {
+      return 0;
+    }
+    ACE_Event_Handler* eh = next_.front();
+    next_.pop_front();
+    return eh;
+  }
+
+  unsigned
+  EpollReactor::lead_() throw ()
+  {
+    in_wait_ = true;
+
+    // notify() signals the pipe only if it sees in_wait_
+    bool queued;
+    {
+      Sync::PosixGuard guard(queue_);
+      queued = !next_.empty();
+    }
+
+    epoll_event events[MAX_EVENTS];
+    const int count = exit_ || queued ? 0 :
+      epoll_wait(epoll_, events, MAX_EVENTS, -1);
+
+    in_wait_ = false;
+
+    ACE_Event_Handler* ready[MAX_EVENTS];
+    unsigned ready_count = 0;
+
+    for (int i = 0; i < count; i++)
+    {
+      const int fd = events[i].data.fd;
+      if (fd == pipe_.read_descriptor())
+      {
+        char buf[4096];
+        pipe_.read(buf, sizeof(buf));
+        continue;
+      }
+
+      Sync::PosixGuard guard(lock_(fd));
+      Slot* slot = slot_(fd, false);
+      if (slot && slot->handler)
+      {
+        slot->handler->add_reference();
+        ready[ready_count++] = slot->handler;
+      }
+    }
+
+    if (ready_count)
+    {
+      push_(ready, ready_count);
+    }
+
+    return ready_count;
+  }
+
+  void
+  EpollReactor::dispatch_(ACE_Event_Handler* eh) throw ()
+  {
+    assert(eh);
+
+    int fd = eh->get_handle();
+    int auto_resume = eh->resume_handler() ==
+      ACE_Event_Handler::ACE_REACTOR_RESUMES_HANDLER;
+    int ref_count = eh->reference_counting_policy().value() ==
+      ACE_Event_Handler::Reference_Counting_Policy::ENABLED;
+    int status;
+    while ((status = eh->handle_input(fd)) > 0)
+    {
+    }
+
+    if (status < 0 || auto_resume)
+    {
+      Sync::PosixGuard guard(lock_(fd));
+      Slot* slot = slot_(fd, false);
+      if (slot && slot->handler == eh)
+      {
+        if (status < 0)
+        {
+          slot->handler = 0;
+          epoll_ctl(epoll_, EPOLL_CTL_DEL, fd, 0);
+        }
+        else
+        {
+          arm_(fd, EPOLL_CTL_MOD);
+        }
+      }
+    }
+
+    if (ref_count)
+    {
+      eh->remove_reference();
+    }
+  }
+
+  int
+  EpollReactor::open(size_t, bool, ACE_Sig_Handler*, ACE_Timer_Queue*, int,
+    ACE_Reactor_Notify*) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::current_info(ACE_HANDLE, size_t&) throw ()
+  {
+    abort();
+  }
+
+  int
+  EpollReactor::set_sig_handler(ACE_Sig_Handler*) throw ()
+  {
+    abort();
+  }
+
+  int
+  EpollReactor::timer_queue(ACE_Timer_Queue *) throw ()
+  {
+    abort();
+  }
+
+  ACE_Timer_Queue*
+  EpollReactor::timer_queue() const throw ()
+  {
+    return 0;
+  }
+
+  int
+  EpollReactor::close() throw ()
+  {
+    return 0;
+  }
+
+  int
+  EpollReactor::work_pending(const ACE_Time_Value&) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::handle_events([[maybe_unused]] ACE_Time_Value* max_wait_time) throw ()
+  {
+    assert(!max_wait_time);
+
+    // Leader/followers: one thread waits in epoll_wait, queues the ready
+    // handlers and wakes followers to dispatch them and to take over the
+    // waiting, while it dispatches itself.
+    while (!exit_)
+    {
+      ACE_Event_Handler* eh = pop_();
+      if (eh)
+      {
+        dispatch_(eh);
+        continue;
+      }
+
+      bool led = false;
+      unsigned queued = 0;
+      {
+        Sync::PosixTryGuard guard{leader_};
+        if (guard)
+        {
+          led = true;
+          queued = lead_();
+        }
+      }
+
+      if (led)
+      {
+        for (int wake = std::min<int>(queued + 1, waiters_); wake > 0; wake--)
+        {
+          sem_.release();
+        }
+        continue;
+      }
+
+      ACE_Token::waiters_callback_(++waiters_);
+      sem_.acquire(); // wait event or leadership
+      --waiters_;
+    }
+
+    sem_.release();
+
+    errno = ESHUTDOWN;
+    return -1;
+  }
+
+  int
+  EpollReactor::alertable_handle_events(ACE_Time_Value*) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::handle_events(ACE_Time_Value&) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::alertable_handle_events(ACE_Time_Value&) throw ()
+  {
+    abort();
+  }
+
+  int
+  EpollReactor::deactivated() throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  void
+  EpollReactor::deactivate(int) throw ()
+  {
+    exit_ = true;
+    pipe_.signal();
+    sem_.release();
+  }
+
+  int
+  EpollReactor::register_handler(ACE_Event_Handler* event_handler,
+    ACE_Reactor_Mask mask) throw ()
+  {
+    // don't register handler on mask == EXCEPT_MASK only
+    // remove handler will ignore it
+
+    if((mask & ACE_Event_Handler::READ_MASK) ||
+      (mask & ACE_Event_Handler::ACCEPT_MASK))
+    {
+      assert(event_handler);
+
+      int handle = event_handler->get_handle();
+
+      Sync::PosixGuard guard(lock_(handle));
+      Slot* slot = slot_(handle, true);
+      if (!slot)
+      {
+        errno = EMFILE;
+        return -1;
+      }
+      assert(!slot->handler);
+      slot->handler = event_handler;
+      if (arm_(handle, EPOLL_CTL_ADD) < 0 &&
+        (errno != EEXIST || arm_(handle, EPOLL_CTL_MOD) < 0))
+      {
+        slot->handler = 0;
+        return -1;
+      }
+    }
+
+    return 0;
+  }
+
+  int
+  EpollReactor::register_handler(ACE_HANDLE, ACE_Event_Handler*,
+    ACE_Reactor_Mask) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::register_handler(ACE_HANDLE, ACE_HANDLE, ACE_Event_Handler*,
+    ACE_Reactor_Mask) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::register_handler(const ACE_Handle_Set&, ACE_Event_Handler*,
+    ACE_Reactor_Mask) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::register_handler(int, ACE_Event_Handler*, ACE_Sig_Action*,
+    ACE_Event_Handler**, ACE_Sig_Action*) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::register_handler(const ACE_Sig_Set&, ACE_Event_Handler*,
+    ACE_Sig_Action*) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::remove_handler(ACE_Event_Handler* eh, ACE_Reactor_Mask mask)
+    throw ()
+  {
+    remove_handler(eh->get_handle(), mask);
+    return 0;
+  }
+
+  int
+  EpollReactor::remove_handler(ACE_HANDLE handle, ACE_Reactor_Mask) throw ()
+  {
+    Sync::PosixGuard guard(lock_(handle));
+    Slot* slot = slot_(handle, false);
+    if (slot && slot->handler)
+    {
+      slot->handler = 0;
+      // fails if the descriptor is closed already, it's removed then
+      epoll_ctl(epoll_, EPOLL_CTL_DEL, handle, 0);
+    }
+    return 0;
+  }
+
+  int
+  EpollReactor::remove_handler(const ACE_Handle_Set&, ACE_Reactor_Mask) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::remove_handler(int, ACE_Sig_Action*, ACE_Sig_Action*, int)
+    throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::remove_handler(const ACE_Sig_Set&) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::suspend_handler(ACE_Event_Handler*) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::suspend_handler(ACE_HANDLE) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::suspend_handler(const ACE_Handle_Set&) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::suspend_handlers() throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::resume_handler(ACE_Event_Handler*) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::resume_handler(ACE_HANDLE handle) throw ()
+  {
+    Sync::PosixGuard guard(lock_(handle));
+    Slot* slot = slot_(handle, false);
+    if (!slot || !slot->handler)
+    {
+      return -1;
+    }
+
+    // Reports the event again if data came while the handler was working
+    return arm_(handle, EPOLL_CTL_MOD);
+  }
+
+  int
+  EpollReactor::resume_handler(const ACE_Handle_Set&) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::resume_handlers() throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::resumable_handler() throw ()
+  {
+    return true;
+  }
+
+  bool
+  EpollReactor::uses_event_associations() throw ()
+  {
+    return false;
+  }
+
+  long
+  EpollReactor::schedule_timer(ACE_Event_Handler*, const void*,
+    const ACE_Time_Value&, const ACE_Time_Value&) throw ()
+  {
+    // Expected that will be called only from TAO_Acceptor::handle_accept_error
+    errno = EOPNOTSUPP;
+    return -1;
+  }
+
+  int
+  EpollReactor::reset_timer_interval(long, const ACE_Time_Value&) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::cancel_timer(ACE_Event_Handler*, int) throw ()
+  {
+    return 0;
+  }
+
+  int
+  EpollReactor::cancel_timer(long, const void**, int) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::schedule_wakeup(ACE_Event_Handler*, ACE_Reactor_Mask) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::schedule_wakeup(ACE_HANDLE, ACE_Reactor_Mask) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::cancel_wakeup(ACE_Event_Handler*, ACE_Reactor_Mask) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::cancel_wakeup(ACE_HANDLE, ACE_Reactor_Mask) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::notify(ACE_Event_Handler* event_handler, [[maybe_unused]] ACE_Reactor_Mask mask,
+    ACE_Time_Value*) throw ()
+  {
+    assert(mask == ACE_Event_Handler::READ_MASK);
+    assert(event_handler);
+    event_handler->add_reference();
+    push_(&event_handler, 1);
+    sem_.release();
+    if (in_wait_)
+    {
+      pipe_.signal();
+    }
+    return 0;
+  }
+
+  void
+  EpollReactor::max_notify_iterations(int) throw ()
+  {
+    abort();
+  }
+
+  int
+  EpollReactor::max_notify_iterations() throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::purge_pending_notifications(ACE_Event_Handler*, ACE_Reactor_Mask)
+    throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  ACE_Event_Handler*
+  EpollReactor::find_handler(ACE_HANDLE) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::handler(ACE_HANDLE, ACE_Reactor_Mask, ACE_Event_Handler**)
+    throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::handler(int, ACE_Event_Handler**) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  bool
+  EpollReactor::initialized() throw ()
+  {
+    return epoll_ >= 0;
+  }
+
+  size_t
+  EpollReactor::size() const throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  ACE_Lock&
+  EpollReactor::lock() throw ()
+  {
+    abort();
+    return *(ACE_Lock*)0;
+  }
+
+  void
+  EpollReactor::wakeup_all_threads() throw ()
+  {
+    abort();
+  }
+
+  int
+  EpollReactor::owner(ACE_thread_t, ACE_thread_t*) throw ()
+  {
+    return 0;
+  }
+
+  int
+  EpollReactor::owner(ACE_thread_t*) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  bool
+  EpollReactor::restart() throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  bool
+  EpollReactor::restart(bool) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  void
+  EpollReactor::requeue_position(int) throw ()
+  {
+    abort();
+  }
+
+  int
+  EpollReactor::requeue_position() throw ()
+  {
+    abort();
+  }
+
+  int
+  EpollReactor::mask_ops(ACE_Event_Handler*, ACE_Reactor_Mask, int) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::mask_ops(ACE_HANDLE, ACE_Reactor_Mask, int) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::ready_ops(ACE_Event_Handler*, ACE_Reactor_Mask, int) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  int
+  EpollReactor::ready_ops(ACE_HANDLE, ACE_Reactor_Mask, int) throw ()
+  {
+    abort();
+    return 0;
+  }
+
+  void
+  EpollReactor::dump() const throw ()
+  {
+    abort();
+  }
+}
+
+namespace CORBACommons
+{
+  ACE_Reactor_Impl*
+  create_epoll_reactor_impl(ACE_Timer_Queue* tq) throw ()
+  {
+    try
+    {
+      EpollReactor* reactor = new EpollReactor(tq);
+      if (reactor->initialized())
+      {
+        return reactor;
+      }
+      delete reactor;
+    }
+    catch (...)
+    {
+    }
+    return 0;
+  }
+}
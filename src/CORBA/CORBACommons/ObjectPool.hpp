@@ -6,15 +6,22 @@
 #ifndef CORBA_COMMONS_OBJECT_POOL_HPP
 #define CORBA_COMMONS_OBJECT_POOL_HPP
 
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
 #include <deque>
+#include <memory>
+#include <vector>
 //#include <cassert>
 
 #include <tao/ORB.h>
 
 #include <Sync/PosixLock.hpp>
+#include <Sync/Condition.hpp>
 
 #include <Generics/Time.hpp>
 #include <Generics/Rand.hpp>
+#include <Generics/ThreadRunner.hpp>
 
 #include <CORBACommons/CorbaAdapters.hpp>
 
@@ -120,12 +127,15 @@ namespace CORBACommons
   protected:
     ObjectHandler() throw ();
     template <typename D>
-    ObjectHandler(D&& p_object, ObjectPoolType* pool)
+    ObjectHandler(D&& p_object, ObjectPoolType* pool,
+      typename ObjectPoolType::ConnData* conn_data)
       throw ();
 
   private:
     typename ObjectPoolType::ObjectRef p_object_;
     ObjectPoolType* pool_;
+    typename ObjectPoolType::ConnData* conn_data_;
+    Generics::Time get_time_;
   };
 
 
@@ -192,6 +202,12 @@ namespace CORBACommons
     Resolver resolver;
     bool object_once;
     bool all_bad_no_wait;
+
+    /**
+     * Resolve references and remove badness status in a separate
+     * thread, get_object doesn't wait for it then
+     */
+    bool background_resolve;
   };
 
 
@@ -245,7 +261,11 @@ namespace CORBACommons
       PT_PERSISTENT,
 
       // Return key < number_of_objects ? objects[key] : round robin
-      PT_PRECISE
+      PT_PRECISE,
+
+      // Return the object with the least calls in flight weighted
+      // by its average call time, ties are broken round robin
+      PT_LEAST_LOADED
     };
   };
 
@@ -277,6 +297,8 @@ namespace CORBACommons
       ChoosePolicyType::POLICY_TYPE policy_type = ChoosePolicyType::PT_LOOP)
       /*throw (Exception, eh::Exception)*/;
 
+    ~ObjectPool() throw ();
+
     // This function MUST NOT throw anything except ObjectPool::Exception
     // and derivatives.
     ObjectHandlerType
@@ -295,6 +317,18 @@ namespace CORBACommons
       unsigned first_key = SPECIAL_KEY, unsigned next_key = SPECIAL_KEY)
       /*throw (UserException)*/;
 
+    /**
+     * Put usage statistics of the references into values
+     * (e.g. ProcessStatsGen::stats()) as
+     * <prefix><index>.{in_flight,uses,failures,latency_us,bad}
+     * @param values Generics::Values compatible container
+     * @param prefix prefix of the keys
+     */
+    template <typename Values>
+    void
+    fill_stats(Values& values, const String::SubString& prefix)
+      /*throw (eh::Exception)*/;
+
   private:
     /**
      * Badness status remove from objects which worthless time is over
@@ -329,32 +363,56 @@ namespace CORBACommons
 
       bool made_good;
 
-      int use_count;
+      // Calls in flight, changed without lock_ on good release
+      std::atomic<int> use_count;
       int use_max;
       GiveOnce give_once;
+
+      // Statistics, updated without lock_
+      std::atomic<unsigned long> uses;
+      std::atomic<unsigned long> failures;
+      // Moving average of the call time in 1/2^LATENCY_SHIFT
+      // microseconds, zero if no call was made
+      static const unsigned LATENCY_SHIFT = 8;
+      std::atomic<std::uint64_t> latency;
     };
 
     typedef std::deque<ConnData> Objects;
     Objects objects_;
 
-    ConnData&
-    get_conndata_(ObjectRef& t) throw ();
-
+    /**
+     * Call under lock_
+     */
     void
     release_object_(ConnData& conn_data,
       const String::SubString& bad_dsc)
       throw ();
 
     /**
-     * @param object object to be released
+     * @param conn_data object to be released
+     * @param get_time time the object was got from the pool
      * @param bad_dsc parameter with description of reason to be bad
-     * if equal to zero object release in good state
+     * if empty object release in good state
      */
     void
-    release_object_(ObjectRef& object,
+    release_object_(ConnData& conn_data,
+      const Generics::Time& get_time,
       const String::SubString& bad_dsc = String::SubString())
       throw ();
 
+    class ResolveJob;
+
+    /**
+     * Resolve not resolved references and references which worthless
+     * time is over, called by ResolveJob without locks held
+     * @return time of the next check, zero if nothing to wait for
+     */
+    Generics::Time
+    resolve_bad_refs_() /*throw (eh::Exception)*/;
+
+    void
+    wake_resolver_() throw ();
+
     typedef Sync::PosixMutex Mutex;
     typedef Sync::PosixGuard Guard;
 
@@ -364,6 +422,7 @@ namespace CORBACommons
     class RandPolicy;
     class PersistentPolicy;
     class PrecisePolicy;
+    class LeastLoadedPolicy;
 
     typedef ::ReferenceCounting::QualPtr<ChoosePolicy> ChoosePolicy_var;
 
@@ -373,6 +432,12 @@ namespace CORBACommons
     Mutex lock_;
     const bool OBJECT_ONCE_;
     const bool ALL_BAD_NO_WAIT_;
+    const bool BACKGROUND_RESOLVE_;
+
+    Sync::Condition resolve_condition_;
+    bool resolve_signaled_;
+    bool resolve_terminated_;
+    std::unique_ptr<Generics::ThreadRunner> resolve_runner_;
   };
 
   template <class T, class Conf, class TVar, const bool RERESOLVE>
@@ -527,6 +592,45 @@ namespace CORBACommons
     ~PrecisePolicy() throw () = default;
   };
 
+  template <class T, class Conf, class TVar, const bool RERESOLVE>
+  class ObjectPool<T, Conf, TVar, RERESOLVE>::LeastLoadedPolicy :
+    public ChoosePolicy
+  {
+  public:
+    explicit
+    LeastLoadedPolicy(ObjectPool& pool) /*throw (eh::Exception)*/;
+
+    virtual
+    ConnData&
+    get_valid_object(unsigned key) /*throw (eh::Exception)*/;
+
+  protected:
+    virtual
+    ~LeastLoadedPolicy() throw () = default;
+
+    std::size_t start_;
+  };
+
+  template <class T, class Conf, class TVar, const bool RERESOLVE>
+  class ObjectPool<T, Conf, TVar, RERESOLVE>::ResolveJob :
+    public Generics::ThreadJob
+  {
+  public:
+    explicit
+    ResolveJob(ObjectPool& pool) throw ();
+
+    virtual
+    void
+    work() throw ();
+
+  protected:
+    virtual
+    ~ResolveJob() throw () = default;
+
+  private:
+    ObjectPool& pool_;
+  };
+
 } // namespace ObjectPool
 
 //////////////////////////////////////////////////////////////////////////
@@ -597,23 +701,26 @@ namespace CORBACommons
 
   template <class ObjectPool>
   ObjectHandler<ObjectPool>::ObjectHandler() throw ()
-    : p_object_(), pool_()
+    : p_object_(), pool_(), conn_data_()
   {
   }
 
   template <class ObjectPool>
   template <typename D>
   ObjectHandler<ObjectPool>::ObjectHandler(
-    D&& p_object, ObjectPool* pool)
+    D&& p_object, ObjectPool* pool,
+    typename ObjectPool::ConnData* conn_data)
     throw ()
-    : p_object_(std::forward<D>(p_object)), pool_(pool)
+    : p_object_(std::forward<D>(p_object)), pool_(pool),
+      conn_data_(conn_data), get_time_(Generics::Time::get_time_of_day())
   {
   }
 
   template <class ObjectPool>
   ObjectHandler<ObjectPool>::ObjectHandler(
     ObjectHandler&& src) throw ()
-    : p_object_(src.p_object_._retn()), pool_(src.pool_)
+    : p_object_(src.p_object_._retn()), pool_(src.pool_),
+      conn_data_(src.conn_data_), get_time_(src.get_time_)
   {
     src.pool_ = 0;
   }
@@ -635,6 +742,8 @@ namespace CORBACommons
 
       p_object_ = src.p_object_._retn();
       pool_ = src.pool_;
+      conn_data_ = src.conn_data_;
+      get_time_ = src.get_time_;
       src.pool_ = 0;
     }
 
@@ -675,7 +784,7 @@ namespace CORBACommons
   {
     if (pool_)
     {
-      pool_->release_object_(p_object_);
+      pool_->release_object_(*conn_data_, get_time_);
       p_object_ = 0;
       pool_ = 0;
     }
@@ -688,7 +797,7 @@ namespace CORBACommons
   {
     if (pool_)
     {
-      pool_->release_object_(p_object_,
+      pool_->release_object_(*conn_data_, get_time_,
         dsc.empty() ? String::SubString("reason unknown") : dsc);
       p_object_ = 0;
       pool_ = 0;
@@ -753,7 +862,7 @@ namespace CORBACommons
 
   template <class T, typename Ref>
   ObjectPoolConfiguration<T, Ref>::ObjectPoolConfiguration() throw ()
-    : object_once(true), all_bad_no_wait(false)
+    : object_once(true), all_bad_no_wait(false), background_resolve(false)
   {
   }
 
@@ -1002,6 +1111,117 @@ namespace CORBACommons
   }
 
 
+  //
+  // ObjectPool::LeastLoadedPolicy class
+  //
+
+  template <class T, class Conf, class TVar, const bool RERESOLVE>
+  ObjectPool<T, Conf, TVar, RERESOLVE>::LeastLoadedPolicy::
+    LeastLoadedPolicy(ObjectPool& pool) /*throw (eh::Exception)*/
+    : ChoosePolicy(pool), start_(0)
+  {
+  }
+
+  template <class T, class Conf, class TVar, const bool RERESOLVE>
+  typename ObjectPool<T, Conf, TVar, RERESOLVE>::ConnData&
+  ObjectPool<T, Conf, TVar, RERESOLVE>::LeastLoadedPolicy::
+    get_valid_object(unsigned /*key*/) /*throw (eh::Exception)*/
+  {
+    Objects& objects = ChoosePolicy::pool_.objects_;
+    const std::size_t SIZE = objects.size();
+
+    // Scan from the next position each time, so equally loaded
+    // objects are given in turn
+    start_ = (start_ + 1) % SIZE;
+
+    ConnData* best = 0;
+    std::uint64_t best_load = 0;
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+      ConnData& conn = objects[(start_ + i) % SIZE];
+      if (ChoosePolicy::soft_suitable(conn))
+      {
+        // Not measured object has the minimal weight to be tried soon
+        const std::uint64_t LATENCY =
+          conn.latency.load(std::memory_order_relaxed);
+        const std::uint64_t LOAD =
+          (conn.use_count.load(std::memory_order_relaxed) + 1) *
+          (LATENCY ? LATENCY : 1);
+        if (!best || LOAD < best_load)
+        {
+          best = &conn;
+          best_load = LOAD;
+        }
+      }
+    }
+
+    // check_all_are_bad_or_busy_ guarantees a suitable object
+    return best ? *best : *ChoosePolicy::cycle_next(objects.begin());
+  }
+
+
+  //
+  // ObjectPool::ResolveJob class
+  //
+
+  template <class T, class Conf, class TVar, const bool RERESOLVE>
+  ObjectPool<T, Conf, TVar, RERESOLVE>::ResolveJob::ResolveJob(
+    ObjectPool& pool) throw ()
+    : pool_(pool)
+  {
+  }
+
+  template <class T, class Conf, class TVar, const bool RERESOLVE>
+  void
+  ObjectPool<T, Conf, TVar, RERESOLVE>::ResolveJob::work() throw ()
+  {
+    // Don't spin on references failing to resolve with zero timeout
+    const Generics::Time MIN_PERIOD(0, 100000);
+
+    for (;;)
+    {
+      Generics::Time next_check;
+      try
+      {
+        next_check = pool_.resolve_bad_refs_();
+      }
+      catch (const eh::Exception&)
+      {
+        next_check = Generics::Time::get_time_of_day() +
+          Generics::Time::ONE_SECOND;
+      }
+
+      if (next_check != Generics::Time::ZERO)
+      {
+        next_check = std::max(next_check,
+          Generics::Time::get_time_of_day() + MIN_PERIOD);
+      }
+
+      try
+      {
+        Sync::ConditionalGuard guard(pool_.resolve_condition_);
+        while (!pool_.resolve_terminated_ && !pool_.resolve_signaled_)
+        {
+          if (!guard.timed_wait(
+            next_check == Generics::Time::ZERO ? 0 : &next_check))
+          {
+            break;
+          }
+        }
+        if (pool_.resolve_terminated_)
+        {
+          return;
+        }
+        pool_.resolve_signaled_ = false;
+      }
+      catch (const eh::Exception&)
+      {
+        return;
+      }
+    }
+  }
+
+
   //
   // ObjectPool::ConnData class
   //
@@ -1011,7 +1231,8 @@ namespace CORBACommons
     typename Conf::ObjectRef object_ref, int use_max) throw ()
     : obj_lock(), object_ref(object_ref), object(TVar::_obj_type::_nil()),
       resolve(false), is_bad(false), badness_description(),
-      made_good(false), use_count(0), use_max(use_max), give_once(GO_OTHERS)
+      made_good(false), use_count(0), use_max(use_max), give_once(GO_OTHERS),
+      uses(0), failures(0), latency(0)
   {
   }
 
@@ -1030,7 +1251,9 @@ namespace CORBACommons
     /*throw (Exception, eh::Exception)*/
     : TIMEOUT_(configuration.timeout), resolver_(configuration.resolver),
       OBJECT_ONCE_(configuration.object_once),
-      ALL_BAD_NO_WAIT_(configuration.all_bad_no_wait)
+      ALL_BAD_NO_WAIT_(configuration.all_bad_no_wait),
+      BACKGROUND_RESOLVE_(configuration.background_resolve),
+      resolve_signaled_(false), resolve_terminated_(false)
   {
     if (configuration.iors_list.empty())
     {
@@ -1061,11 +1284,41 @@ namespace CORBACommons
     case ChoosePolicyType::PT_PRECISE:
       choose_policy_ = new PrecisePolicy(*this);
       break;
+    case ChoosePolicyType::PT_LEAST_LOADED:
+      choose_policy_ = new LeastLoadedPolicy(*this);
+      break;
     default:
       Stream::Error ostr;
       ostr << FNS << "Invalid policy type.";
       throw Exception(ostr);
     }
+
+    if (BACKGROUND_RESOLVE_)
+    {
+      resolve_runner_.reset(new Generics::ThreadRunner(
+        Generics::ThreadJob_var(new ResolveJob(*this)), 1));
+      resolve_runner_->start();
+    }
+  }
+
+  template <class T, class Conf, class TVar, const bool RERESOLVE>
+  ObjectPool<T, Conf, TVar, RERESOLVE>::~ObjectPool() throw ()
+  {
+    if (resolve_runner_.get())
+    {
+      try
+      {
+        {
+          Sync::ConditionalGuard guard(resolve_condition_);
+          resolve_terminated_ = true;
+        }
+        resolve_condition_.signal();
+        resolve_runner_->wait_for_completion();
+      }
+      catch (const eh::Exception&)
+      {
+      }
+    }
   }
 
   template <class T, class Conf, class TVar, const bool RERESOLVE>
@@ -1162,7 +1415,24 @@ namespace CORBACommons
       {
         Guard guard(lock_);
 
-        if (ALL_BAD_NO_WAIT_)
+        if (BACKGROUND_RESOLVE_)
+        {
+          // Badness status is removed by ResolveJob
+          try
+          {
+            check_all_are_bad_or_busy_();
+          }
+          catch (const NoGoodReference&)
+          {
+            if (!ALL_BAD_NO_WAIT_)
+            {
+              throw;
+            }
+            check_bad_refs_(true);
+            check_all_are_bad_or_busy_();
+          }
+        }
+        else if (ALL_BAD_NO_WAIT_)
         {
           try
           {
@@ -1184,15 +1454,29 @@ namespace CORBACommons
         conn_data = &choose_policy_->get_valid_object(key);
 
         conn_data->use_count++;
+        conn_data->uses.fetch_add(1, std::memory_order_relaxed);
         if (conn_data->give_once == GO_NOT_GIVEN)
         {
           conn_data->give_once = GO_FIRST;
         }
+        if (BACKGROUND_RESOLVE_)
+        {
+          conn_data->made_good = false;
+        }
 
 #if BUILD_WITH_DEBUG_MESSAGES
         std::cerr << FNS << conn_data->use_count << ", " <<
           conn_data->use_max << ", " << conn_data->is_bad << std::endl;
 #endif
+
+        // Resolved object is changed under both obj_lock and lock_,
+        // so it can be given without obj_lock
+        if (!(RERESOLVE && conn_data->resolve) &&
+          !CORBA::is_nil(conn_data->object))
+        {
+          return ObjectHandlerType(
+            TVar::_obj_type::_duplicate(conn_data->object), this, conn_data);
+        }
       }
 
       Sync::PosixGuard guard(conn_data->obj_lock);
@@ -1209,24 +1493,26 @@ namespace CORBACommons
           {
             conn_data->resolve = false;
           }
+          ObjectRef object(TVar::_obj_type::_nil());
           try
           {
-            conn_data->object =
-              resolver_.template resolve<T>(conn_data->object_ref);
+            object = resolver_.template resolve<T>(conn_data->object_ref);
           }
           catch (const eh::Exception& ex)
           {
-            conn_data->object = TVar::_obj_type::_nil();
             error = ex.what();
           }
-          if (CORBA::is_nil(conn_data->object))
+
+          Guard guard(lock_);
+          if (CORBA::is_nil(object))
           {
-            Guard guard(lock_);
+            conn_data->object = TVar::_obj_type::_nil();
             release_object_(*conn_data, error.empty() ?
               "failed to resolve" : "failed to resolve: " + error);
           }
           else
           {
+            conn_data->object = object._retn();
             bad = false;
           }
         }
@@ -1245,7 +1531,7 @@ namespace CORBACommons
       }
 
       return ObjectHandlerType(
-        TVar::_obj_type::_duplicate(conn_data->object), this);
+        TVar::_obj_type::_duplicate(conn_data->object), this, conn_data);
     }
     catch (const Exception& ex)
     {
@@ -1305,21 +1591,161 @@ namespace CORBACommons
   }
 
   template <class T, class Conf, class TVar, const bool RERESOLVE>
-  typename ObjectPool<T, Conf, TVar, RERESOLVE>::ConnData&
-  ObjectPool<T, Conf, TVar, RERESOLVE>::get_conndata_(ObjectRef& t)
-    throw ()
+  template <typename Values>
+  void
+  ObjectPool<T, Conf, TVar, RERESOLVE>::fill_stats(Values& values,
+    const String::SubString& prefix) /*throw (eh::Exception)*/
   {
-    typename Objects::iterator iter = objects_.begin();
-    for (; iter != objects_.end(); ++iter)
+    struct RefStats
     {
-      if (iter->object == t)
+      unsigned long in_flight;
+      unsigned long uses;
+      unsigned long failures;
+      unsigned long latency;
+      unsigned long bad;
+    };
+
+    // is_bad is changed under lock_, values.set is called without it
+    std::vector<RefStats> stats;
+    {
+      Guard guard(lock_);
+      stats.reserve(objects_.size());
+      for (typename Objects::const_iterator iter = objects_.begin();
+        iter != objects_.end(); ++iter)
       {
-        return *iter;
+        const std::uint64_t LATENCY =
+          iter->latency.load(std::memory_order_relaxed);
+        stats.push_back(RefStats{
+          static_cast<unsigned long>(iter->use_count.load()),
+          iter->uses.load(std::memory_order_relaxed),
+          iter->failures.load(std::memory_order_relaxed),
+          static_cast<unsigned long>(
+            (LATENCY + (1 << (ConnData::LATENCY_SHIFT - 1))) >>
+              ConnData::LATENCY_SHIFT),
+          iter->is_bad ? 1ul : 0ul});
       }
     }
-    // we should newer reach this code...
-    assert(false);
-    return *iter;
+
+    for (std::size_t index = 0; index < stats.size(); ++index)
+    {
+      std::string key;
+      prefix.assign_to(key);
+      key += std::to_string(index);
+
+      const RefStats& ref_stats = stats[index];
+      values.set(key + ".in_flight", ref_stats.in_flight);
+      values.set(key + ".uses", ref_stats.uses);
+      values.set(key + ".failures", ref_stats.failures);
+      values.set(key + ".latency_us", ref_stats.latency);
+      values.set(key + ".bad", ref_stats.bad);
+    }
+  }
+
+  template <class T, class Conf, class TVar, const bool RERESOLVE>
+  Generics::Time
+  ObjectPool<T, Conf, TVar, RERESOLVE>::resolve_bad_refs_()
+    /*throw (eh::Exception)*/
+  {
+    const Generics::Time NOW = Generics::Time::get_time_of_day();
+    Generics::Time next_check;
+
+    for (typename Objects::iterator iter = objects_.begin();
+      iter != objects_.end(); ++iter)
+    {
+      {
+        Guard guard(lock_);
+        if (iter->is_bad)
+        {
+          const Generics::Time CHECK_TIME = iter->bad_mark_time + TIMEOUT_;
+          if (NOW < CHECK_TIME)
+          {
+            if (next_check == Generics::Time::ZERO ||
+              CHECK_TIME < next_check)
+            {
+              next_check = CHECK_TIME;
+            }
+            continue;
+          }
+          if (!RERESOLVE && !CORBA::is_nil(iter->object))
+          {
+            iter->is_bad = false;
+            iter->made_good = true;
+            if (OBJECT_ONCE_)
+            {
+              iter->give_once = GO_NOT_GIVEN;
+            }
+            continue;
+          }
+        }
+        else if (!CORBA::is_nil(iter->object))
+        {
+          continue;
+        }
+      }
+
+      std::string error;
+      ObjectRef object(TVar::_obj_type::_nil());
+      try
+      {
+        object = resolver_.template resolve<T>(iter->object_ref);
+      }
+      catch (const eh::Exception& ex)
+      {
+        error = ex.what();
+      }
+
+      Sync::PosixGuard obj_guard(iter->obj_lock);
+      Guard guard(lock_);
+      if (CORBA::is_nil(object))
+      {
+        iter->failures.fetch_add(1, std::memory_order_relaxed);
+        iter->is_bad = true;
+        iter->badness_description = error.empty() ?
+          "failed to resolve" : "failed to resolve: " + error;
+        iter->bad_mark_time = NOW;
+        if (next_check == Generics::Time::ZERO ||
+          NOW + TIMEOUT_ < next_check)
+        {
+          next_check = NOW + TIMEOUT_;
+        }
+      }
+      else
+      {
+        iter->object = object._retn();
+        if (RERESOLVE)
+        {
+          iter->resolve = false;
+        }
+        if (iter->is_bad)
+        {
+          iter->is_bad = false;
+          iter->made_good = true;
+          if (OBJECT_ONCE_)
+          {
+            iter->give_once = GO_NOT_GIVEN;
+          }
+        }
+      }
+    }
+
+    return next_check;
+  }
+
+  template <class T, class Conf, class TVar, const bool RERESOLVE>
+  void
+  ObjectPool<T, Conf, TVar, RERESOLVE>::wake_resolver_() throw ()
+  {
+    try
+    {
+      {
+        Sync::ConditionalGuard guard(resolve_condition_);
+        resolve_signaled_ = true;
+      }
+      resolve_condition_.signal();
+    }
+    catch (const eh::Exception&)
+    {
+    }
   }
 
   template <class T, class Conf, class TVar, const bool RERESOLVE>
@@ -1330,11 +1756,16 @@ namespace CORBACommons
     conn_data.use_count--;
     if (dsc.size())
     {
+      conn_data.failures.fetch_add(1, std::memory_order_relaxed);
       conn_data.is_bad = true;
       conn_data.badness_description =
         "released object as bad, with reason: ";
       dsc.append_to(conn_data.badness_description);
       conn_data.bad_mark_time = Generics::Time::get_time_of_day();
+      if (BACKGROUND_RESOLVE_)
+      {
+        wake_resolver_();
+      }
     }
     else
     {
@@ -1350,11 +1781,35 @@ namespace CORBACommons
 
   template <class T, class Conf, class TVar, const bool RERESOLVE>
   void
-  ObjectPool<T, Conf, TVar, RERESOLVE>::release_object_(ObjectRef& object,
-    const String::SubString& dsc) throw ()
-  {
+  ObjectPool<T, Conf, TVar, RERESOLVE>::release_object_(ConnData& conn_data,
+    const Generics::Time& get_time, const String::SubString& dsc) throw ()
+  {
+    const Generics::Time CALL_TIME =
+      Generics::Time::get_time_of_day() - get_time;
+    const std::uint64_t SAMPLE = CALL_TIME < Generics::Time::ZERO ?
+      0 : static_cast<std::uint64_t>(CALL_TIME.microseconds()) <<
+        ConnData::LATENCY_SHIFT;
+
+    // Moving average with 1/8 weight of the new call, in fixed point
+    // so short calls are not lost in rounding. Stays nonzero once
+    // measured.
+    std::uint64_t latency = conn_data.latency.load(std::memory_order_relaxed);
+    while (!conn_data.latency.compare_exchange_weak(latency,
+      std::max<std::uint64_t>(
+        latency ? latency - (latency >> 3) + (SAMPLE >> 3) : SAMPLE, 1),
+      std::memory_order_relaxed))
+    {
+    }
+
+    if (dsc.empty() && !OBJECT_ONCE_)
+    {
+      // give_once stays GO_OTHERS, nothing to change under lock_
+      conn_data.use_count--;
+      return;
+    }
+
     Guard guard(lock_);
-    release_object_(get_conndata_(object), dsc);
+    release_object_(conn_data, dsc);
   }
 }
 
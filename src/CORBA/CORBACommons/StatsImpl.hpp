@@ -1,8 +1,13 @@
 #ifndef CORBA_CORBACOMMONS_STATSIMPL_HPP
 #define CORBA_CORBACOMMONS_STATSIMPL_HPP
 
+#include <algorithm>
+
 #include <CORBACommons/Stats_s.hpp>
 
+#include <Generics/GnuHashTable.hpp>
+#include <Generics/Rand.hpp>
+#include <Generics/Time.hpp>
 #include <Generics/Values.hpp>
 
 #include <CORBACommons/CorbaAdapters.hpp>
@@ -91,6 +96,110 @@ namespace CORBACommons
     };
   };
 
+  /**
+   * Tracks changes of Values for ProcessStatsControl::get_stats_delta.
+   * Keys are interned into ids stable during the object life (epoch),
+   * a change of a value or of a key presence is stamped with the version
+   * of the call noticed it, so one call serves clients with any cursors.
+   */
+  class ValuesDelta : private Generics::Uncopyable
+  {
+  public:
+    ValuesDelta() throw ();
+
+    /**
+     * Returns values changed since the cursor
+     * @param values generalized values
+     * @param cursor cursor returned by the previous call, zero or foreign
+     * cursor requests all values
+     * @return delta with the cursor for the next call
+     */
+    template <typename Values>
+    StatsDelta*
+    get_stats_delta(Values& values, const StatsCursor& cursor)
+      /*throw (CORBA::Exception,
+        CORBACommons::ProcessStatsControl::ImplementationException)*/;
+
+  private:
+    enum ValueType
+    {
+      VT_NONE,
+      VT_SIGNEDINT,
+      VT_UNSIGNEDINT,
+      VT_FLOATING,
+      VT_STRING,
+      VT_LAST
+    };
+
+    struct Entry
+    {
+      explicit
+      Entry(CORBA::ULong id_val) throw ();
+
+      CORBA::ULong id;
+      CORBA::ULongLong key_version;
+      CORBA::ULongLong value_version;
+      CORBA::ULongLong seen_version;
+      bool removed;
+      ValueType type;
+      union
+      {
+        Generics::Values::SignedInt signed_int;
+        Generics::Values::UnsignedInt unsigned_int;
+        Generics::Values::Floating floating;
+      };
+      Generics::Values::String string;
+    };
+
+    typedef Generics::GnuHashTable<Generics::Values::Key, Entry> Entries;
+
+    class Updater : private Generics::Uncopyable
+    {
+    public:
+      Updater(ValuesDelta& delta, CORBA::ULongLong version) throw ();
+
+      void
+      operator ()(size_t size) /*throw (eh::Exception)*/;
+
+      template <typename Type>
+      void
+      operator ()(const Generics::Values::Key& key, const Type& value)
+        /*throw (eh::Exception)*/;
+
+    private:
+      ValuesDelta& delta_;
+      const CORBA::ULongLong VERSION_;
+    };
+
+    static
+    bool
+    assign_(Entry& entry, const Generics::Values::SignedInt& value) throw ();
+
+    static
+    bool
+    assign_(Entry& entry, const Generics::Values::UnsignedInt& value)
+      throw ();
+
+    static
+    bool
+    assign_(Entry& entry, const Generics::Values::Floating& value) throw ();
+
+    static
+    bool
+    assign_(Entry& entry, const Generics::Values::String& value)
+      /*throw (eh::Exception)*/;
+
+    void
+    fill_delta_(StatsDelta& delta, CORBA::ULongLong since)
+      /*throw (eh::Exception, CORBA::Exception)*/;
+
+    Sync::PosixMutex mutex_;
+    const CORBA::ULongLong EPOCH_;
+    CORBA::ULongLong version_;
+    CORBA::ULong next_id_;
+    Entries entries_;
+  };
+
   template <typename Values>
   class ProcessStatsGen :
     public virtual POA_CORBACommons::ProcessStatsControl
@@ -105,6 +214,12 @@ namespace CORBACommons
       /*throw (CORBA::Exception,
         CORBACommons::ProcessStatsControl::ImplementationException)*/;
 
+    virtual
+    StatsDelta*
+    get_stats_delta(const StatsCursor& cursor)
+      /*throw (CORBA::Exception,
+        CORBACommons::ProcessStatsControl::ImplementationException)*/;
+
     Values&
     stats() throw ();
 
@@ -117,6 +232,7 @@ namespace CORBACommons
 
   private:
     ::ReferenceCounting::FixedPtr<Values> stats_;
+    ValuesDelta delta_;
   };
 
   typedef ProcessStatsGen<Generics::Values> ProcessStatsImpl;
@@ -268,6 +384,270 @@ namespace CORBACommons
     throw Generics::Values::KeyNotFound(ostr);
   }
 
+  //
+  // ValuesDelta::Entry class
+  //
+
+  inline
+  ValuesDelta::Entry::Entry(CORBA::ULong id_val) throw ()
+    : id(id_val), key_version(0), value_version(0), seen_version(0),
+      removed(true), type(VT_NONE), unsigned_int(0)
+  {
+  }
+
+
+  //
+  // ValuesDelta::Updater class
+  //
+
+  inline
+  ValuesDelta::Updater::Updater(ValuesDelta& delta,
+    CORBA::ULongLong version) throw ()
+    : delta_(delta), VERSION_(version)
+  {
+  }
+
+  inline
+  void
+  ValuesDelta::Updater::operator ()(size_t size) /*throw (eh::Exception)*/
+  {
+    if (delta_.entries_.size() < size)
+    {
+      delta_.entries_.reserve(size);
+    }
+  }
+
+  template <typename Type>
+  void
+  ValuesDelta::Updater::operator ()(const Generics::Values::Key& key,
+    const Type& value) /*throw (eh::Exception)*/
+  {
+    Entries::iterator itor = delta_.entries_.find(key);
+    if (itor == delta_.entries_.end())
+    {
+      itor = delta_.entries_.insert(
+        Entries::value_type(key, Entry(delta_.next_id_++))).first;
+    }
+
+    Entry& entry = itor->second;
+    if (entry.removed)
+    {
+      entry.removed = false;
+      entry.key_version = VERSION_;
+      entry.value_version = VERSION_;
+    }
+    if (assign_(entry, value))
+    {
+      entry.value_version = VERSION_;
+    }
+    entry.seen_version = VERSION_;
+  }
+
+
+  //
+  // ValuesDelta class
+  //
+
+  inline
+  bool
+  ValuesDelta::assign_(Entry& entry,
+    const Generics::Values::SignedInt& value) throw ()
+  {
+    if (entry.type == VT_SIGNEDINT && entry.signed_int == value)
+    {
+      return false;
+    }
+    entry.type = VT_SIGNEDINT;
+    entry.signed_int = value;
+    return true;
+  }
+
+  inline
+  bool
+  ValuesDelta::assign_(Entry& entry,
+    const Generics::Values::UnsignedInt& value) throw ()
+  {
+    if (entry.type == VT_UNSIGNEDINT && entry.unsigned_int == value)
+    {
+      return false;
+    }
+    entry.type = VT_UNSIGNEDINT;
+    entry.unsigned_int = value;
+    return true;
+  }
+
+  inline
+  bool
+  ValuesDelta::assign_(Entry& entry,
+    const Generics::Values::Floating& value) throw ()
+  {
+    if (entry.type == VT_FLOATING && entry.floating == value)
+    {
+      return false;
+    }
+    entry.type = VT_FLOATING;
+    entry.floating = value;
+    return true;
+  }
+
+  inline
+  bool
+  ValuesDelta::assign_(Entry& entry,
+    const Generics::Values::String& value) /*throw (eh::Exception)*/
+  {
+    if (entry.type == VT_STRING && entry.string == value)
+    {
+      return false;
+    }
+    entry.type = VT_STRING;
+    entry.string = value;
+    return true;
+  }
+
+  inline
+  ValuesDelta::ValuesDelta() throw ()
+    : EPOCH_((static_cast<CORBA::ULongLong>(
+        Generics::Time::get_time_of_day().tv_sec) << 32) |
+        Generics::safe_rand()),
+      version_(0),
+      next_id_(0)
+  {
+  }
+
+  inline
+  void
+  ValuesDelta::fill_delta_(StatsDelta& delta, CORBA::ULongLong since)
+    /*throw (eh::Exception, CORBA::Exception)*/
+  {
+    // Entries not seen by the last Updater are removed from Values
+    CORBA::ULong new_keys = 0;
+    CORBA::ULong removed = 0;
+    CORBA::ULong counts[VT_LAST] = {};
+
+    for (Entries::iterator itor(entries_.begin());
+      itor != entries_.end(); ++itor)
+    {
+      Entry& entry = itor->second;
+      if (!entry.removed && entry.seen_version != version_)
+      {
+        entry.removed = true;
+        entry.value_version = version_;
+      }
+
+      if (entry.removed)
+      {
+        // key_version is of the last appearance, the client may know
+        // an earlier one: any removal since the cursor is sent, ids
+        // unknown to the client are ignored by it. Reset drops all.
+        removed += since && entry.value_version > since;
+      }
+      else
+      {
+        new_keys += entry.key_version > since;
+        counts[entry.type] += entry.value_version > since;
+      }
+    }
+
+    delta.new_keys.length(new_keys);
+    delta.removed.length(removed);
+    delta.signed_int_ids.length(counts[VT_SIGNEDINT]);
+    delta.signed_int_values.length(counts[VT_SIGNEDINT]);
+    delta.unsigned_int_ids.length(counts[VT_UNSIGNEDINT]);
+    delta.unsigned_int_values.length(counts[VT_UNSIGNEDINT]);
+    delta.floating_ids.length(counts[VT_FLOATING]);
+    delta.floating_values.length(counts[VT_FLOATING]);
+    delta.string_ids.length(counts[VT_STRING]);
+    delta.string_values.length(counts[VT_STRING]);
+
+    new_keys = 0;
+    removed = 0;
+    std::fill(counts, counts + VT_LAST, 0);
+
+    for (Entries::const_iterator itor(entries_.begin());
+      itor != entries_.end(); ++itor)
+    {
+      const Entry& entry = itor->second;
+      if (entry.removed)
+      {
+        if (since && entry.value_version > since)
+        {
+          delta.removed[removed++] = entry.id;
+        }
+        continue;
+      }
+
+      if (entry.key_version > since)
+      {
+        StatsKey& key = delta.new_keys[new_keys++];
+        key.id = entry.id;
+        key.key << itor->first.text();
+      }
+
+      if (entry.value_version <= since)
+      {
+        continue;
+      }
+
+      CORBA::ULong& index = counts[entry.type];
+      switch (entry.type)
+      {
+      case VT_SIGNEDINT:
+        delta.signed_int_ids[index] = entry.id;
+        delta.signed_int_values[index] = entry.signed_int;
+        break;
+      case VT_UNSIGNEDINT:
+        delta.unsigned_int_ids[index] = entry.id;
+        delta.unsigned_int_values[index] = entry.unsigned_int;
+        break;
+      case VT_FLOATING:
+        delta.floating_ids[index] = entry.id;
+        delta.floating_values[index] = entry.floating;
+        break;
+      case VT_STRING:
+        delta.string_ids[index] = entry.id;
+        delta.string_values[index] << entry.string;
+        break;
+      default:
+        break;
+      }
+      ++index;
+    }
+  }
+
+  template <typename Values>
+  StatsDelta*
+  ValuesDelta::get_stats_delta(Values& values, const StatsCursor& cursor)
+    /*throw (CORBA::Exception,
+      CORBACommons::ProcessStatsControl::ImplementationException)*/
+  {
+    try
+    {
+      StatsDelta_var delta(new StatsDelta);
+
+      Sync::PosixGuard guard(mutex_);
+
+      const bool RESET = cursor.epoch != EPOCH_ || !cursor.version ||
+        cursor.version > version_;
+
+      // version_ is advanced only after a successful enumeration
+      Updater updater(*this, version_ + 1);
+      values.enumerate_all(updater);
+      ++version_;
+
+      fill_delta_(*delta, RESET ? 0 : cursor.version);
+      delta->cursor.epoch = EPOCH_;
+      delta->cursor.version = version_;
+      delta->reset = RESET;
+
+      return delta._retn();
+    }
+    catch (...)
+    {
+      throw CORBACommons::ProcessStatsControl::ImplementationException();
+    }
+  }
+
+
   //
   // ProcessStatsGen class
   //
@@ -293,6 +673,15 @@ namespace CORBACommons
   {
     return ValuesConverter::get_stats(*stats_);
   }
+
+  template <typename Values>
+  StatsDelta*
+  ProcessStatsGen<Values>::get_stats_delta(const StatsCursor& cursor)
+    /*throw (CORBA::Exception,
+      CORBACommons::ProcessStatsControl::ImplementationException)*/
+  {
+    return delta_.get_stats_delta(*stats_, cursor);
+  }
 }
 
 #endif
@@ -1,4 +1,9 @@
+#include <unistd.h>
+
+#include <cstdlib>
 #include <iostream>
+#include <string>
+#include <vector>
 
 #include <eh/Exception.hpp>
 #include <Stream/MemoryStream.hpp>
@@ -8,10 +13,13 @@
 
 namespace
 {
-  const char USAGE[] = "Usage: StatsTool <url>";
+  const char USAGE[] = "Usage: StatsTool <url> [<period in seconds>]";
 
   DECLARE_EXCEPTION(Exception, eh::DescriptiveException);
   DECLARE_EXCEPTION(InvalidArgument, Exception);
+
+  // Key names indexed by key ids of the delta
+  typedef std::vector<std::string> KeyNames;
 }
 
 template <typename T>
@@ -23,6 +31,119 @@ print(const CORBA::Any& any) /*throw (CORBA::Exception, eh::Exception)*/
   std::cout << value;
 }
 
+/**
+ * Prints all stats received as Any, for servers without get_stats_delta
+ */
+void
+print_stats(CORBACommons::ProcessStatsControl_ptr stats_control)
+  /*throw (CORBA::Exception, eh::Exception)*/
+{
+  CORBACommons::StatsValueSeq_var stats = stats_control->get_stats();
+
+  std::cout << "Total: " << stats->length() << " stats(s)" << std::endl;
+  for (size_t i = 0; i < stats->length(); i++)
+  {
+    const CORBA::Any& value = stats[i].value;
+    CORBA::TypeCode_var type_code = value.type();
+
+    std::cout << stats[i].key << "=";
+
+    switch (type_code->kind())
+    {
+    case CORBA::tk_longlong:
+      print<CORBA::LongLong>(value);
+      break;
+    case CORBA::tk_ulonglong:
+      print<CORBA::ULongLong>(value);
+      break;
+    case CORBA::tk_long:
+      print<CORBA::Long>(value);
+      break;
+    case CORBA::tk_ulong:
+      print<CORBA::ULong>(value);
+      break;
+    case CORBA::tk_double:
+      print<CORBA::Double>(value);
+      break;
+    case CORBA::tk_string:
+      print<const CORBA::Char*>(value);
+      break;
+    default:
+      std::cout << "UNKNOWN TYPE: " << type_code->kind();
+      break;
+    }
+
+    std::cout << std::endl;
+  }
+}
+
+const char*
+key_name(const KeyNames& keys, CORBA::ULong id) throw ()
+{
+  return id < keys.size() ? keys[id].c_str() : "UNKNOWN KEY";
+}
+
+template <typename Ids, typename Values>
+void
+print_values(const KeyNames& keys, const Ids& ids, const Values& values)
+  /*throw (eh::Exception)*/
+{
+  for (CORBA::ULong i = 0; i < ids.length(); i++)
+  {
+    std::cout << key_name(keys, ids[i]) << "=" << values[i] << std::endl;
+  }
+}
+
+/**
+ * Prints stats changed since the cursor and advances it
+ */
+void
+print_stats_delta(CORBACommons::ProcessStatsControl_ptr stats_control,
+  CORBACommons::StatsCursor& cursor, KeyNames& keys)
+  /*throw (CORBA::Exception, eh::Exception)*/
+{
+  CORBACommons::StatsDelta_var delta =
+    stats_control->get_stats_delta(cursor);
+
+  if (delta->reset)
+  {
+    keys.clear();
+  }
+
+  for (CORBA::ULong i = 0; i < delta->new_keys.length(); i++)
+  {
+    const CORBACommons::StatsKey& key = delta->new_keys[i];
+    if (key.id >= keys.size())
+    {
+      keys.resize(key.id + 1);
+    }
+    keys[key.id] = key.key.in();
+  }
+
+  std::cout << (delta->reset ? "Total: " : "Changed: ") <<
+    delta->signed_int_ids.length() + delta->unsigned_int_ids.length() +
+    delta->floating_ids.length() + delta->string_ids.length() <<
+    " stats(s)";
+  if (delta->removed.length())
+  {
+    std::cout << ", removed: " << delta->removed.length();
+  }
+  std::cout << std::endl;
+
+  for (CORBA::ULong i = 0; i < delta->removed.length(); i++)
+  {
+    std::cout << key_name(keys, delta->removed[i]) << " removed" <<
+      std::endl;
+  }
+
+  print_values(keys, delta->signed_int_ids, delta->signed_int_values);
+  print_values(keys, delta->unsigned_int_ids, delta->unsigned_int_values);
+  print_values(keys, delta->floating_ids, delta->floating_values);
+  print_values(keys, delta->string_ids, delta->string_values);
+
+  cursor = delta->cursor;
+}
+
 int
 main(int argc, char* argv[])
 {
@@ -37,11 +158,24 @@ main(int argc, char* argv[])
         throw InvalidArgument("CORBA::ORB_init failed");
       }
 
-      if (argc != 2)
+      if (argc != 2 && argc != 3)
       {
         throw InvalidArgument("Invalid number of arguments");
       }
 
+      unsigned long period = 0;
+      if (argc == 3)
+      {
+        char* end;
+        period = std::strtoul(argv[2], &end, 10);
+        if (!*argv[2] || *end || !period)
+        {
+          Stream::Error ostr;
+          ostr << "Invalid period '" << argv[2] << "'";
+          throw InvalidArgument(ostr);
+        }
+      }
+
       CORBA::Object_var obj = orb->string_to_object(argv[1]);
 
       if (CORBA::is_nil(obj))
@@ -68,10 +202,34 @@ main(int argc, char* argv[])
         throw Exception(ostr);
       }
 
-      CORBACommons::StatsValueSeq_var stats;
       try
       {
-        stats = stats_control->get_stats();
+        try
+        {
+          CORBACommons::StatsCursor cursor;
+          cursor.epoch = 0;
+          cursor.version = 0;
+          KeyNames keys;
+
+          for (;;)
+          {
+            print_stats_delta(stats_control, cursor, keys);
+            if (!period)
+            {
+              break;
+            }
+            ::sleep(period);
+          }
+        }
+        catch (const CORBA::BAD_OPERATION&)
+        {
+          // The server does not implement get_stats_delta
+          if (period)
+          {
+            throw;
+          }
+          print_stats(stats_control);
+        }
       }
       catch (const
         CORBACommons::ProcessStatsControl::ImplementationException&)
@@ -80,42 +238,6 @@ main(int argc, char* argv[])
           "CORBACommons::ProcessStatsControl::ImplementationException");
       }
 
-      std::cout << "Total: " << stats->length() << " stats(s)" << std::endl;
-      for (size_t i = 0; i < stats->length(); i++)
-      {
-        const CORBA::Any& value = stats[i].value;
-        CORBA::TypeCode_var type_code = value.type();
-
-        std::cout << stats[i].key << "=";
-
-        switch (type_code->kind())
-        {
-        case CORBA::tk_longlong:
-          print<CORBA::LongLong>(value);
-          break;
-        case CORBA::tk_ulonglong:
-          print<CORBA::ULongLong>(value);
-          break;
-        case CORBA::tk_long:
-          print<CORBA::Long>(value);
-          break;
-        case CORBA::tk_ulong:
-          print<CORBA::ULong>(value);
-          break;
-        case CORBA::tk_double:
-          print<CORBA::Double>(value);
-          break;
-        case CORBA::tk_string:
-          print<const CORBA::Char*>(value);
-          break;
-        default:
-          std::cout << "UNKNOWN TYPE: " << type_code->kind();
-          break;
-        }
-
-        std::cout << std::endl;
-      }
-
       orb->destroy();
 
       return 0;
@@ -0,0 +1,207 @@
+// Arena.cpp
+
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#include <Generics/Arena.hpp>
+
+
+namespace Generics
+{
+  /**
+   * Free chunks of a thread. Trivially destructible to stay accessible
+   * from destructors of other thread local objects, the list is freed
+   * by Cleaner on thread exit.
+   */
+  struct Arena::ChunkCache
+  {
+    struct Cleaner
+    {
+      ~Cleaner() throw ();
+    };
+
+    Chunk* head;
+    std::size_t size;
+    bool closed;
+
+    static thread_local ChunkCache cache;
+    static thread_local Cleaner cleaner;
+  };
+
+  thread_local Arena::ChunkCache Arena::ChunkCache::cache = { 0, 0, false };
+  thread_local Arena::ChunkCache::Cleaner Arena::ChunkCache::cleaner;
+
+  Arena::ChunkCache::Cleaner::~Cleaner() throw ()
+  {
+    while (cache.head)
+    {
+      Chunk* next = cache.head->next;
+      std::free(cache.head);
+      cache.head = next;
+    }
+    cache.size = 0;
+    cache.closed = true;
+  }
+
+
+  //
+  // Arena class
+  //
+
+  const std::size_t Arena::CHUNK_SIZE;
+  const std::size_t Arena::LARGE_SIZE;
+  const std::size_t Arena::CACHED_CHUNKS;
+
+  Arena::Arena() throw ()
+    : chunks_(0), large_(0), cur_(0), end_(0), allocated_(0)
+  {
+  }
+
+  Arena::~Arena() throw ()
+  {
+    release();
+  }
+
+  void
+  Arena::release() throw ()
+  {
+    while (chunks_)
+    {
+      Chunk* next = chunks_->next;
+      put_chunk_(chunks_);
+      chunks_ = next;
+    }
+
+    while (large_)
+    {
+      Chunk* next = large_->next;
+      std::free(large_);
+      large_ = next;
+    }
+
+    cur_ = 0;
+    end_ = 0;
+    allocated_ = 0;
+  }
+
+  void*
+  Arena::allocate_(std::size_t size, std::size_t alignment)
+    /*throw (std::bad_alloc)*/
+  {
+    if (alignment > LARGE_SIZE || size > LARGE_SIZE - alignment)
+    {
+      if (size > std::numeric_limits<std::size_t>::max() -
+        sizeof(Chunk) - alignment)
+      {
+        throw std::bad_alloc();
+      }
+
+      Chunk* chunk = static_cast<Chunk*>(
+        std::malloc(sizeof(Chunk) + size + alignment));
+      if (!chunk)
+      {
+        throw std::bad_alloc();
+      }
+      chunk->next = large_;
+      large_ = chunk;
+      allocated_ += size;
+      return align_(reinterpret_cast<char*>(chunk + 1), alignment);
+    }
+
+    // Rest of the current chunk is lost
+    Chunk* chunk = get_chunk_();
+    chunk->next = chunks_;
+    chunks_ = chunk;
+
+    char* ptr = align_(reinterpret_cast<char*>(chunk + 1), alignment);
+    cur_ = ptr + size;
+    end_ = reinterpret_cast<char*>(chunk) + CHUNK_SIZE;
+    allocated_ += size;
+    return ptr;
+  }
+
+  std::size_t
+  Arena::cached_chunks() throw ()
+  {
+    return ChunkCache::cache.size;
+  }
+
+  Arena::Chunk*
+  Arena::get_chunk_() /*throw (std::bad_alloc)*/
+  {
+    ChunkCache& cache = ChunkCache::cache;
+    if (cache.head)
+    {
+      Chunk* chunk = cache.head;
+      cache.head = chunk->next;
+      --cache.size;
+      return chunk;
+    }
+
+    Chunk* chunk = static_cast<Chunk*>(std::malloc(CHUNK_SIZE));
+    if (!chunk)
+    {
+      throw std::bad_alloc();
+    }
+    return chunk;
+  }
+
+  void
+  Arena::put_chunk_(Chunk* chunk) throw ()
+  {
+    ChunkCache& cache = ChunkCache::cache;
+    if (cache.closed || cache.size >= CACHED_CHUNKS)
+    {
+      std::free(chunk);
+      return;
+    }
+
+    if (!cache.size)
+    {
+      // Makes the thread construct Cleaner
+      static_cast<void>(&ChunkCache::cleaner);
+    }
+
+    chunk->next = cache.head;
+    cache.head = chunk;
+    ++cache.size;
+  }
+
+
+  namespace Allocator
+  {
+    //
+    // Arena class
+    //
+
+    Arena::Arena() throw ()
+    {
+    }
+
+    Arena::~Arena() throw ()
+    {
+    }
+
+    Base::Pointer
+    Arena::allocate(size_t& size) /*throw (eh::Exception, OutOfMemory)*/
+    {
+      try
+      {
+        return arena_.allocate(size);
+      }
+      catch (const std::bad_alloc&)
+      {
+        Stream::Error ostr;
+        ostr << FNS << "Failed to allocate " << size << " bytes";
+        throw OutOfMemory(ostr);
+      }
+    }
+
+    void
+    Arena::deallocate(Pointer ptr, size_t size) throw ()
+    {
+      arena_.deallocate(ptr, size);
+    }
+  }
+}
@@ -0,0 +1,234 @@
+#ifndef GENERICS_ARENA_HPP
+#define GENERICS_ARENA_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+
+#include <Generics/Allocator.hpp>
+#include <Generics/Uncopyable.hpp>
+
+
+namespace Generics
+{
+  /**
+   * Monotonic memory arena for request scoped data.
+   * Allocation bumps a pointer inside of the current chunk,
+   * deallocation is a no-op except for the last allocated block
+   * which is reused. All memory is given back at once by release()
+   * or destruction.
+   * Chunks of CHUNK_SIZE bytes are taken from and given back to
+   * a cache of the calling thread, so steady flow of requests does not
+   * reach malloc. Blocks larger than LARGE_SIZE get own memory.
+   * Can be used by std::pmr containers and Stream::PolymorphicDynamic
+   * directly and by Allocator::Base users through Allocator::Arena.
+   *
+   * Implementation is not thread safe
+   */
+  class Arena final :
+    public std::pmr::memory_resource,
+    private Uncopyable
+  {
+  public:
+    static const std::size_t CHUNK_SIZE = 64 * 1024;
+    static const std::size_t LARGE_SIZE = CHUNK_SIZE / 4;
+    /// Limit of free chunks kept by a thread
+    static const std::size_t CACHED_CHUNKS = 64;
+
+    Arena() throw ();
+
+    /**
+     * Destructor
+     * Releases all allocated memory
+     */
+    ~Arena() throw ();
+
+    /**
+     * Gives back all allocated memory, chunks go to the cache of
+     * the calling thread
+     */
+    void
+    release() throw ();
+
+    /**
+     * @return size of allocated and not released blocks
+     */
+    std::size_t
+    allocated() const throw ();
+
+    /**
+     * @return number of free chunks in the cache of the calling thread
+     */
+    static
+    std::size_t
+    cached_chunks() throw ();
+
+  private:
+    struct alignas(std::max_align_t) Chunk
+    {
+      Chunk* next;
+    };
+
+    struct ChunkCache;
+
+    virtual
+    void*
+    do_allocate(std::size_t size, std::size_t alignment);
+
+    virtual
+    void
+    do_deallocate(void* ptr, std::size_t size, std::size_t alignment);
+
+    virtual
+    bool
+    do_is_equal(const std::pmr::memory_resource& other) const noexcept;
+
+    /**
+     * Slow path of allocation: takes a new chunk or allocates
+     * a large block
+     */
+    void*
+    allocate_(std::size_t size, std::size_t alignment)
+      /*throw (std::bad_alloc)*/;
+
+    static
+    Chunk*
+    get_chunk_() /*throw (std::bad_alloc)*/;
+
+    static
+    void
+    put_chunk_(Chunk* chunk) throw ();
+
+    static
+    char*
+    align_(char* ptr, std::size_t alignment) throw ();
+
+    Chunk* chunks_;
+    Chunk* large_;
+    char* cur_;
+    char* end_;
+    std::size_t allocated_;
+  };
+
+  namespace Allocator
+  {
+    /**
+     * Allocator::Base over own Generics::Arena, lets MemBuf,
+     * String::RegEx and other users of Allocator::Base allocate
+     * from the arena. Memory is given back by arena().release() or
+     * destruction of the allocator.
+     * Not thread safe as the arena itself.
+     */
+    class Arena :
+      public Base,
+      public ReferenceCounting::AtomicImpl
+    {
+    public:
+      Arena() throw ();
+
+      /**
+       * Allocates size bytes aligned to max_align_t
+       * @param size bytes to allocate, not changed
+       * @return pointer to allocated memory block
+       */
+      virtual
+      Pointer
+      allocate(size_t& size) /*throw (eh::Exception, OutOfMemory)*/;
+
+      /**
+       * Reuses the memory block if it was allocated last
+       * @param ptr pointer to memory block
+       * @param size size of the block
+       */
+      virtual
+      void
+      deallocate(Pointer ptr, size_t size) throw ();
+
+      /**
+       * @return the arena memory is allocated from
+       */
+      Generics::Arena&
+      arena() throw ();
+
+    protected:
+      virtual
+      ~Arena() throw ();
+
+    private:
+      Generics::Arena arena_;
+    };
+
+    typedef ReferenceCounting::SmartPtr<Arena> Arena_var;
+  }
+}
+
+//
+// Implementation
+//
+
+namespace Generics
+{
+  inline
+  std::size_t
+  Arena::allocated() const throw ()
+  {
+    return allocated_;
+  }
+
+  inline
+  char*
+  Arena::align_(char* ptr, std::size_t alignment) throw ()
+  {
+    return ptr + ((-reinterpret_cast<std::uintptr_t>(ptr)) & (alignment - 1));
+  }
+
+  inline
+  void*
+  Arena::do_allocate(std::size_t size, std::size_t alignment)
+  {
+    const std::size_t AVAILABLE = end_ - cur_;
+    const std::size_t PADDING =
+      (-reinterpret_cast<std::uintptr_t>(cur_)) & (alignment - 1);
+
+    // Strict comparison keeps the result inside of a chunk for size 0
+    if (size < AVAILABLE && PADDING < AVAILABLE - size)
+    {
+      char* ptr = cur_ + PADDING;
+      cur_ = ptr + size;
+      allocated_ += size;
+      return ptr;
+    }
+
+    return allocate_(size, alignment);
+  }
+
+  inline
+  void
+  Arena::do_deallocate(void* ptr, std::size_t size, std::size_t /*alignment*/)
+  {
+    allocated_ -= size;
+    if (static_cast<char*>(ptr) + size == cur_)
+    {
+      cur_ = static_cast<char*>(ptr);
+    }
+  }
+
+  inline
+  bool
+  Arena::do_is_equal(const std::pmr::memory_resource& other) const noexcept
+  {
+    return this == &other;
+  }
+
+  namespace Allocator
+  {
+    inline
+    Generics::Arena&
+    Arena::arena() throw ()
+    {
+      return arena_;
+    }
+  }
+}
+
+#endif
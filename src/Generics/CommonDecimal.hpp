@@ -397,8 +397,62 @@ namespace Generics
     void
     div<false>(uint64_t major, uint64_t minor, uint64_t base,
       uint64_t divisor, uint64_t& quotient, uint64_t& remainder) throw ();
+
+    __extension__ typedef unsigned __int128 UInt128;
+
+    /**
+     * tmp = high * 2^64 + low;
+     * quotient = tmp / divisor;
+     * remainder = tmp % divisor;
+     * high must be less than divisor
+     */
+    inline
+    void
+    div128(uint64_t high, uint64_t low, uint64_t divisor,
+      uint64_t& quotient, uint64_t& remainder) throw ()
+    {
+      __asm__(
+        "divq %4\n"
+        : "=a" (quotient), "=d" (remainder)
+        : "a" (low), "d" (high), "rm" (divisor)
+      );
+    }
+
+    /**
+     * remainder = dividend % divisor;
+     * returns dividend / divisor
+     */
+    inline
+    UInt128
+    div128(UInt128 dividend, uint64_t divisor, uint64_t& remainder)
+      throw ()
+    {
+      uint64_t high = static_cast<uint64_t>(dividend >> 64);
+      uint64_t major = 0;
+      if (high >= divisor)
+      {
+        major = high / divisor;
+        high %= divisor;
+      }
+      uint64_t minor;
+      div128(high, static_cast<uint64_t>(dividend), divisor, minor,
+        remainder);
+      return static_cast<UInt128>(major) << 64 | minor;
+    }
   }
 
+  /**
+   * Decimal keeps magnitudes in DecimalHelper::UInt128 during arithmetic
+   * if ENABLED, it requires TOTAL digits and 10 ^ FRACTION to fit.
+   * Specialize with ENABLED = false to force element-wise arithmetic.
+   */
+  template <typename BaseType, const unsigned TOTAL,
+    const unsigned FRACTION>
+  struct DecimalInt128
+  {
+    static const bool ENABLED = TOTAL <= 38 && FRACTION <= 19;
+  };
+
   /**
    * Checks that the base type is an expected integer.
    */
@@ -563,6 +617,15 @@ namespace Generics
   const unsigned DecimalRanks<BaseType, TOTAL, FRACTION>::INTEGER_RANK;
 
 
+  //
+  // DecimalInt128 class
+  //
+
+  template <typename BaseType, const unsigned TOTAL,
+    const unsigned FRACTION>
+  const bool DecimalInt128<BaseType, TOTAL, FRACTION>::ENABLED;
+
+
   //
   // SimpleDecimalBase class
   //
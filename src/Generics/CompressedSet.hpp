@@ -10,6 +10,9 @@
 
 namespace Generics
 {
+  template <typename Integer>
+  class FlatCompressedSet;
+
   /**
    * Implementation of Interval tree. For every interval [low, high]
    * (low <= high) the corresponding [first, second] element is stored
@@ -117,6 +120,8 @@ namespace Generics
     check_presence(Integer low, Integer high) const /*throw (eh::Exception)*/;
 
   protected:
+    friend class FlatCompressedSet<Integer>;
+
     typedef std::map<Integer, Integer> Holder;
 
     Holder holder_;
@@ -439,9 +439,36 @@ namespace Generics
     sub(const Decimal& minuend, const Decimal& subtrahend,
       Decimal& target) /*throw (eh::Exception, Overflow)*/;
 
+    /**
+     * Make sum of a column of decimals, equals to summing them one by one
+     * @tparam Iterator input iterator over decimals
+     * @param begin the first summand
+     * @param end the end of summands
+     * @return result of operation, zero sum is nonnegative
+     * @exception Overflow if a partial sum is too big
+     */
+    template <typename Iterator>
+    static
+    Decimal
+    sum(Iterator begin, Iterator end) /*throw (eh::Exception, Overflow)*/;
+
   private:
     static const Element INVALID_FLAG_ = -1;
 
+    typedef DecimalHelper::UInt128 UInt128;
+
+    /** arithmetic on magnitudes in UInt128 */
+    static const bool INT128_ =
+      DecimalInt128<Element, TOTAL, FRACTION>::ENABLED;
+
+    /** magnitude is less than 10 ^ TOTAL_RANK */
+    static const UInt128 INT128_MAX_OVER_ =
+      DecimalHelper::Pow10<UInt128, TOTAL_RANK>::Value;
+
+    /** 10 ^ FRACTION_RANK, the magnitude of one */
+    static const uint64_t INT128_ONE_ =
+      DecimalHelper::Pow10<uint64_t, FRACTION_RANK>::Value;
+
     /**
      * Maximum
      * @return maximal value
@@ -524,6 +551,62 @@ namespace Generics
     is_less_than_(const Decimal& test, unsigned& diff_index) const
       noexcept;
 
+    /**
+     * Magnitude of this number
+     * @return array part of this as integer of minimal decimal units
+     */
+    UInt128
+    to_int128_() const noexcept;
+
+    /**
+     * Set array part of this
+     * @param magnitude integer of minimal decimal units, less than
+     * INT128_MAX_OVER_
+     */
+    void
+    from_int128_(UInt128 magnitude) noexcept;
+
+    /**
+     * Make sum of decimals on UInt128 magnitudes without branching on signs
+     * @param summand1 the first summand
+     * @param summand2 the second summand
+     * @param negative2 sign to use for the second summand
+     * @param target result of operation
+     * @return false if result is too big and target isn't changed
+     */
+    static
+    bool
+    add_int128_(const Decimal& summand1, const Decimal& summand2,
+      bool negative2, Decimal& target) noexcept;
+
+    /**
+     * Do multiplication of decimals on UInt128 magnitudes
+     * @param factor1 the first factor
+     * @param factor2 the second factor
+     * @param dmr remainder processing behaviour
+     * @param target result of operation
+     * @return false if product doesn't fit UInt128 or result is too big,
+     * target isn't changed then
+     */
+    static
+    bool
+    mul_int128_(const Decimal& factor1, const Decimal& factor2,
+      DecimalMulRemainder dmr, Decimal& target) noexcept;
+
+    /**
+     * Do division of decimals on UInt128 magnitudes
+     * @param dividend dividend
+     * @param divisor divisor
+     * @param ddr remainder processing behaviour
+     * @param quotient quotient
+     * @return false if divisor is zero, scaled dividend doesn't fit UInt128
+     * or result is too big, quotient isn't changed then
+     */
+    static
+    bool
+    div_int128_(const Decimal& dividend, const Decimal& divisor,
+      DecimalDivRemainder ddr, Decimal& quotient) noexcept;
+
     /**
      * Multiply elements in base of BASE
      * @param multiplier value to multiply
@@ -137,8 +137,14 @@ namespace Generics
   bool
   Decimal<Element, TOTAL_RANK, FRACTION_RANK>::MulTmpArray::ceil() noexcept
   {
-    if (FRACTION_REMAINDER == 1 ? tmp_array_[FRACTION_END - 1] :
-      tmp_array_[FRACTION_END] % FRACTION_REMAINDER)
+    // any nonzero digit out of fraction, not only the most significant
+    bool inexact = FRACTION_REMAINDER != 1 &&
+      tmp_array_[FRACTION_END] % FRACTION_REMAINDER;
+    for (unsigned i = 0; !inexact && i != FRACTION_END; i++)
+    {
+      inexact = tmp_array_[i];
+    }
+    if (inexact)
     {
       if (add(FRACTION_REMAINDER, FRACTION_END))
       {
@@ -198,9 +204,13 @@ namespace Generics
   Decimal<Element, TOTAL_RANK, FRACTION_RANK>::
     DivTmpArrayBase<TMP_DIV_SIZE>::shrink() noexcept
   {
-    for (; size_ > 1 && !tmp_array_[size_ - 1]; size_--)
+    // walk by pointer: gcc 12 value range propagation folds
+    // the indexed loop over a two element array to a wrong size
+    const Element* end = tmp_array_ + size_;
+    for (; end - tmp_array_ > 1 && !end[-1]; --end)
     {
     }
+    size_ = end - tmp_array_;
     if (!initial_size_)
     {
       initial_size_ = size_;
@@ -584,6 +594,17 @@ namespace Generics
     const unsigned FRACTION_RANK>
   const Element Decimal<Element, TOTAL_RANK, FRACTION_RANK>::INVALID_FLAG_;
 
+  template <typename Element, const unsigned TOTAL_RANK,
+    const unsigned FRACTION_RANK>
+  const bool Decimal<Element, TOTAL_RANK, FRACTION_RANK>::INT128_;
+  template <typename Element, const unsigned TOTAL_RANK,
+    const unsigned FRACTION_RANK>
+  const typename Decimal<Element, TOTAL_RANK, FRACTION_RANK>::UInt128
+    Decimal<Element, TOTAL_RANK, FRACTION_RANK>::INT128_MAX_OVER_;
+  template <typename Element, const unsigned TOTAL_RANK,
+    const unsigned FRACTION_RANK>
+  const uint64_t Decimal<Element, TOTAL_RANK, FRACTION_RANK>::INT128_ONE_;
+
   template <typename Element, const unsigned TOTAL_RANK,
     const unsigned FRACTION_RANK>
   const unsigned Decimal<Element, TOTAL_RANK, FRACTION_RANK>::
@@ -1417,6 +1438,13 @@ namespace Generics
     DEV_ASSERT(summand1.array_[0] != INVALID_FLAG_);
     DEV_ASSERT(summand2.array_[0] != INVALID_FLAG_);
 
+    // conversions cost more than element-wise addition of several ones
+    if (INT128_ && SIZE == 1 &&
+      add_int128_(summand1, summand2, summand2.negative_, target))
+    {
+      return;
+    }
+
     if (summand1.negative_ == summand2.negative_)
     {
       if (internal_add_(summand1, summand2, target))
@@ -1455,6 +1483,12 @@ namespace Generics
     DEV_ASSERT(minuend.array_[0] != INVALID_FLAG_);
     DEV_ASSERT(subtrahend.array_[0] != INVALID_FLAG_);
 
+    if (INT128_ && SIZE == 1 &&
+      add_int128_(minuend, subtrahend, !subtrahend.negative_, target))
+    {
+      return;
+    }
+
     if (minuend.negative_ == subtrahend.negative_)
     {
       unsigned diff_index;
@@ -1544,6 +1578,11 @@ namespace Generics
 
     Decimal target;
 
+    if (INT128_ && mul_int128_(factor1, factor2, dmr, target))
+    {
+      return target;
+    }
+
     MulTmpArray mul_tmp;
 
     // Multiplication
@@ -1668,7 +1707,8 @@ namespace Generics
       return true;
     }
 
-    if (divisor_tmp.size() == 1)
+    // single element divisor can't be normalized to two elements
+    if (SIZE == 1 || divisor_tmp.size() == 1)
     {
 #ifdef DEBUG_DECIMAL
       std::cerr << "Quick\n";
@@ -1800,7 +1840,8 @@ namespace Generics
     /*throw (eh::Exception, Overflow)*/
   {
     Decimal quotient;
-    if (div_(dividend, divisor, quotient))
+    if (!(INT128_ && div_int128_(dividend, divisor, DDR_FLOOR, quotient)) &&
+      div_(dividend, divisor, quotient))
     {
       remainder = dividend;
     }
@@ -1819,6 +1860,10 @@ namespace Generics
     /*throw (eh::Exception, Overflow)*/
   {
     Decimal quotient;
+    if (INT128_ && div_int128_(dividend, divisor, ddr, quotient))
+    {
+      return quotient;
+    }
     div_(dividend, divisor, quotient);
     if (ddr == DDR_CEIL && dividend != mul(quotient, divisor, DMR_FLOOR))
     {
@@ -1913,6 +1958,202 @@ namespace Generics
     return false;
   }
 
+  template <typename Element, const unsigned TOTAL_RANK,
+   const unsigned FRACTION_RANK>
+  typename Decimal<Element, TOTAL_RANK, FRACTION_RANK>::UInt128
+  Decimal<Element, TOTAL_RANK, FRACTION_RANK>::to_int128_() const noexcept
+  {
+    UInt128 magnitude = array_[SIZE - 1];
+    for (unsigned i = SIZE - 1; i--;)
+    {
+      magnitude = magnitude * BASE + array_[i];
+    }
+    return magnitude;
+  }
+
+  template <typename Element, const unsigned TOTAL_RANK,
+   const unsigned FRACTION_RANK>
+  void
+  Decimal<Element, TOTAL_RANK, FRACTION_RANK>::from_int128_(
+    UInt128 magnitude) noexcept
+  {
+    if (SIZE == 1)
+    {
+      array_[0] = static_cast<Element>(magnitude);
+    }
+    else if (!(magnitude >> 64))
+    {
+      uint64_t low = static_cast<uint64_t>(magnitude);
+      for (unsigned i = 0; i != SIZE; i++)
+      {
+        array_[i] = static_cast<Element>(low % BASE);
+        low /= BASE;
+      }
+    }
+    else if (SIZE == 2 && sizeof(Element) == sizeof(uint64_t))
+    {
+      // magnitude < BASE * BASE, so the high part is less than BASE
+      uint64_t major, minor;
+      DecimalHelper::div128(static_cast<uint64_t>(magnitude >> 64),
+        static_cast<uint64_t>(magnitude), BASE, major, minor);
+      array_[0] = static_cast<Element>(minor);
+      array_[1] = static_cast<Element>(major);
+    }
+    else
+    {
+      for (unsigned i = 0; i != SIZE; i++)
+      {
+        array_[i] = static_cast<Element>(magnitude % BASE);
+        magnitude /= BASE;
+      }
+    }
+  }
+
+  template <typename Element, const unsigned TOTAL_RANK,
+   const unsigned FRACTION_RANK>
+  bool
+  Decimal<Element, TOTAL_RANK, FRACTION_RANK>::add_int128_(
+    const Decimal& summand1, const Decimal& summand2, bool negative2,
+    Decimal& target) noexcept
+  {
+    const UInt128 left = summand1.to_int128_();
+    const UInt128 right = summand2.to_int128_();
+    const bool same_sign = summand1.negative_ == negative2;
+    const bool less = left < right;
+    const UInt128 magnitude = same_sign ? left + right :
+      less ? right - left : left - right;
+    if (magnitude >= INT128_MAX_OVER_)
+    {
+      return false;
+    }
+    // the sign of the bigger one, the first one for equal magnitudes
+    target.negative_ = !same_sign && less ? negative2 : summand1.negative_;
+    target.from_int128_(magnitude);
+    return true;
+  }
+
+  template <typename Element, const unsigned TOTAL_RANK,
+   const unsigned FRACTION_RANK>
+  bool
+  Decimal<Element, TOTAL_RANK, FRACTION_RANK>::mul_int128_(
+    const Decimal& factor1, const Decimal& factor2,
+    DecimalMulRemainder dmr, Decimal& target) noexcept
+  {
+    UInt128 magnitude;
+    if (__builtin_mul_overflow(factor1.to_int128_(), factor2.to_int128_(),
+      &magnitude))
+    {
+      return false;
+    }
+
+    if (FRACTION_RANK)
+    {
+      uint64_t remainder;
+      magnitude = DecimalHelper::div128(magnitude, INT128_ONE_, remainder);
+      if (dmr == DMR_ROUND ? remainder >= INT128_ONE_ / 2 :
+        dmr == DMR_CEIL && remainder)
+      {
+        magnitude++;
+      }
+    }
+
+    if (magnitude >= INT128_MAX_OVER_)
+    {
+      return false;
+    }
+    target.negative_ = factor1.negative_ != factor2.negative_;
+    target.from_int128_(magnitude);
+    return true;
+  }
+
+  template <typename Element, const unsigned TOTAL_RANK,
+   const unsigned FRACTION_RANK>
+  bool
+  Decimal<Element, TOTAL_RANK, FRACTION_RANK>::div_int128_(
+    const Decimal& dividend, const Decimal& divisor,
+    DecimalDivRemainder ddr, Decimal& quotient) noexcept
+  {
+    const UInt128 divider = divisor.to_int128_();
+    UInt128 magnitude;
+    if (!divider || __builtin_mul_overflow(dividend.to_int128_(),
+      static_cast<UInt128>(INT128_ONE_), &magnitude))
+    {
+      return false;
+    }
+
+    bool inexact;
+    if (!(divider >> 64))
+    {
+      uint64_t remainder;
+      magnitude = DecimalHelper::div128(magnitude,
+        static_cast<uint64_t>(divider), remainder);
+      inexact = remainder;
+    }
+    else
+    {
+      const UInt128 scaled = magnitude;
+      magnitude /= divider;
+      inexact = magnitude * divider != scaled;
+    }
+    if (ddr == DDR_CEIL && inexact)
+    {
+      magnitude++;
+    }
+
+    if (magnitude >= INT128_MAX_OVER_)
+    {
+      return false;
+    }
+    quotient.negative_ = dividend.negative_ != divisor.negative_;
+    quotient.from_int128_(magnitude);
+    return true;
+  }
+
+  template <typename Element, const unsigned TOTAL_RANK,
+    const unsigned FRACTION_RANK>
+  template <typename Iterator>
+  Decimal<Element, TOTAL_RANK, FRACTION_RANK>
+  Decimal<Element, TOTAL_RANK, FRACTION_RANK>::sum(Iterator begin,
+    Iterator end) /*throw (eh::Exception, Overflow)*/
+  {
+    Decimal result(ZERO);
+
+    if (INT128_)
+    {
+      // signed sum in two's complement, a partial sum is in range
+      // while sum + MAX_OVER - 1 < 2 * MAX_OVER - 1,
+      // out of range one can't wrap into it as |sum| < 2 * 10 ^ 38
+      UInt128 sum = 0;
+      for (; begin != end; ++begin)
+      {
+        const Decimal& summand = *begin;
+        DEV_ASSERT(summand.array_[0] != INVALID_FLAG_);
+        const UInt128 negative = summand.negative_;
+        sum += (summand.to_int128_() ^ -negative) + negative;
+        if (sum + (INT128_MAX_OVER_ - 1) >= 2 * INT128_MAX_OVER_ - 1)
+        {
+          Stream::Error ostr;
+          ostr << FNS << "overflow summing column (over " <<
+            INTEGER_RANK << " digits in integer)";
+          throw Overflow(ostr);
+        }
+      }
+      result.negative_ = sum >> 127;
+      result.from_int128_(result.negative_ ? -sum : sum);
+      return result;
+    }
+
+    for (; begin != end; ++begin)
+    {
+      add(result, *begin, result);
+    }
+    if (result.is_zero())
+    {
+      result.negative_ = false;
+    }
+    return result;
+  }
+
   template <typename Element, const unsigned TOTAL_RANK,
     const unsigned FRACTION_RANK>
   const Decimal<Element, TOTAL_RANK, FRACTION_RANK>
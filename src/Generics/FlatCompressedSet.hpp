@@ -0,0 +1,929 @@
+#ifndef GENERICS_FLATCOMPRESSEDSET_HPP
+#define GENERICS_FLATCOMPRESSEDSET_HPP
+
+#include <algorithm>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include <eh/Exception.hpp>
+
+#include <Stream/MemoryStream.hpp>
+
+#include <Generics/CompressedSet.hpp>
+#include <Generics/Function.hpp>
+#include <Generics/MemBuf.hpp>
+#include <Generics/TypeTraits.hpp>
+
+
+namespace Generics
+{
+  /**
+   * Read mostly set of integers stored as sorted intervals.
+   * Low and high bounds of intervals are kept in two flat arrays,
+   * for i-th and (i + 1)-th intervals high[i] + 1 < low[i + 1]
+   * is always true (the same invariant as of CompressedSet).
+   * Operations over whole sets are linear merges of contiguous arrays,
+   * lookup is a binary search or a branchless scan of a short array.
+   * Modification by single interval is linear, so the set should be
+   * built in bulk (assign, assign_intervals, from CompressedSet or
+   * by load) and then combined with other sets.
+   *
+   * Implementation is not thread safe
+   */
+  template <typename Integer>
+  class FlatCompressedSet
+  {
+  public:
+    DECLARE_EXCEPTION(Exception, eh::DescriptiveException);
+    DECLARE_EXCEPTION(CorruptedData, Exception);
+
+    typedef typename CompressedSet<Integer>::CheckStatus CheckStatus;
+
+    /**
+     * Constructor
+     */
+    FlatCompressedSet() throw ();
+
+    /**
+     * Constructor
+     * Copies intervals of tree based set
+     * @param cset set to copy
+     */
+    explicit
+    FlatCompressedSet(const CompressedSet<Integer>& cset)
+      /*throw (eh::Exception)*/;
+
+    /**
+     * Replaces content of the set with values of the range
+     * @param begin start of the range of unsorted values
+     * @param end end of the range
+     */
+    template <typename Iterator>
+    void
+    assign(Iterator begin, Iterator end) /*throw (eh::Exception)*/;
+
+    /**
+     * Replaces content of the set with intervals of the range.
+     * Intervals may overlap, intervals with first > second are ignored
+     * @param begin start of the range of unsorted pairs [first, second]
+     * @param end end of the range
+     */
+    template <typename Iterator>
+    void
+    assign_intervals(Iterator begin, Iterator end) /*throw (eh::Exception)*/;
+
+    /**
+     * Checks if the set is empty
+     * @return true if no element is present in the set
+     */
+    bool
+    empty() const throw ();
+
+    /**
+     * @return number of stored intervals
+     */
+    std::size_t
+    size() const throw ();
+
+    /**
+     * @param index index of interval, must be less than size()
+     * @return low bound of the interval
+     */
+    Integer
+    low(std::size_t index) const throw ();
+
+    /**
+     * @param index index of interval, must be less than size()
+     * @return high bound of the interval
+     */
+    Integer
+    high(std::size_t index) const throw ();
+
+    /**
+     * Adds interval [low, high] to the set. Merges stored intervals
+     * if required
+     * @param low low bound of the interval
+     * @param high high bound of the interval
+     */
+    void
+    add(Integer low, Integer high) /*throw (eh::Exception)*/;
+
+    /**
+     * Adds interval [value, value] to the set
+     * @param value value to insert
+     */
+    void
+    add(Integer value) /*throw (eh::Exception)*/;
+
+    /**
+     * Makes union with fset
+     * @param fset set of intervals to insert
+     */
+    void
+    add(const FlatCompressedSet<Integer>& fset) /*throw (eh::Exception)*/;
+
+    /**
+     * Removes interval [low, high] from the set. Splits stored intervals
+     * if required
+     * @param low low bound of the interval
+     * @param high high bound of the interval
+     */
+    void
+    remove(Integer low, Integer high) /*throw (eh::Exception)*/;
+
+    /**
+     * Removes interval [value, value] from the set
+     * @param value value to remove
+     */
+    void
+    remove(Integer value) /*throw (eh::Exception)*/;
+
+    /**
+     * Makes difference with fset
+     * @param fset set of intervals to remove
+     */
+    void
+    remove(const FlatCompressedSet<Integer>& fset) /*throw (eh::Exception)*/;
+
+    /**
+     * Makes intersection with fset
+     * @param fset set of intervals to keep
+     */
+    void
+    intersect(const FlatCompressedSet<Integer>& fset)
+      /*throw (eh::Exception)*/;
+
+    /**
+     * Clears the entire set
+     */
+    void
+    clear() throw ();
+
+    /**
+     * Swaps content with the other set
+     * @param fset set to swap with
+     */
+    void
+    swap(FlatCompressedSet<Integer>& fset) throw ();
+
+    /**
+     * Checks if value belongs to any interval stored in the set
+     * @param value value to check
+     * @return if value belongs to the set
+     */
+    bool
+    belongs(Integer value) const throw ();
+
+    /**
+     * Checks if every value in interval [low, high] is present in the set
+     * @param low low bound of the interval
+     * @param high high bound of the interval
+     * @return status of presence of every value of interval in the set
+     */
+    CheckStatus
+    check_presence(Integer low, Integer high) const throw ();
+
+    /**
+     * @param fset set to check
+     * @return if every value of fset is present in the set
+     */
+    bool
+    includes(const FlatCompressedSet<Integer>& fset) const throw ();
+
+    /**
+     * @param fset set to check
+     * @return if any value of fset is present in the set
+     */
+    bool
+    intersects(const FlatCompressedSet<Integer>& fset) const throw ();
+
+    bool
+    operator ==(const FlatCompressedSet<Integer>& fset) const throw ();
+
+    bool
+    operator !=(const FlatCompressedSet<Integer>& fset) const throw ();
+
+    /**
+     * Stores the set in compact binary form: number of intervals
+     * followed by gaps between and lengths of intervals, all as LEB128
+     * @param buffer buffer to store the set in
+     */
+    void
+    save(MemBuf& buffer) const /*throw (eh::Exception)*/;
+
+    /**
+     * Replaces content of the set with one stored by save()
+     * @param data stored set
+     * @param size size of data
+     */
+    void
+    load(const void* data, std::size_t size)
+      /*throw (eh::Exception, CorruptedData)*/;
+
+  protected:
+    typedef std::vector<Integer> Bounds;
+
+    /**
+     * Sets with no more intervals are searched by a scan
+     * the compiler is able to vectorize
+     */
+    static const std::size_t LINEAR_SEARCH_LIMIT = 32;
+
+    static const std::size_t MAX_LEB128_SIZE =
+      (std::numeric_limits<uint64_t>::digits + 6) / 7;
+
+    /**
+     * @param value value to find
+     * @return number of intervals with low bound <= value
+     */
+    std::size_t
+    lows_not_greater_(Integer value) const throw ();
+
+    /**
+     * Appends interval to the arrays sorted by low bound,
+     * merges it with the last one if required
+     */
+    static
+    void
+    append_(Bounds& lows, Bounds& highs, Integer low, Integer high)
+      /*throw (eh::Exception)*/;
+
+    /**
+     * Maps value to unsigned one keeping the order
+     */
+    static
+    uint64_t
+    to_ordinal_(Integer value) throw ();
+
+    static
+    Integer
+    from_ordinal_(uint64_t ordinal) throw ();
+
+    static
+    unsigned char*
+    write_(unsigned char* out, uint64_t value) throw ();
+
+    static
+    const unsigned char*
+    read_(const unsigned char* in, const unsigned char* end, uint64_t& value)
+      /*throw (CorruptedData)*/;
+
+    Bounds lows_;
+    Bounds highs_;
+  };
+}
+
+//
+// Implementation
+//
+
+namespace Generics
+{
+  template <typename Integer>
+  const std::size_t FlatCompressedSet<Integer>::LINEAR_SEARCH_LIMIT;
+
+  template <typename Integer>
+  const std::size_t FlatCompressedSet<Integer>::MAX_LEB128_SIZE;
+
+  template <typename Integer>
+  FlatCompressedSet<Integer>::FlatCompressedSet() throw ()
+  {
+  }
+
+  template <typename Integer>
+  FlatCompressedSet<Integer>::FlatCompressedSet(
+    const CompressedSet<Integer>& cset) /*throw (eh::Exception)*/
+  {
+    lows_.reserve(cset.holder_.size());
+    highs_.reserve(cset.holder_.size());
+    for (typename CompressedSet<Integer>::Holder::const_iterator itor(
+      cset.holder_.begin()); itor != cset.holder_.end(); ++itor)
+    {
+      lows_.push_back(itor->first);
+      highs_.push_back(itor->second);
+    }
+  }
+
+  template <typename Integer>
+  template <typename Iterator>
+  void
+  FlatCompressedSet<Integer>::assign(Iterator begin, Iterator end)
+    /*throw (eh::Exception)*/
+  {
+    Bounds values(begin, end);
+    std::sort(values.begin(), values.end());
+
+    Bounds lows;
+    Bounds highs;
+    for (typename Bounds::const_iterator itor(values.begin());
+      itor != values.end(); ++itor)
+    {
+      append_(lows, highs, *itor, *itor);
+    }
+
+    lows_.swap(lows);
+    highs_.swap(highs);
+  }
+
+  template <typename Integer>
+  template <typename Iterator>
+  void
+  FlatCompressedSet<Integer>::assign_intervals(Iterator begin, Iterator end)
+    /*throw (eh::Exception)*/
+  {
+    typedef std::vector<std::pair<Integer, Integer> > Intervals;
+
+    Intervals intervals;
+    for (; begin != end; ++begin)
+    {
+      if (begin->first <= begin->second)
+      {
+        intervals.push_back(
+          typename Intervals::value_type(begin->first, begin->second));
+      }
+    }
+    std::sort(intervals.begin(), intervals.end());
+
+    Bounds lows;
+    Bounds highs;
+    for (typename Intervals::const_iterator itor(intervals.begin());
+      itor != intervals.end(); ++itor)
+    {
+      append_(lows, highs, itor->first, itor->second);
+    }
+
+    lows_.swap(lows);
+    highs_.swap(highs);
+  }
+
+  template <typename Integer>
+  bool
+  FlatCompressedSet<Integer>::empty() const throw ()
+  {
+    return lows_.empty();
+  }
+
+  template <typename Integer>
+  std::size_t
+  FlatCompressedSet<Integer>::size() const throw ()
+  {
+    return lows_.size();
+  }
+
+  template <typename Integer>
+  Integer
+  FlatCompressedSet<Integer>::low(std::size_t index) const throw ()
+  {
+    return lows_[index];
+  }
+
+  template <typename Integer>
+  Integer
+  FlatCompressedSet<Integer>::high(std::size_t index) const throw ()
+  {
+    return highs_[index];
+  }
+
+  template <typename Integer>
+  void
+  FlatCompressedSet<Integer>::add(Integer low, Integer high)
+    /*throw (eh::Exception)*/
+  {
+    if (low > high)
+    {
+      return;
+    }
+
+    // First interval adjacent to or above low
+    const std::size_t FIRST = std::partition_point(
+      highs_.begin(), highs_.end(),
+      [low] (Integer bound) { return safe_next(bound) < low; }) -
+      highs_.begin();
+    // Intervals [FIRST, last) are merged with [low, high]
+    const std::size_t LAST = std::upper_bound(
+      lows_.begin() + FIRST, lows_.end(), safe_next(high)) - lows_.begin();
+
+    if (FIRST == LAST)
+    {
+      lows_.insert(lows_.begin() + FIRST, low);
+      highs_.insert(highs_.begin() + FIRST, high);
+      return;
+    }
+
+    lows_[FIRST] = std::min(lows_[FIRST], low);
+    highs_[FIRST] = std::max(highs_[LAST - 1], high);
+    lows_.erase(lows_.begin() + FIRST + 1, lows_.begin() + LAST);
+    highs_.erase(highs_.begin() + FIRST + 1, highs_.begin() + LAST);
+  }
+
+  template <typename Integer>
+  void
+  FlatCompressedSet<Integer>::add(Integer value) /*throw (eh::Exception)*/
+  {
+    add(value, value);
+  }
+
+  template <typename Integer>
+  void
+  FlatCompressedSet<Integer>::add(const FlatCompressedSet<Integer>& fset)
+    /*throw (eh::Exception)*/
+  {
+    if (this == &fset || fset.empty())
+    {
+      return;
+    }
+
+    Bounds lows;
+    Bounds highs;
+    lows.reserve(size() + fset.size());
+    highs.reserve(size() + fset.size());
+
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < size() || j < fset.size())
+    {
+      if (j == fset.size() || (i < size() && lows_[i] < fset.lows_[j]))
+      {
+        append_(lows, highs, lows_[i], highs_[i]);
+        ++i;
+      }
+      else
+      {
+        append_(lows, highs, fset.lows_[j], fset.highs_[j]);
+        ++j;
+      }
+    }
+
+    lows_.swap(lows);
+    highs_.swap(highs);
+  }
+
+  template <typename Integer>
+  void
+  FlatCompressedSet<Integer>::remove(Integer low, Integer high)
+    /*throw (eh::Exception)*/
+  {
+    if (low > high)
+    {
+      return;
+    }
+
+    // First interval not below low
+    const std::size_t FIRST = std::partition_point(
+      highs_.begin(), highs_.end(),
+      [low] (Integer bound) { return bound < low; }) - highs_.begin();
+    // Intervals [FIRST, last) intersect [low, high]
+    const std::size_t LAST = std::upper_bound(
+      lows_.begin() + FIRST, lows_.end(), high) - lows_.begin();
+
+    if (FIRST == LAST)
+    {
+      return;
+    }
+
+    Integer rest_lows[2];
+    Integer rest_highs[2];
+    std::size_t rest = 0;
+    if (lows_[FIRST] < low)
+    {
+      rest_lows[rest] = lows_[FIRST];
+      rest_highs[rest++] = low - 1;
+    }
+    if (highs_[LAST - 1] > high)
+    {
+      rest_lows[rest] = high + 1;
+      rest_highs[rest++] = highs_[LAST - 1];
+    }
+
+    lows_.erase(lows_.begin() + FIRST, lows_.begin() + LAST);
+    highs_.erase(highs_.begin() + FIRST, highs_.begin() + LAST);
+    lows_.insert(lows_.begin() + FIRST, rest_lows, rest_lows + rest);
+    highs_.insert(highs_.begin() + FIRST, rest_highs, rest_highs + rest);
+  }
+
+  template <typename Integer>
+  void
+  FlatCompressedSet<Integer>::remove(Integer value) /*throw (eh::Exception)*/
+  {
+    remove(value, value);
+  }
+
+  template <typename Integer>
+  void
+  FlatCompressedSet<Integer>::remove(const FlatCompressedSet<Integer>& fset)
+    /*throw (eh::Exception)*/
+  {
+    if (this == &fset)
+    {
+      clear();
+      return;
+    }
+
+    if (empty() || fset.empty())
+    {
+      return;
+    }
+
+    Bounds lows;
+    Bounds highs;
+    lows.reserve(size() + fset.size());
+    highs.reserve(size() + fset.size());
+
+    std::size_t j = 0;
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+      Integer low = lows_[i];
+      const Integer HIGH = highs_[i];
+
+      while (j < fset.size() && fset.highs_[j] < low)
+      {
+        ++j;
+      }
+
+      bool rest = true;
+      // fset.highs_[k] >= low for k >= j
+      for (std::size_t k = j; k < fset.size() && fset.lows_[k] <= HIGH; ++k)
+      {
+        if (fset.lows_[k] > low)
+        {
+          lows.push_back(low);
+          highs.push_back(fset.lows_[k] - 1);
+        }
+
+        if (fset.highs_[k] >= HIGH)
+        {
+          rest = false;
+          break;
+        }
+
+        low = fset.highs_[k] + 1; // fset.highs_[k] < HIGH
+        j = k + 1;
+      }
+
+      if (rest)
+      {
+        lows.push_back(low);
+        highs.push_back(HIGH);
+      }
+    }
+
+    lows_.swap(lows);
+    highs_.swap(highs);
+  }
+
+  template <typename Integer>
+  void
+  FlatCompressedSet<Integer>::intersect(
+    const FlatCompressedSet<Integer>& fset) /*throw (eh::Exception)*/
+  {
+    if (this == &fset)
+    {
+      return;
+    }
+
+    Bounds lows;
+    Bounds highs;
+    lows.reserve(size() + fset.size());
+    highs.reserve(size() + fset.size());
+
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < size() && j < fset.size())
+    {
+      const Integer LOW = std::max(lows_[i], fset.lows_[j]);
+      const Integer HIGH = std::min(highs_[i], fset.highs_[j]);
+
+      if (LOW <= HIGH)
+      {
+        lows.push_back(LOW);
+        highs.push_back(HIGH);
+      }
+
+      if (highs_[i] < fset.highs_[j])
+      {
+        ++i;
+      }
+      else
+      {
+        ++j;
+      }
+    }
+
+    lows_.swap(lows);
+    highs_.swap(highs);
+  }
+
+  template <typename Integer>
+  void
+  FlatCompressedSet<Integer>::clear() throw ()
+  {
+    lows_.clear();
+    highs_.clear();
+  }
+
+  template <typename Integer>
+  void
+  FlatCompressedSet<Integer>::swap(FlatCompressedSet<Integer>& fset) throw ()
+  {
+    lows_.swap(fset.lows_);
+    highs_.swap(fset.highs_);
+  }
+
+  template <typename Integer>
+  std::size_t
+  FlatCompressedSet<Integer>::lows_not_greater_(Integer value) const throw ()
+  {
+    if (lows_.size() <= LINEAR_SEARCH_LIMIT)
+    {
+      const Integer* lows = lows_.data();
+      std::size_t count = 0;
+      for (std::size_t i = 0; i < lows_.size(); ++i)
+      {
+        count += lows[i] <= value;
+      }
+      return count;
+    }
+
+    return std::upper_bound(lows_.begin(), lows_.end(), value) -
+      lows_.begin();
+  }
+
+  template <typename Integer>
+  bool
+  FlatCompressedSet<Integer>::belongs(Integer value) const throw ()
+  {
+    const std::size_t COUNT = lows_not_greater_(value);
+    return COUNT && value <= highs_[COUNT - 1];
+  }
+
+  template <typename Integer>
+  typename FlatCompressedSet<Integer>::CheckStatus
+  FlatCompressedSet<Integer>::check_presence(Integer low, Integer high) const
+    throw ()
+  {
+    if (low > high)
+    {
+      return CompressedSet<Integer>::CS_NONE;
+    }
+
+    const std::size_t COUNT = lows_not_greater_(low);
+
+    if (COUNT && low <= highs_[COUNT - 1])
+    {
+      return high <= highs_[COUNT - 1] ? CompressedSet<Integer>::CS_ALL :
+        CompressedSet<Integer>::CS_SOME;
+    }
+
+    // lows_[COUNT] > low
+    return COUNT < lows_.size() && lows_[COUNT] <= high ?
+      CompressedSet<Integer>::CS_SOME : CompressedSet<Integer>::CS_NONE;
+  }
+
+  template <typename Integer>
+  bool
+  FlatCompressedSet<Integer>::includes(
+    const FlatCompressedSet<Integer>& fset) const throw ()
+  {
+    std::size_t i = 0;
+    for (std::size_t j = 0; j < fset.size(); ++j)
+    {
+      while (i < size() && highs_[i] < fset.lows_[j])
+      {
+        ++i;
+      }
+
+      if (i == size() || lows_[i] > fset.lows_[j] ||
+        highs_[i] < fset.highs_[j])
+      {
+        return false;
+      }
+    }
+
+    return true;
+  }
+
+  template <typename Integer>
+  bool
+  FlatCompressedSet<Integer>::intersects(
+    const FlatCompressedSet<Integer>& fset) const throw ()
+  {
+    std::size_t i = 0;
+    std::size_t j = 0;
+    while (i < size() && j < fset.size())
+    {
+      if (highs_[i] < fset.lows_[j])
+      {
+        ++i;
+      }
+      else if (fset.highs_[j] < lows_[i])
+      {
+        ++j;
+      }
+      else
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+  template <typename Integer>
+  bool
+  FlatCompressedSet<Integer>::operator ==(
+    const FlatCompressedSet<Integer>& fset) const throw ()
+  {
+    return lows_ == fset.lows_ && highs_ == fset.highs_;
+  }
+
+  template <typename Integer>
+  bool
+  FlatCompressedSet<Integer>::operator !=(
+    const FlatCompressedSet<Integer>& fset) const throw ()
+  {
+    return !(*this == fset);
+  }
+
+  template <typename Integer>
+  void
+  FlatCompressedSet<Integer>::append_(Bounds& lows, Bounds& highs,
+    Integer low, Integer high) /*throw (eh::Exception)*/
+  {
+    // lows.back() <= low
+    if (!lows.empty() && low <= safe_next(highs.back()))
+    {
+      if (highs.back() < high)
+      {
+        highs.back() = high;
+      }
+      return;
+    }
+
+    lows.push_back(low);
+    highs.push_back(high);
+  }
+
+  template <typename Integer>
+  uint64_t
+  FlatCompressedSet<Integer>::to_ordinal_(Integer value) throw ()
+  {
+    static_assert(std::numeric_limits<Integer>::is_integer &&
+      sizeof(Integer) <= sizeof(uint64_t), "Integer type is not supported");
+
+    typedef typename std::make_unsigned<Integer>::type UInteger;
+
+    // Flipping the sign bit maps signed order to unsigned one
+    const UInteger SIGN = std::numeric_limits<Integer>::is_signed ?
+      UInteger(1) << (std::numeric_limits<UInteger>::digits - 1) : 0;
+    return static_cast<UInteger>(static_cast<UInteger>(value) ^ SIGN);
+  }
+
+  template <typename Integer>
+  Integer
+  FlatCompressedSet<Integer>::from_ordinal_(uint64_t ordinal) throw ()
+  {
+    typedef typename std::make_unsigned<Integer>::type UInteger;
+
+    const UInteger SIGN = std::numeric_limits<Integer>::is_signed ?
+      UInteger(1) << (std::numeric_limits<UInteger>::digits - 1) : 0;
+    return static_cast<Integer>(
+      static_cast<UInteger>(static_cast<UInteger>(ordinal) ^ SIGN));
+  }
+
+  template <typename Integer>
+  unsigned char*
+  FlatCompressedSet<Integer>::write_(unsigned char* out, uint64_t value)
+    throw ()
+  {
+    for (; value >= 0x80; value >>= 7)
+    {
+      *out++ = static_cast<unsigned char>(value | 0x80);
+    }
+    *out++ = static_cast<unsigned char>(value);
+    return out;
+  }
+
+  template <typename Integer>
+  const unsigned char*
+  FlatCompressedSet<Integer>::read_(const unsigned char* in,
+    const unsigned char* end, uint64_t& value) /*throw (CorruptedData)*/
+  {
+    value = 0;
+    for (unsigned shift = 0; in != end; shift += 7)
+    {
+      const uint64_t BYTE = *in++;
+      if (shift == 63 && BYTE > 1)
+      {
+        Stream::Error ostr;
+        ostr << FNS << "too long number";
+        throw CorruptedData(ostr);
+      }
+
+      value |= (BYTE & 0x7F) << shift;
+      if (!(BYTE & 0x80))
+      {
+        return in;
+      }
+    }
+
+    Stream::Error ostr;
+    ostr << FNS << "unexpected end of data";
+    throw CorruptedData(ostr);
+  }
+
+  template <typename Integer>
+  void
+  FlatCompressedSet<Integer>::save(MemBuf& buffer) const
+    /*throw (eh::Exception)*/
+  {
+    buffer.alloc((1 + 2 * size()) * MAX_LEB128_SIZE);
+
+    unsigned char* const BEGIN = buffer.get<unsigned char>();
+    unsigned char* out = write_(BEGIN, size());
+
+    // The first low bound is stored as is, next ones as gaps
+    // between intervals decreased by the minimal gap
+    uint64_t previous_high = 0;
+    for (std::size_t i = 0; i < size(); ++i)
+    {
+      const uint64_t LOW = to_ordinal_(lows_[i]);
+      const uint64_t HIGH = to_ordinal_(highs_[i]);
+      out = write_(out, i ? LOW - previous_high - 2 : LOW);
+      out = write_(out, HIGH - LOW);
+      previous_high = HIGH;
+    }
+
+    buffer.resize(out - BEGIN);
+  }
+
+  template <typename Integer>
+  void
+  FlatCompressedSet<Integer>::load(const void* data, std::size_t size)
+    /*throw (eh::Exception, CorruptedData)*/
+  {
+    const uint64_t MAX = to_ordinal_(std::numeric_limits<Integer>::max());
+
+    const unsigned char* in = static_cast<const unsigned char*>(data);
+    const unsigned char* const END = in + size;
+
+    uint64_t count;
+    in = read_(in, END, count);
+    // Every interval takes two bytes at least
+    if (count > static_cast<std::size_t>(END - in) / 2)
+    {
+      Stream::Error ostr;
+      ostr << FNS << "number of intervals " << count <<
+        " exceeds data size " << size;
+      throw CorruptedData(ostr);
+    }
+
+    Bounds lows;
+    Bounds highs;
+    lows.reserve(count);
+    highs.reserve(count);
+
+    uint64_t previous_high = 0;
+    for (uint64_t i = 0; i < count; ++i)
+    {
+      uint64_t low;
+      uint64_t length;
+      in = read_(in, END, low);
+      in = read_(in, END, length);
+
+      if (i)
+      {
+        if (previous_high >= MAX - 1 || low > MAX - previous_high - 2)
+        {
+          Stream::Error ostr;
+          ostr << FNS << "interval " << i << " is out of range";
+          throw CorruptedData(ostr);
+        }
+        low += previous_high + 2;
+      }
+
+      if (low > MAX || length > MAX - low)
+      {
+        Stream::Error ostr;
+        ostr << FNS << "interval " << i << " is out of range";
+        throw CorruptedData(ostr);
+      }
+
+      previous_high = low + length;
+      lows.push_back(from_ordinal_(low));
+      highs.push_back(from_ordinal_(previous_high));
+    }
+
+    if (in != END)
+    {
+      Stream::Error ostr;
+      ostr << FNS << (END - in) << " unexpected bytes after the set";
+      throw CorruptedData(ostr);
+    }
+
+    lows_.swap(lows);
+    highs_.swap(highs);
+  }
+}
+
+#endif
@@ -3,6 +3,7 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 
 #include <unistd.h>
 #include <fcntl.h>
@@ -74,6 +75,15 @@ namespace Generics
     uint32_t
     rand() throw ();
 
+    /**
+     * Fills the buffer with the next bytes of the sequence.
+     * Whole blocks of generated numbers are copied at once.
+     * @param buffer memory to fill
+     * @param size number of bytes to fill
+     */
+    void
+    fill(void* buffer, size_t size) throw ();
+
   protected:
     /**
      * Initializes state
@@ -137,6 +147,30 @@ namespace Generics
     return *next_++;
   }
 
+  inline
+  void
+  ISAAC::fill(void* buffer, size_t size) throw ()
+  {
+    unsigned char* out = static_cast<unsigned char*>(buffer);
+    while (size)
+    {
+      if (!left_)
+      {
+        reinit_();
+      }
+
+      const size_t WORDS = std::min<size_t>(left_,
+        (size + sizeof(uint32_t) - 1) / sizeof(uint32_t));
+      const size_t BYTES = std::min(WORDS * sizeof(uint32_t), size);
+      std::memcpy(out, next_, BYTES);
+
+      left_ -= WORDS;
+      next_ += WORDS;
+      out += BYTES;
+      size -= BYTES;
+    }
+  }
+
   inline
   void
   ISAAC::rng_step_(uint32_t*& m, uint32_t*& m2, uint32_t*& r, uint32_t* mm,
@@ -1,16 +1,120 @@
 // Generics/Rand.cpp
+#include <new>
+
 #include <Sync/PosixLock.hpp>
+#include <Sync/Key.hpp>
 
 #include <Generics/ISAAC.hpp>
 #include <Generics/MT19937.hpp>
+#include <Generics/Rand.hpp>
 
 
 namespace Generics
 {
   namespace
   {
-    Sync::PosixMutex mutex;
-    ISAAC generator;
+    /**
+     * Holds the master generator used for seeding of the thread
+     * generators and the fallback for threads failed to get their own.
+     */
+    class ThreadGenerators : private Uncopyable
+    {
+    public:
+      ThreadGenerators() /*throw (eh::Exception)*/;
+
+      /**
+       * @return generator of the current thread or null
+       */
+      ISAAC*
+      get() throw ();
+
+      uint32_t
+      shared_rand() throw ();
+
+      void
+      shared_fill(void* buffer, size_t size) throw ();
+
+    private:
+      static
+      void
+      delete_generator_(void* generator) throw ();
+
+      static const size_t SEED_SIZE = 256;
+
+      Sync::PosixMutex mutex_;
+      ISAAC master_;
+      Sync::Key<ISAAC> key_;
+    };
+
+    ThreadGenerators::ThreadGenerators() /*throw (eh::Exception)*/
+      : key_(delete_generator_)
+    {}
+
+    ISAAC*
+    ThreadGenerators::get() throw ()
+    {
+      ISAAC* generator = key_.get_data();
+      if (generator)
+      {
+        return generator;
+      }
+
+      uint32_t seed[SEED_SIZE];
+
+      {
+        Sync::PosixGuard lock(mutex_);
+        master_.fill(seed, sizeof(seed));
+      }
+
+      generator = new(std::nothrow) ISAAC(seed);
+      if (!generator)
+      {
+        return 0;
+      }
+
+      try
+      {
+        key_.set_data(generator);
+      }
+      catch (const eh::Exception&)
+      {
+        delete generator;
+        return 0;
+      }
+
+      return generator;
+    }
+
+    uint32_t
+    ThreadGenerators::shared_rand() throw ()
+    {
+      Sync::PosixGuard lock(mutex_);
+      return master_.rand();
+    }
+
+    void
+    ThreadGenerators::shared_fill(void* buffer, size_t size) throw ()
+    {
+      Sync::PosixGuard lock(mutex_);
+      master_.fill(buffer, size);
+    }
+
+    void
+    ThreadGenerators::delete_generator_(void* generator) throw ()
+    {
+      delete static_cast<ISAAC*>(generator);
+    }
+
+    /**
+     * Constructed on the first use, so safe_rand is callable
+     * from constructors of other static objects
+     */
+    ThreadGenerators&
+    generators() /*throw (eh::Exception)*/
+    {
+      static ThreadGenerators instance;
+      return instance;
+    }
   }
 
   const size_t MT19937::STATE_SIZE;
@@ -22,7 +126,24 @@ namespace Generics
   uint32_t
   safe_rand() throw ()
   {
-    Sync::PosixGuard lock(mutex);
-    return generator.rand() >> 1;
+    ThreadGenerators& thread_generators = generators();
+    ISAAC* generator = thread_generators.get();
+    return (generator ? generator->rand() :
+      thread_generators.shared_rand()) >> 1;
+  }
+
+  void
+  safe_rand_fill(void* buffer, size_t size) throw ()
+  {
+    ThreadGenerators& thread_generators = generators();
+    ISAAC* generator = thread_generators.get();
+    if (generator)
+    {
+      generator->fill(buffer, size);
+    }
+    else
+    {
+      thread_generators.shared_fill(buffer, size);
+    }
   }
 }
@@ -6,6 +6,7 @@
 #ifndef GENERICS_RAND_HPP
 #define GENERICS_RAND_HPP
 
+#include <cstddef>
 #include <cstdint>
 
 
@@ -13,12 +14,23 @@ namespace Generics
 {
   /**
    * Thread safe service for random numbers generation.
-   * Based on ISAAC generator with /dev/urandom seed.
+   * Based on per-thread ISAAC generators, each seeded with a distinct
+   * sequence from the master ISAAC generator with /dev/urandom seed.
+   * Does not lock after the first call in the thread.
    * @return random number in [0..RAND_MAX] range
    */
   uint32_t
   safe_rand() throw ();
 
+  /**
+   * Fills the buffer with random bytes from the current thread generator.
+   * Thread-safe.
+   * @param buffer memory to fill
+   * @param size number of bytes to fill
+   */
+  void
+  safe_rand_fill(void* buffer, size_t size) throw ();
+
   /**
    * Give uniform distribution in range [0..max_boundary-1].
    * Thread-safe.
@@ -2,6 +2,10 @@
  * @file   Time.cpp
  * @author Karen Aroutiounov
  */
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #include <eh/Errno.hpp>
 
 #include <Generics/Time.hpp>
@@ -136,6 +140,223 @@ namespace Generics
     et.tm_mday = time - *MONTH;
   }
 
+  namespace
+  {
+    /**
+     * Periods of constant UTC offset of the local time zone between 1970
+     * and 2100 (the range of gm_to_time() and time_to_gm()) found by
+     * probing localtime_r() once a day and bisecting the changes.
+     * Immutable after construction, so the readers take no lock.
+     */
+    class LocalTimeZone
+    {
+    public:
+      LocalTimeZone() noexcept;
+
+      static
+      const LocalTimeZone&
+      instance() noexcept;
+
+      bool
+      to_local(time_t time, tm& et) const noexcept;
+
+      bool
+      to_time(tm& et, time_t& time) const noexcept;
+
+    private:
+      struct Period
+      {
+        time_t start;
+        long gmtoff;
+        int isdst;
+        const char* zone;
+      };
+
+      typedef std::vector<Period> Periods;
+
+      static
+      bool
+      same_(const Period& period, const tm& et) noexcept;
+
+      Periods::const_iterator
+      find_(time_t time) const noexcept;
+
+      // 2100-01-01 00:00:00 UTC
+      static const time_t END_ = 4102444800l;
+      static const time_t DAY_ = 24 * 60 * 60;
+      static const time_t MAX_OFFSET_ = 26 * 60 * 60;
+
+      Periods periods_;
+    };
+
+    LocalTimeZone::LocalTimeZone() noexcept
+    {
+      try
+      {
+        ::tzset();
+
+        tm et;
+        time_t time = 0;
+        if (!localtime_r(&time, &et))
+        {
+          return;
+        }
+        periods_.push_back(Period{0, et.tm_gmtoff, et.tm_isdst, et.tm_zone});
+
+        for (time = DAY_; time < END_; time += DAY_)
+        {
+          if (!localtime_r(&time, &et))
+          {
+            periods_.clear();
+            return;
+          }
+          if (same_(periods_.back(), et))
+          {
+            continue;
+          }
+
+          time_t low = time - DAY_;
+          time_t high = time;
+          tm found = et;
+          while (high - low > 1)
+          {
+            const time_t MIDDLE = low + (high - low) / 2;
+            if (!localtime_r(&MIDDLE, &et))
+            {
+              periods_.clear();
+              return;
+            }
+            if (same_(periods_.back(), et))
+            {
+              low = MIDDLE;
+            }
+            else
+            {
+              high = MIDDLE;
+              found = et;
+            }
+          }
+
+          periods_.push_back(
+            Period{high, found.tm_gmtoff, found.tm_isdst, found.tm_zone});
+        }
+      }
+      catch (...)
+      {
+        periods_.clear();
+      }
+    }
+
+    const LocalTimeZone&
+    LocalTimeZone::instance() noexcept
+    {
+      static const LocalTimeZone TIME_ZONE;
+      return TIME_ZONE;
+    }
+
+    bool
+    LocalTimeZone::same_(const Period& period, const tm& et) noexcept
+    {
+      return period.gmtoff == et.tm_gmtoff &&
+        period.isdst == et.tm_isdst &&
+        (period.zone == et.tm_zone ||
+          (period.zone && et.tm_zone && !strcmp(period.zone, et.tm_zone)));
+    }
+
+    LocalTimeZone::Periods::const_iterator
+    LocalTimeZone::find_(time_t time) const noexcept
+    {
+      // periods_.front().start is 0 and time is not negative
+      return std::upper_bound(periods_.begin(), periods_.end(), time,
+        [] (time_t time, const Period& period)
+        {
+          return time < period.start;
+        }) - 1;
+    }
+
+    bool
+    LocalTimeZone::to_local(time_t time, tm& et) const noexcept
+    {
+      if (periods_.empty() || time < 0 || time >= END_)
+      {
+        return false;
+      }
+
+      const Period& period = *find_(time);
+      const time_t LOCAL = time + period.gmtoff;
+      if (LOCAL < 0 || LOCAL >= END_)
+      {
+        return false;
+      }
+
+      time_to_gm(LOCAL, et);
+      et.tm_isdst = period.isdst;
+      et.tm_gmtoff = period.gmtoff;
+      et.tm_zone = period.zone;
+      return true;
+    }
+
+    bool
+    LocalTimeZone::to_time(tm& et, time_t& time) const noexcept
+    {
+      if (periods_.empty() || et.tm_mon < 0 || et.tm_mon > 11 ||
+        et.tm_year < 70 || et.tm_year >= 200)
+      {
+        return false;
+      }
+
+      const time_t LOCAL = gm_to_time(et);
+      if (LOCAL < MAX_OFFSET_ || LOCAL >= END_ - MAX_OFFSET_)
+      {
+        return false;
+      }
+
+      // Any period may hold LOCAL only within MAX_OFFSET_ from it
+      const Period* found = 0;
+      for (Periods::const_iterator itor(find_(LOCAL - MAX_OFFSET_));
+        itor != periods_.end() && itor->start <= LOCAL + MAX_OFFSET_;
+        ++itor)
+      {
+        const time_t TIME = LOCAL - itor->gmtoff;
+        const Periods::const_iterator NEXT = itor + 1;
+        if (TIME >= itor->start &&
+          (NEXT == periods_.end() || TIME < NEXT->start))
+        {
+          if (found)
+          {
+            // Ambiguous local time, leave the choice to mktime()
+            return false;
+          }
+          found = &*itor;
+          time = TIME;
+        }
+      }
+
+      if (!found || (et.tm_isdst >= 0 &&
+        (et.tm_isdst > 0) != (found->isdst > 0)))
+      {
+        return false;
+      }
+
+      return to_local(time, et);
+    }
+  }
+
+  bool
+  time_to_local(time_t time, tm& et) noexcept
+  {
+    return LocalTimeZone::instance().to_local(time, et) ||
+      localtime_r(&time, &et);
+  }
+
+  time_t
+  local_to_time(tm& et) noexcept
+  {
+    time_t time;
+    return LocalTimeZone::instance().to_time(et, time) ? time :
+      ::mktime(&et);
+  }
+
   namespace
   {
     bool
@@ -222,6 +443,39 @@ namespace Generics
       while (i);
       return add_str(str, size, length, String::SubString(buf, SIZE));
     }
+
+    /**
+     * The last result of ExtendedTime::format() in the thread:
+     * loggers format the same second many times
+     */
+    struct FormatCache
+    {
+      static const size_t KEY_SIZE = 11;
+
+      int key[KEY_SIZE];
+      char format[32];
+      char str[256];
+      size_t length;
+    };
+
+    thread_local FormatCache format_cache;
+
+    void
+    format_key(const ExtendedTime& time, const char* format,
+      int (&key)[FormatCache::KEY_SIZE]) noexcept
+    {
+      key[0] = time.tm_sec;
+      key[1] = time.tm_min;
+      key[2] = time.tm_hour;
+      key[3] = time.tm_mday;
+      key[4] = time.tm_mon;
+      key[5] = time.tm_year;
+      key[6] = time.tm_wday;
+      key[7] = time.tm_yday;
+      key[8] = time.tm_isdst;
+      key[9] = time.timezone;
+      key[10] = strstr(format, "%q") ? time.tm_usec : -1;
+    }
   }
 
 
@@ -239,10 +493,10 @@ namespace Generics
       break;
 
     case Time::TZ_LOCAL:
-      if (!localtime_r(&sec, this))
+      if (!time_to_local(sec, *this))
       {
         eh::throw_errno_exception<Exception>(FNE,
-          "localtime_r(", sec, ") failed");
+          "time_to_local(", sec, ") failed");
       }
       break;
     /*
@@ -611,7 +865,7 @@ namespace Generics
             else
             {
               Generics::ExtendedTime tmp = *this;
-              if (mktime(&tmp) == -1)
+              if (local_to_time(tmp) == -1)
               {
                 return 0;
               }
@@ -660,16 +914,40 @@ namespace Generics
       throw InvalidArgument(ostr);
     }
 
-    char str[256];
-    size_t length = to_str_(str, sizeof(str), fmt);
-    if (!length)
+    FormatCache& cache = format_cache;
+    const size_t FORMAT_LENGTH = strlen(fmt);
+    const bool CACHED = FORMAT_LENGTH < sizeof(cache.format);
+
+    int key[FormatCache::KEY_SIZE];
+    if (CACHED)
+    {
+      format_key(*this, fmt, key);
+      if (cache.length && !memcmp(cache.key, key, sizeof(key)) &&
+        !strcmp(cache.format, fmt))
+      {
+        return std::string(cache.str, cache.length);
+      }
+      cache.length = 0;
+    }
+
+    char buf[sizeof(cache.str)];
+    char* const str = CACHED ? cache.str : buf;
+    const size_t LENGTH = to_str_(str, sizeof(buf), fmt);
+    if (!LENGTH)
     {
       Stream::Error ostr;
       ostr << FNS << "can't format time with format '" << fmt << "'";
       throw Exception(ostr);
     }
 
-    return std::string(str, length);
+    if (CACHED)
+    {
+      memcpy(cache.key, key, sizeof(key));
+      memcpy(cache.format, fmt, FORMAT_LENGTH + 1);
+      cache.length = LENGTH;
+    }
+
+    return std::string(str, LENGTH);
   }
 
   std::string
@@ -504,6 +504,28 @@ namespace Generics
   void
   time_to_gm(time_t time, tm& et) noexcept;
 
+  /**
+   * localtime_r(3) analogue
+   * Times between 1970 and 2100 are converted by the table of the local
+   * time zone transitions built once on the first call, without the libc
+   * time zone lock. TZ changes after that are not seen.
+   * @param time seconds since epoch to split
+   * @param et resulted split local time
+   * @return false if the conversion failed
+   */
+  bool
+  time_to_local(time_t time, tm& et) noexcept;
+
+  /**
+   * mktime(3) analogue
+   * Uses the table of time_to_local() except for nonexistent and
+   * ambiguous local times and tm_isdst contradicting the table.
+   * @param et split local time, normalized on success
+   * @return seconds since epoch or -1 on failure
+   */
+  time_t
+  local_to_time(tm& et) noexcept;
+
   template <typename Hash>
   void
   hash_add(Hash& hash, const Time& key) noexcept;
@@ -750,7 +772,7 @@ namespace Generics
     case Time::TZ_LOCAL:
       {
         tm tmp = *this;
-        sec = ::mktime(&tmp);
+        sec = local_to_time(tmp);
       }
       break;
 
@@ -775,7 +797,7 @@ namespace Generics
       res = 0;
       break;
     case Time::TZ_LOCAL:
-      res = mktime(this);
+      res = local_to_time(*this);
       break;
     default:
       break;
@@ -1,4 +1,5 @@
 #include <list>
+#include <vector>
 
 #include <String/UTF8Case.hpp>
 
@@ -6,6 +7,8 @@
 
 #include <Stream/MemoryStream.hpp>
 
+#include <Sync/Semaphore.hpp>
+
 #include <Language/BLogic/NormalizeTrigger.hpp>
 
 
@@ -19,10 +22,90 @@ namespace
     typedef std::pair<std::string, bool> Part;
     typedef std::list<Part> Parts;
 
+    void
+    clear() throw ();
+
+    Part&
+    add() /*throw (eh::Exception)*/;
+
+    Parts::iterator
+    erase(Parts::iterator itor) throw ();
+
     bool exact;
     Parts parts;
+    // Removed parts, their nodes and strings are reused by add()
+    Parts spare;
   };
 
+  void
+  Split::clear() throw ()
+  {
+    spare.splice(spare.end(), parts);
+  }
+
+  Split::Part&
+  Split::add() /*throw (eh::Exception)*/
+  {
+    if (spare.empty())
+    {
+      parts.emplace_back();
+    }
+    else
+    {
+      parts.splice(parts.end(), spare, spare.begin());
+    }
+    return parts.back();
+  }
+
+  Split::Parts::iterator
+  Split::erase(Parts::iterator itor) throw ()
+  {
+    Parts::iterator next(itor);
+    ++next;
+    spare.splice(spare.end(), parts, itor);
+    return next;
+  }
+
+
+  /**
+   * Working buffers of the normalizations made in one thread
+   */
+  struct Scratch
+  {
+    // Larger buffers are released after use (long phrases)
+    static const std::size_t MAX_KEPT_CAPACITY = 64 * 1024;
+
+    void
+    trim() throw ();
+
+    std::string simplified;
+    std::string part;
+    Split split;
+  };
+
+  void
+  trim_string(std::string& str) throw ()
+  {
+    if (str.capacity() > Scratch::MAX_KEPT_CAPACITY)
+    {
+      std::string().swap(str);
+    }
+  }
+
+  void
+  Scratch::trim() throw ()
+  {
+    trim_string(simplified);
+    trim_string(part);
+  }
+
+  Scratch&
+  thread_scratch() throw ()
+  {
+    static thread_local Scratch scratch;
+    return scratch;
+  }
+
 
   const char*
   find_quote(const char* cur, const char* const END) throw ()
@@ -137,12 +220,13 @@ namespace
   void
   simplify_common(const String::SubString& trigger, const char* name,
     const String::SubString& str, std::string& result,
-    const Language::Segmentor::SegmentorInterface* segmentor)
+    const Language::Segmentor::SegmentorInterface* segmentor,
+    Scratch& scratch)
     /*throw (eh::Exception, Exception)*/
   {
     const bool HAS_SEGMENTOR = segmentor;
 
-    std::string res;
+    std::string& res = scratch.simplified;
     if (!String::case_change<String::Simplify>(str,
       HAS_SEGMENTOR ? res : result))
     {
@@ -168,10 +252,11 @@ namespace
   void
   simplify(const String::SubString& trigger, const char* name,
     const String::SubString& str, std::string& result,
-    const Language::Segmentor::SegmentorInterface* segmentor)
+    const Language::Segmentor::SegmentorInterface* segmentor,
+    Scratch& scratch)
     /*throw (eh::Exception, Exception)*/
   {
-    simplify_common(trigger, name, str, result, segmentor);
+    simplify_common(trigger, name, str, result, segmentor, scratch);
 
     if (!result.empty())
     {
@@ -197,15 +282,15 @@ namespace
   add_part(const char* begin, const char* end, bool quotes, bool exact,
     const String::SubString& trigger, Split& split,
     const Language::Segmentor::SegmentorInterface* segmentor,
-    unsigned& parts, unsigned& size)
+    Scratch& scratch, unsigned& parts, unsigned& size)
     /*throw (eh::Exception)*/
   {
     if (begin != end)
     {
-      std::string tmp;
+      std::string& tmp = scratch.part;
 
       simplify(trigger, "trigger", String::SubString(begin, end),
-        tmp, segmentor);
+        tmp, segmentor, scratch);
 
       if (!tmp.empty())
       {
@@ -220,8 +305,7 @@ namespace
               parts++;
               size += (cur - begin) + 1;
 
-              split.parts.emplace_back();
-              Split::Part& part = split.parts.back();
+              Split::Part& part = split.add();
               part.first.assign(begin, cur);
               part.second = false;
 
@@ -238,8 +322,7 @@ namespace
           parts++;
           size += tmp.size() + 3;
 
-          split.parts.emplace_back();
-          Split::Part& part = split.parts.back();
+          Split::Part& part = split.add();
           part.first.swap(tmp);
           part.second = quotes;
         }
@@ -250,7 +333,7 @@ namespace
   void
   divide(const String::SubString& trigger, Split& split,
     const Language::Segmentor::SegmentorInterface* segmentor,
-    unsigned& parts, unsigned& size)
+    Scratch& scratch, unsigned& parts, unsigned& size)
     /*throw (eh::Exception, Exception)*/
   {
     if (trigger.size() > 1024)
@@ -264,7 +347,7 @@ namespace
     size = 0;
 
     split.exact = false;
-    split.parts.clear();
+    split.clear();
 
     if (trigger.empty())
     {
@@ -349,7 +432,7 @@ namespace
       }
 
       add_part(begin, end, QUOTES, EXACT, trigger, split, segmentor,
-        parts, size);
+        scratch, parts, size);
 
       if (cur == END || next(cur, END))
       {
@@ -387,11 +470,11 @@ namespace
   }
 
   bool
-  narrow_one(Split::Parts& parts, Split::Parts::iterator itor) throw ()
+  narrow_one(Split& split, Split::Parts::iterator itor) throw ()
   {
     Split::Parts::iterator next(itor);
 
-    for (++next; next != parts.end();)
+    for (++next; next != split.parts.end();)
     {
       if (itor->first.size() == next->first.size())
       {
@@ -401,7 +484,7 @@ namespace
           {
             itor->second = true;
           }
-          next = parts.erase(next);
+          next = split.erase(next);
           continue;
         }
       }
@@ -409,7 +492,7 @@ namespace
       {
         if (is_substr(next->first, itor->first))
         {
-          next = parts.erase(next);
+          next = split.erase(next);
           continue;
         }
       }
@@ -427,20 +510,21 @@ namespace
   }
 
   void
-  narrow(Split::Parts& parts) throw ()
+  narrow(Split& split) throw ()
   {
-    for (Split::Parts::iterator itor = parts.begin(); itor != parts.end();)
+    for (Split::Parts::iterator itor = split.parts.begin();
+      itor != split.parts.end();)
     {
-      if (narrow_one(parts, itor))
+      if (narrow_one(split, itor))
       {
-        itor = parts.erase(itor);
+        itor = split.erase(itor);
       }
       else
       {
         ++itor;
       }
     }
-    parts.sort();
+    split.parts.sort();
   }
 
   void
@@ -529,6 +613,173 @@ namespace
       result.trigger.push_back(']');
     }
   }
+
+  /**
+   * Consecutive triggers of a batch normalized by one thread
+   */
+  struct Chunk
+  {
+    const String::SubString* begin;
+    const String::SubString* end;
+    // Index of the first trigger in the batch
+    std::size_t first;
+    std::string arena;
+    // Ends of the normalized triggers in the arena
+    Batch::IndexArray ends;
+    Batch::IndexArray failed;
+    // Not empty if the chunk isn't normalized completely
+    std::string error;
+  };
+
+  typedef std::vector<Chunk> ChunkArray;
+
+  // Number of triggers in a chunk enqueued into the executor
+  const std::size_t CHUNK_SIZE = 4096;
+
+  void
+  normalize_chunk(Chunk& chunk,
+    const Language::Segmentor::SegmentorInterface* segmentor) throw ()
+  {
+    try
+    {
+      Scratch& scratch = thread_scratch();
+      Split& split = scratch.split;
+
+      chunk.arena.clear();
+      chunk.ends.clear();
+      chunk.failed.clear();
+      chunk.ends.reserve(chunk.end - chunk.begin);
+
+      for (const String::SubString* cur = chunk.begin; cur != chunk.end;
+        ++cur)
+      {
+        unsigned parts, size;
+
+        try
+        {
+          divide(*cur, split, segmentor, scratch, parts, size);
+        }
+        catch (const Exception&)
+        {
+          chunk.failed.push_back(chunk.first + (cur - chunk.begin));
+          parts = 0;
+        }
+
+        if (parts)
+        {
+          if (!split.exact)
+          {
+            narrow(split);
+          }
+
+          combine(split, chunk.arena);
+        }
+
+        chunk.ends.push_back(chunk.arena.size());
+      }
+
+      scratch.trim();
+    }
+    catch (const eh::Exception& ex)
+    {
+      chunk.error = ex.what();
+    }
+    catch (...)
+    {
+      chunk.error = "unknown exception";
+    }
+  }
+
+  class NormalizeTask : public Generics::TaskImpl
+  {
+  public:
+    NormalizeTask(Chunk& chunk,
+      const Language::Segmentor::SegmentorInterface* segmentor,
+      Sync::Semaphore& done)
+      throw ();
+
+    virtual
+    void
+    execute() throw ();
+
+  protected:
+    virtual
+    ~NormalizeTask() throw ();
+
+  private:
+    Chunk& chunk_;
+    const Language::Segmentor::SegmentorInterface* segmentor_;
+    Sync::Semaphore& done_;
+  };
+
+  NormalizeTask::NormalizeTask(Chunk& chunk,
+    const Language::Segmentor::SegmentorInterface* segmentor,
+    Sync::Semaphore& done)
+    throw ()
+    : chunk_(chunk), segmentor_(segmentor), done_(done)
+  {
+  }
+
+  NormalizeTask::~NormalizeTask() throw ()
+  {
+  }
+
+  void
+  NormalizeTask::execute() throw ()
+  {
+    normalize_chunk(chunk_, segmentor_);
+
+    try
+    {
+      done_.release();
+    }
+    catch (const eh::Exception&)
+    {
+    }
+  }
+
+  /**
+   * Normalizes chunks except the first one in the executor and the
+   * first one in the calling thread. Chunks the executor doesn't accept
+   * are normalized in the calling thread too.
+   */
+  void
+  normalize_chunks(ChunkArray& chunks,
+    const Language::Segmentor::SegmentorInterface* segmentor,
+    Generics::TaskExecutor* executor)
+    /*throw (eh::Exception)*/
+  {
+    Sync::Semaphore done(0);
+    std::vector<bool> enqueued(chunks.size());
+    std::size_t to_wait = 0;
+
+    for (std::size_t i = 1; i < chunks.size(); ++i)
+    {
+      try
+      {
+        executor->enqueue_task(Generics::Task_var(
+          new NormalizeTask(chunks[i], segmentor, done)));
+        enqueued[i] = true;
+        ++to_wait;
+      }
+      catch (const eh::Exception&)
+      {
+      }
+    }
+
+    for (std::size_t i = 0; i < chunks.size(); ++i)
+    {
+      if (!enqueued[i])
+      {
+        normalize_chunk(chunks[i], segmentor);
+      }
+    }
+
+    for (; to_wait; --to_wait)
+    {
+      done.acquire();
+    }
+  }
 }
 
 namespace Language
@@ -540,10 +791,11 @@ namespace Language
       const Segmentor::SegmentorInterface* segmentor)
       /*throw (eh::Exception, Exception)*/
     {
-      Split split;
+      Scratch& scratch = thread_scratch();
+      Split& split = scratch.split;
       unsigned parts, size;
 
-      divide(trigger, split, segmentor, parts, size);
+      divide(trigger, split, segmentor, scratch, parts, size);
 
       result.clear();
       if (!parts)
@@ -553,7 +805,7 @@ namespace Language
 
       if (!split.exact)
       {
-        narrow(split.parts);
+        narrow(split);
       }
 
       result.reserve(size);
@@ -566,10 +818,11 @@ namespace Language
       const Segmentor::SegmentorInterface* segmentor)
       /*throw (eh::Exception, Exception)*/
     {
-      Split split;
+      Scratch& scratch = thread_scratch();
+      Split& split = scratch.split;
       unsigned parts, size;
 
-      divide(trigger, split, segmentor, parts, size);
+      divide(trigger, split, segmentor, scratch, parts, size);
 
       result.exact = false;
       result.parts.clear();
@@ -582,7 +835,7 @@ namespace Language
 
       if (!split.exact)
       {
-        narrow(split.parts);
+        narrow(split);
       }
 
       result.exact = split.exact;
@@ -597,7 +850,79 @@ namespace Language
       const Language::Segmentor::SegmentorInterface* segmentor)
       /*throw (eh::Exception, Exception)*/
     {
-      simplify(phrase, "phrase", phrase, result, segmentor);
+      Scratch& scratch = thread_scratch();
+      simplify(phrase, "phrase", phrase, result, segmentor, scratch);
+      scratch.trim();
+    }
+
+    void
+    normalize(const String::SubString* begin, const String::SubString* end,
+      Batch& result, const Segmentor::SegmentorInterface* segmentor,
+      Generics::TaskExecutor* executor)
+      /*throw (eh::Exception)*/
+    {
+      const std::size_t SIZE = end - begin;
+      const std::size_t CHUNKS = executor && SIZE > CHUNK_SIZE ?
+        (SIZE + CHUNK_SIZE - 1) / CHUNK_SIZE : 1;
+
+      ChunkArray chunks(CHUNKS);
+      for (std::size_t i = 0; i < CHUNKS; ++i)
+      {
+        Chunk& chunk = chunks[i];
+        chunk.first = i * CHUNK_SIZE;
+        chunk.begin = begin + chunk.first;
+        chunk.end = i + 1 == CHUNKS ? end : chunk.begin + CHUNK_SIZE;
+      }
+
+      // The first chunk is normalized right into the result arena
+      chunks[0].arena.swap(result.arena);
+
+      if (CHUNKS > 1)
+      {
+        normalize_chunks(chunks, segmentor, executor);
+      }
+      else
+      {
+        normalize_chunk(chunks[0], segmentor);
+      }
+
+      result.arena.swap(chunks[0].arena);
+      result.offsets.clear();
+      result.failed.clear();
+
+      std::size_t arena_size = 0;
+      for (std::size_t i = 0; i < CHUNKS; ++i)
+      {
+        if (!chunks[i].error.empty())
+        {
+          result.arena.clear();
+          Stream::Error ostr;
+          ostr << FNS << "can't normalize triggers: " << chunks[i].error;
+          throw Exception(ostr);
+        }
+        arena_size += chunks[i].arena.size();
+      }
+
+      result.arena.reserve(arena_size);
+      result.offsets.reserve(SIZE + 1);
+      result.offsets.push_back(0);
+
+      for (std::size_t i = 0; i < CHUNKS; ++i)
+      {
+        const Chunk& chunk = chunks[i];
+        const std::size_t BASE = i ? result.arena.size() : 0;
+        if (i)
+        {
+          result.arena.append(chunk.arena);
+        }
+        for (Batch::IndexArray::const_iterator itor = chunk.ends.begin();
+          itor != chunk.ends.end(); ++itor)
+        {
+          result.offsets.push_back(BASE + *itor);
+        }
+        result.failed.insert(result.failed.end(), chunk.failed.begin(),
+          chunk.failed.end());
+      }
     }
   }
 }
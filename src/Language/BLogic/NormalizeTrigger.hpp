@@ -7,6 +7,8 @@
 #include <String/SubString.hpp>
 #include <String/AsciiStringManip.hpp>
 
+#include <Generics/TaskRunner.hpp>
+
 #include <Language/SegmentorCommons/SegmentorInterface.hpp>
 
 
@@ -69,6 +71,75 @@ namespace Language
     normalize_phrase(const String::SubString& phrase, std::string& result,
       const Language::Segmentor::SegmentorInterface* segmentor = 0)
       /*throw (eh::Exception, Exception)*/;
+
+
+    /**
+     * Normalized triggers of a batch stored one after another in the
+     * arena. Trigger i occupies [offsets[i], offsets[i + 1]).
+     */
+    struct Batch
+    {
+      typedef std::vector<std::size_t> IndexArray;
+
+      std::string arena;
+      IndexArray offsets;
+      // Indexes of invalid triggers (normalized as empty) in ascending order
+      IndexArray failed;
+
+      /**
+       * @return number of triggers in the batch
+       */
+      std::size_t
+      size() const throw ();
+
+      /**
+       * @param index index of the trigger
+       * @return normalized trigger
+       */
+      String::SubString
+      operator [](std::size_t index) const throw ();
+    };
+
+    /**
+     * Normalizes triggers as normalize(trigger, std::string&) does.
+     * Invalid triggers are reported in result.failed instead of an
+     * exception. Buffers of result and the per-thread working buffers are
+     * reused, so normalizing a stream of batches into the same result
+     * doesn't allocate in the steady state.
+     * @param begin beginning of the triggers
+     * @param end end of the triggers
+     * @param result normalized triggers
+     * @param segmentor optional segmentor, should be thread safe if
+     * executor is used
+     * @param executor optional executor, parts of large batches are
+     * enqueued into it and normalized in parallel with the calling thread
+     */
+    void
+    normalize(const String::SubString* begin, const String::SubString* end,
+      Batch& result, const Segmentor::SegmentorInterface* segmentor = 0,
+      Generics::TaskExecutor* executor = 0)
+      /*throw (eh::Exception)*/;
+  }
+}
+
+namespace Language
+{
+  namespace Trigger
+  {
+    inline
+    std::size_t
+    Batch::size() const throw ()
+    {
+      return offsets.empty() ? 0 : offsets.size() - 1;
+    }
+
+    inline
+    String::SubString
+    Batch::operator [](std::size_t index) const throw ()
+    {
+      return String::SubString(arena.data() + offsets[index],
+        offsets[index + 1] - offsets[index]);
+    }
   }
 }
 
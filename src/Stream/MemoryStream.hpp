@@ -9,6 +9,7 @@
 #include <cstring>
 #include <iomanip>
 #include <istream>
+#include <memory_resource>
 #include <ostream>
 #include <sstream>
 #include <streambuf>
@@ -559,7 +560,9 @@ namespace Stream
        * @param allocator_initializer allocator initializer
        */
       explicit
-      OutputMemoryStream(typename Allocator::size_type initial_size = SIZE,
+      OutputMemoryStream(
+        typename std::allocator_traits<Allocator>::size_type initial_size =
+          SIZE,
         const AllocatorInitializer& allocator_initializer =
           AllocatorInitializer()) /*throw (eh::Exception)*/;
 
@@ -714,6 +717,10 @@ namespace Stream
   // Dynamic memory output stream with preallocation
   typedef MemoryStream::OutputMemoryStream<char> Dynamic;
 
+  // Dynamic memory output stream over std::pmr::memory_resource
+  typedef MemoryStream::OutputMemoryStream<char, std::char_traits<char>,
+    std::pmr::polymorphic_allocator<char> > PolymorphicDynamic;
+
 
   /**
    * Output memory stream working on external memory buffer of size
@@ -816,7 +816,8 @@ namespace Stream
     template <typename Elem, typename Traits, typename Allocator,
       typename AllocatorInitializer, const size_t SIZE>
     OutputMemoryStream<Elem, Traits, Allocator, AllocatorInitializer, SIZE>::
-      OutputMemoryStream(typename Allocator::size_type initial_size,
+      OutputMemoryStream(
+        typename std::allocator_traits<Allocator>::size_type initial_size,
         const AllocatorInitializer& allocator_initializer)
       /*throw (eh::Exception)*/
       : Holder(initial_size, allocator_initializer)
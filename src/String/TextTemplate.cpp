@@ -17,6 +17,74 @@ namespace String
 {
   namespace TextTemplate
   {
+    namespace
+    {
+      /**
+       * Splits a template into text and keys
+       * @param source template to parse
+       * @param start_lexeme Start lexeme.
+       * @param end_lexeme End lexeme.
+       * @param handler receives text(SubString) and key(SubString) calls
+       */
+      template <typename Handler>
+      void
+      parse_template(const SubString& source,
+        const SubString& start_lexeme, const SubString& end_lexeme,
+        Handler& handler)
+        /*throw (InvalidTemplate, TextTemplException, eh::Exception)*/
+      {
+        if (start_lexeme.empty())
+        {
+          Stream::Error ostr;
+          ostr << FNS << "empty start_lexeme.";
+          throw TextTemplException(ostr);
+        }
+
+        if (end_lexeme.empty())
+        {
+          Stream::Error ostr;
+          ostr << FNS << "empty end_lexeme.";
+          throw TextTemplException(ostr);
+        }
+
+        SubString str(source);
+
+        // Split a template string on keys into items
+        while (!str.empty())
+        {
+          SubString::SizeType begin = str.find(start_lexeme);
+
+          if (begin == SubString::NPOS)
+          {
+            handler.text(str);
+            break;
+          }
+
+          if(begin > 0)
+          {
+            handler.text(str.substr(0, begin));
+          }
+
+          begin += start_lexeme.length();
+
+          SubString::SizeType end = str.find(end_lexeme, begin);
+          if (end == SubString::NPOS)
+          {
+            Stream::Error ostr;
+            ostr << FNS <<
+              "invalid template: closing lexeme (" << end_lexeme <<
+              ") not found. Template:\n'" << source << "'";
+            throw InvalidTemplate(ostr);
+          }
+
+          handler.key(str.substr(begin, end - begin));
+
+          str = str.substr(end + end_lexeme.length());
+        }
+      }
+    }
+
+
     //
     // Basic::Item class
     //
@@ -108,63 +176,42 @@ namespace String
       init(str, start_lexeme, end_lexeme);
     }
 
-    void
-    Basic::init(const SubString& source,
-      const SubString& start_lexeme, const SubString& end_lexeme)
-      /*throw (InvalidTemplate, TextTemplException, eh::Exception)*/
+    /**
+     * Creates the list of items from the template
+     */
+    struct Basic::ItemsBuilder
     {
-      items_.clear();
-
-      if (start_lexeme.empty())
+      explicit
+      ItemsBuilder(Items& items) throw ()
+        : items_(items)
       {
-        Stream::Error ostr;
-        ostr << FNS << "empty start_lexeme.";
-        throw TextTemplException(ostr);
       }
 
-      if (end_lexeme.empty())
+      void
+      text(const SubString& str) /*throw (eh::Exception)*/
       {
-        Stream::Error ostr;
-        ostr << FNS << "empty end_lexeme.";
-        throw TextTemplException(ostr);
+        items_.push_back(Item_var(new StringItem(str)));
       }
 
-      SubString str(source);
-
-      // Split a template string on keys into items
-      // and create the list from them.
-      while (!str.empty())
+      void
+      key(const SubString& str) /*throw (eh::Exception)*/
       {
-        SubString::SizeType begin = str.find(start_lexeme);
-
-        if (begin == SubString::NPOS)
-        {
-          items_.push_back(Item_var(new StringItem(str)));
-          break;
-        }
-
-        if(begin > 0)
-        {
-          items_.push_back(Item_var(new StringItem(str.substr(0, begin))));
-        }
-
-        begin += start_lexeme.length();
+        items_.push_back(Item_var(new VarItem(str)));
+      }
 
-        SubString::SizeType end = str.find(end_lexeme, begin);
-        if (end == SubString::NPOS)
-        {
-          Stream::Error ostr;
-          ostr << FNS <<
-            "invalid template: closing lexeme (" << end_lexeme <<
-            ") not found. Template:\n'" << source << "'";
-          throw InvalidTemplate(ostr);
-        }
+    private:
+      Items& items_;
+    };
 
-        items_.push_back(Item_var(
-          new VarItem(str.substr(begin, end - begin))));
+    void
+    Basic::init(const SubString& source,
+      const SubString& start_lexeme, const SubString& end_lexeme)
+      /*throw (InvalidTemplate, TextTemplException, eh::Exception)*/
+    {
+      items_.clear();
 
-        str = str.substr(end + end_lexeme.length());
-      }
+      ItemsBuilder builder(items_);
+      parse_template(source, start_lexeme, end_lexeme, builder);
     }
 
     std::string
@@ -222,6 +269,103 @@ namespace String
     }
 
 
+    //
+    // Compiled class
+    //
+
+    /**
+     * Creates pieces and numbers keys of the template
+     */
+    struct Compiled::PiecesBuilder
+    {
+      explicit
+      PiecesBuilder(Compiled& compiled) throw ()
+        : compiled_(compiled)
+      {
+      }
+
+      void
+      text(const SubString& str) /*throw (eh::Exception)*/
+      {
+        const Piece PIECE = {str, NO_SLOT};
+        compiled_.pieces_.push_back(PIECE);
+        compiled_.text_size_ += str.size();
+      }
+
+      void
+      key(const SubString& str) /*throw (eh::Exception)*/
+      {
+        std::pair<Slots::iterator, bool> ins =
+          slots_.insert(Slots::value_type(str, compiled_.keys_.size()));
+        if (ins.second)
+        {
+          compiled_.keys_.push_back(str);
+        }
+        const Piece PIECE = {str, ins.first->second};
+        compiled_.pieces_.push_back(PIECE);
+      }
+
+    private:
+      typedef std::map<SubString, std::size_t> Slots;
+
+      Compiled& compiled_;
+      Slots slots_;
+    };
+
+    Compiled::Compiled(const SubString& str,
+      const SubString& start_lexeme, const SubString& end_lexeme)
+      /*throw (InvalidTemplate, TextTemplException, eh::Exception)*/
+      : text_size_(0)
+    {
+      init(str, start_lexeme, end_lexeme);
+    }
+
+    void
+    Compiled::init(const SubString& str,
+      const SubString& start_lexeme, const SubString& end_lexeme)
+      /*throw (InvalidTemplate, TextTemplException, eh::Exception)*/
+    {
+      pieces_.clear();
+      keys_.clear();
+      text_size_ = 0;
+
+      str.assign_to(text_template_);
+
+      PiecesBuilder builder(*this);
+      parse_template(text_template_, start_lexeme, end_lexeme, builder);
+    }
+
+    std::size_t
+    Compiled::slot(const SubString& key) const throw ()
+    {
+      for (std::size_t i = 0; i < keys_.size(); ++i)
+      {
+        if (keys_[i] == key)
+        {
+          return i;
+        }
+      }
+      return NO_SLOT;
+    }
+
+    void
+    Compiled::resolve(const ArgsCallback& args,
+      std::vector<std::string>& values) const
+      /*throw (UnknownName, eh::Exception)*/
+    {
+      values.resize(keys_.size());
+      for (std::size_t i = 0; i < keys_.size(); ++i)
+      {
+        if (!args.get_argument(keys_[i], values[i]))
+        {
+          Stream::Error ostr;
+          ostr << FNS << "failed to substitute key '" << keys_[i] << "'";
+          throw UnknownName(ostr);
+        }
+      }
+    }
+
+
     //
     // IStream class
     //
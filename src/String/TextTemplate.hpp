@@ -8,8 +8,12 @@
 #ifndef STRING_TEXTTEMPLATE_HPP
 #define STRING_TEXTTEMPLATE_HPP
 
+#include <sys/uio.h>
+
+#include <cstring>
 #include <istream>
 #include <set>
+#include <vector>
 
 #include <ReferenceCounting/ReferenceCounting.hpp>
 #include <ReferenceCounting/Deque.hpp>
@@ -254,6 +258,8 @@ namespace String
     private:
       typedef ReferenceCounting::Deque<Item_var> Items;
 
+      struct ItemsBuilder;
+
       Items items_;
     };
 
@@ -354,6 +360,167 @@ namespace String
     };
 
 
+    /**
+     * Text template compiled for frequent instantiation.
+     * Keys are numbered by init() in the order of their first occurrence,
+     * values are supplied as an array indexed by these slots (SubString
+     * or std::string). The output size is known before writing, so
+     * the result is written into a caller buffer at once or described
+     * with iovec without copying.
+     * Stores the template text.
+     */
+    class Compiled : private Generics::Uncopyable
+    {
+    public:
+      static const std::size_t NO_SLOT = static_cast<std::size_t>(-1);
+
+      /**
+       * Constructor.
+       */
+      Compiled() throw ();
+
+      /**
+       * Constructor. Calls init.
+       * @param str template to copy and parse
+       * @param start_lexeme Start lexeme.
+       * @param end_lexeme End lexeme.
+       * @exception InvalidTemplate Invalid template.
+       * @exception TextTemplException Other errors.
+       * @exception eh::Exception std::exception.
+       */
+      explicit
+      Compiled(const SubString& str,
+        const SubString& start_lexeme = Basic::DEFAULT_LEXEME,
+        const SubString& end_lexeme = Basic::DEFAULT_LEXEME)
+        /*throw (InvalidTemplate, TextTemplException, eh::Exception)*/;
+
+      /**
+       * Initializes a pattern.
+       * @param str template to copy and parse
+       * @param start_lexeme Start lexeme.
+       * @param end_lexeme End lexeme.
+       * @exception InvalidTemplate Invalid template.
+       * @exception TextTemplException Other errors.
+       * @exception eh::Exception std::exception.
+       */
+      void
+      init(const SubString& str,
+        const SubString& start_lexeme = Basic::DEFAULT_LEXEME,
+        const SubString& end_lexeme = Basic::DEFAULT_LEXEME)
+        /*throw (InvalidTemplate, TextTemplException, eh::Exception)*/;
+
+      /**
+       * Tests whether the template is contains items or not
+       * @return true if contains
+       */
+      bool
+      empty() const throw ();
+
+      /**
+       * @return number of distinct keys, size of the values array
+       */
+      std::size_t
+      slots() const throw ();
+
+      /**
+       * @param slot slot number
+       * @return key text of the slot
+       */
+      const SubString&
+      key(std::size_t slot) const throw ();
+
+      /**
+       * Linear search, intended for binding keys once.
+       * @param key key text
+       * @return slot of the key or NO_SLOT
+       */
+      std::size_t
+      slot(const SubString& key) const throw ();
+
+      /**
+       * Fills values of all slots.
+       * @param args supplier of values for keys
+       * @param values resulted values indexed by slot
+       * @exception UnknownName args doesn't supply a key.
+       * @exception eh::Exception std::exception.
+       */
+      void
+      resolve(const ArgsCallback& args, std::vector<std::string>& values)
+        const /*throw (UnknownName, eh::Exception)*/;
+
+      /**
+       * @param values values indexed by slot
+       * @return size of the instantiated template
+       */
+      template <typename Value>
+      std::size_t
+      size(const Value* values) const throw ();
+
+      /**
+       * Instantiation into a caller buffer. Nothing is written if
+       * the buffer is too small.
+       * @param values values indexed by slot
+       * @param buffer output buffer
+       * @param buffer_size size of the buffer
+       * @return size of the instantiated template
+       */
+      template <typename Value>
+      std::size_t
+      instantiate(const Value* values, char* buffer,
+        std::size_t buffer_size) const throw ();
+
+      /**
+       * Instantiation into a string, allocates at most once.
+       * @param values values indexed by slot
+       * @param result instantiated template
+       */
+      template <typename Value>
+      void
+      instantiate(const Value* values, std::string& result) const
+        /*throw (eh::Exception)*/;
+
+      /**
+       * @return size of iovec array instantiate(values, iov) requires
+       */
+      std::size_t
+      pieces() const throw ();
+
+      /**
+       * Describes instantiated template without copying, iov refers
+       * to the template and to the values.
+       * @param values values indexed by slot
+       * @param iov array of at least pieces() elements
+       * @return number of filled iov elements (empty values are skipped)
+       */
+      template <typename Value>
+      std::size_t
+      instantiate(const Value* values, iovec* iov) const throw ();
+
+    private:
+      struct Piece
+      {
+        SubString text;
+        // NO_SLOT for text between keys
+        std::size_t slot;
+      };
+
+      typedef std::vector<Piece> Pieces;
+      typedef std::vector<SubString> KeyArray;
+
+      struct PiecesBuilder;
+
+      template <typename Value>
+      static
+      SubString
+      text_(const Piece& piece, const Value* values) throw ();
+
+      std::string text_template_;
+      Pieces pieces_;
+      KeyArray keys_;
+      std::size_t text_size_;
+    };
+
+
     /**
      * General adapter for ArgsContainer
      */
@@ -715,6 +882,124 @@ namespace String
     }
 
 
+    //
+    // Compiled class
+    //
+
+    inline
+    Compiled::Compiled() throw ()
+      : text_size_(0)
+    {
+    }
+
+    inline
+    bool
+    Compiled::empty() const throw ()
+    {
+      return pieces_.empty();
+    }
+
+    inline
+    std::size_t
+    Compiled::slots() const throw ()
+    {
+      return keys_.size();
+    }
+
+    inline
+    const SubString&
+    Compiled::key(std::size_t slot) const throw ()
+    {
+      return keys_[slot];
+    }
+
+    inline
+    std::size_t
+    Compiled::pieces() const throw ()
+    {
+      return pieces_.size();
+    }
+
+    template <typename Value>
+    SubString
+    Compiled::text_(const Piece& piece, const Value* values) throw ()
+    {
+      return piece.slot == NO_SLOT ? piece.text :
+        SubString(values[piece.slot].data(), values[piece.slot].size());
+    }
+
+    template <typename Value>
+    std::size_t
+    Compiled::size(const Value* values) const throw ()
+    {
+      std::size_t result = text_size_;
+      for (Pieces::const_iterator itor = pieces_.begin();
+        itor != pieces_.end(); ++itor)
+      {
+        if (itor->slot != NO_SLOT)
+        {
+          result += values[itor->slot].size();
+        }
+      }
+      return result;
+    }
+
+    template <typename Value>
+    std::size_t
+    Compiled::instantiate(const Value* values, char* buffer,
+      std::size_t buffer_size) const throw ()
+    {
+      const std::size_t SIZE = size(values);
+      if (SIZE > buffer_size)
+      {
+        return SIZE;
+      }
+
+      for (Pieces::const_iterator itor = pieces_.begin();
+        itor != pieces_.end(); ++itor)
+      {
+        const SubString TEXT = text_(*itor, values);
+        if (!TEXT.empty())
+        {
+          std::memcpy(buffer, TEXT.data(), TEXT.size());
+          buffer += TEXT.size();
+        }
+      }
+      return SIZE;
+    }
+
+    template <typename Value>
+    void
+    Compiled::instantiate(const Value* values, std::string& result) const
+      /*throw (eh::Exception)*/
+    {
+      result.resize(size(values));
+      if (!result.empty())
+      {
+        instantiate(values, &result[0], result.size());
+      }
+    }
+
+    template <typename Value>
+    std::size_t
+    Compiled::instantiate(const Value* values, iovec* iov) const throw ()
+    {
+      iovec* cur = iov;
+      for (Pieces::const_iterator itor = pieces_.begin();
+        itor != pieces_.end(); ++itor)
+      {
+        const SubString TEXT = text_(*itor, values);
+        if (!TEXT.empty())
+        {
+          cur->iov_base = const_cast<char*>(TEXT.data());
+          cur->iov_len = TEXT.size();
+          ++cur;
+        }
+      }
+      return cur - iov;
+    }
+
+
     //
     // ArgsContainerAdapter class
     //
@@ -3,8 +3,12 @@
 
 #include <cstddef>
 #include <algorithm>
+#include <bitset>
+#include <string>
+#include <vector>
 
 #include <String/UnicodeNormalizer.hpp>
+#include <String/UTF8Handler.hpp>
 
 /**
  * Hangul composition constants
@@ -818,3 +822,363 @@ namespace String
     return true;
   }
 }
+
+namespace
+{
+  typedef wchar_t* (*Decomposer)(wchar_t, wchar_t*) throw ();
+
+  const std::size_t BMP_SIZE = 0x10000;
+  const std::size_t MAX_DECOMPOSITION = 18;
+
+  wchar_t*
+  decompose_2003_keep_prohibited(wchar_t wch, wchar_t* output) throw ()
+  {
+    wchar_t* res = String::Normalizer::decompose_2003(wch, output);
+    if (res)
+    {
+      return res;
+    }
+    *output++ = wch;
+    return output;
+  }
+
+  wchar_t*
+  decompose_2008_keep_prohibited(wchar_t wch, wchar_t* output) throw ()
+  {
+    wchar_t* res = String::Normalizer::decompose_2008(wch, output);
+    if (res)
+    {
+      return res;
+    }
+    *output++ = wch;
+    return output;
+  }
+
+  /**
+   * Symbols that may be composed with the previous one: second
+   * elements of primary composites and Hangul V, T jamo.
+   */
+  class CompositionSeconds
+  {
+  public:
+    CompositionSeconds() /*throw (eh::Exception)*/
+    {
+      using String::Normalizer::Composition::COMPOSITE_HASH;
+
+      const std::size_t SIZE = sizeof(COMPOSITE_HASH) /
+        sizeof(*COMPOSITE_HASH);
+      for (std::size_t i = 0; i < SIZE; ++i)
+      {
+        const uint32_t COMBINER = COMPOSITE_HASH[i].combiner;
+        if (!COMPOSITE_HASH[i].value)
+        {
+          continue;
+        }
+        if (COMBINER < BMP_SIZE)
+        {
+          bmp_[COMBINER] = true;
+        }
+        else
+        {
+          supplementary_.push_back(COMBINER);
+        }
+      }
+      std::sort(supplementary_.begin(), supplementary_.end());
+
+      for (wchar_t wch = V_BASE; wch < V_BASE + V_COUNT; ++wch)
+      {
+        bmp_[wch] = true;
+      }
+      for (wchar_t wch = T_BASE + 1; wch < T_BASE + T_COUNT; ++wch)
+      {
+        bmp_[wch] = true;
+      }
+    }
+
+    bool
+    is_owned(wchar_t wch) const throw ()
+    {
+      if (static_cast<uint32_t>(wch) < BMP_SIZE)
+      {
+        return bmp_[wch];
+      }
+      return std::binary_search(supplementary_.begin(),
+        supplementary_.end(), static_cast<uint32_t>(wch));
+    }
+
+  private:
+    std::bitset<BMP_SIZE> bmp_;
+    std::vector<uint32_t> supplementary_;
+  };
+
+  const CompositionSeconds&
+  composition_seconds() /*throw (eh::Exception)*/
+  {
+    static const CompositionSeconds SECONDS;
+    return SECONDS;
+  }
+
+  /**
+   * Quick check property (YES) of a symbol for the decomposer:
+   * mapped to itself, starter and never composed with the previous
+   * symbol. Such a symbol is a safe point: text before it is
+   * normalized independently of text after it.
+   * BMP is precalculated, other planes are checked on demand.
+   */
+  class QuickCheck
+  {
+  public:
+    explicit
+    QuickCheck(Decomposer decomposer) /*throw (eh::Exception)*/
+      : decomposer_(decomposer),
+        seconds_(composition_seconds())
+    {
+      for (std::size_t wch = 0; wch < BMP_SIZE; ++wch)
+      {
+        bmp_[wch] = check_(static_cast<wchar_t>(wch));
+      }
+    }
+
+    bool
+    is_yes(wchar_t wch) const throw ()
+    {
+      if (static_cast<uint32_t>(wch) < BMP_SIZE)
+      {
+        return bmp_[wch];
+      }
+      return check_(wch);
+    }
+
+    Decomposer
+    decomposer() const throw ()
+    {
+      return decomposer_;
+    }
+
+  private:
+    bool
+    check_(wchar_t wch) const throw ()
+    {
+      // Precomposed Hangul syllables decompose algorithmically and
+      // compose back to themselves
+      if (wch >= 0xAC00 && wch <= 0xD7A3)
+      {
+        return true;
+      }
+
+      wchar_t buf[MAX_DECOMPOSITION];
+      const wchar_t* const END = decomposer_(wch, buf);
+      return END == buf + 1 && *buf == wch &&
+        !String::Normalizer::get_combining_class(wch) &&
+        !seconds_.is_owned(wch);
+    }
+
+    const Decomposer decomposer_;
+    const CompositionSeconds& seconds_;
+    std::bitset<BMP_SIZE> bmp_;
+  };
+
+  const QuickCheck&
+  get_quick_check(bool idna2008, bool keep_prohibited)
+    /*throw (eh::Exception)*/
+  {
+    if (idna2008)
+    {
+      if (keep_prohibited)
+      {
+        static const QuickCheck QC(decompose_2008_keep_prohibited);
+        return QC;
+      }
+      static const QuickCheck QC(String::Normalizer::decompose_2008);
+      return QC;
+    }
+    if (keep_prohibited)
+    {
+      static const QuickCheck QC(decompose_2003_keep_prohibited);
+      return QC;
+    }
+    static const QuickCheck QC(String::Normalizer::decompose_2003);
+    return QC;
+  }
+
+  /**
+   * Decodes one well-formed UTF-8 symbol in [cur, end)
+   * @return false if the sequence is ill-formed or truncated
+   */
+  inline
+  bool
+  decode(const char* cur, const char* end, wchar_t& wch,
+    unsigned long& octets) throw ()
+  {
+    const unsigned char CH = static_cast<unsigned char>(*cur);
+    if (CH < 0x80)
+    {
+      wch = CH;
+      octets = 1;
+      return true;
+    }
+
+    octets = String::UTF8Handler::get_octet_count(*cur);
+    if (!octets || octets > static_cast<unsigned long>(end - cur))
+    {
+      return false;
+    }
+
+    unsigned long count;
+    return String::UTF8Handler::is_correct_utf8_sequence(cur, count) &&
+      count == octets &&
+      String::UTF8Handler::utf8_char_to_wchar(cur, octets, wch);
+  }
+
+  /**
+   * Skips symbols with the quick check property
+   * @param cur in - position to start from, out - first symbol without
+   * the property (or end)
+   * @param last_yes the start of the last skipped symbol, unchanged
+   * if nothing is skipped
+   * @return false for ill-formed UTF-8
+   */
+  bool
+  skip_normalized(const QuickCheck& quick_check, const char*& cur,
+    const char* end, const char*& last_yes) throw ()
+  {
+    while (cur != end)
+    {
+      wchar_t wch;
+      unsigned long octets;
+      if (!decode(cur, end, wch, octets))
+      {
+        return false;
+      }
+      if (!quick_check.is_yes(wch))
+      {
+        break;
+      }
+      last_yes = cur;
+      cur += octets;
+    }
+    return true;
+  }
+}
+
+namespace String
+{
+  namespace Normalizer
+  {
+    bool
+    is_normalized(const String::SubString& input, bool idna2008,
+      bool keep_prohibited) throw ()
+    {
+      try
+      {
+        const char* cur = input.begin();
+        const char* last_yes = 0;
+        return skip_normalized(get_quick_check(idna2008, keep_prohibited),
+          cur, input.end(), last_yes) && cur == input.end();
+      }
+      catch (...)
+      {
+        return false;
+      }
+    }
+  }
+
+  bool
+  lower_and_normalize(const String::SubString& input,
+    std::string& output, bool idna2008, bool& changed,
+    bool keep_prohibited) /*throw (eh::Exception)*/
+  {
+    const QuickCheck& quick_check =
+      get_quick_check(idna2008, keep_prohibited);
+    const char* const END = input.end();
+    const char* cur = input.begin();
+    const char* last_yes = 0;
+
+    changed = false;
+    if (!skip_normalized(quick_check, cur, END, last_yes))
+    {
+      return false;
+    }
+    if (cur == END)
+    {
+      return true;
+    }
+
+    // The segment starts from the last safe point: the symbol
+    // before cur may be composed with it.
+    const char* segment = last_yes ? last_yes : input.begin();
+
+    std::string result;
+    result.reserve(input.size() + input.size() / 2);
+    result.append(input.begin(), segment);
+
+    std::wstring code_points;
+    std::wstring buffer;
+    char utf8[8];
+
+    for (;;)
+    {
+      // Segment: a symbol and following ones without
+      // the quick check property
+      code_points.clear();
+      cur = segment;
+      do
+      {
+        wchar_t wch;
+        unsigned long octets;
+        if (!decode(cur, END, wch, octets))
+        {
+          return false;
+        }
+        if (cur != segment && quick_check.is_yes(wch))
+        {
+          break;
+        }
+        code_points.push_back(wch);
+        cur += octets;
+      }
+      while (cur != END);
+
+      buffer.resize(code_points.size() * MAX_DECOMPOSITION);
+      wchar_t* out = Normalizer::normalize(code_points.data(),
+        code_points.data() + code_points.size(), &buffer[0],
+        quick_check.decomposer());
+      if (!out)
+      {
+        return false;
+      }
+      out = Normalizer::compose_string(&buffer[0], out);
+
+      for (const wchar_t* it = buffer.data(); it != out; ++it)
+      {
+        unsigned long octets = 0;
+        if (!UTF8Handler::wchar_to_utf8_char(*it, utf8, octets))
+        {
+          return false;
+        }
+        result.append(utf8, octets);
+      }
+
+      // Safe symbols are copied as is, the last one before
+      // the next unsafe symbol starts the next segment
+      const char* const RUN = cur;
+      last_yes = 0;
+      if (!skip_normalized(quick_check, cur, END, last_yes))
+      {
+        return false;
+      }
+      if (cur == END)
+      {
+        result.append(RUN, END);
+        break;
+      }
+
+      segment = last_yes ? last_yes : cur;
+      result.append(RUN, segment);
+    }
+
+    output.swap(result);
+    changed = true;
+    return true;
+  }
+}
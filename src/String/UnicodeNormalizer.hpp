@@ -22,8 +22,40 @@ namespace String
   lower_and_normalize(const String::WSubString& input,
     std::wstring& output, bool idna2008) /*throw (eh::Exception)*/;
 
+  /**
+   * UTF-8 version of lower_and_normalize: transforms input in one pass
+   * without conversion to a wide string. The quick check runs first,
+   * input that is normalized already isn't copied.
+   * @param input UTF-8 string
+   * @param output Normalized string, assigned whenever input has a symbol
+   * failing the quick check, the result can be equal to input
+   * @param idna2008 if IDNA2008 rules are applied (IDNA2003 otherwise)
+   * @param changed true if output is assigned, false if every symbol passes
+   * the quick check (output is untouched, input is normalized)
+   * @param keep_prohibited pass prohibited symbols through unchanged
+   * instead of failing
+   * @return false for ill-formed UTF-8, prohibited symbol or leading
+   * combiner
+   */
+  bool
+  lower_and_normalize(const String::SubString& input,
+    std::string& output, bool idna2008, bool& changed,
+    bool keep_prohibited = false) /*throw (eh::Exception)*/;
+
   namespace Normalizer
   {
+    /**
+     * Quick check of UTF-8 string: every symbol is mapped to itself,
+     * is a starter and can't be composed with the previous one.
+     * @param input UTF-8 string
+     * @param idna2008 if IDNA2008 rules are applied (IDNA2003 otherwise)
+     * @param keep_prohibited if prohibited symbols are allowed
+     * @return true if lower_and_normalize won't assign output
+     */
+    bool
+    is_normalized(const String::SubString& input, bool idna2008,
+      bool keep_prohibited = false) throw ();
+
     /**
      * Perform decomposition and case folding according to RFC-3454
      * @param wch The wide character to be decomposed
@@ -4,6 +4,7 @@
 #include <sstream>
 
 // THIS
+#include <UServerUtils/Grpc/Server/ServerStatisticsProvider.hpp>
 #include <UServerUtils/Statistics/MemoryStatisticsProvider.hpp>
 #include <UServerUtils/ComponentsBuilder.hpp>
 
@@ -88,6 +89,27 @@ void ComponentsBuilder::add_grpc_cobrazz_server(
   auto& server = server_info.server;
   auto& services = server_info.services;
 
+  auto statistics_provider =
+    std::make_shared<Grpc::Server::ServerStatisticsProvider>(
+      server.in(),
+      server->port());
+  auto entry = statistics_storage_->RegisterWriter(
+    statistics_provider->name(),
+    [statistics_provider = std::move(statistics_provider)] (
+      userver::utils::statistics::Writer& writer) {
+      try
+      {
+        statistics_provider->write(writer);
+      }
+      catch (...)
+      {
+      }
+    },
+    {});
+  statistics_holders_.emplace_back(
+    std::make_unique<StatisticsHolder>(
+      std::move(entry)));
+
   add_component_cash(server);
   grpc_cobrazz_servers_.emplace_back(
     std::move(server));
@@ -238,7 +260,7 @@ ComponentsBuilder::build()
     std::end(http_servers_),
     std::back_inserter(components_));
 
-  StatisticsHolders statistics_holders;
+  StatisticsHolders statistics_holders = std::move(statistics_holders_);
   if (statistics_provider_)
   {
     auto entry = statistics_storage_->RegisterWriter(
@@ -140,6 +140,9 @@ private:
 
   std::string statistics_prefix_;
 
+  // Writers of components registered in statistics_storage_.
+  StatisticsHolders statistics_holders_;
+
   GrpcUserverServers grpc_userver_servers_;
 
   MiddlewaresList middlewares_list_;
@@ -0,0 +1,72 @@
+#ifndef USERVER_FILEMANAGER_BATCHOPERATION_HPP
+#define USERVER_FILEMANAGER_BATCHOPERATION_HPP
+
+// STD
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+// THIS
+#include <UServerUtils/FileManager/File.hpp>
+#include <UServerUtils/FileManager/RegisteredBufferPool.hpp>
+#include <UServerUtils/FileManager/RegisteredFileTable.hpp>
+
+namespace UServerUtils::FileManager
+{
+
+/**
+ * One read or write of batch submitted with FileManager::submit_batch.
+ * result is set on completion: number of read/written bytes or -error.
+ **/
+struct BatchOperation final
+{
+  enum class Type : std::uint8_t
+  {
+    Read = 0,
+    Write
+  };
+
+  BatchOperation() = default;
+
+  BatchOperation(
+    const Type type,
+    const File& file,
+    const std::string_view buffer,
+    const std::int64_t offset) noexcept
+    : type(type),
+      fd(file.fd()),
+      buffer(buffer),
+      offset(offset)
+  {
+  }
+
+  BatchOperation(
+    const Type type,
+    const RegisteredFile& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset) noexcept
+    : type(type),
+      fd(file.index),
+      is_fixed_file(true),
+      buffer(buffer.view()),
+      buffer_index(buffer.index),
+      offset(offset)
+  {
+  }
+
+  Type type = Type::Read;
+  // Descriptor or index in registered file table if is_fixed_file
+  int fd = -1;
+  bool is_fixed_file = false;
+  std::string_view buffer;
+  // Index of registered buffer, -1 - ordinary buffer
+  int buffer_index = -1;
+  std::int64_t offset = 0;
+  int result = 0;
+};
+
+using BatchOperations = std::span<BatchOperation>;
+
+} // namespace UServerUtils::FileManager
+
+#endif // USERVER_FILEMANAGER_BATCHOPERATION_HPP
@@ -16,8 +16,23 @@ struct Config final
   std::uint32_t io_uring_flags = IORING_SETUP_ATTACH_WQ;
   std::uint32_t event_queue_max_size = 100000;
   std::uint32_t number_io_urings = 1;
+
+  // Used with IORING_SETUP_SQPOLL in io_uring_flags.
+  // Idle time of kernel submission thread in milliseconds.
+  std::uint32_t sq_thread_idle = 1000;
+  // Pin kernel submission thread to cpu (IORING_SETUP_SQ_AFF), -1 - not pin.
+  std::int32_t sq_thread_cpu = -1;
+
+  // Buffers registered in every io_uring of FileManagerPool
+  // (io_uring_register_buffers), 0 - disabled.
+  std::uint32_t number_registered_buffers = 0;
+  std::uint32_t registered_buffer_size = 64 * 1024;
+
+  // Size of registered file table of every io_uring
+  // (io_uring_register_files), 0 - disabled.
+  std::uint32_t number_registered_files = 0;
 };
 
 } // namespace UServerUtils::FileManager
 
-#endif // USERVER_FILEMANAGER_CONFIG_HPP
\ No newline at end of file
+#endif // USERVER_FILEMANAGER_CONFIG_HPP
@@ -4,6 +4,7 @@
 // POSIX
 #include <liburing.h>
 #include <sys/eventfd.h>
+#include <sys/uio.h>
 
 // BOOST
 #include <boost/thread/scoped_thread.hpp>
@@ -11,6 +12,7 @@
 // STD
 #include <functional>
 #include <memory>
+#include <span>
 #include <thread>
 
 // THIS
@@ -18,8 +20,11 @@
 #include <Generics/Uncopyable.hpp>
 #include <Logger/Logger.hpp>
 #include <ReferenceCounting/SmartPtr.hpp>
+#include <UServerUtils/FileManager/BatchOperation.hpp>
 #include <UServerUtils/FileManager/File.hpp>
 #include <UServerUtils/FileManager/IoUring.hpp>
+#include <UServerUtils/FileManager/RegisteredBufferPool.hpp>
+#include <UServerUtils/FileManager/RegisteredFileTable.hpp>
 #include <UServerUtils/FileManager/Semaphore.hpp>
 #include <UServerUtils/Grpc/Common/QueueAtomic.hpp>
 #include <UServerUtils/Function.hpp>
@@ -36,6 +41,7 @@ public:
   using Thread = boost::scoped_thread<boost::join_if_joinable, std::thread>;
   using ThreadPtr = std::unique_ptr<Thread>;
   using Callback = UServerUtils::Utils::Function<void(int)>;
+  using IoVecs = std::span<const iovec>;
 
   DECLARE_EXCEPTION(Exception, eh::DescriptiveException);
 
@@ -44,7 +50,10 @@ private:
   {
     Close = 0,
     Read,
-    Write
+    Write,
+    Readv,
+    Writev,
+    Batch
   };
 
   struct Event final
@@ -59,8 +68,13 @@ private:
 
     EventType type = EventType::Close;
     int fd = -1;
+    bool is_fixed_file = false;
     std::string_view buffer;
+    int buffer_index = -1;
     std::int64_t offset = 0;
+    IoVecs iovecs;
+    BatchOperations operations;
+    bool is_linked = false;
     Callback callback;
   };
 
@@ -68,9 +82,19 @@ private:
   {
     Read,
     Write,
-    Semaphore
+    Semaphore,
+    Batch
   };
 
+  struct BatchState final
+  {
+    BatchOperations operations;
+    std::size_t number_remain = 0;
+    Callback callback;
+  };
+
+  using BatchStatePtr = std::shared_ptr<BatchState>;
+
   struct UserData
   {
     UserData() = default;
@@ -79,26 +103,32 @@ private:
     CompletionType type = CompletionType::Semaphore;
     eventfd_t semaphore_buffer = 0;
     Callback callback;
+    BatchStatePtr batch_state;
+    std::size_t batch_index = 0;
   };
 
+  using EventPtr = std::unique_ptr<Event>;
   using SemaphorePtr = std::shared_ptr<Semaphore>;
   using EventQueue = UServerUtils::Grpc::Common::QueueAtomic<Event>;
   using EventQueuePtr = std::shared_ptr<EventQueue>;
-  using PointerMember = void(FileManager::*) (
-    const File&,
-    const std::string_view,
-    const std::int64_t,
-    Callback&&) noexcept;
 
 public:
+  /**
+   * If registered_buffer_pool is set, its buffers are registered
+   * in io_uring and must survive FileManager.
+   * If config.number_registered_files > 0, registered file table
+   * of this size is created.
+   **/
   explicit FileManager(
     const Config& config,
-    Logger* logger);
+    Logger* logger,
+    const RegisteredBufferPool* registered_buffer_pool = nullptr);
 
   explicit FileManager(
     const Config& config,
     const std::uint32_t uring_fd,
-    Logger* logger);
+    Logger* logger,
+    const RegisteredBufferPool* registered_buffer_pool = nullptr);
 
   /**
    * You must ensure that buffer survives callback.
@@ -144,12 +174,135 @@ public:
     const std::string_view buffer,
     const std::int64_t offset) noexcept;
 
+  /**
+   * Write iovecs at offset with one operation (IORING_OP_WRITEV).
+   * You must ensure that iovecs and its buffers survive callback.
+   * On success, the number of written bytes pass to callback.
+   * On error, -error pass to callback.
+   **/
+  void writev(
+    const File& file,
+    const IoVecs iovecs,
+    const std::int64_t offset,
+    Callback&& callback) noexcept;
+
+  int writev(
+    const File& file,
+    const IoVecs iovecs,
+    const std::int64_t offset) noexcept;
+
+  /**
+   * Read to iovecs from offset with one operation (IORING_OP_READV).
+   * You must ensure that iovecs and its buffers survive callback.
+   * On success, the number of read bytes pass to callback.
+   * On error, -error pass to callback.
+   **/
+  void readv(
+    const File& file,
+    const IoVecs iovecs,
+    const std::int64_t offset,
+    Callback&& callback) noexcept;
+
+  int readv(
+    const File& file,
+    const IoVecs iovecs,
+    const std::int64_t offset) noexcept;
+
+  /**
+   * Submit all operations with one io_uring_submit.
+   * If is_linked, operations are executed in order (IOSQE_IO_LINK)
+   * and error or short read/write cancels the rest of them.
+   * Batch is submitted completely when io_uring queues have room for
+   * all its operations, batch greater than submission queue
+   * (config.io_uring_size) fails with -EINVAL.
+   * You must ensure that operations and buffers survive callback.
+   * Callback is called once after all operations are completed,
+   * result of each operation is set to BatchOperation::result.
+   * 0 pass to callback if all operations are succeeded,
+   * otherwise the first -error.
+   **/
+  void submit_batch(
+    const BatchOperations operations,
+    const bool is_linked,
+    Callback&& callback) noexcept;
+
+  int submit_batch(
+    const BatchOperations operations,
+    const bool is_linked = false) noexcept;
+
+  /**
+   * Fast path with registered buffer (IORING_OP_WRITE_FIXED)
+   * and/or registered file (IOSQE_FIXED_FILE).
+   * Buffer with negative index is written as ordinary one.
+   * Semantic is the same as for write.
+   **/
+  void write_fixed(
+    const File& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset,
+    Callback&& callback) noexcept;
+
+  int write_fixed(
+    const File& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset) noexcept;
+
+  void write_fixed(
+    const RegisteredFile& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset,
+    Callback&& callback) noexcept;
+
+  int write_fixed(
+    const RegisteredFile& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset) noexcept;
+
+  /**
+   * Fast path with registered buffer (IORING_OP_READ_FIXED)
+   * and/or registered file (IOSQE_FIXED_FILE).
+   * Buffer with negative index is read as ordinary one.
+   * Semantic is the same as for read.
+   **/
+  void read_fixed(
+    const File& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset,
+    Callback&& callback) noexcept;
+
+  int read_fixed(
+    const File& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset) noexcept;
+
+  void read_fixed(
+    const RegisteredFile& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset,
+    Callback&& callback) noexcept;
+
+  int read_fixed(
+    const RegisteredFile& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset) noexcept;
+
+  /**
+   * Thread safe. Set fd to slot of registered file table,
+   * fd = -1 clear slot.
+   **/
+  bool update_registered_file(
+    const RegisteredFile& file,
+    const int fd) noexcept;
+
   ~FileManager();
 
   std::uint32_t uring_fd() const noexcept;
 
 private:
-  void initialize(IoUringPtr&& uring);
+  void initialize(
+    const Config& config,
+    const RegisteredBufferPool* registered_buffer_pool,
+    IoUringPtr&& uring);
 
   void run(
     const SemaphorePtr& semaphore,
@@ -162,16 +315,59 @@ private:
   bool create_read_or_write_event(
     const bool is_read,
     const int fd,
+    const bool is_fixed_file,
     const std::string_view buffer,
+    const int buffer_index,
+    const std::int64_t offset,
+    Callback&& callback,
+    io_uring* const uring) noexcept;
+
+  bool create_vector_event(
+    const bool is_read,
+    const int fd,
+    const IoVecs iovecs,
     const std::int64_t offset,
     Callback&& callback,
     io_uring* const uring) noexcept;
 
+  // Return number of submitted operations.
+  // Batch must fit to free space of io_uring queues.
+  std::size_t create_batch_event(
+    const BatchOperations operations,
+    const bool is_linked,
+    Callback&& callback,
+    io_uring* const uring) noexcept;
+
+  void on_batch_ready(
+    const int result,
+    UserData& user_data) const noexcept;
+
   void on_semaphore_ready(
     io_uring* const uring,
     std::size_t& number_remain_operaions,
     bool& is_cansel) noexcept;
 
+  // Submit pending events while they fit to free space of io_uring queues
+  void submit_events(
+    io_uring* const uring,
+    std::size_t& number_remain_operaions,
+    bool& is_cansel) noexcept;
+
+  void submit_event(
+    Event& event,
+    io_uring* const uring,
+    std::size_t& number_remain_operaions,
+    bool& is_cansel) noexcept;
+
+  // Number of submission and completion queue entries used by event
+  std::size_t event_size(const Event& event) const noexcept;
+
+  // Number of operations which can be submitted without
+  // overflow of submission and completion queues
+  std::size_t free_space(
+    io_uring* const uring,
+    const std::size_t number_remain_operaions) const noexcept;
+
   void on_write_ready(
     const int result,
     Callback&& callback) const noexcept;
@@ -183,11 +379,18 @@ private:
   void add_event_to_queue(
     Event&& event) noexcept;
 
-  int call(
-    PointerMember const pointer,
-    const File& file,
+  void add_read_or_write_event(
+    const EventType type,
+    const int fd,
+    const bool is_fixed_file,
     const std::string_view buffer,
-    const std::int64_t offset) noexcept;
+    const int buffer_index,
+    const std::int64_t offset,
+    Callback&& callback) noexcept;
+
+  // Submit(Callback&&) starts operation
+  template<class Submit>
+  int call(Submit&& submit) noexcept;
 
 private:
   Logger_var logger_;
@@ -198,8 +401,21 @@ private:
 
   std::uint32_t uring_fd_ = 0;
 
+  // Owned by thread_
+  IoUring* uring_ = nullptr;
+
   std::size_t max_size_cq_queue_ = 0;
 
+  std::size_t max_size_batch_ = 0;
+
+  // Owned by thread_. Semaphore units consumed for events
+  // which are not taken from event_queue_ yet
+  std::size_t number_pending_events_ = 0;
+
+  // Owned by thread_. Event waiting for completions
+  // to fit to io_uring queues
+  EventPtr deferred_event_;
+
   ThreadPtr thread_;
 };
 
@@ -1,6 +1,9 @@
 // STD
+#include <algorithm>
 #include <future>
 #include <iostream>
+#include <limits>
+#include <vector>
 
 // USERVER
 #include <userver/engine/future.hpp>
@@ -23,7 +26,8 @@ inline constexpr char FILE_MANAGER[] = "FILE_MANAGER";
 
 inline FileManager::FileManager(
   const Config& config,
-  Logger* logger)
+  Logger* logger,
+  const RegisteredBufferPool* registered_buffer_pool)
   : logger_(ReferenceCounting::add_ref(logger)),
     event_queue_(std::make_shared<EventQueue>(
       config.event_queue_max_size)),
@@ -31,13 +35,14 @@ inline FileManager::FileManager(
 {
   auto uring = std::make_unique<IoUring>(config);
   uring_fd_ = uring->get()->ring_fd;
-  initialize(std::move(uring));
+  initialize(config, registered_buffer_pool, std::move(uring));
 }
 
 inline FileManager::FileManager(
   const Config& config,
   const std::uint32_t uring_fd,
-  Logger* logger)
+  Logger* logger,
+  const RegisteredBufferPool* registered_buffer_pool)
   : logger_(ReferenceCounting::add_ref(logger)),
     event_queue_(std::make_shared<EventQueue>(
       config.event_queue_max_size)),
@@ -45,12 +50,27 @@ inline FileManager::FileManager(
 {
   auto uring = std::make_unique<IoUring>(config, uring_fd);
   uring_fd_ = uring_fd;
-  initialize(std::move(uring));
+  initialize(config, registered_buffer_pool, std::move(uring));
 }
 
-inline void FileManager::initialize(IoUringPtr&& uring)
+inline void FileManager::initialize(
+  const Config& config,
+  const RegisteredBufferPool* registered_buffer_pool,
+  IoUringPtr&& uring)
 {
+  if (registered_buffer_pool)
+  {
+    uring->register_buffers(registered_buffer_pool->iovecs());
+  }
+
+  if (config.number_registered_files > 0)
+  {
+    uring->register_files(config.number_registered_files);
+  }
+
   max_size_cq_queue_ = uring->cq_size();
+  // One completion queue entry is kept for the semaphore event
+  max_size_batch_ = std::min(uring->sq_size(), max_size_cq_queue_ - 1);
   if (!create_semaphore_event(semaphore_->fd(), uring->get()))
   {
     std::ostringstream stream;
@@ -59,6 +79,7 @@ inline void FileManager::initialize(IoUringPtr&& uring)
     throw Exception(stream.str());
   }
 
+  uring_ = uring.get();
   thread_ = std::make_unique<Thread>(
     &FileManager::run,
     this,
@@ -112,15 +133,14 @@ inline void FileManager::write(
   const std::int64_t offset,
   Callback&& callback) noexcept
 {
-  Event write_event;
-  write_event.type = EventType::Write;
-  write_event.fd = file.fd();
-  write_event.buffer = buffer;
-  write_event.offset = offset;
-  write_event.callback = std::move(callback);
-
-  add_event_to_queue(
-    std::move(write_event));
+  add_read_or_write_event(
+    EventType::Write,
+    file.fd(),
+    false,
+    buffer,
+    -1,
+    offset,
+    std::move(callback));
 }
 
 inline int FileManager::write(
@@ -128,7 +148,9 @@ inline int FileManager::write(
   const std::string_view buffer,
   const std::int64_t offset) noexcept
 {
-  return call(&FileManager::write, file, buffer, offset);
+  return call([this, &file, buffer, offset] (Callback&& callback) {
+    write(file, buffer, offset, std::move(callback));
+  });
 }
 
 inline void FileManager::read(
@@ -137,15 +159,14 @@ inline void FileManager::read(
   const std::int64_t offset,
   Callback&& callback) noexcept
 {
-  Event read_event;
-  read_event.type = EventType::Read;
-  read_event.fd = file.fd();
-  read_event.buffer = buffer;
-  read_event.offset = offset;
-  read_event.callback = callback;
-
-  add_event_to_queue(
-    std::move(read_event));
+  add_read_or_write_event(
+    EventType::Read,
+    file.fd(),
+    false,
+    buffer,
+    -1,
+    offset,
+    std::move(callback));
 }
 
 inline int FileManager::read(
@@ -153,14 +174,243 @@ inline int FileManager::read(
   const std::string_view buffer,
   const std::int64_t offset) noexcept
 {
-  return call(&FileManager::read, file, buffer, offset);
+  return call([this, &file, buffer, offset] (Callback&& callback) {
+    read(file, buffer, offset, std::move(callback));
+  });
+}
+
+inline void FileManager::writev(
+  const File& file,
+  const IoVecs iovecs,
+  const std::int64_t offset,
+  Callback&& callback) noexcept
+{
+  Event event;
+  event.type = EventType::Writev;
+  event.fd = file.fd();
+  event.iovecs = iovecs;
+  event.offset = offset;
+  event.callback = std::move(callback);
+
+  add_event_to_queue(
+    std::move(event));
+}
+
+inline int FileManager::writev(
+  const File& file,
+  const IoVecs iovecs,
+  const std::int64_t offset) noexcept
+{
+  return call([this, &file, iovecs, offset] (Callback&& callback) {
+    writev(file, iovecs, offset, std::move(callback));
+  });
+}
+
+inline void FileManager::readv(
+  const File& file,
+  const IoVecs iovecs,
+  const std::int64_t offset,
+  Callback&& callback) noexcept
+{
+  Event event;
+  event.type = EventType::Readv;
+  event.fd = file.fd();
+  event.iovecs = iovecs;
+  event.offset = offset;
+  event.callback = std::move(callback);
+
+  add_event_to_queue(
+    std::move(event));
+}
+
+inline int FileManager::readv(
+  const File& file,
+  const IoVecs iovecs,
+  const std::int64_t offset) noexcept
+{
+  return call([this, &file, iovecs, offset] (Callback&& callback) {
+    readv(file, iovecs, offset, std::move(callback));
+  });
+}
+
+inline void FileManager::submit_batch(
+  const BatchOperations operations,
+  const bool is_linked,
+  Callback&& callback) noexcept
+{
+  if (operations.empty())
+  {
+    try
+    {
+      callback(0);
+    }
+    catch (...)
+    {
+    }
+    return;
+  }
+
+  Event event;
+  event.type = EventType::Batch;
+  event.operations = operations;
+  event.is_linked = is_linked;
+  event.callback = std::move(callback);
+
+  add_event_to_queue(
+    std::move(event));
+}
+
+inline int FileManager::submit_batch(
+  const BatchOperations operations,
+  const bool is_linked) noexcept
+{
+  return call([this, operations, is_linked] (Callback&& callback) {
+    submit_batch(operations, is_linked, std::move(callback));
+  });
+}
+
+inline void FileManager::write_fixed(
+  const File& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset,
+  Callback&& callback) noexcept
+{
+  add_read_or_write_event(
+    EventType::Write,
+    file.fd(),
+    false,
+    buffer.view(),
+    buffer.index,
+    offset,
+    std::move(callback));
+}
+
+inline int FileManager::write_fixed(
+  const File& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset) noexcept
+{
+  return call([this, &file, buffer, offset] (Callback&& callback) {
+    write_fixed(file, buffer, offset, std::move(callback));
+  });
 }
 
-inline int FileManager::call(
-    PointerMember const pointer,
-    const File& file,
-    const std::string_view buffer,
-    const std::int64_t offset) noexcept
+inline void FileManager::write_fixed(
+  const RegisteredFile& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset,
+  Callback&& callback) noexcept
+{
+  add_read_or_write_event(
+    EventType::Write,
+    file.index,
+    true,
+    buffer.view(),
+    buffer.index,
+    offset,
+    std::move(callback));
+}
+
+inline int FileManager::write_fixed(
+  const RegisteredFile& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset) noexcept
+{
+  return call([this, file, buffer, offset] (Callback&& callback) {
+    write_fixed(file, buffer, offset, std::move(callback));
+  });
+}
+
+inline void FileManager::read_fixed(
+  const File& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset,
+  Callback&& callback) noexcept
+{
+  add_read_or_write_event(
+    EventType::Read,
+    file.fd(),
+    false,
+    buffer.view(),
+    buffer.index,
+    offset,
+    std::move(callback));
+}
+
+inline int FileManager::read_fixed(
+  const File& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset) noexcept
+{
+  return call([this, &file, buffer, offset] (Callback&& callback) {
+    read_fixed(file, buffer, offset, std::move(callback));
+  });
+}
+
+inline void FileManager::read_fixed(
+  const RegisteredFile& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset,
+  Callback&& callback) noexcept
+{
+  add_read_or_write_event(
+    EventType::Read,
+    file.index,
+    true,
+    buffer.view(),
+    buffer.index,
+    offset,
+    std::move(callback));
+}
+
+inline int FileManager::read_fixed(
+  const RegisteredFile& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset) noexcept
+{
+  return call([this, file, buffer, offset] (Callback&& callback) {
+    read_fixed(file, buffer, offset, std::move(callback));
+  });
+}
+
+inline bool FileManager::update_registered_file(
+  const RegisteredFile& file,
+  const int fd) noexcept
+{
+  if (!file.is_valid())
+  {
+    return false;
+  }
+
+  return uring_->update_registered_file(
+    static_cast<std::uint32_t>(file.index),
+    fd);
+}
+
+inline void FileManager::add_read_or_write_event(
+  const EventType type,
+  const int fd,
+  const bool is_fixed_file,
+  const std::string_view buffer,
+  const int buffer_index,
+  const std::int64_t offset,
+  Callback&& callback) noexcept
+{
+  Event event;
+  event.type = type;
+  event.fd = fd;
+  event.is_fixed_file = is_fixed_file;
+  event.buffer = buffer;
+  event.buffer_index = buffer_index;
+  event.offset = offset;
+  event.callback = std::move(callback);
+
+  add_event_to_queue(
+    std::move(event));
+}
+
+template<class Submit>
+inline int FileManager::call(Submit&& submit) noexcept
 {
   try
   {
@@ -181,7 +431,7 @@ inline int FileManager::call(
           }
       });
 
-      (this->*pointer)(file, buffer, offset, std::move(callback));
+      submit(std::move(callback));
       return future.get();
     }
     else
@@ -199,7 +449,7 @@ inline int FileManager::call(
           }
       });
 
-      (this->*pointer)(file, buffer, offset, std::move(callback));
+      submit(std::move(callback));
       return future.get();
     }
   }
@@ -363,9 +613,20 @@ inline void FileManager::run(
         on_write_ready(cqe->res, std::move(user_data->callback));
         break;
       }
+      case CompletionType::Batch:
+      {
+        number_remain_operaions -= 1;
+        on_batch_ready(cqe->res, *user_data);
+        break;
+      }
     }
 
     io_uring_cqe_seen(uring->get(), cqe);
+
+    if (deferred_event_ || number_pending_events_ != 0)
+    {
+      submit_events(uring->get(), number_remain_operaions, is_stopped);
+    }
   }
 }
 
@@ -374,60 +635,135 @@ inline void FileManager::on_semaphore_ready(
   std::size_t& number_remain_operaions,
   bool& is_stopped) noexcept
 {
-  const std::uint32_t sq_limit = io_uring_sq_space_left(uring) - 1;
-  const std::uint32_t cq_limit = max_size_cq_queue_ - number_remain_operaions - 1;
-  const std::uint32_t max_queue_elements = std::min(sq_limit, cq_limit);
-  std::uint32_t count = 1 + semaphore_->try_consume(max_queue_elements);
-  while (count > 0)
+  // Units of events which can't fit to free space
+  // of io_uring queues stay in semaphore
+  number_pending_events_ += 1;
+  const std::size_t free_size = free_space(uring, number_remain_operaions);
+  if (free_size > number_pending_events_)
   {
-    auto data = event_queue_->pop();
-    if (!data)
-    {
-      continue;
-    }
+    number_pending_events_ += semaphore_->try_consume(
+      static_cast<std::uint32_t>(std::min<std::size_t>(
+        free_size - number_pending_events_,
+        std::numeric_limits<std::uint32_t>::max())));
+  }
+
+  submit_events(uring, number_remain_operaions, is_stopped);
+}
 
-    count -= 1;
-    switch (data->type)
+inline void FileManager::submit_events(
+  io_uring* const uring,
+  std::size_t& number_remain_operaions,
+  bool& is_stopped) noexcept
+{
+  while (deferred_event_ || number_pending_events_ != 0)
+  {
+    if (!deferred_event_)
     {
-      case EventType::Read:
+      deferred_event_ = event_queue_->pop();
+      if (!deferred_event_)
       {
-        const auto result = create_read_or_write_event(
-          true,
-          data->fd,
-          data->buffer,
-          data->offset,
-          std::move(data->callback),
-          uring);
-        if (result)
-        {
-          number_remain_operaions += 1;
-        }
-        break;
+        continue;
       }
-      case EventType::Write:
+      number_pending_events_ -= 1;
+    }
+
+    // Batch greater than io_uring queues is failed by create_batch_event
+    const std::size_t size = event_size(*deferred_event_);
+    if (size <= max_size_batch_ &&
+        size > free_space(uring, number_remain_operaions))
+    {
+      return;
+    }
+
+    const EventPtr event = std::move(deferred_event_);
+    submit_event(*event, uring, number_remain_operaions, is_stopped);
+  }
+}
+
+inline void FileManager::submit_event(
+  Event& event,
+  io_uring* const uring,
+  std::size_t& number_remain_operaions,
+  bool& is_stopped) noexcept
+{
+  switch (event.type)
+  {
+    case EventType::Read:
+    case EventType::Write:
+    {
+      const auto result = create_read_or_write_event(
+        event.type == EventType::Read,
+        event.fd,
+        event.is_fixed_file,
+        event.buffer,
+        event.buffer_index,
+        event.offset,
+        std::move(event.callback),
+        uring);
+      if (result)
       {
-        const auto result = create_read_or_write_event(
-          false,
-          data->fd,
-          data->buffer,
-          data->offset,
-          std::move(data->callback),
-          uring);
-        if (result)
-        {
-          number_remain_operaions += 1;
-        }
-        break;
+        number_remain_operaions += 1;
       }
-      case EventType::Close:
+      break;
+    }
+    case EventType::Readv:
+    case EventType::Writev:
+    {
+      const auto result = create_vector_event(
+        event.type == EventType::Readv,
+        event.fd,
+        event.iovecs,
+        event.offset,
+        std::move(event.callback),
+        uring);
+      if (result)
       {
-        is_stopped = true;
-        break;
+        number_remain_operaions += 1;
       }
+      break;
+    }
+    case EventType::Batch:
+    {
+      number_remain_operaions += create_batch_event(
+        event.operations,
+        event.is_linked,
+        std::move(event.callback),
+        uring);
+      break;
+    }
+    case EventType::Close:
+    {
+      is_stopped = true;
+      break;
     }
   }
 }
 
+inline std::size_t FileManager::event_size(
+  const Event& event) const noexcept
+{
+  switch (event.type)
+  {
+    case EventType::Batch:
+      return event.operations.size();
+    case EventType::Close:
+      return 0;
+    default:
+      return 1;
+  }
+}
+
+inline std::size_t FileManager::free_space(
+  io_uring* const uring,
+  const std::size_t number_remain_operaions) const noexcept
+{
+  // One completion queue entry is kept for the semaphore event
+  const std::size_t cq_used = number_remain_operaions + 1;
+  const std::size_t cq_free = max_size_cq_queue_ > cq_used ?
+    max_size_cq_queue_ - cq_used : 0;
+  return std::min<std::size_t>(io_uring_sq_space_left(uring), cq_free);
+}
+
 inline void FileManager::on_write_ready(
   const int result,
   Callback&& callback) const noexcept
@@ -454,6 +790,37 @@ inline void FileManager::on_read_ready(
   }
 }
 
+inline void FileManager::on_batch_ready(
+  const int result,
+  UserData& user_data) const noexcept
+{
+  auto& batch_state = *user_data.batch_state;
+  batch_state.operations[user_data.batch_index].result = result;
+  batch_state.number_remain -= 1;
+  if (batch_state.number_remain != 0)
+  {
+    return;
+  }
+
+  int batch_result = 0;
+  for (const auto& operation : batch_state.operations)
+  {
+    if (operation.result < 0)
+    {
+      batch_result = operation.result;
+      break;
+    }
+  }
+
+  try
+  {
+    batch_state.callback(batch_result);
+  }
+  catch (...)
+  {
+  }
+}
+
 inline bool FileManager::create_semaphore_event(
   const int semaphore_fd,
   io_uring* const uring) noexcept
@@ -511,7 +878,9 @@ inline bool FileManager::create_semaphore_event(
 inline bool FileManager::create_read_or_write_event(
   const bool is_read,
   const int fd,
+  const bool is_fixed_file,
   const std::string_view buffer,
+  const int buffer_index,
   const std::int64_t offset,
   Callback&& callback,
   io_uring* const uring) noexcept
@@ -541,7 +910,30 @@ inline bool FileManager::create_read_or_write_event(
     user_data->type = is_read ? CompletionType::Read : CompletionType::Write;
     user_data->callback = callback;
 
-    if (is_read)
+    if (buffer_index >= 0)
+    {
+      if (is_read)
+      {
+        io_uring_prep_read_fixed(
+          sqe,
+          fd,
+          const_cast<char*>(buffer.data()),
+          buffer.size(),
+          offset,
+          buffer_index);
+      }
+      else
+      {
+        io_uring_prep_write_fixed(
+          sqe,
+          fd,
+          buffer.data(),
+          buffer.size(),
+          offset,
+          buffer_index);
+      }
+    }
+    else if (is_read)
     {
       io_uring_prep_read(
         sqe,
@@ -560,6 +952,11 @@ inline bool FileManager::create_read_or_write_event(
         offset);
     }
 
+    if (is_fixed_file)
+    {
+      io_uring_sqe_set_flags(sqe, IOSQE_FIXED_FILE);
+    }
+
     auto* p_user_data = user_data.get();
     io_uring_sqe_set_data(sqe, user_data.release());
 
@@ -624,4 +1021,261 @@ inline bool FileManager::create_read_or_write_event(
   }
 }
 
-} // namespace UServerUtils::FileManager
\ No newline at end of file
+inline bool FileManager::create_vector_event(
+  const bool is_read,
+  const int fd,
+  const IoVecs iovecs,
+  const std::int64_t offset,
+  Callback&& callback,
+  io_uring* const uring) noexcept
+{
+  auto* const sqe = io_uring_get_sqe(uring);
+  if (!sqe)
+  {
+    try
+    {
+      callback(-ECANCELED);
+
+      std::stringstream stream;
+      stream << FNS
+             << "io_uring_get_sqe is failed, reason=SQ ring is currently full";
+      logger_->error(stream.str(), Aspect::FILE_MANAGER);
+    }
+    catch (...)
+    {
+    }
+
+    return false;
+  }
+
+  try
+  {
+    auto user_data = std::make_unique<UserData>();
+    user_data->type = is_read ? CompletionType::Read : CompletionType::Write;
+    user_data->callback = std::move(callback);
+
+    if (is_read)
+    {
+      io_uring_prep_readv(
+        sqe,
+        fd,
+        iovecs.data(),
+        iovecs.size(),
+        offset);
+    }
+    else
+    {
+      io_uring_prep_writev(
+        sqe,
+        fd,
+        iovecs.data(),
+        iovecs.size(),
+        offset);
+    }
+
+    io_uring_sqe_set_data(sqe, user_data.release());
+
+    const auto result = io_uring_submit(uring);
+    if (result < 0)
+    {
+      // Prepared sqe stays in submission queue
+      // and will be submitted with the next io_uring_submit
+      const auto error = -result;
+      std::ostringstream stream;
+      stream << FNS
+             << "io_uring_submit is failed, reason=[code"
+             << error
+             << ", message="
+             << Utils::safe_strerror(error)
+             << "]";
+      logger_->error(stream.str(), Aspect::FILE_MANAGER);
+    }
+
+    return true;
+  }
+  catch (...)
+  {
+  }
+
+  return false;
+}
+
+inline std::size_t FileManager::create_batch_event(
+  const BatchOperations operations,
+  const bool is_linked,
+  Callback&& callback,
+  io_uring* const uring) noexcept
+{
+  const std::size_t size = operations.size();
+  std::size_t number_submitted = 0;
+  int error = 0;
+  BatchStatePtr batch_state;
+
+  try
+  {
+    batch_state = std::make_shared<BatchState>();
+    batch_state->operations = operations;
+    batch_state->number_remain = size;
+    batch_state->callback = std::move(callback);
+
+    // User data is allocated before the first sqe is taken,
+    // so a batch is prepared completely or not at all
+    std::vector<std::unique_ptr<UserData>> users_data;
+    if (size > max_size_batch_)
+    {
+      error = -EINVAL;
+    }
+    else
+    {
+      users_data.reserve(size);
+      for (std::size_t i = 0; i < size; ++i)
+      {
+        auto& user_data = users_data.emplace_back(
+          std::make_unique<UserData>());
+        user_data->type = CompletionType::Batch;
+        user_data->batch_state = batch_state;
+        user_data->batch_index = i;
+      }
+    }
+
+    io_uring_sqe* last_sqe = nullptr;
+    for (std::size_t i = 0; i < size && error == 0; ++i)
+    {
+      auto* const sqe = io_uring_get_sqe(uring);
+      if (!sqe)
+      {
+        // Prepared part of linked batch must not be linked
+        // with the next sqe
+        if (last_sqe)
+        {
+          last_sqe->flags &= ~IOSQE_IO_LINK;
+        }
+
+        error = -ECANCELED;
+        std::stringstream stream;
+        stream << FNS
+               << "io_uring_get_sqe is failed, reason=SQ ring is currently full";
+        logger_->error(stream.str(), Aspect::FILE_MANAGER);
+        break;
+      }
+
+      auto& operation = operations[i];
+      operation.result = 0;
+      const bool is_read = operation.type == BatchOperation::Type::Read;
+      if (operation.buffer_index >= 0)
+      {
+        if (is_read)
+        {
+          io_uring_prep_read_fixed(
+            sqe,
+            operation.fd,
+            const_cast<char*>(operation.buffer.data()),
+            operation.buffer.size(),
+            operation.offset,
+            operation.buffer_index);
+        }
+        else
+        {
+          io_uring_prep_write_fixed(
+            sqe,
+            operation.fd,
+            operation.buffer.data(),
+            operation.buffer.size(),
+            operation.offset,
+            operation.buffer_index);
+        }
+      }
+      else if (is_read)
+      {
+        io_uring_prep_read(
+          sqe,
+          operation.fd,
+          const_cast<char*>(operation.buffer.data()),
+          operation.buffer.size(),
+          operation.offset);
+      }
+      else
+      {
+        io_uring_prep_write(
+          sqe,
+          operation.fd,
+          operation.buffer.data(),
+          operation.buffer.size(),
+          operation.offset);
+      }
+
+      unsigned flags = 0;
+      if (operation.is_fixed_file)
+      {
+        flags |= IOSQE_FIXED_FILE;
+      }
+      if (is_linked && i + 1 != size)
+      {
+        flags |= IOSQE_IO_LINK;
+      }
+      io_uring_sqe_set_flags(sqe, flags);
+      io_uring_sqe_set_data(sqe, users_data[i].release());
+
+      last_sqe = sqe;
+      number_submitted += 1;
+    }
+
+    if (number_submitted != 0)
+    {
+      const auto result = io_uring_submit(uring);
+      if (result < 0)
+      {
+        // Prepared sqes stay in submission queue
+        // and will be submitted with the next io_uring_submit
+        const auto submit_error = -result;
+        std::ostringstream stream;
+        stream << FNS
+               << "io_uring_submit is failed, reason=[code"
+               << submit_error
+               << ", message="
+               << Utils::safe_strerror(submit_error)
+               << "]";
+        logger_->error(stream.str(), Aspect::FILE_MANAGER);
+      }
+    }
+  }
+  catch (...)
+  {
+    error = -ECANCELED;
+  }
+
+  if (number_submitted == size)
+  {
+    return number_submitted;
+  }
+
+  // Operations which are not submitted are completed here,
+  // submitted ones are completed in run
+  for (std::size_t i = number_submitted; i < size; ++i)
+  {
+    operations[i].result = error;
+  }
+
+  try
+  {
+    if (!batch_state)
+    {
+      callback(error);
+    }
+    else
+    {
+      batch_state->number_remain -= size - number_submitted;
+      if (batch_state->number_remain == 0)
+      {
+        batch_state->callback(error);
+      }
+    }
+  }
+  catch (...)
+  {
+  }
+
+  return number_submitted;
+}
+
+} // namespace UServerUtils::FileManager
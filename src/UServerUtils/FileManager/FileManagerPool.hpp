@@ -4,6 +4,7 @@
 // STD
 #include <atomic>
 #include <memory>
+#include <optional>
 #include <vector>
 
 // THIS
@@ -18,6 +19,8 @@ private:
   using FileManagerPtr = std::unique_ptr<FileManager>;
   using FileManagers = std::vector<FileManagerPtr>;
   using Counter = std::atomic<std::uint64_t>;
+  using RegisteredBufferPoolPtr = std::unique_ptr<RegisteredBufferPool>;
+  using RegisteredFileTablePtr = std::unique_ptr<RegisteredFileTable>;
 
 public:
   using Callback = typename FileManager::Callback;
@@ -80,9 +83,119 @@ public:
     const std::string_view buffer,
     const std::int64_t offset) noexcept;
 
+  // See FileManager::writev
+  void writev(
+    const File& file,
+    const FileManager::IoVecs iovecs,
+    const std::int64_t offset,
+    Callback&& callback) noexcept;
+
+  int writev(
+    const File& file,
+    const FileManager::IoVecs iovecs,
+    const std::int64_t offset) noexcept;
+
+  // See FileManager::readv
+  void readv(
+    const File& file,
+    const FileManager::IoVecs iovecs,
+    const std::int64_t offset,
+    Callback&& callback) noexcept;
+
+  int readv(
+    const File& file,
+    const FileManager::IoVecs iovecs,
+    const std::int64_t offset) noexcept;
+
+  /**
+   * All operations of batch are submitted to the same io_uring.
+   * See FileManager::submit_batch.
+   **/
+  void submit_batch(
+    const BatchOperations operations,
+    const bool is_linked,
+    Callback&& callback) noexcept;
+
+  int submit_batch(
+    const BatchOperations operations,
+    const bool is_linked = false) noexcept;
+
+  /**
+   * Get buffer registered in all io_urings
+   * (config.number_registered_buffers > 0).
+   * Return std::nullopt if all buffers are in use or pool is disabled.
+   **/
+  std::optional<RegisteredBuffer> acquire_buffer() noexcept;
+
+  // Return false if buffer is not acquired or is released already
+  bool release_buffer(const RegisteredBuffer& buffer) noexcept;
+
+  /**
+   * Register file in all io_urings (config.number_registered_files > 0).
+   * Return std::nullopt if table is full or disabled.
+   **/
+  std::optional<RegisteredFile> register_file(const File& file) noexcept;
+
+  // Slot which is not registered or is unregistered already is ignored
+  void unregister_file(const RegisteredFile& file) noexcept;
+
+  void write_fixed(
+    const File& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset,
+    Callback&& callback) noexcept;
+
+  int write_fixed(
+    const File& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset) noexcept;
+
+  void write_fixed(
+    const RegisteredFile& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset,
+    Callback&& callback) noexcept;
+
+  int write_fixed(
+    const RegisteredFile& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset) noexcept;
+
+  void read_fixed(
+    const File& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset,
+    Callback&& callback) noexcept;
+
+  int read_fixed(
+    const File& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset) noexcept;
+
+  void read_fixed(
+    const RegisteredFile& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset,
+    Callback&& callback) noexcept;
+
+  int read_fixed(
+    const RegisteredFile& file,
+    const RegisteredBuffer& buffer,
+    const std::int64_t offset) noexcept;
+
+private:
+  void create_registered(const Config& config);
+
+  FileManager& next_file_manager() noexcept;
+
 private:
   Counter counter_{0};
 
+  // Must survive file_managers_
+  RegisteredBufferPoolPtr registered_buffer_pool_;
+
+  RegisteredFileTablePtr registered_file_table_;
+
   FileManagers file_managers_;
 };
 
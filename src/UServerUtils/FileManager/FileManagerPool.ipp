@@ -8,27 +8,39 @@ inline FileManagerPool::FileManagerPool(
   const Config& config,
   Logging::Logger* logger)
 {
+  create_registered(config);
+
   file_managers_.reserve(config.number_io_urings);
   if ((config.io_uring_flags & IORING_SETUP_ATTACH_WQ) == 0)
   {
     for (std::size_t i = 1; i <= config.number_io_urings; ++i)
     {
       file_managers_.emplace_back(
-        std::make_unique<FileManager>(config, logger));
+        std::make_unique<FileManager>(
+          config,
+          logger,
+          registered_buffer_pool_.get()));
     }
   }
   else
   {
     Config helper_config(config);
     helper_config.io_uring_flags &= ~IORING_SETUP_ATTACH_WQ;
-    auto file_manager = std::make_unique<FileManager>(helper_config, logger);
+    auto file_manager = std::make_unique<FileManager>(
+      helper_config,
+      logger,
+      registered_buffer_pool_.get());
     const auto uring_fd = file_manager->uring_fd();
     file_managers_.emplace_back(std::move(file_manager));
 
     for (std::size_t i = 1; i < config.number_io_urings; ++i)
     {
       file_managers_.emplace_back(
-        std::make_unique<FileManager>(config, uring_fd, logger));
+        std::make_unique<FileManager>(
+          config,
+          uring_fd,
+          logger,
+          registered_buffer_pool_.get()));
     }
   }
 }
@@ -38,13 +50,43 @@ inline FileManagerPool::FileManagerPool(
   const std::uint32_t uring_fd,
   Logging::Logger* logger)
 {
+  create_registered(config);
+
   for (std::size_t i = 1; i <= config.number_io_urings; ++i)
   {
     file_managers_.emplace_back(
-      std::make_unique<FileManager>(config, uring_fd, logger));
+      std::make_unique<FileManager>(
+        config,
+        uring_fd,
+        logger,
+        registered_buffer_pool_.get()));
+  }
+}
+
+inline void FileManagerPool::create_registered(const Config& config)
+{
+  if (config.number_registered_buffers > 0)
+  {
+    registered_buffer_pool_ = std::make_unique<RegisteredBufferPool>(
+      config.number_registered_buffers,
+      config.registered_buffer_size);
+  }
+
+  if (config.number_registered_files > 0)
+  {
+    registered_file_table_ = std::make_unique<RegisteredFileTable>(
+      config.number_registered_files);
   }
 }
 
+inline FileManager& FileManagerPool::next_file_manager() noexcept
+{
+  const auto index = counter_.fetch_add(
+    1,
+    std::memory_order_relaxed) % file_managers_.size();
+  return *file_managers_[index];
+}
+
 inline std::size_t FileManagerPool::size() const noexcept
 {
   return file_managers_.size();
@@ -114,4 +156,213 @@ inline int FileManagerPool::read(
     offset);
 }
 
+inline void FileManagerPool::writev(
+  const File& file,
+  const FileManager::IoVecs iovecs,
+  const std::int64_t offset,
+  Callback&& callback) noexcept
+{
+  next_file_manager().writev(
+    file,
+    iovecs,
+    offset,
+    std::move(callback));
+}
+
+inline int FileManagerPool::writev(
+  const File& file,
+  const FileManager::IoVecs iovecs,
+  const std::int64_t offset) noexcept
+{
+  return next_file_manager().writev(file, iovecs, offset);
+}
+
+inline void FileManagerPool::readv(
+  const File& file,
+  const FileManager::IoVecs iovecs,
+  const std::int64_t offset,
+  Callback&& callback) noexcept
+{
+  next_file_manager().readv(
+    file,
+    iovecs,
+    offset,
+    std::move(callback));
+}
+
+inline int FileManagerPool::readv(
+  const File& file,
+  const FileManager::IoVecs iovecs,
+  const std::int64_t offset) noexcept
+{
+  return next_file_manager().readv(file, iovecs, offset);
+}
+
+inline void FileManagerPool::submit_batch(
+  const BatchOperations operations,
+  const bool is_linked,
+  Callback&& callback) noexcept
+{
+  next_file_manager().submit_batch(
+    operations,
+    is_linked,
+    std::move(callback));
+}
+
+inline int FileManagerPool::submit_batch(
+  const BatchOperations operations,
+  const bool is_linked) noexcept
+{
+  return next_file_manager().submit_batch(operations, is_linked);
+}
+
+inline std::optional<RegisteredBuffer>
+FileManagerPool::acquire_buffer() noexcept
+{
+  if (!registered_buffer_pool_)
+  {
+    return std::nullopt;
+  }
+
+  return registered_buffer_pool_->acquire();
+}
+
+inline bool FileManagerPool::release_buffer(
+  const RegisteredBuffer& buffer) noexcept
+{
+  if (!registered_buffer_pool_)
+  {
+    return false;
+  }
+
+  return registered_buffer_pool_->release(buffer);
+}
+
+inline std::optional<RegisteredFile> FileManagerPool::register_file(
+  const File& file) noexcept
+{
+  if (!registered_file_table_ || !file.is_valid())
+  {
+    return std::nullopt;
+  }
+
+  auto registered_file = registered_file_table_->acquire();
+  if (!registered_file)
+  {
+    return std::nullopt;
+  }
+
+  for (auto& file_manager : file_managers_)
+  {
+    if (!file_manager->update_registered_file(*registered_file, file.fd()))
+    {
+      unregister_file(*registered_file);
+      return std::nullopt;
+    }
+  }
+
+  return registered_file;
+}
+
+inline void FileManagerPool::unregister_file(
+  const RegisteredFile& file) noexcept
+{
+  // Slot of stale handle can be reused by other file
+  if (!registered_file_table_ || !registered_file_table_->is_acquired(file))
+  {
+    return;
+  }
+
+  for (auto& file_manager : file_managers_)
+  {
+    file_manager->update_registered_file(file, -1);
+  }
+
+  registered_file_table_->release(file);
+}
+
+inline void FileManagerPool::write_fixed(
+  const File& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset,
+  Callback&& callback) noexcept
+{
+  next_file_manager().write_fixed(
+    file,
+    buffer,
+    offset,
+    std::move(callback));
+}
+
+inline int FileManagerPool::write_fixed(
+  const File& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset) noexcept
+{
+  return next_file_manager().write_fixed(file, buffer, offset);
+}
+
+inline void FileManagerPool::write_fixed(
+  const RegisteredFile& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset,
+  Callback&& callback) noexcept
+{
+  next_file_manager().write_fixed(
+    file,
+    buffer,
+    offset,
+    std::move(callback));
+}
+
+inline int FileManagerPool::write_fixed(
+  const RegisteredFile& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset) noexcept
+{
+  return next_file_manager().write_fixed(file, buffer, offset);
+}
+
+inline void FileManagerPool::read_fixed(
+  const File& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset,
+  Callback&& callback) noexcept
+{
+  next_file_manager().read_fixed(
+    file,
+    buffer,
+    offset,
+    std::move(callback));
+}
+
+inline int FileManagerPool::read_fixed(
+  const File& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset) noexcept
+{
+  return next_file_manager().read_fixed(file, buffer, offset);
+}
+
+inline void FileManagerPool::read_fixed(
+  const RegisteredFile& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset,
+  Callback&& callback) noexcept
+{
+  next_file_manager().read_fixed(
+    file,
+    buffer,
+    offset,
+    std::move(callback));
+}
+
+inline int FileManagerPool::read_fixed(
+  const RegisteredFile& file,
+  const RegisteredBuffer& buffer,
+  const std::int64_t offset) noexcept
+{
+  return next_file_manager().read_fixed(file, buffer, offset);
+}
+
 } // namespace UServerUtils::FileManager
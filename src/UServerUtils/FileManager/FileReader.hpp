@@ -3,12 +3,14 @@
 
 // STD
 #include <fstream>
+#include <memory>
 #include <vector>
 #include <span>
 
 // THIS
 #include <UServerUtils/FileManager/File.hpp>
 #include <UServerUtils/FileManager/FileManagerPool.hpp>
+#include <UServerUtils/FileManager/ReadaheadBuffers.hpp>
 
 namespace UServerUtils::FileManager
 {
@@ -18,6 +20,7 @@ class FileReader final
 private:
   using Buffer = std::vector<char>;
   using FilePosition = off_t;
+  using ReadaheadBuffersPtr = std::unique_ptr<ReadaheadBuffers>;
 
   enum class State : std::uint8_t
   {
@@ -36,6 +39,18 @@ public:
     const std::size_t initial_buffer_size = 4096,
     const FileManagerPoolPtr& file_manager_pool = {});
 
+  /**
+   * Readahead mode: keeps readahead_config.number_buffers reads
+   * in flight, so parsing of one chunk overlaps reading of the next.
+   * Require file_manager_pool.
+   **/
+  explicit FileReader(
+    const File& file,
+    const char delimeter,
+    const std::size_t initial_buffer_size,
+    const FileManagerPoolPtr& file_manager_pool,
+    const ReadaheadConfig& readahead_config);
+
   FileReader(const FileReader&) = delete;
   FileReader(FileReader&&) = delete;
   FileReader& operator=(const FileReader&) = delete;
@@ -68,6 +83,8 @@ private:
 
   File file_;
 
+  ReadaheadBuffersPtr readahead_buffers_;
+
 #ifdef ENABLE_READ_IFSTREAM
   std::ifstream ifstream_;
 #endif
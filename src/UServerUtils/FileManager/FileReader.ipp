@@ -85,6 +85,33 @@ inline FileReader::FileReader(
   position_ = end_position_;
 }
 
+inline FileReader::FileReader(
+  const File& file,
+  const char delimeter,
+  const std::size_t initial_buffer_size,
+  const FileManagerPoolPtr& file_manager_pool,
+  const ReadaheadConfig& readahead_config)
+  : FileReader(file, delimeter, initial_buffer_size, file_manager_pool)
+{
+  if (readahead_config.number_buffers == 0)
+  {
+    return;
+  }
+
+  if (!file_manager_pool)
+  {
+    Stream::Error stream;
+    stream << FNS
+           << "Readahead require file_manager_pool";
+    throw Exception(stream);
+  }
+
+  readahead_buffers_ = std::make_unique<ReadaheadBuffers>(
+    file,
+    readahead_config,
+    file_manager_pool);
+}
+
 inline FileReader::State FileReader::load_buffer(
   const File& file,
   std::span<char>& buffer,
@@ -93,7 +120,11 @@ inline FileReader::State FileReader::load_buffer(
   State state = State::Good;
   const std::size_t size = buffer.size();
   int result = 0;
-  if (file_manager_pool_)
+  if (readahead_buffers_)
+  {
+    result = readahead_buffers_->read(buffer.data(), size);
+  }
+  else if (file_manager_pool_)
   {
     result = file_manager_pool_->read(
       file,
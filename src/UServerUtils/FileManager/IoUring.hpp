@@ -3,6 +3,7 @@
 
 // POSIX
 #include <liburing.h>
+#include <sys/uio.h>
 
 // STD
 #include <optional>
@@ -40,6 +41,16 @@ public:
 
   std::size_t cq_size() const noexcept;
 
+  void register_buffers(const std::vector<iovec>& buffers);
+
+  // Register table of number_files empty slots
+  void register_files(const std::uint32_t number_files);
+
+  // Thread safe. fd = -1 clear slot.
+  bool update_registered_file(
+    const std::uint32_t index,
+    const int fd) noexcept;
+
 private:
   Version linux_kernel_version() const;
 
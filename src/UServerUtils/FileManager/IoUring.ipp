@@ -35,6 +35,16 @@ inline IoUring::IoUring(
     params_.wq_fd = *uring_fd;
   }
 
+  if ((params_.flags & IORING_SETUP_SQPOLL) != 0)
+  {
+    params_.sq_thread_idle = config.sq_thread_idle;
+    if (config.sq_thread_cpu >= 0)
+    {
+      params_.flags |= IORING_SETUP_SQ_AFF;
+      params_.sq_thread_cpu = static_cast<std::uint32_t>(config.sq_thread_cpu);
+    }
+  }
+
   const auto result = io_uring_queue_init_params(
     config.io_uring_size,
     &ring_,
@@ -127,4 +137,49 @@ inline std::size_t IoUring::cq_size() const noexcept
   return params_.cq_entries;
 }
 
+inline void IoUring::register_buffers(const std::vector<iovec>& buffers)
+{
+  const auto result = io_uring_register_buffers(
+    &ring_,
+    buffers.data(),
+    buffers.size());
+  if (result < 0)
+  {
+    const auto error = -result;
+    std::ostringstream stream;
+    stream << FNS
+           << "io_uring_register_buffers is failed, reason=[code="
+           << error
+           << ", message="
+           << Utils::safe_strerror(error)
+           << "]";
+    throw Exception(stream.str());
+  }
+}
+
+inline void IoUring::register_files(const std::uint32_t number_files)
+{
+  const auto result = io_uring_register_files_sparse(&ring_, number_files);
+  if (result < 0)
+  {
+    const auto error = -result;
+    std::ostringstream stream;
+    stream << FNS
+           << "io_uring_register_files_sparse is failed, reason=[code="
+           << error
+           << ", message="
+           << Utils::safe_strerror(error)
+           << "]";
+    throw Exception(stream.str());
+  }
+}
+
+inline bool IoUring::update_registered_file(
+  const std::uint32_t index,
+  const int fd) noexcept
+{
+  int fds[1] = {fd};
+  return io_uring_register_files_update(&ring_, index, fds, 1) == 1;
+}
+
 } // namespace UServerUtils::FileManager
\ No newline at end of file
@@ -0,0 +1,109 @@
+#ifndef USERVER_FILEMANAGER_READAHEADBUFFERS_HPP
+#define USERVER_FILEMANAGER_READAHEADBUFFERS_HPP
+
+// STD
+#include <future>
+#include <memory>
+#include <optional>
+#include <vector>
+
+// USERVER
+#include <userver/engine/future.hpp>
+
+// THIS
+#include <eh/Exception.hpp>
+#include <Generics/Uncopyable.hpp>
+#include <UServerUtils/FileManager/File.hpp>
+#include <UServerUtils/FileManager/FileManagerPool.hpp>
+#include <UServerUtils/FileManager/Utils.hpp>
+
+namespace UServerUtils::FileManager
+{
+
+struct ReadaheadConfig final
+{
+  // Zero disables readahead
+  std::size_t number_buffers = 0;
+  std::size_t buffer_size = 256 * 1024;
+  // Reopen file with O_DIRECT and read into aligned buffers
+  bool is_direct = false;
+};
+
+/**
+ * Sequential reader keeping number_buffers reads in flight
+ * into a ring of buffers. While the caller consumes one buffer,
+ * the next ones are being read by FileManagerPool.
+ * Not thread safe.
+ **/
+class ReadaheadBuffers final : private Generics::Uncopyable
+{
+public:
+  DECLARE_EXCEPTION(Exception, eh::DescriptiveException);
+
+private:
+  using BufferPtr = std::unique_ptr<char, Utils::AlignedFreeDeleter>;
+
+  enum class ChunkState : std::uint8_t
+  {
+    Idle = 0,
+    Pending,
+    Ready
+  };
+
+  struct Chunk final
+  {
+    BufferPtr buffer;
+    ChunkState state = ChunkState::Idle;
+    int result = 0;
+    std::optional<std::future<int>> future;
+    std::optional<userver::engine::Future<int>> coro_future;
+  };
+
+  using Chunks = std::vector<Chunk>;
+
+public:
+  static constexpr std::size_t kDirectAlignment = 4096;
+
+public:
+  explicit ReadaheadBuffers(
+    const File& file,
+    const ReadaheadConfig& config,
+    const FileManagerPoolPtr& file_manager_pool);
+
+  ~ReadaheadBuffers();
+
+  /**
+   * Copy next size bytes of file to data.
+   * On success, return number of copied bytes (less than size on eof).
+   * On error, return -error.
+   **/
+  int read(char* data, const std::size_t size) noexcept;
+
+private:
+  void submit(Chunk& chunk) noexcept;
+
+  void wait(Chunk& chunk) noexcept;
+
+private:
+  const FileManagerPoolPtr file_manager_pool_;
+
+  File file_;
+
+  std::size_t buffer_size_ = 0;
+
+  Chunks chunks_;
+
+  std::size_t head_ = 0;
+
+  std::size_t position_ = 0;
+
+  std::int64_t submit_offset_ = 0;
+
+  bool is_eof_ = false;
+};
+
+} // namespace UServerUtils::FileManager
+
+#include <UServerUtils/FileManager/ReadaheadBuffers.ipp>
+
+#endif // USERVER_FILEMANAGER_READAHEADBUFFERS_HPP
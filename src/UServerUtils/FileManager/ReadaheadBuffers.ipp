@@ -0,0 +1,235 @@
+// STD
+#include <cstring>
+
+// USERVER
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/task/task.hpp>
+
+// THIS
+#include <Generics/Function.hpp>
+
+namespace UServerUtils::FileManager
+{
+
+inline ReadaheadBuffers::ReadaheadBuffers(
+  const File& file,
+  const ReadaheadConfig& config,
+  const FileManagerPoolPtr& file_manager_pool)
+  : file_manager_pool_(file_manager_pool)
+{
+  if (!file_manager_pool_)
+  {
+    Stream::Error stream;
+    stream << FNS
+           << "file_manager_pool is null";
+    throw Exception(stream);
+  }
+
+  if (config.number_buffers == 0)
+  {
+    Stream::Error stream;
+    stream << FNS
+           << "number_buffers must be positive";
+    throw Exception(stream);
+  }
+
+  if (config.is_direct)
+  {
+    const std::string& path = file.path();
+    if (path.empty())
+    {
+      Stream::Error stream;
+      stream << FNS
+             << "Path is empty, can't reopen file with O_DIRECT";
+      throw Exception(stream);
+    }
+
+    file_.open(path, O_RDONLY | O_DIRECT);
+    buffer_size_ = std::max(
+      kDirectAlignment,
+      (config.buffer_size + kDirectAlignment - 1) /
+        kDirectAlignment * kDirectAlignment);
+  }
+  else
+  {
+    file_ = file;
+    buffer_size_ = std::max<std::size_t>(config.buffer_size, 1);
+  }
+
+  if (!file_.is_valid())
+  {
+    Stream::Error stream;
+    stream << FNS
+           << "File not valid, error code=["
+           << file_.error_details()
+           << "], error message=["
+           << file_.error_message()
+           << "]";
+    throw Exception(stream);
+  }
+
+  chunks_.resize(config.number_buffers);
+  for (auto& chunk : chunks_)
+  {
+    chunk.buffer.reset(static_cast<char*>(
+      Utils::aligned_alloc(buffer_size_, kDirectAlignment)));
+  }
+
+  for (auto& chunk : chunks_)
+  {
+    submit(chunk);
+  }
+}
+
+inline ReadaheadBuffers::~ReadaheadBuffers()
+{
+  // Buffers must survive all reads in flight
+  const bool is_coroutine_thread =
+    userver::engine::current_task::IsTaskProcessorThread();
+  std::optional<userver::engine::TaskCancellationBlocker> blocker;
+  if (is_coroutine_thread)
+  {
+    blocker.emplace();
+  }
+
+  for (auto& chunk : chunks_)
+  {
+    if (chunk.state == ChunkState::Pending)
+    {
+      wait(chunk);
+    }
+  }
+}
+
+inline void ReadaheadBuffers::submit(Chunk& chunk) noexcept
+{
+  chunk.state = ChunkState::Pending;
+  chunk.result = 0;
+
+  try
+  {
+    const std::string_view buffer(chunk.buffer.get(), buffer_size_);
+    const std::int64_t offset = submit_offset_;
+    submit_offset_ += static_cast<std::int64_t>(buffer_size_);
+
+    const bool is_coroutine_thread =
+      userver::engine::current_task::IsTaskProcessorThread();
+    if (is_coroutine_thread)
+    {
+      userver::engine::Promise<int> promise;
+      chunk.coro_future = promise.get_future();
+      FileManager::Callback callback(
+        [promise = std::move(promise)] (const int result) mutable {
+          try
+          {
+            promise.set_value(result);
+          }
+          catch (...)
+          {
+          }
+      });
+
+      file_manager_pool_->read(file_, buffer, offset, std::move(callback));
+    }
+    else
+    {
+      std::promise<int> promise;
+      chunk.future = promise.get_future();
+      FileManager::Callback callback(
+        [promise = std::move(promise)] (const int result) mutable {
+          try
+          {
+            promise.set_value(result);
+          }
+          catch (...)
+          {
+          }
+      });
+
+      file_manager_pool_->read(file_, buffer, offset, std::move(callback));
+    }
+  }
+  catch (...)
+  {
+    chunk.coro_future.reset();
+    chunk.future.reset();
+    chunk.state = ChunkState::Ready;
+    chunk.result = -ECANCELED;
+  }
+}
+
+inline void ReadaheadBuffers::wait(Chunk& chunk) noexcept
+{
+  try
+  {
+    if (chunk.coro_future)
+    {
+      chunk.result = chunk.coro_future->get();
+    }
+    else if (chunk.future)
+    {
+      chunk.result = chunk.future->get();
+    }
+  }
+  catch (...)
+  {
+    chunk.result = -ECANCELED;
+  }
+
+  chunk.coro_future.reset();
+  chunk.future.reset();
+  chunk.state = ChunkState::Ready;
+}
+
+inline int ReadaheadBuffers::read(
+  char* data,
+  const std::size_t size) noexcept
+{
+  std::size_t total = 0;
+  while (total < size)
+  {
+    auto& chunk = chunks_[head_];
+    if (chunk.state == ChunkState::Pending)
+    {
+      wait(chunk);
+    }
+
+    if (chunk.state != ChunkState::Ready)
+    {
+      break;
+    }
+
+    if (chunk.result < 0)
+    {
+      return chunk.result;
+    }
+
+    const std::size_t chunk_size = static_cast<std::size_t>(chunk.result);
+    if (position_ == chunk_size)
+    {
+      if (chunk_size < buffer_size_)
+      {
+        is_eof_ = true;
+      }
+
+      if (is_eof_)
+      {
+        break;
+      }
+
+      submit(chunk);
+      head_ = (head_ + 1) % chunks_.size();
+      position_ = 0;
+      continue;
+    }
+
+    const std::size_t copy_size = std::min(chunk_size - position_, size - total);
+    std::memcpy(data + total, chunk.buffer.get() + position_, copy_size);
+    position_ += copy_size;
+    total += copy_size;
+  }
+
+  return static_cast<int>(total);
+}
+
+} // namespace UServerUtils::FileManager
@@ -0,0 +1,107 @@
+#ifndef USERVER_FILEMANAGER_REGISTEREDBUFFERPOOL_HPP
+#define USERVER_FILEMANAGER_REGISTEREDBUFFERPOOL_HPP
+
+// POSIX
+#include <sys/uio.h>
+
+// STD
+#include <memory>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+// THIS
+#include <eh/Exception.hpp>
+#include <Generics/Uncopyable.hpp>
+#include <UServerUtils/FileManager/Utils.hpp>
+
+namespace UServerUtils::FileManager
+{
+
+/**
+ * Part of buffer registered in io_uring.
+ * size can be reduced to read/write less than whole buffer.
+ **/
+struct RegisteredBuffer final
+{
+  char* data = nullptr;
+  std::size_t size = 0;
+  int index = -1;
+  // Distinguishes acquisitions of the same buffer
+  std::uint32_t generation = 0;
+
+  bool is_valid() const noexcept
+  {
+    return index >= 0;
+  }
+
+  std::string_view view() const noexcept
+  {
+    return std::string_view(data, size);
+  }
+};
+
+// Thread safe
+class RegisteredBufferPool final : private Generics::Uncopyable
+{
+public:
+  using IoVecs = std::vector<iovec>;
+
+  DECLARE_EXCEPTION(Exception, eh::DescriptiveException);
+
+private:
+  using BufferPtr = std::unique_ptr<char, Utils::AlignedFreeDeleter>;
+  using Buffers = std::vector<BufferPtr>;
+  using Indexes = std::vector<int>;
+  using Flags = std::vector<bool>;
+  using Generations = std::vector<std::uint32_t>;
+
+public:
+  static constexpr std::size_t kAlignment = 4096;
+
+public:
+  explicit RegisteredBufferPool(
+    const std::size_t number_buffers,
+    const std::size_t buffer_size);
+
+  ~RegisteredBufferPool() = default;
+
+  std::size_t size() const noexcept;
+
+  std::size_t buffer_size() const noexcept;
+
+  const IoVecs& iovecs() const noexcept;
+
+  // Return std::nullopt if all buffers are in use
+  std::optional<RegisteredBuffer> acquire() noexcept;
+
+  /**
+   * Return false if buffer is not acquired from this pool
+   * or is released already, even if it is acquired again
+   * (pool is not changed).
+   **/
+  bool release(const RegisteredBuffer& buffer) noexcept;
+
+private:
+  const std::size_t buffer_size_ = 0;
+
+  Buffers buffers_;
+
+  IoVecs iovecs_;
+
+  std::mutex mutex_;
+
+  Indexes free_indexes_;
+
+  Flags is_acquired_;
+
+  Generations generations_;
+};
+
+} // namespace UServerUtils::FileManager
+
+#include <UServerUtils/FileManager/RegisteredBufferPool.ipp>
+
+#endif // USERVER_FILEMANAGER_REGISTEREDBUFFERPOOL_HPP
@@ -0,0 +1,114 @@
+// STD
+#include <sstream>
+
+// THIS
+#include <Generics/Function.hpp>
+
+namespace UServerUtils::FileManager
+{
+
+inline RegisteredBufferPool::RegisteredBufferPool(
+  const std::size_t number_buffers,
+  const std::size_t buffer_size)
+  : buffer_size_((buffer_size + kAlignment - 1) / kAlignment * kAlignment)
+{
+  if (number_buffers == 0 || buffer_size_ == 0)
+  {
+    std::ostringstream stream;
+    stream << FNS
+           << "number_buffers and buffer_size must be positive";
+    throw Exception(stream.str());
+  }
+
+  buffers_.reserve(number_buffers);
+  iovecs_.reserve(number_buffers);
+  free_indexes_.reserve(number_buffers);
+  is_acquired_.resize(number_buffers, false);
+  generations_.resize(number_buffers, 0);
+  for (std::size_t i = 0; i < number_buffers; ++i)
+  {
+    buffers_.emplace_back(static_cast<char*>(
+      Utils::aligned_alloc(buffer_size_, kAlignment)));
+
+    iovec vec;
+    vec.iov_base = buffers_.back().get();
+    vec.iov_len = buffer_size_;
+    iovecs_.emplace_back(vec);
+
+    free_indexes_.emplace_back(static_cast<int>(number_buffers - 1 - i));
+  }
+}
+
+inline std::size_t RegisteredBufferPool::size() const noexcept
+{
+  return buffers_.size();
+}
+
+inline std::size_t RegisteredBufferPool::buffer_size() const noexcept
+{
+  return buffer_size_;
+}
+
+inline const RegisteredBufferPool::IoVecs&
+RegisteredBufferPool::iovecs() const noexcept
+{
+  return iovecs_;
+}
+
+inline std::optional<RegisteredBuffer>
+RegisteredBufferPool::acquire() noexcept
+{
+  int index = -1;
+  std::uint32_t generation = 0;
+  {
+    std::lock_guard lock(mutex_);
+    if (free_indexes_.empty())
+    {
+      return std::nullopt;
+    }
+
+    index = free_indexes_.back();
+    free_indexes_.pop_back();
+    is_acquired_[index] = true;
+    generation = ++generations_[index];
+  }
+
+  RegisteredBuffer buffer;
+  buffer.data = buffers_[index].get();
+  buffer.size = buffer_size_;
+  buffer.index = index;
+  buffer.generation = generation;
+
+  return buffer;
+}
+
+inline bool RegisteredBufferPool::release(
+  const RegisteredBuffer& buffer) noexcept
+{
+  if (!buffer.is_valid() ||
+      static_cast<std::size_t>(buffer.index) >= buffers_.size())
+  {
+    return false;
+  }
+
+  const char* const begin = buffers_[buffer.index].get();
+  if (buffer.data < begin || buffer.data >= begin + buffer_size_)
+  {
+    return false;
+  }
+
+  std::lock_guard lock(mutex_);
+  if (!is_acquired_[buffer.index] ||
+      generations_[buffer.index] != buffer.generation)
+  {
+    return false;
+  }
+
+  is_acquired_[buffer.index] = false;
+  // capacity is reserved for all buffers
+  free_indexes_.emplace_back(buffer.index);
+
+  return true;
+}
+
+} // namespace UServerUtils::FileManager
@@ -0,0 +1,74 @@
+#ifndef USERVER_FILEMANAGER_REGISTEREDFILETABLE_HPP
+#define USERVER_FILEMANAGER_REGISTEREDFILETABLE_HPP
+
+// STD
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+// THIS
+#include <eh/Exception.hpp>
+#include <Generics/Uncopyable.hpp>
+
+namespace UServerUtils::FileManager
+{
+
+/**
+ * Slot of file registered in io_uring (IOSQE_FIXED_FILE).
+ **/
+struct RegisteredFile final
+{
+  int index = -1;
+  // Distinguishes registrations in the same slot
+  std::uint32_t generation = 0;
+
+  bool is_valid() const noexcept
+  {
+    return index >= 0;
+  }
+};
+
+// Allocator of slots in registered file tables. Thread safe.
+class RegisteredFileTable final : private Generics::Uncopyable
+{
+public:
+  DECLARE_EXCEPTION(Exception, eh::DescriptiveException);
+
+private:
+  using Indexes = std::vector<int>;
+  using Flags = std::vector<bool>;
+  using Generations = std::vector<std::uint32_t>;
+
+public:
+  explicit RegisteredFileTable(const std::size_t size);
+
+  ~RegisteredFileTable() = default;
+
+  std::size_t size() const noexcept;
+
+  // Return std::nullopt if table is full
+  std::optional<RegisteredFile> acquire() noexcept;
+
+  // Return false if slot is not acquired from this table or released already
+  bool release(const RegisteredFile& file) noexcept;
+
+  bool is_acquired(const RegisteredFile& file) noexcept;
+
+private:
+  const std::size_t size_ = 0;
+
+  std::mutex mutex_;
+
+  Indexes free_indexes_;
+
+  Flags is_acquired_;
+
+  Generations generations_;
+};
+
+} // namespace UServerUtils::FileManager
+
+#include <UServerUtils/FileManager/RegisteredFileTable.ipp>
+
+#endif // USERVER_FILEMANAGER_REGISTEREDFILETABLE_HPP
@@ -0,0 +1,86 @@
+// STD
+#include <sstream>
+
+// THIS
+#include <Generics/Function.hpp>
+
+namespace UServerUtils::FileManager
+{
+
+inline RegisteredFileTable::RegisteredFileTable(const std::size_t size)
+  : size_(size)
+{
+  if (size_ == 0)
+  {
+    std::ostringstream stream;
+    stream << FNS
+           << "size must be positive";
+    throw Exception(stream.str());
+  }
+
+  free_indexes_.reserve(size_);
+  is_acquired_.resize(size_, false);
+  generations_.resize(size_, 0);
+  for (std::size_t i = 0; i < size_; ++i)
+  {
+    free_indexes_.emplace_back(static_cast<int>(size_ - 1 - i));
+  }
+}
+
+inline std::size_t RegisteredFileTable::size() const noexcept
+{
+  return size_;
+}
+
+inline std::optional<RegisteredFile> RegisteredFileTable::acquire() noexcept
+{
+  std::lock_guard lock(mutex_);
+  if (free_indexes_.empty())
+  {
+    return std::nullopt;
+  }
+
+  RegisteredFile file;
+  file.index = free_indexes_.back();
+  free_indexes_.pop_back();
+  is_acquired_[file.index] = true;
+  file.generation = ++generations_[file.index];
+
+  return file;
+}
+
+inline bool RegisteredFileTable::is_acquired(
+  const RegisteredFile& file) noexcept
+{
+  if (!file.is_valid() || static_cast<std::size_t>(file.index) >= size_)
+  {
+    return false;
+  }
+
+  std::lock_guard lock(mutex_);
+  return is_acquired_[file.index] &&
+    generations_[file.index] == file.generation;
+}
+
+inline bool RegisteredFileTable::release(const RegisteredFile& file) noexcept
+{
+  if (!file.is_valid() || static_cast<std::size_t>(file.index) >= size_)
+  {
+    return false;
+  }
+
+  std::lock_guard lock(mutex_);
+  if (!is_acquired_[file.index] ||
+      generations_[file.index] != file.generation)
+  {
+    return false;
+  }
+
+  is_acquired_[file.index] = false;
+  // capacity is reserved for all slots
+  free_indexes_.emplace_back(file.index);
+
+  return true;
+}
+
+} // namespace UServerUtils::FileManager
@@ -0,0 +1,111 @@
+#ifndef GRPC_CLIENT_BALANCING_POLICY_H_
+#define GRPC_CLIENT_BALANCING_POLICY_H_
+
+// STD
+#include <atomic>
+#include <cstdint>
+
+// THIS
+#include <UServerUtils/Grpc/Client/Client.hpp>
+
+namespace UServerUtils::Grpc::Client
+{
+
+enum class BalancingPolicy
+{
+  // clients[counter % size]
+  RoundRobin = 0,
+  // Client with the smallest number of calls in flight (full scan).
+  LeastOutstanding,
+  // Less loaded of two random clients.
+  PowerOfTwoChoices,
+  // Of two random clients the one with the smallest
+  // ewma_latency * (in_flight + 1).
+  EwmaLatency
+};
+
+struct ClientStats final
+{
+  ClientId client_id = 0;
+  std::uint64_t in_flight = 0;
+  std::uint64_t number_requests = 0;
+  std::uint64_t number_errors = 0;
+  std::uint64_t ewma_latency_us = 0;
+};
+
+namespace Internal
+{
+
+/**
+ * Load of one client, shared by all snapshots of the pool.
+ * Aligned so that neighbouring clients do not share a cache line.
+ **/
+struct alignas(64) ClientLoad final
+{
+  // Weight of the new sample is 1 / 2^EWMA_SHIFT.
+  static constexpr std::uint64_t EWMA_SHIFT = 3;
+
+  void on_start() noexcept
+  {
+    in_flight.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void on_finish(
+    const std::uint64_t latency_us,
+    const bool is_error) noexcept
+  {
+    in_flight.fetch_sub(1, std::memory_order_relaxed);
+    number_requests.fetch_add(1, std::memory_order_relaxed);
+    if (is_error)
+    {
+      number_errors.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Lost updates under contention only make the average a bit noisier.
+    const std::uint64_t old_value = ewma_latency_us.load(
+      std::memory_order_relaxed);
+    const std::uint64_t new_value = old_value == 0 ?
+      latency_us :
+      old_value - (old_value >> EWMA_SHIFT) + (latency_us >> EWMA_SHIFT);
+    ewma_latency_us.store(new_value, std::memory_order_relaxed);
+  }
+
+  // Attempt was cancelled (e.g. lost a hedging race), not a failure.
+  void on_cancel() noexcept
+  {
+    in_flight.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  std::uint64_t load(const BalancingPolicy policy) const noexcept
+  {
+    const std::uint64_t number = in_flight.load(std::memory_order_relaxed);
+    if (policy == BalancingPolicy::EwmaLatency)
+    {
+      const std::uint64_t latency = ewma_latency_us.load(
+        std::memory_order_relaxed);
+      return (latency + 1) * (number + 1);
+    }
+
+    return number;
+  }
+
+  std::atomic<std::uint64_t> in_flight{0};
+  std::atomic<std::uint64_t> number_requests{0};
+  std::atomic<std::uint64_t> number_errors{0};
+  std::atomic<std::uint64_t> ewma_latency_us{0};
+};
+
+// splitmix64, cheap enough to be called on every write.
+inline std::uint64_t mix_counter(std::uint64_t value) noexcept
+{
+  value += 0x9e3779b97f4a7c15ULL;
+  value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+  return value ^ (value >> 31);
+}
+
+} // namespace Internal
+
+} // namespace UServerUtils::Grpc::Client
+
+#endif // GRPC_CLIENT_BALANCING_POLICY_H_
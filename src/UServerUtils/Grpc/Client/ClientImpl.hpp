@@ -2,6 +2,7 @@
 #define GRPC_CLIENT_CLIENT_IMPL_H_
 
 // STD
+#include <atomic>
 #include <memory>
 
 // GRPC
@@ -21,7 +22,9 @@
 #include <UServerUtils/Grpc/Client/EventType.hpp>
 #include <UServerUtils/Grpc/Client/PendingQueue.hpp>
 #include <UServerUtils/Grpc/Client/Types.hpp>
+#include <UServerUtils/Grpc/Common/MessageArena.hpp>
 #include <UServerUtils/Grpc/Common/RpcServiceMethodTraits.hpp>
+#include <UServerUtils/Grpc/Common/WriteCoalescing.hpp>
 
 namespace UServerUtils::Grpc::Client
 {
@@ -98,7 +101,9 @@ public:
     const CompletionQueuePtr& completion_queue,
     const ObserverPtr& observer,
     Delegate& delegate,
-    RequestPtr&& request);
+    RequestPtr&& request,
+    const std::size_t arena_initial_block_size = 0,
+    const UServerUtils::Grpc::Common::WriteCoalescingConfig& write_coalescing = {});
 
   ~ClientImpl() override = default;
 
@@ -119,7 +124,9 @@ private:
     const CompletionQueuePtr& completion_queue,
     const ObserverPtr& observer,
     Delegate& delegate,
-    RequestPtr&& request);
+    RequestPtr&& request,
+    const std::size_t arena_initial_block_size = 0,
+    const UServerUtils::Grpc::Common::WriteCoalescingConfig& write_coalescing = {});
 
   static ClientId create_id() noexcept;
 
@@ -152,8 +159,12 @@ private:
 
   void execute_queue() noexcept;
 
+  bool has_pending_write() const noexcept;
+
   void try_close() noexcept;
 
+  Message* response_message() noexcept;
+
 private:
   const ClientId client_id_;
 
@@ -171,12 +182,21 @@ private:
 
   MessagePtr responce_;
 
+  // Set instead of responce_ if arena is enabled.
+  UServerUtils::Grpc::Common::MessageArenaPtr responce_arena_;
+
   grpc::ClientContext client_context_;
 
   grpc::internal::RpcMethod rpc_method_;
 
   PendingQueue pending_queue_;
 
+  const std::size_t max_pending_writes_ = 0;
+
+  std::atomic<std::size_t> number_pending_writes_{0};
+
+  UServerUtils::Grpc::Common::WriteBatch write_batch_;
+
   Event initialize_event_;
 
   Event read_event_;
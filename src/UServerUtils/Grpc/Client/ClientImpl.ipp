@@ -19,7 +19,9 @@ ClientImpl<RpcServiceMethodConcept>::create(
   const CompletionQueuePtr& completion_queue,
   const ObserverPtr& observer,
   Delegate& delegate,
-  RequestPtr&& request)
+  RequestPtr&& request,
+  const std::size_t arena_initial_block_size,
+  const UServerUtils::Grpc::Common::WriteCoalescingConfig& write_coalescing)
 {
   auto client = std::shared_ptr<ClientImpl<RpcServiceMethodConcept>>(
     new ClientImpl<RpcServiceMethodConcept>(
@@ -28,7 +30,9 @@ ClientImpl<RpcServiceMethodConcept>::create(
       completion_queue,
       observer,
       delegate,
-      std::move(request)));
+      std::move(request),
+      arena_initial_block_size,
+      write_coalescing));
   return client;
 }
 
@@ -39,7 +43,9 @@ inline ClientImpl<RpcServiceMethodConcept>::ClientImpl(
   const CompletionQueuePtr& completion_queue,
   const ObserverPtr& observer,
   Delegate& delegate,
-  RequestPtr&& request)
+  RequestPtr&& request,
+  const std::size_t arena_initial_block_size,
+  const UServerUtils::Grpc::Common::WriteCoalescingConfig& write_coalescing)
   : client_id_(create_id()),
     logger_(ReferenceCounting::add_ref(logger)),
     channel_(channel),
@@ -47,8 +53,15 @@ inline ClientImpl<RpcServiceMethodConcept>::ClientImpl(
     observer_(observer),
     delegate_(delegate),
     request_(std::move(request)),
-    responce_(std::make_unique<Response>()),
+    responce_(arena_initial_block_size == 0 ?
+      std::make_unique<Response>() : nullptr),
+    responce_arena_(arena_initial_block_size == 0 ? nullptr :
+      std::make_unique<UServerUtils::Grpc::Common::MessageArena>(
+        Response::default_instance(),
+        arena_initial_block_size)),
     rpc_method_(Traits::method_name(), Traits::rpc_type, channel_),
+    max_pending_writes_(write_coalescing.max_pending_writes),
+    write_batch_(write_coalescing),
     initialize_event_(EventType::Initialize, *this, false),
     read_event_(EventType::Read, *this, false),
     write_event_(EventType::Write, *this, false),
@@ -154,6 +167,16 @@ ClientImpl<RpcServiceMethodConcept>::write(
     return false;
   }
 
+  // Bounded pending queue: the writer gets an error
+  // instead of piling up messages the server does not read.
+  if (max_pending_writes_ != 0 &&
+      number_pending_writes_.load(std::memory_order_relaxed) >=
+        max_pending_writes_)
+  {
+    return false;
+  }
+  number_pending_writes_.fetch_add(1, std::memory_order_relaxed);
+
   try
   {
     auto event = std::make_unique<EventQueue>(
@@ -166,6 +189,7 @@ ClientImpl<RpcServiceMethodConcept>::write(
     if (!is_success)
     {
       event.reset(event_ptr);
+      number_pending_writes_.fetch_sub(1, std::memory_order_relaxed);
       return false;
     }
 
@@ -186,6 +210,7 @@ ClientImpl<RpcServiceMethodConcept>::write(
     }
   }
 
+  number_pending_writes_.fetch_sub(1, std::memory_order_relaxed);
   return false;
 }
 
@@ -351,7 +376,7 @@ ClientImpl<RpcServiceMethodConcept>::on_start(
             completion_queue_.get(),
             rpc_method_,
             &client_context_,
-            responce_.get(),
+            response_message(),
             true,
             &initialize_event_));
     }
@@ -466,7 +491,7 @@ ClientImpl<RpcServiceMethodConcept>::on_initialize(
       if constexpr (k_rpc_type == grpc::internal::RpcMethod::NORMAL_RPC)
       {
         client_response_reader_->Finish(
-          responce_.get(),
+          response_message(),
           &status_,
           &finish_event_);
       }
@@ -539,7 +564,11 @@ ClientImpl<RpcServiceMethodConcept>::on_read(const bool ok) noexcept
 
     try
     {
-      observer_->on_read(static_cast<Response&&>(*responce_));
+      observer_->on_read(static_cast<Response&&>(*response_message()));
+      if (responce_arena_)
+      {
+        responce_arena_->recycle();
+      }
     }
     catch (const eh::Exception &exc)
     {
@@ -647,7 +676,7 @@ ClientImpl<RpcServiceMethodConcept>::on_finish(
     {
       observer_->on_finish(
         std::move(status_),
-        static_cast<Response&&>(*responce_));
+        static_cast<Response&&>(*response_message()));
     }
   }
   catch (const eh::Exception& exc)
@@ -779,14 +808,14 @@ ClientImpl<RpcServiceMethodConcept>::request_new_read() noexcept
     if constexpr (k_rpc_type == grpc::internal::RpcMethod::BIDI_STREAMING)
     {
       client_reader_writer_->Read(
-        responce_.get(),
+        response_message(),
         &read_event_);
       read_event_.set_pending(true);
     }
     else if constexpr (k_rpc_type == grpc::internal::RpcMethod::SERVER_STREAMING)
     {
       client_reader_->Read(
-        responce_.get(),
+        response_message(),
         &read_event_);
       read_event_.set_pending(true);
     }
@@ -830,17 +859,23 @@ ClientImpl<RpcServiceMethodConcept>::execute_queue() noexcept
 
     if (data.first == PendingQueueType::Write)
     {
+      number_pending_writes_.fetch_sub(1, std::memory_order_relaxed);
       request_ = std::move(data.second);
+      const auto options = write_batch_.next(
+        *request_,
+        has_pending_write());
       if constexpr (k_rpc_type == Internal::RpcType::BIDI_STREAMING)
       {
         client_reader_writer_->Write(
           *request_,
+          options,
           &write_event_);
       }
       else if constexpr (k_rpc_type == Internal::RpcType::CLIENT_STREAMING)
       {
         client_writer_->Write(
           *request_,
+          options,
           &write_event_);
       }
     }
@@ -874,6 +909,14 @@ ClientImpl<RpcServiceMethodConcept>::execute_queue() noexcept
   }
 }
 
+template<class RpcServiceMethodConcept>
+inline bool
+ClientImpl<RpcServiceMethodConcept>::has_pending_write() const noexcept
+{
+  return !pending_queue_.empty() &&
+    pending_queue_.front().first == PendingQueueType::Write;
+}
+
 template<class RpcServiceMethodConcept>
 inline void
 ClientImpl<RpcServiceMethodConcept>::try_close() noexcept
@@ -894,4 +937,11 @@ ClientImpl<RpcServiceMethodConcept>::try_close() noexcept
   delegate_.need_remove(get_id());
 }
 
+template<class RpcServiceMethodConcept>
+inline google::protobuf::Message*
+ClientImpl<RpcServiceMethodConcept>::response_message() noexcept
+{
+  return responce_arena_ ? responce_arena_->message() : responce_.get();
+}
+
 } // namespace UServerUtils::Grpc::Client
\ No newline at end of file
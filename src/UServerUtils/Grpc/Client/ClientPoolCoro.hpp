@@ -2,8 +2,10 @@
 #define GRPC_CLIENT_CLIENT_POOL_CORO_H_
 
 // STD
+#include <chrono>
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 // GRPC
 #include <grpc/impl/codegen/connectivity_state.h>
@@ -13,18 +15,22 @@
 // USERVER
 #include <userver/engine/task/task_processor_fwd.hpp>
 #include <userver/engine/async.hpp>
-#include <userver/engine/shared_mutex.hpp>
 #include <userver/engine/sleep.hpp>
+#include <userver/engine/task/cancel.hpp>
+#include <userver/engine/wait_any.hpp>
+#include <userver/rcu/rcu.hpp>
 
 // THIS
 #include <Generics/Uncopyable.hpp>
 #include <Logger/Logger.hpp>
+#include <UServerUtils/Grpc/Client/BalancingPolicy.hpp>
 #include <UServerUtils/Grpc/Client/ClientCoro.hpp>
 #include <UServerUtils/Grpc/Client/ClientObserver.hpp>
 #include <UServerUtils/Grpc/Client/Config.hpp>
 #include <UServerUtils/Grpc/Client/ConfigPoolCoro.hpp>
 #include <UServerUtils/Grpc/Client/Factory.hpp>
 #include <UServerUtils/Grpc/Client/FactoryObserver.hpp>
+#include <UServerUtils/Grpc/Client/Hedging.hpp>
 #include <UServerUtils/Grpc/Client/Types.hpp>
 #include <UServerUtils/Utils.hpp>
 
@@ -59,22 +65,46 @@ public:
   using Request = typename Traits::Request;
   using RequestPtr = std::unique_ptr<Request>;
   using WriteResult = typename ClientCoro<RpcServiceMethodConcept>::WriteResult;
+  using ClientsStats = std::vector<ClientStats>;
 
   DECLARE_EXCEPTION(Exception, eh::DescriptiveException);
 
 private:
   using ClientPtr = ClientCoroPtr<RpcServiceMethodConcept>;
+  using ClientLoadPtr = std::shared_ptr<ClientLoad>;
   using Index = std::size_t;
   using IdToIndex = std::unordered_map<ClientId, Index>;
-  using Clients = std::vector<ClientPtr>;
-  using Counter = std::atomic<ClientId>;
-  using Mutex = userver::engine::SharedMutex;
+  using Counter = std::atomic<std::uint64_t>;
+
+  struct Entry final
+  {
+    ClientPtr client;
+    ClientLoadPtr load;
+  };
+  using Entries = std::vector<Entry>;
+
+  /**
+   * Immutable list of clients. Readers never lock, writers
+   * (emplace/remove, rare) copy the snapshot and publish a new one.
+   **/
+  struct Snapshot final
+  {
+    Entries entries;
+    IdToIndex id_to_index;
+  };
+  using SnapshotVariable = userver::rcu::Variable<Snapshot>;
 
 public:
-  ClientPoolCoroImpl(Logger* logger)
-    : logger_(ReferenceCounting::add_ref(logger))
+  explicit ClientPoolCoroImpl(
+    Logger* logger,
+    const BalancingPolicy balancing_policy = BalancingPolicy::RoundRobin,
+    const HedgingConfig& hedging_config = {})
+    : logger_(ReferenceCounting::add_ref(logger)),
+      balancing_policy_(balancing_policy),
+      hedging_config_(hedging_config),
+      retry_budget_(hedging_config),
+      latency_window_(hedging_config)
   {
-    clients_.reserve(10000);
   }
 
   ~ClientPoolCoroImpl() = default;
@@ -101,19 +131,40 @@ public:
         1,
         std::memory_order_relaxed);
 
-      ClientPtr client;
+      Entry entry;
+      Entry hedge_entry;
       {
-        std::shared_lock lock(mutex_);
-        const auto size = clients_.size();
+        const auto snapshot = snapshot_.Read();
+        const auto& entries = snapshot->entries;
+        const auto size = entries.size();
         if (size == 0)
         {
           return WriteResult(Status::InternalError, {});
         }
 
-        client = clients_[number % size];
+        const auto index = select(entries, number);
+        entry = entries[index];
+        if (hedging_config_.enabled && size > 1)
+        {
+          auto hedge_index = select(entries, number + 1);
+          if (hedge_index == index)
+          {
+            hedge_index = (index + 1) % size;
+          }
+          hedge_entry = entries[hedge_index];
+        }
+      }
+
+      if (!hedge_entry.client)
+      {
+        return write(entry, std::move(request), timeout);
       }
 
-      return client->write(std::move(request), timeout);
+      return write_hedged(
+        std::move(entry),
+        std::move(hedge_entry),
+        std::move(request),
+        timeout);
     }
     catch (const eh::Exception &exc)
     {
@@ -143,9 +194,9 @@ public:
     {
       const auto client_id = client->client_id();
 
-      std::unique_lock lock(mutex_);
-      const auto size = clients_.size();
-      const auto result = id_to_index_.try_emplace(
+      auto snapshot = snapshot_.StartWrite();
+      const auto size = snapshot->entries.size();
+      const auto result = snapshot->id_to_index.try_emplace(
         client_id,
         size);
       if (!result.second)
@@ -156,7 +207,9 @@ public:
                << client_id;
         throw Exception(stream.str());
       }
-      clients_.emplace_back(std::move(client));
+      snapshot->entries.push_back(
+        Entry{std::move(client), std::make_shared<ClientLoad>()});
+      snapshot.Commit();
     }
     catch (const eh::Exception& exc)
     {
@@ -183,16 +236,18 @@ public:
     ClientPtr client;
     try
     {
-      std::unique_lock lock(mutex_);
-      auto it_remove = id_to_index_.find(client_id);
-      if (it_remove == std::end(id_to_index_))
+      auto snapshot = snapshot_.StartWrite();
+      auto& id_to_index = snapshot->id_to_index;
+      auto& entries = snapshot->entries;
+      auto it_remove = id_to_index.find(client_id);
+      if (it_remove == std::end(id_to_index))
       {
         return client;
       }
       const auto index = it_remove->second;
-      id_to_index_.erase(it_remove);
+      id_to_index.erase(it_remove);
 
-      const auto size = clients_.size();
+      const auto size = entries.size();
       if (index >= size)
       {
         Stream::Error stream;
@@ -206,18 +261,18 @@ public:
           Aspect::CLIENT_POOL_CORO);
         return client;
       }
-      client = std::move(clients_[index]);
+      client = entries[index].client;
 
       std::swap(
-        clients_[index],
-        clients_[size - 1]);
-      clients_.pop_back();
+        entries[index],
+        entries[size - 1]);
+      entries.pop_back();
 
-      if (!clients_.empty() && index != size - 1)
+      if (!entries.empty() && index != size - 1)
       {
-        const auto id = clients_[index]->client_id();
-        auto it_change = id_to_index_.find(id);
-        if (it_change == std::end(id_to_index_))
+        const auto id = entries[index].client->client_id();
+        auto it_change = id_to_index.find(id);
+        if (it_change == std::end(id_to_index))
         {
           Stream::Error stream;
           stream << FNS
@@ -231,6 +286,7 @@ public:
         it_change->second = index;
       }
 
+      snapshot.Commit();
       return client;
     }
     catch (const eh::Exception &exc)
@@ -255,16 +311,241 @@ public:
     return {};
   }
 
+  ClientsStats stats() const
+  {
+    const auto snapshot = snapshot_.Read();
+    ClientsStats result;
+    result.reserve(snapshot->entries.size());
+    for (const auto& entry : snapshot->entries)
+    {
+      const auto& load = *entry.load;
+      auto& stats = result.emplace_back();
+      stats.client_id = entry.client->client_id();
+      stats.in_flight = load.in_flight.load(std::memory_order_relaxed);
+      stats.number_requests = load.number_requests.load(
+        std::memory_order_relaxed);
+      stats.number_errors = load.number_errors.load(
+        std::memory_order_relaxed);
+      stats.ewma_latency_us = load.ewma_latency_us.load(
+        std::memory_order_relaxed);
+    }
+
+    return result;
+  }
+
+  HedgingStats hedging_stats() const noexcept
+  {
+    HedgingStats stats;
+    stats.number_hedged = number_hedged_.load(std::memory_order_relaxed);
+    stats.number_hedge_won = number_hedge_won_.load(
+      std::memory_order_relaxed);
+    stats.number_budget_exhausted = number_budget_exhausted_.load(
+      std::memory_order_relaxed);
+    stats.delay_us = latency_window_.delay_us();
+    return stats;
+  }
+
+private:
+  WriteResult write(
+    const Entry& entry,
+    RequestPtr&& request,
+    const std::size_t timeout)
+  {
+    auto& load = *entry.load;
+    load.on_start();
+    const auto start = std::chrono::steady_clock::now();
+    auto result = entry.client->write(std::move(request), timeout);
+    const auto latency = static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+
+    if (result.status != Status::Ok
+      && userver::engine::current_task::ShouldCancel())
+    {
+      load.on_cancel();
+      return result;
+    }
+
+    load.on_finish(latency, result.status != Status::Ok);
+    if (hedging_config_.enabled && result.status == Status::Ok)
+    {
+      latency_window_.add(latency);
+    }
+
+    return result;
+  }
+
+  /**
+   * Send request to entry, if no reply arrives in hedging delay
+   * and retry budget allows, send copy of request to hedge_entry.
+   * The first successful reply wins, the other attempt is cancelled.
+   **/
+  WriteResult write_hedged(
+    Entry&& entry,
+    Entry&& hedge_entry,
+    RequestPtr&& request,
+    const std::size_t timeout)
+  {
+    using Milliseconds = std::chrono::milliseconds;
+    using Microseconds = std::chrono::microseconds;
+
+    retry_budget_.deposit();
+
+    auto hedge_request = std::make_unique<Request>(*request);
+    auto& task_processor = userver::engine::current_task::GetTaskProcessor();
+    const auto start = std::chrono::steady_clock::now();
+
+    auto task = userver::engine::AsyncNoSpan(
+      task_processor,
+      [this,
+       entry = std::move(entry),
+       request = std::move(request),
+       timeout] () mutable {
+        return write(entry, std::move(request), timeout);
+      });
+
+    const Microseconds delay = hedging_config_.delay ?
+      Microseconds(Milliseconds(*hedging_config_.delay)) :
+      Microseconds(latency_window_.delay_us());
+    if (delay >= Milliseconds(timeout))
+    {
+      return task.Get();
+    }
+
+    task.WaitFor(delay);
+    if (task.IsFinished())
+    {
+      return task.Get();
+    }
+
+    if (!retry_budget_.try_acquire())
+    {
+      number_budget_exhausted_.fetch_add(1, std::memory_order_relaxed);
+      return task.Get();
+    }
+    number_hedged_.fetch_add(1, std::memory_order_relaxed);
+
+    const auto elapsed = std::chrono::duration_cast<Milliseconds>(
+      std::chrono::steady_clock::now() - start).count();
+    const std::size_t remain_timeout =
+      timeout > static_cast<std::size_t>(elapsed) ?
+        timeout - static_cast<std::size_t>(elapsed) : 1;
+    auto hedge_task = userver::engine::AsyncNoSpan(
+      task_processor,
+      [this,
+       entry = std::move(hedge_entry),
+       request = std::move(hedge_request),
+       remain_timeout] () mutable {
+        return write(entry, std::move(request), remain_timeout);
+      });
+
+    const auto index = userver::engine::WaitAny(task, hedge_task);
+    if (!index)
+    {
+      return WriteResult(Status::InternalError, {});
+    }
+
+    auto& first_task = *index == 0 ? task : hedge_task;
+    auto& second_task = *index == 0 ? hedge_task : task;
+    auto result = first_task.Get();
+    if (result.status == Status::Ok)
+    {
+      second_task.RequestCancel();
+      if (*index == 1)
+      {
+        number_hedge_won_.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      return result;
+    }
+
+    auto second_result = second_task.Get();
+    if (second_result.status == Status::Ok)
+    {
+      if (*index == 0)
+      {
+        number_hedge_won_.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      return second_result;
+    }
+
+    return result;
+  }
+
+  Index select(
+    const Entries& entries,
+    const std::uint64_t number) const noexcept
+  {
+    const auto size = entries.size();
+    switch (balancing_policy_)
+    {
+      case BalancingPolicy::LeastOutstanding:
+      {
+        // Start from a rotating position so that ties are spread evenly.
+        Index best = number % size;
+        auto best_load = entries[best].load->load(balancing_policy_);
+        for (Index i = 1; i < size && best_load != 0; ++i)
+        {
+          const Index index = (number + i) % size;
+          const auto load = entries[index].load->load(balancing_policy_);
+          if (load < best_load)
+          {
+            best = index;
+            best_load = load;
+          }
+        }
+
+        return best;
+      }
+      case BalancingPolicy::PowerOfTwoChoices:
+      case BalancingPolicy::EwmaLatency:
+      {
+        if (size == 1)
+        {
+          return 0;
+        }
+
+        const auto random = mix_counter(number);
+        const Index first = random % size;
+        Index second = (random >> 32) % (size - 1);
+        if (second >= first)
+        {
+          second += 1;
+        }
+
+        return entries[first].load->load(balancing_policy_)
+          <= entries[second].load->load(balancing_policy_) ? first : second;
+      }
+      case BalancingPolicy::RoundRobin:
+      {
+        break;
+      }
+    }
+
+    return number % size;
+  }
+
 private:
   const Logger_var logger_;
 
-  IdToIndex id_to_index_;
+  const BalancingPolicy balancing_policy_;
 
-  Clients clients_;
+  const HedgingConfig hedging_config_;
 
-  mutable Mutex mutex_;
+  RetryBudget retry_budget_;
+
+  LatencyWindow latency_window_;
+
+  SnapshotVariable snapshot_;
 
   Counter counter_{0};
+
+  Counter number_hedged_{0};
+
+  Counter number_hedge_won_{0};
+
+  Counter number_budget_exhausted_{0};
 };
 
 } // namespace Internal
@@ -290,6 +571,7 @@ public:
   using Logger = Logging::Logger;
   using Logger_var = Logging::Logger_var;
   using WriteResult = typename Impl::WriteResult;
+  using ClientsStats = typename Impl::ClientsStats;
 
   DECLARE_EXCEPTION(Exception, eh::DescriptiveException);
 
@@ -301,7 +583,9 @@ public:
     const SchedulerPtr& scheduler,
     const Channels& channels,
     const std::size_t number_async_client,
-    TaskProcessor& task_processor)
+    TaskProcessor& task_processor,
+    const BalancingPolicy balancing_policy = BalancingPolicy::RoundRobin,
+    const HedgingConfig& hedging_config = {})
   {
     ClientPoolCoroPtr pool(
       new ClientPoolCoro(
@@ -309,7 +593,9 @@ public:
         scheduler,
         channels,
         number_async_client,
-        task_processor));
+        task_processor,
+        balancing_policy,
+        hedging_config));
     pool->initialize();
 
     return pool;
@@ -319,14 +605,18 @@ public:
     Logger* logger,
     const SchedulerPtr& scheduler,
     const Channels& channels,
-    const std::size_t number_async_client)
+    const std::size_t number_async_client,
+    const BalancingPolicy balancing_policy = BalancingPolicy::RoundRobin,
+    const HedgingConfig& hedging_config = {})
   {
     ClientPoolCoroPtr pool(
       new ClientPoolCoro(
         logger,
         scheduler,
         channels,
-        number_async_client));
+        number_async_client,
+        balancing_policy,
+        hedging_config));
     pool->initialize();
 
     return pool;
@@ -386,6 +676,27 @@ public:
     return WriteResult(Status::InternalError, {});
   }
 
+  /**
+   * In-flight calls, number of requests/errors and
+   * ewma latency of every client of the pool.
+   **/
+  ClientsStats stats() const
+  {
+    return UServerUtils::Utils::run_in_coro(
+      task_processor_,
+      UServerUtils::Utils::Importance::kNormal,
+      {},
+      [this] () {
+        return impl_->stats();
+      }
+    );
+  }
+
+  HedgingStats hedging_stats() const noexcept
+  {
+    return impl_->hedging_stats();
+  }
+
   bool ok(const std::optional<std::size_t> max_number_check_channels = {}) const noexcept
   {
     const std::size_t count = channels_.size();
@@ -417,11 +728,15 @@ private:
     const SchedulerPtr& scheduler,
     const Channels& channels,
     const std::size_t number_async_client,
-    TaskProcessor& task_processor)
+    TaskProcessor& task_processor,
+    const BalancingPolicy balancing_policy,
+    const HedgingConfig& hedging_config)
     : logger_(ReferenceCounting::add_ref(logger)),
       scheduler_(scheduler),
       channels_(channels),
       number_async_client_(number_async_client),
+      balancing_policy_(balancing_policy),
+      hedging_config_(hedging_config),
       task_processor_(task_processor)
   {
     if (channels.empty())
@@ -437,11 +752,15 @@ private:
     Logger* logger,
     const SchedulerPtr& scheduler,
     const Channels& channels,
-    const std::size_t number_async_client)
+    const std::size_t number_async_client,
+    const BalancingPolicy balancing_policy,
+    const HedgingConfig& hedging_config)
     : logger_(ReferenceCounting::add_ref(logger)),
       scheduler_(scheduler),
       channels_(channels),
-      number_async_client_(number_async_client)
+      number_async_client_(number_async_client),
+      balancing_policy_(balancing_policy),
+      hedging_config_(hedging_config)
   {
     if (channels.empty())
     {
@@ -591,7 +910,10 @@ private:
           scheduler,
           channels,
           std::move(factory_observer));
-        impl = std::make_unique<Impl>(logger);
+        impl = std::make_unique<Impl>(
+          logger,
+          ptr->balancing_policy_,
+          ptr->hedging_config_);
 
         const auto number_thread = factory->number_thread();
         if (number_thread == 0)
@@ -624,6 +946,10 @@ private:
 
   const std::size_t number_async_client_;
 
+  const BalancingPolicy balancing_policy_;
+
+  const HedgingConfig hedging_config_;
+
   TaskProcessorRef task_processor_;
 
   ImplPtr impl_;
@@ -8,6 +8,9 @@
 // GRPCPP
 #include <grpcpp/security/credentials.h>
 
+// THIS
+#include <UServerUtils/Grpc/Common/WriteCoalescing.hpp>
+
 namespace UServerUtils::Grpc::Client
 {
 
@@ -35,6 +38,16 @@ struct Config final
   // If number of channels is not set, then
   // it is equal to the number of threads.
   std::optional<std::size_t> number_channels = {};
+
+  // Responses are parsed into a google::protobuf::Arena recycled
+  // per stream message. Observer must not keep the response
+  // after on_read (moving it out copies the message).
+  bool is_arena_enabled = false;
+
+  std::size_t arena_initial_block_size = 8 * 1024;
+
+  // Batching of stream requests (CLIENT_STREAMING, BIDI_STREAMING).
+  UServerUtils::Grpc::Common::WriteCoalescingConfig write_coalescing;
 };
 
 } // namespace UServerUtils::Grpc::Client
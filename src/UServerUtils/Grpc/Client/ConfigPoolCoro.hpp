@@ -9,6 +9,10 @@
 // GRPCPP
 #include <grpcpp/security/credentials.h>
 
+// THIS
+#include <UServerUtils/Grpc/Client/BalancingPolicy.hpp>
+#include <UServerUtils/Grpc/Client/Hedging.hpp>
+
 namespace UServerUtils::Grpc::Client
 {
 
@@ -39,6 +43,12 @@ struct ConfigPoolCoro final
   // Desired number of async clients. Result number of async clients
   // is rounded up to a multiple of the number of threads.
   std::size_t number_async_client = 100;
+
+  // How ClientPoolCoro chooses async client for a request.
+  BalancingPolicy balancing_policy = BalancingPolicy::RoundRobin;
+
+  // Send second attempt to another client if the first is slow.
+  HedgingConfig hedging;
 };
 
 } // namespace UServerUtils::Grpc::Client
@@ -10,6 +10,7 @@
 
 // THIS
 #include <UServerUtils/Grpc/Common/Event.hpp>
+#include <UServerUtils/Grpc/Common/EventPool.hpp>
 #include <UServerUtils/Grpc/Client/EventObserver.hpp>
 #include <UServerUtils/Grpc/Client/PendingQueue.hpp>
 
@@ -54,7 +55,7 @@ private:
   bool is_pending_ = false;
 };
 
-class EventStart final : public Common::Event
+class EventStart final : public Common::PooledEvent
 {
 public:
   using EventObserverPtr = std::weak_ptr<EventObserver>;
@@ -89,7 +90,7 @@ private:
   const EventObserverPtr observer_;
 };
 
-class EventQueue final : public Common::Event
+class EventQueue final : public Common::PooledEvent
 {
 public:
   using ObserverPtr = std::weak_ptr<EventQueueObserver>;
@@ -127,7 +128,7 @@ private:
   PendingQueueData data_;
 };
 
-class EventStop final : public Common::Event
+class EventStop final : public Common::PooledEvent
 {
 public:
   using ObserverPtr = std::weak_ptr<EventObserver>;
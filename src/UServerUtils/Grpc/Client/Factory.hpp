@@ -158,7 +158,10 @@ public:
     Logger* logger,
     FactoryObserver&& factory_observer = {})
     : logger_(ReferenceCounting::add_ref(logger)),
-      factory_observer_(std::move(factory_observer))
+      factory_observer_(std::move(factory_observer)),
+      arena_initial_block_size_(
+        config.is_arena_enabled ? config.arena_initial_block_size : 0),
+      write_coalescing_(config.write_coalescing)
   {
     scheduler_ = UServerUtils::Grpc::Common::Utils::create_scheduler(
       config.number_threads,
@@ -320,7 +323,9 @@ public:
       channel_data.completion_queue,
       observer,
       *this,
-      std::move(request));
+      std::move(request),
+      arena_initial_block_size_,
+      write_coalescing_);
 
     if constexpr (k_rpc_type == grpc::internal::RpcMethod::CLIENT_STREAMING
       || k_rpc_type == grpc::internal::RpcMethod::BIDI_STREAMING)
@@ -411,6 +416,13 @@ private:
 
   FactoryObserver factory_observer_;
 
+  // Zero if arena is disabled. Always disabled for pools:
+  // ClientCoro moves responses out of the read buffer.
+  const std::size_t arena_initial_block_size_ = 0;
+
+  // Disabled for pools.
+  const UServerUtils::Grpc::Common::WriteCoalescingConfig write_coalescing_;
+
   ChannelsData channels_data_;
 
   ChannelIdToIndex channel_id_to_index_;
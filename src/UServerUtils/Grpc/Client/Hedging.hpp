@@ -0,0 +1,172 @@
+#ifndef GRPC_CLIENT_HEDGING_H_
+#define GRPC_CLIENT_HEDGING_H_
+
+// STD
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <optional>
+
+namespace UServerUtils::Grpc::Client
+{
+
+struct HedgingConfig final
+{
+  HedgingConfig() = default;
+
+  ~HedgingConfig() = default;
+
+  bool enabled = false;
+
+  // Delay (in milliseconds) after which the second attempt is sent.
+  // If not set, delay is the percentile of recent latencies.
+  std::optional<std::size_t> delay = {};
+
+  // Used only if delay is not set.
+  double percentile = 0.95;
+
+  // Bounds of the percentile based delay (in microseconds).
+  std::uint64_t min_delay_us = 500;
+  std::uint64_t max_delay_us = 1000000;
+
+  // Token bucket: every request adds tokens_per_request tokens
+  // (up to max_tokens), every hedged attempt takes one token.
+  double tokens_per_request = 0.1;
+  double max_tokens = 100;
+};
+
+struct HedgingStats final
+{
+  std::uint64_t number_hedged = 0;
+  std::uint64_t number_hedge_won = 0;
+  std::uint64_t number_budget_exhausted = 0;
+  std::uint64_t delay_us = 0;
+};
+
+namespace Internal
+{
+
+class RetryBudget final
+{
+private:
+  static constexpr std::int64_t SCALE = 1000;
+
+public:
+  explicit RetryBudget(const HedgingConfig& config) noexcept
+    : deposit_(static_cast<std::int64_t>(config.tokens_per_request * SCALE)),
+      max_tokens_(static_cast<std::int64_t>(config.max_tokens * SCALE)),
+      tokens_(max_tokens_)
+  {
+  }
+
+  void deposit() noexcept
+  {
+    auto tokens = tokens_.load(std::memory_order_relaxed);
+    while (tokens < max_tokens_ && !tokens_.compare_exchange_weak(
+      tokens,
+      std::min(tokens + deposit_, max_tokens_),
+      std::memory_order_relaxed))
+    {
+    }
+  }
+
+  bool try_acquire() noexcept
+  {
+    auto tokens = tokens_.load(std::memory_order_relaxed);
+    while (tokens >= SCALE)
+    {
+      if (tokens_.compare_exchange_weak(
+        tokens,
+        tokens - SCALE,
+        std::memory_order_relaxed))
+      {
+        return true;
+      }
+    }
+
+    return false;
+  }
+
+private:
+  const std::int64_t deposit_;
+
+  const std::int64_t max_tokens_;
+
+  std::atomic<std::int64_t> tokens_;
+};
+
+/**
+ * Last SIZE latencies. The percentile is recomputed by the writer
+ * of every UPDATE_PERIOD-th sample, readers only load a cached value.
+ **/
+class LatencyWindow final
+{
+private:
+  static constexpr std::size_t SIZE = 1024;
+  static constexpr std::size_t UPDATE_PERIOD = 128;
+
+public:
+  explicit LatencyWindow(const HedgingConfig& config) noexcept
+    : percentile_(std::clamp(config.percentile, 0.0, 1.0)),
+      min_delay_us_(config.min_delay_us),
+      max_delay_us_(std::max(config.min_delay_us, config.max_delay_us)),
+      delay_us_(config.max_delay_us)
+  {
+  }
+
+  void add(const std::uint64_t latency_us) noexcept
+  {
+    const auto number = counter_.fetch_add(1, std::memory_order_relaxed);
+    samples_[number % SIZE].store(latency_us, std::memory_order_relaxed);
+    if ((number + 1) % UPDATE_PERIOD == 0)
+    {
+      update(std::min<std::uint64_t>(number + 1, SIZE));
+    }
+  }
+
+  std::uint64_t delay_us() const noexcept
+  {
+    return delay_us_.load(std::memory_order_relaxed);
+  }
+
+private:
+  void update(const std::size_t size) noexcept
+  {
+    std::array<std::uint64_t, SIZE> samples;
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      samples[i] = samples_[i].load(std::memory_order_relaxed);
+    }
+
+    const std::size_t index = std::min(
+      size - 1,
+      static_cast<std::size_t>(percentile_ * size));
+    std::nth_element(
+      samples.begin(),
+      samples.begin() + index,
+      samples.begin() + size);
+    delay_us_.store(
+      std::clamp(samples[index], min_delay_us_, max_delay_us_),
+      std::memory_order_relaxed);
+  }
+
+private:
+  const double percentile_;
+
+  const std::uint64_t min_delay_us_;
+
+  const std::uint64_t max_delay_us_;
+
+  std::array<std::atomic<std::uint64_t>, SIZE> samples_{};
+
+  std::atomic<std::uint64_t> counter_{0};
+
+  std::atomic<std::uint64_t> delay_us_;
+};
+
+} // namespace Internal
+
+} // namespace UServerUtils::Grpc::Client
+
+#endif // GRPC_CLIENT_HEDGING_H_
@@ -69,7 +69,9 @@ public:
       scheduler_,
       channels_,
       number_client_,
-      task_processor);
+      task_processor,
+      balancing_policy_,
+      hedging_config_);
   }
 
   template<class ClientPool>
@@ -94,7 +96,9 @@ public:
       scheduler_,
       channels_,
       number_client_,
-      current_task_processor);
+      current_task_processor,
+      balancing_policy_,
+      hedging_config_);
   }
 
 private:
@@ -116,6 +120,9 @@ private:
       number_client_ += 1;
     }
     number_client_ *= number_thread;
+
+    balancing_policy_ = config_pool.balancing_policy;
+    hedging_config_ = config_pool.hedging;
   }
 
 private:
@@ -126,6 +133,10 @@ private:
   Channels channels_;
 
   std::size_t number_client_ = 0;
+
+  BalancingPolicy balancing_policy_ = BalancingPolicy::RoundRobin;
+
+  HedgingConfig hedging_config_;
 };
 
 } // namespace UServerUtils
@@ -0,0 +1,402 @@
+#ifndef GRPC_COMMON_EVENT_POOL_H_
+#define GRPC_COMMON_EVENT_POOL_H_
+
+// STD
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <unordered_set>
+#include <vector>
+
+// THIS
+#include <Generics/Uncopyable.hpp>
+#include <UServerUtils/Grpc/Common/Event.hpp>
+
+namespace UServerUtils::Grpc::Common
+{
+
+struct EventPoolStats final
+{
+  // Allocations served from a free list.
+  std::uint64_t number_hits = 0;
+  // Allocations served by operator new.
+  std::uint64_t number_misses = 0;
+  // Allocated and not yet deallocated events.
+  std::int64_t number_outstanding = 0;
+  // Free blocks kept in the shared depot.
+  std::uint64_t number_cached = 0;
+
+  double hit_rate() const noexcept
+  {
+    const auto total = number_hits + number_misses;
+    return total == 0 ? 0 : static_cast<double>(number_hits) / total;
+  }
+};
+
+/**
+ * Free lists of fixed size blocks for one-shot completion queue events
+ * (EventQueue, EventStart, EventStop).
+ *
+ * Events are usually created by writer threads and deleted by
+ * the completion queue threads of Scheduler, so every thread has
+ * its own free list and surplus blocks travel between threads
+ * in batches of BATCH_SIZE through a mutex protected depot.
+ * Every pooled block has BLOCK_SIZE bytes whatever thread
+ * allocated it, so it can be cached by any thread.
+ **/
+class EventPool final : private Generics::Uncopyable
+{
+public:
+  static constexpr std::size_t BLOCK_SIZE = 256;
+  static constexpr std::size_t BATCH_SIZE = 64;
+  static constexpr std::size_t MAX_THREAD_CACHE_SIZE = 2 * BATCH_SIZE;
+  static constexpr std::size_t MAX_DEPOT_BATCHES = 256;
+
+public:
+  static void* allocate(const std::size_t size)
+  {
+    ThreadCache& cache = thread_cache();
+    if (cache.is_closed)
+    {
+      depot().count_unpooled_allocation();
+      return ::operator new(size > BLOCK_SIZE ? size : BLOCK_SIZE);
+    }
+
+    if (size > BLOCK_SIZE)
+    {
+      increment(cache.number_misses);
+      increment(cache.number_allocated);
+      return ::operator new(size);
+    }
+
+    return cache.allocate();
+  }
+
+  static void deallocate(
+    void* ptr,
+    const std::size_t size) noexcept
+  {
+    if (!ptr)
+    {
+      return;
+    }
+
+    ThreadCache& cache = thread_cache();
+    if (cache.is_closed)
+    {
+      depot().count_unpooled_deallocation();
+      ::operator delete(ptr);
+      return;
+    }
+
+    if (size > BLOCK_SIZE)
+    {
+      increment(cache.number_deallocated);
+      ::operator delete(ptr);
+      return;
+    }
+
+    cache.deallocate(ptr);
+  }
+
+  static EventPoolStats stats() noexcept
+  {
+    return depot().stats();
+  }
+
+private:
+  struct Node final
+  {
+    Node* next = nullptr;
+  };
+
+  struct ThreadCache;
+
+  class Depot final : private Generics::Uncopyable
+  {
+  public:
+    Node* pop() noexcept
+    {
+      std::lock_guard lock(mutex_);
+      if (batches_.empty())
+      {
+        return nullptr;
+      }
+
+      Node* batch = batches_.back();
+      batches_.pop_back();
+      return batch;
+    }
+
+    bool push(Node* batch) noexcept
+    {
+      std::lock_guard lock(mutex_);
+      if (batches_.size() >= MAX_DEPOT_BATCHES)
+      {
+        return false;
+      }
+
+      try
+      {
+        batches_.emplace_back(batch);
+        return true;
+      }
+      catch (...)
+      {
+        return false;
+      }
+    }
+
+    void add(ThreadCache* cache)
+    {
+      std::lock_guard lock(mutex_);
+      caches_.emplace(cache);
+    }
+
+    void remove(ThreadCache* cache) noexcept
+    {
+      std::lock_guard lock(mutex_);
+      caches_.erase(cache);
+      number_hits_ += cache->number_hits.load(std::memory_order_relaxed);
+      number_misses_ += cache->number_misses.load(std::memory_order_relaxed);
+      number_allocated_ += cache->number_allocated.load(std::memory_order_relaxed);
+      number_deallocated_ += cache->number_deallocated.load(std::memory_order_relaxed);
+    }
+
+    void count_unpooled_allocation() noexcept
+    {
+      std::lock_guard lock(mutex_);
+      number_misses_ += 1;
+      number_allocated_ += 1;
+    }
+
+    void count_unpooled_deallocation() noexcept
+    {
+      std::lock_guard lock(mutex_);
+      number_deallocated_ += 1;
+    }
+
+    EventPoolStats stats() noexcept
+    {
+      std::lock_guard lock(mutex_);
+      std::uint64_t number_hits = number_hits_;
+      std::uint64_t number_misses = number_misses_;
+      std::uint64_t number_allocated = number_allocated_;
+      std::uint64_t number_deallocated = number_deallocated_;
+      for (const auto* cache : caches_)
+      {
+        number_hits += cache->number_hits.load(std::memory_order_relaxed);
+        number_misses += cache->number_misses.load(std::memory_order_relaxed);
+        number_allocated += cache->number_allocated.load(std::memory_order_relaxed);
+        number_deallocated += cache->number_deallocated.load(std::memory_order_relaxed);
+      }
+
+      EventPoolStats stats;
+      stats.number_hits = number_hits;
+      stats.number_misses = number_misses;
+      stats.number_outstanding =
+        static_cast<std::int64_t>(number_allocated - number_deallocated);
+      stats.number_cached = batches_.size() * BATCH_SIZE;
+      return stats;
+    }
+
+  private:
+    std::mutex mutex_;
+
+    std::vector<Node*> batches_;
+
+    std::unordered_set<ThreadCache*> caches_;
+
+    std::uint64_t number_hits_ = 0;
+
+    std::uint64_t number_misses_ = 0;
+
+    std::uint64_t number_allocated_ = 0;
+
+    std::uint64_t number_deallocated_ = 0;
+  };
+
+  /**
+   * Free list of a thread. Constant initialized and trivially
+   * destructible to stay accessible from destructors of other
+   * thread local objects, which may delete events on thread exit:
+   * the list is freed and the cache is closed by Cleaner, after that
+   * blocks of the thread go directly to operator new/delete.
+   *
+   * Counters are atomics only to be read by stats(),
+   * they are written by the owning thread alone.
+   **/
+  struct ThreadCache final
+  {
+    struct Cleaner final
+    {
+      ~Cleaner();
+    };
+
+    void* allocate()
+    {
+      increment(number_allocated);
+      if (!head)
+      {
+        head = depot().pop();
+        size = head ? BATCH_SIZE : 0;
+      }
+
+      if (head)
+      {
+        Node* node = head;
+        head = head->next;
+        size -= 1;
+        increment(number_hits);
+        return node;
+      }
+
+      increment(number_misses);
+      return ::operator new(BLOCK_SIZE);
+    }
+
+    void deallocate(void* ptr) noexcept
+    {
+      increment(number_deallocated);
+
+      Node* node = ::new (ptr) Node;
+      node->next = head;
+      head = node;
+      size += 1;
+
+      if (size < MAX_THREAD_CACHE_SIZE)
+      {
+        return;
+      }
+
+      Node* batch = head;
+      Node* last = head;
+      for (std::size_t i = 1; i < BATCH_SIZE; ++i)
+      {
+        last = last->next;
+      }
+      head = last->next;
+      last->next = nullptr;
+      size -= BATCH_SIZE;
+
+      if (!depot().push(batch))
+      {
+        delete_list(batch);
+      }
+    }
+
+    static void delete_list(Node* list) noexcept
+    {
+      while (list)
+      {
+        Node* next = list->next;
+        ::operator delete(list);
+        list = next;
+      }
+    }
+
+    Node* head = nullptr;
+
+    std::size_t size = 0;
+
+    bool is_registered = false;
+
+    bool is_closed = false;
+
+    std::atomic<std::uint64_t> number_hits{0};
+
+    std::atomic<std::uint64_t> number_misses{0};
+
+    std::atomic<std::uint64_t> number_allocated{0};
+
+    std::atomic<std::uint64_t> number_deallocated{0};
+  };
+
+  static_assert(std::is_trivially_destructible_v<ThreadCache>);
+
+private:
+  // Never destroyed: thread caches may outlive static objects.
+  static Depot& depot() noexcept
+  {
+    static Depot* depot = new Depot;
+    return *depot;
+  }
+
+  static ThreadCache& local_thread_cache() noexcept
+  {
+    thread_local ThreadCache cache;
+    return cache;
+  }
+
+  static ThreadCache& thread_cache() noexcept
+  {
+    ThreadCache& cache = local_thread_cache();
+    if (!cache.is_registered)
+    {
+      // Makes the thread construct Cleaner
+      thread_local ThreadCache::Cleaner cleaner;
+      static_cast<void>(cleaner);
+
+      cache.is_registered = true;
+      try
+      {
+        depot().add(&cache);
+      }
+      catch (...)
+      {
+        // Counters of this thread are reported on its exit only.
+      }
+    }
+
+    return cache;
+  }
+
+  // Single writer: plain load and store instead of read-modify-write.
+  static void increment(std::atomic<std::uint64_t>& counter) noexcept
+  {
+    counter.store(
+      counter.load(std::memory_order_relaxed) + 1,
+      std::memory_order_relaxed);
+  }
+};
+
+inline EventPool::ThreadCache::Cleaner::~Cleaner()
+{
+  ThreadCache& cache = local_thread_cache();
+  ThreadCache::delete_list(cache.head);
+  cache.head = nullptr;
+  cache.size = 0;
+  cache.is_closed = true;
+  depot().remove(&cache);
+}
+
+/**
+ * Base of events allocated for a single completion.
+ * Object must be deleted by the same static type (events do "delete this").
+ **/
+class PooledEvent : public Event
+{
+public:
+  static void* operator new(const std::size_t size)
+  {
+    return EventPool::allocate(size);
+  }
+
+  static void operator delete(
+    void* ptr,
+    const std::size_t size) noexcept
+  {
+    EventPool::deallocate(ptr, size);
+  }
+
+protected:
+  PooledEvent() = default;
+
+  ~PooledEvent() override = default;
+};
+
+} // namespace UServerUtils::Grpc::Common
+
+#endif // GRPC_COMMON_EVENT_POOL_H_
@@ -0,0 +1,89 @@
+#ifndef GRPC_COMMON_MESSAGE_ARENA_H_
+#define GRPC_COMMON_MESSAGE_ARENA_H_
+
+// PROTOBUF
+#include <google/protobuf/arena.h>
+#include <google/protobuf/message.h>
+
+// STD
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+
+// THIS
+#include <Generics/Uncopyable.hpp>
+
+namespace UServerUtils::Grpc::Common
+{
+
+/**
+ * Arena holding one message at a time. recycle() destroys the message
+ * and creates a new one; the initial block is owned by MessageArena
+ * and survives Arena::Reset(), so messages fitting into it are parsed
+ * without a single malloc.
+ **/
+class MessageArena final : private Generics::Uncopyable
+{
+public:
+  using Message = google::protobuf::Message;
+  using Arena = google::protobuf::Arena;
+
+public:
+  explicit MessageArena(
+    const Message& prototype,
+    const std::size_t initial_block_size)
+    : prototype_(prototype),
+      initial_block_(std::make_unique<char[]>(initial_block_size)),
+      arena_(create_options(initial_block_.get(), initial_block_size))
+  {
+    message_ = prototype_.New(&arena_);
+  }
+
+  ~MessageArena() = default;
+
+  Message* message() const noexcept
+  {
+    return message_;
+  }
+
+  void recycle()
+  {
+    message_ = nullptr;
+    arena_.Reset();
+    message_ = prototype_.New(&arena_);
+  }
+
+  std::uint64_t space_allocated() const noexcept
+  {
+    return arena_.SpaceAllocated();
+  }
+
+private:
+  static google::protobuf::ArenaOptions create_options(
+    char* initial_block,
+    const std::size_t initial_block_size) noexcept
+  {
+    google::protobuf::ArenaOptions options;
+    options.initial_block = initial_block;
+    options.initial_block_size = initial_block_size;
+    options.start_block_size = std::max(
+      initial_block_size,
+      options.start_block_size);
+    return options;
+  }
+
+private:
+  const Message& prototype_;
+
+  std::unique_ptr<char[]> initial_block_;
+
+  Arena arena_;
+
+  Message* message_ = nullptr;
+};
+
+using MessageArenaPtr = std::unique_ptr<MessageArena>;
+
+} // namespace UServerUtils::Grpc::Common
+
+#endif // GRPC_COMMON_MESSAGE_ARENA_H_
@@ -0,0 +1,304 @@
+#ifndef GRPC_COMMON_QUEUE_MPMC_H_
+#define GRPC_COMMON_QUEUE_MPMC_H_
+
+// STD
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+
+// THIS
+#include <Generics/Uncopyable.hpp>
+
+namespace UServerUtils::Grpc::Common
+{
+
+/**
+ * Bounded multi producer multi consumer queue (D. Vyukov).
+ * Elements are stored inline in a ring of power of two size,
+ * every cell has a sequence number telling whether it may be
+ * written (sequence == position) or read (sequence == position + 1).
+ *
+ * Capacity is exact: emplace fails if capacity() elements are in the
+ * queue (the ring itself is rounded up to a power of two).
+ * Neither emplace nor pop allocate memory.
+ **/
+template<class T>
+class QueueMpmc final : protected Generics::Uncopyable
+{
+private:
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+  struct Cell final
+  {
+    std::atomic<std::size_t> sequence;
+    alignas(T) unsigned char storage[sizeof(T)];
+
+    T* data() noexcept
+    {
+      return std::launder(reinterpret_cast<T*>(storage));
+    }
+  };
+
+public:
+  explicit QueueMpmc(const std::size_t capacity = 1024)
+    : capacity_(std::max<std::size_t>(capacity, 1)),
+      mask_(round_capacity(capacity_) - 1),
+      cells_(std::make_unique<Cell[]>(mask_ + 1))
+  {
+    for (std::size_t i = 0; i <= mask_; ++i)
+    {
+      cells_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+  }
+
+  ~QueueMpmc()
+  {
+    while (pop())
+    {
+    }
+  }
+
+  /**
+   * Add an element to the queue.
+   * If return false - queue is full. Args are left untouched if T is
+   * nothrow constructible from them, otherwise T is constructed before
+   * a cell is reserved (a cell must never stay reserved on exception).
+   **/
+  template<class... Args>
+  bool emplace(Args&&... args)
+  {
+    static_assert(
+      std::is_nothrow_move_constructible_v<T>,
+      "T must be nothrow move constructible");
+
+    if constexpr (std::is_nothrow_constructible_v<T, Args&&...>)
+    {
+      Cell* cell = nullptr;
+      std::size_t position = 0;
+      if (!reserve(cell, position))
+      {
+        return false;
+      }
+
+      ::new (static_cast<void*>(cell->storage)) T(std::forward<Args>(args)...);
+      cell->sequence.store(position + 1, std::memory_order_release);
+    }
+    else
+    {
+      T data(std::forward<Args>(args)...);
+
+      Cell* cell = nullptr;
+      std::size_t position = 0;
+      if (!reserve(cell, position))
+      {
+        return false;
+      }
+
+      ::new (static_cast<void*>(cell->storage)) T(std::move(data));
+      cell->sequence.store(position + 1, std::memory_order_release);
+    }
+
+    return true;
+  }
+
+  std::optional<T> pop() noexcept
+  {
+    Cell* cell = nullptr;
+    std::size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    while (true)
+    {
+      cell = &cells_[position & mask_];
+      const std::size_t sequence =
+        cell->sequence.load(std::memory_order_acquire);
+      const auto difference =
+        static_cast<std::intptr_t>(sequence) -
+        static_cast<std::intptr_t>(position + 1);
+      if (difference == 0)
+      {
+        if (dequeue_position_.compare_exchange_weak(
+          position,
+          position + 1,
+          std::memory_order_relaxed))
+        {
+          break;
+        }
+      }
+      else if (difference < 0)
+      {
+        return std::nullopt;
+      }
+      else
+      {
+        position = dequeue_position_.load(std::memory_order_relaxed);
+      }
+    }
+
+    std::optional<T> result(std::move(*cell->data()));
+    cell->data()->~T();
+    cell->sequence.store(position + mask_ + 1, std::memory_order_release);
+
+    return result;
+  }
+
+  /**
+   * Pops up to max_size elements (in queue order) and passes them
+   * to function(T&&). Consumers claim the whole range with one CAS.
+   * If function throws, the element is dropped.
+   **/
+  template<class Function>
+  std::size_t pop_batch(
+    Function&& function,
+    const std::size_t max_size) noexcept
+  {
+    std::size_t position = dequeue_position_.load(std::memory_order_relaxed);
+    std::size_t size = 0;
+    while (true)
+    {
+      size = 0;
+      while (size < max_size)
+      {
+        const Cell& cell = cells_[(position + size) & mask_];
+        if (cell.sequence.load(std::memory_order_acquire) !=
+            position + size + 1)
+        {
+          break;
+        }
+        size += 1;
+      }
+
+      if (size == 0)
+      {
+        const Cell& cell = cells_[position & mask_];
+        const auto difference =
+          static_cast<std::intptr_t>(
+            cell.sequence.load(std::memory_order_acquire)) -
+          static_cast<std::intptr_t>(position + 1);
+        if (difference < 0)
+        {
+          return 0;
+        }
+
+        position = dequeue_position_.load(std::memory_order_relaxed);
+        continue;
+      }
+
+      if (dequeue_position_.compare_exchange_weak(
+        position,
+        position + size,
+        std::memory_order_relaxed))
+      {
+        break;
+      }
+    }
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+      Cell& cell = cells_[(position + i) & mask_];
+      try
+      {
+        function(std::move(*cell.data()));
+      }
+      catch (...)
+      {
+      }
+      cell.data()->~T();
+      cell.sequence.store(position + i + mask_ + 1, std::memory_order_release);
+    }
+
+    return size;
+  }
+
+  // Approximate if there are concurrent operations.
+  std::size_t size() const noexcept
+  {
+    const std::size_t enqueue_position =
+      enqueue_position_.load(std::memory_order_relaxed);
+    const std::size_t dequeue_position =
+      dequeue_position_.load(std::memory_order_relaxed);
+    return enqueue_position >= dequeue_position ?
+      enqueue_position - dequeue_position : 0;
+  }
+
+  bool empty() const noexcept
+  {
+    return size() == 0;
+  }
+
+  std::size_t capacity() const noexcept
+  {
+    return capacity_;
+  }
+
+private:
+  bool reserve(
+    Cell*& cell,
+    std::size_t& position) noexcept
+  {
+    position = enqueue_position_.load(std::memory_order_relaxed);
+    while (true)
+    {
+      cell = &cells_[position & mask_];
+      const std::size_t sequence =
+        cell->sequence.load(std::memory_order_acquire);
+      const auto difference =
+        static_cast<std::intptr_t>(sequence) -
+        static_cast<std::intptr_t>(position);
+      if (difference == 0)
+      {
+        // Ring is larger than capacity: check the distance to consumers.
+        if (capacity_ <= mask_ &&
+            position - dequeue_position_.load(std::memory_order_acquire) >=
+              capacity_)
+        {
+          return false;
+        }
+
+        if (enqueue_position_.compare_exchange_weak(
+          position,
+          position + 1,
+          std::memory_order_relaxed))
+        {
+          return true;
+        }
+      }
+      else if (difference < 0)
+      {
+        return false;
+      }
+      else
+      {
+        position = enqueue_position_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  static std::size_t round_capacity(const std::size_t capacity) noexcept
+  {
+    std::size_t result = 2;
+    while (result < capacity)
+    {
+      result <<= 1;
+    }
+
+    return result;
+  }
+
+private:
+  const std::size_t capacity_;
+
+  const std::size_t mask_;
+
+  const std::unique_ptr<Cell[]> cells_;
+
+  alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_position_{0};
+
+  alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeue_position_{0};
+};
+
+} // namespace UServerUtils::Grpc::Common
+
+#endif // GRPC_COMMON_QUEUE_MPMC_H_
@@ -82,9 +82,15 @@ Scheduler::~Scheduler()
 
     threads_.clear();
 
-    logger_->info(
-      String::SubString("Scheduler is succesfully stopped"),
-      Aspect::SCHEDULER);
+    const auto stats = event_pool_stats();
+    std::stringstream stream;
+    stream << "Scheduler is succesfully stopped. Event pool: hit rate = "
+           << stats.hit_rate()
+           << ", outstanding = "
+           << stats.number_outstanding
+           << ", cached = "
+           << stats.number_cached;
+    logger_->info(stream.str(), Aspect::SCHEDULER);
   }
   catch (const eh::Exception& exc)
   {
@@ -112,4 +118,9 @@ Scheduler::queues() noexcept
   return queues_;
 }
 
+EventPoolStats Scheduler::event_pool_stats() const noexcept
+{
+  return EventPool::stats();
+}
+
 } // UServerUtils::Grpc::Common
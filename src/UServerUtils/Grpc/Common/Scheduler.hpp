@@ -12,6 +12,7 @@
 // THIS
 #include <eh/Exception.hpp>
 #include <Logger/Logger.hpp>
+#include <UServerUtils/Grpc/Common/EventPool.hpp>
 #include <UServerUtils/Grpc/Common/ThreadGuard.hpp>
 
 namespace UServerUtils::Grpc::Common
@@ -38,6 +39,9 @@ public:
 
   const Queues& queues() noexcept;
 
+  // Pool of one-shot events released by the completion queue threads.
+  EventPoolStats event_pool_stats() const noexcept;
+
 private:
   Logger_var logger_;
 
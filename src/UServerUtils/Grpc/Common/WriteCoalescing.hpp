@@ -0,0 +1,164 @@
+#ifndef GRPC_COMMON_WRITE_COALESCING_H_
+#define GRPC_COMMON_WRITE_COALESCING_H_
+
+// STD
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+// GRPC
+#include <grpcpp/grpcpp.h>
+
+// PROTOBUF
+#include <google/protobuf/message.h>
+
+namespace UServerUtils::Grpc::Common
+{
+
+/**
+ * Stream messages written while more messages of the same stream
+ * are pending get WriteOptions::set_buffer_hint: grpc keeps them
+ * in its buffer and sends the whole batch with the first write
+ * without the hint. A batch is flushed when the pending queue
+ * is empty or a size/time threshold is reached.
+ **/
+struct WriteCoalescingConfig final
+{
+  bool is_enabled = false;
+
+  // Messages in a batch.
+  std::size_t max_batch_size = 64;
+
+  // Serialized bytes in a batch.
+  std::size_t max_batch_bytes = 64 * 1024;
+
+  // Time from the first message of a batch.
+  std::chrono::microseconds max_batch_delay{2000};
+
+  // Writes not yet passed to grpc (0 - unbounded).
+  // write() fails if the limit is reached.
+  std::size_t max_pending_writes = 0;
+};
+
+/**
+ * Writes and flushes of all streams of a server. A stream adds to it
+ * once per flush (once per write if coalescing is disabled).
+ **/
+struct alignas(64) WriteCoalescingCounters final
+{
+  std::atomic<std::uint64_t> number_writes{0};
+  std::atomic<std::uint64_t> number_flushes{0};
+};
+
+using WriteCoalescingCountersPtr = std::shared_ptr<WriteCoalescingCounters>;
+
+struct WriteCoalescingStats final
+{
+  std::uint64_t number_writes = 0;
+  std::uint64_t number_flushes = 0;
+};
+
+/**
+ * Current batch of a stream. Used by the completion queue thread only.
+ **/
+class WriteBatch final
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+public:
+  explicit WriteBatch(
+    const WriteCoalescingConfig& config,
+    const WriteCoalescingCountersPtr& counters = {}) noexcept
+    : config_(config),
+      counters_(counters)
+  {
+  }
+
+  ~WriteBatch() = default;
+
+  /**
+   * Options of the next write.
+   * has_more - other messages wait for this write in the pending queue.
+   **/
+  grpc::WriteOptions next(
+    const google::protobuf::Message& message,
+    const bool has_more) noexcept
+  {
+    grpc::WriteOptions options;
+    number_writes_ += 1;
+    if (!config_.is_enabled)
+    {
+      flush(1);
+      return options;
+    }
+
+    const auto now = Clock::now();
+    if (size_ == 0)
+    {
+      start_ = now;
+    }
+
+    size_ += 1;
+    bytes_ += message.ByteSizeLong();
+
+    if (has_more &&
+        size_ < config_.max_batch_size &&
+        bytes_ < config_.max_batch_bytes &&
+        now - start_ < config_.max_batch_delay)
+    {
+      options.set_buffer_hint();
+      return options;
+    }
+
+    flush(size_);
+    size_ = 0;
+    bytes_ = 0;
+    return options;
+  }
+
+  std::uint64_t number_writes() const noexcept
+  {
+    return number_writes_;
+  }
+
+  std::uint64_t number_flushes() const noexcept
+  {
+    return number_flushes_;
+  }
+
+private:
+  void flush(const std::size_t number_writes) noexcept
+  {
+    number_flushes_ += 1;
+    if (counters_)
+    {
+      counters_->number_writes.fetch_add(
+        number_writes,
+        std::memory_order_relaxed);
+      counters_->number_flushes.fetch_add(
+        1,
+        std::memory_order_relaxed);
+    }
+  }
+
+private:
+  const WriteCoalescingConfig config_;
+
+  const WriteCoalescingCountersPtr counters_;
+
+  std::size_t size_ = 0;
+
+  std::size_t bytes_ = 0;
+
+  Clock::time_point start_;
+
+  std::uint64_t number_writes_ = 0;
+
+  std::uint64_t number_flushes_ = 0;
+};
+
+} // namespace UServerUtils::Grpc::Common
+
+#endif // GRPC_COMMON_WRITE_COALESCING_H_
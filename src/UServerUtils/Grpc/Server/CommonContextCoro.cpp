@@ -13,10 +13,16 @@ const char* COMMON_CONTEXT_CORO = "COMMON_CONTEXT_CORO";
 
 CommonContextCoro::CommonContextCoro(
   Logger* logger,
-  const MaxSizeQueue max_size_queue)
+  const MaxSizeQueue max_size_queue,
+  const ConcurrencyLimiterConfigOptional& concurrency_limiter_config)
   : logger_(ReferenceCounting::add_ref(logger)),
     max_size_queue_(max_size_queue)
 {
+  if (concurrency_limiter_config)
+  {
+    concurrency_limiters_ = std::make_shared<ConcurrencyLimiters>(
+      *concurrency_limiter_config);
+  }
 }
 
 CommonContextCoro::~CommonContextCoro()
@@ -15,6 +15,7 @@
 // THIS
 #include <Logger/Logger.hpp>
 #include <UServerUtils/Grpc/Server/CommonContext.hpp>
+#include <UServerUtils/Grpc/Server/ConcurrencyLimiter.hpp>
 #include <UServerUtils/Grpc/Server/DefaultErrorCreator.hpp>
 #include <UServerUtils/Grpc/Server/ServiceCoro.hpp>
 
@@ -63,6 +64,16 @@ public:
   using MethodName = std::string_view;
   using IdRpc = Internal::Types::IdRpc;
   using RpcType = grpc::internal::RpcMethod::RpcType;
+  using ConcurrencyLimiterConfigOptional =
+    std::optional<ConcurrencyLimiterConfig>;
+
+  // Admission of rpc of one method, done once at the rpc start.
+  struct Admission final
+  {
+    // Null if concurrency limiter is disabled.
+    ConcurrencyLimiter* limiter = nullptr;
+    RpcPriority priority = RpcPriority::Normal;
+  };
 
 private:
   struct ServiceInfo final
@@ -71,11 +82,13 @@ private:
       const std::any& service,
       const RpcType rpc_type,
       const ServiceMode service_mode,
-      TaskProcessor& task_processor)
+      TaskProcessor& task_processor,
+      const Admission& admission)
       : service(service),
         rpc_type(rpc_type),
         service_mode(service_mode),
-        task_processor(&task_processor)
+        task_processor(&task_processor),
+        admission(admission)
     {
     }
 
@@ -83,6 +96,7 @@ private:
     const RpcType rpc_type;
     const ServiceMode service_mode;
     TaskProcessor* task_processor;
+    const Admission admission;
   };
 
   using Services = std::unordered_map<MethodName, ServiceInfo>;
@@ -92,13 +106,20 @@ private:
 public:
   explicit CommonContextCoro(
     Logger* logger,
-    const MaxSizeQueue max_size_queue = {});
+    const MaxSizeQueue max_size_queue = {},
+    const ConcurrencyLimiterConfigOptional& concurrency_limiter_config = {});
 
   Logger_var get_logger() noexcept
   {
     return logger_;
   }
 
+  // Null if concurrency limiter is disabled.
+  const ConcurrencyLimitersPtr& concurrency_limiters() const noexcept
+  {
+    return concurrency_limiters_;
+  }
+
   const ServiceInfo& service_info(const MethodName method_name) const
   {
     auto it_service = services_.find(method_name);
@@ -135,7 +156,8 @@ public:
     std::unique_ptr<Writer<Response>>&& writer,
     std::unique_ptr<Request>&& request,
     const IdRpc id_rpc,
-    const RpcType rpc_type)
+    const RpcType rpc_type,
+    ConcurrencyLimiter::Permit&& permit = {})
   {
     using ReaderPtr = ReaderPtr<Request, Response>;
 
@@ -157,7 +179,8 @@ public:
         std::move(reader),
         service,
         rpc_type,
-        is_critical).Detach();
+        is_critical,
+        std::move(permit)).Detach();
     }
     catch (const eh::Exception& exc)
     {
@@ -214,7 +237,8 @@ public:
     ServiceCoro<Request, Response>* service,
     const RpcType rpc_type,
     const ServiceMode service_mode,
-    TaskProcessor& task_processor)
+    TaskProcessor& task_processor,
+    const RpcPriority priority = RpcPriority::Normal)
   {
     if (active())
     {
@@ -234,12 +258,22 @@ public:
       throw Exception(stream);
     }
 
+    Admission admission;
+    admission.priority = priority;
+    if (concurrency_limiters_)
+    {
+      admission.limiter = concurrency_limiters_->get(
+        &task_processor,
+        std::string(method_name));
+    }
+
     ServiceInfo service_info(
       ServiceCoro_var<Request, Response>(
         ReferenceCounting::add_ref(service)),
       rpc_type,
       service_mode,
-      task_processor);
+      task_processor,
+      admission);
     services_.try_emplace(method_name, service_info);
   }
 
@@ -253,13 +287,15 @@ private:
     ReaderPtr<Request, Response>&& reader,
     ServiceCoro<Request, Response>* service,
     const RpcType rpc_type,
-    const bool is_critical)
+    const bool is_critical,
+    ConcurrencyLimiter::Permit&& permit = {})
   {
     auto function = [logger = logger_,
       reader = std::move(reader),
       service = ServiceCoro_var<Request, Response>(
         ReferenceCounting::add_ref(service)),
-      rpc_type] () mutable {
+      rpc_type,
+      permit = std::move(permit)] () mutable {
         while (!reader->is_finish())
         {
           try
@@ -308,6 +344,9 @@ private:
             userver::engine::Yield();
           }
         }
+
+        // Latency sample: from admission to the end of handle.
+        permit.release();
       };
 
     if (is_critical)
@@ -329,6 +368,8 @@ private:
 
   const MaxSizeQueue max_size_queue_;
 
+  ConcurrencyLimitersPtr concurrency_limiters_;
+
   Services services_;
 };
 
@@ -0,0 +1,486 @@
+#ifndef GRPC_SERVER_CONCURRENCY_LIMITER_H_
+#define GRPC_SERVER_CONCURRENCY_LIMITER_H_
+
+// STD
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// THIS
+#include <Generics/Uncopyable.hpp>
+
+namespace UServerUtils::Grpc::Server
+{
+
+enum class RpcPriority
+{
+  Low = 0,
+  Normal,
+  High,
+  // Bounded by max_limit only.
+  Critical
+};
+
+constexpr std::size_t k_number_rpc_priorities = 4;
+
+enum class ConcurrencyLimitAlgorithm
+{
+  // limit = limit * clamp(tolerance * long_rtt / short_rtt, 0.5, 1) + sqrt(limit)
+  Gradient,
+  // limit * backoff_ratio if latency exceeds the threshold, otherwise limit + 1.
+  Aimd
+};
+
+struct ConcurrencyLimiterConfig final
+{
+  ConcurrencyLimitAlgorithm algorithm = ConcurrencyLimitAlgorithm::Gradient;
+
+  std::uint32_t initial_limit = 100;
+
+  std::uint32_t min_limit = 4;
+
+  std::uint32_t max_limit = 5000;
+
+  // Limit is recalculated after window_size samples
+  // or window_duration, whichever comes first.
+  std::uint32_t window_size = 100;
+
+  std::chrono::milliseconds window_duration{100};
+
+  // Gradient: weight of the new limit.
+  double smoothing = 0.2;
+
+  // Gradient: how much short_rtt may exceed long_rtt
+  // before the limit goes down.
+  double tolerance = 1.5;
+
+  // Gradient: number of windows averaged by long_rtt.
+  std::uint32_t long_window = 20;
+
+  // Aimd
+  std::chrono::microseconds latency_threshold{50000};
+
+  double backoff_ratio = 0.9;
+
+  // Part of the limit available to Low, Normal and High priority.
+  std::array<double, k_number_rpc_priorities - 1> priority_shares{0.5, 0.8, 1.0};
+};
+
+struct ConcurrencyLimiterStats final
+{
+  // Methods served by the limiter.
+  std::vector<std::string> methods;
+  std::uint32_t limit = 0;
+  std::uint32_t in_flight = 0;
+  std::uint64_t number_accepted = 0;
+  // Indexed by RpcPriority.
+  std::array<std::uint64_t, k_number_rpc_priorities> number_rejected{};
+  std::uint64_t short_rtt_us = 0;
+  std::uint64_t long_rtt_us = 0;
+};
+
+/**
+ * Adaptive limit of rpc served concurrently by one task processor.
+ * Rpc are admitted once, at their start, streams hold the slot
+ * until they are finished. Latency of every admitted rpc with a single
+ * request (queueing in the task processor included) is a sample, the limit
+ * is recalculated once per window by the thread closing it. Rpc over
+ * the limit of their priority must be rejected at once
+ * (RESOURCE_EXHAUSTED), before the wait queue of the task processor
+ * grows.
+ **/
+class ConcurrencyLimiter final : private Generics::Uncopyable
+{
+public:
+  using Clock = std::chrono::steady_clock;
+
+  /**
+   * Admission of one rpc. Releases the slot on destruction,
+   * the time since admission is the latency sample.
+   **/
+  class Permit final
+  {
+  public:
+    Permit() = default;
+
+    Permit(const Permit&) = delete;
+    Permit& operator=(const Permit&) = delete;
+
+    Permit(Permit&& other) noexcept
+      : limiter_(std::exchange(other.limiter_, nullptr)),
+        start_(other.start_)
+    {
+    }
+
+    Permit& operator=(Permit&& other) noexcept
+    {
+      if (this != &other)
+      {
+        release();
+        limiter_ = std::exchange(other.limiter_, nullptr);
+        start_ = other.start_;
+      }
+
+      return *this;
+    }
+
+    ~Permit()
+    {
+      release();
+    }
+
+    explicit operator bool() const noexcept
+    {
+      return limiter_ != nullptr;
+    }
+
+    void release() noexcept
+    {
+      if (limiter_)
+      {
+        release(std::chrono::duration_cast<std::chrono::microseconds>(
+          Clock::now() - start_));
+      }
+    }
+
+    void release(const std::chrono::microseconds latency) noexcept
+    {
+      if (limiter_)
+      {
+        std::exchange(limiter_, nullptr)->release(latency);
+      }
+    }
+
+    // Frees the slot only: lifetime of a stream is not a latency sample.
+    void release_without_sample() noexcept
+    {
+      if (limiter_)
+      {
+        std::exchange(limiter_, nullptr)->in_flight_.fetch_sub(
+          1,
+          std::memory_order_relaxed);
+      }
+    }
+
+  private:
+    friend class ConcurrencyLimiter;
+
+    Permit(
+      ConcurrencyLimiter* limiter,
+      const Clock::time_point start) noexcept
+      : limiter_(limiter),
+        start_(start)
+    {
+    }
+
+  private:
+    ConcurrencyLimiter* limiter_ = nullptr;
+
+    Clock::time_point start_;
+  };
+
+public:
+  explicit ConcurrencyLimiter(const ConcurrencyLimiterConfig& config)
+    : config_(normalize(config)),
+      limit_value_(config_.initial_limit),
+      limit_(config_.initial_limit),
+      window_start_(Clock::now().time_since_epoch().count())
+  {
+  }
+
+  ~ConcurrencyLimiter() = default;
+
+  Permit try_acquire(const RpcPriority priority) noexcept
+  {
+    const auto index = static_cast<std::size_t>(priority);
+    const std::uint32_t threshold = this->threshold(priority);
+
+    std::uint32_t in_flight = in_flight_.load(std::memory_order_relaxed);
+    do
+    {
+      if (in_flight >= threshold)
+      {
+        number_rejected_[index].fetch_add(1, std::memory_order_relaxed);
+        return {};
+      }
+    } while (!in_flight_.compare_exchange_weak(
+      in_flight,
+      in_flight + 1,
+      std::memory_order_relaxed));
+
+    number_accepted_.fetch_add(1, std::memory_order_relaxed);
+
+    std::uint32_t max_in_flight =
+      max_in_flight_.load(std::memory_order_relaxed);
+    while (in_flight + 1 > max_in_flight &&
+      !max_in_flight_.compare_exchange_weak(
+        max_in_flight,
+        in_flight + 1,
+        std::memory_order_relaxed))
+    {
+    }
+
+    return Permit(this, Clock::now());
+  }
+
+  std::uint32_t limit() const noexcept
+  {
+    return limit_.load(std::memory_order_relaxed);
+  }
+
+  std::uint32_t in_flight() const noexcept
+  {
+    return in_flight_.load(std::memory_order_relaxed);
+  }
+
+  void add_method(const std::string& method)
+  {
+    methods_.emplace_back(method);
+  }
+
+  ConcurrencyLimiterStats stats() const
+  {
+    ConcurrencyLimiterStats stats;
+    stats.methods = methods_;
+    stats.limit = limit();
+    stats.in_flight = in_flight();
+    stats.number_accepted = number_accepted_.load(std::memory_order_relaxed);
+    for (std::size_t i = 0; i < k_number_rpc_priorities; ++i)
+    {
+      stats.number_rejected[i] =
+        number_rejected_[i].load(std::memory_order_relaxed);
+    }
+    stats.short_rtt_us = short_rtt_us_.load(std::memory_order_relaxed);
+    stats.long_rtt_us = long_rtt_us_.load(std::memory_order_relaxed);
+    return stats;
+  }
+
+private:
+  static ConcurrencyLimiterConfig normalize(ConcurrencyLimiterConfig config)
+  {
+    config.min_limit = std::max<std::uint32_t>(config.min_limit, 1);
+    config.max_limit = std::max(config.max_limit, config.min_limit);
+    config.initial_limit = std::clamp(
+      config.initial_limit,
+      config.min_limit,
+      config.max_limit);
+    config.window_size = std::max<std::uint32_t>(config.window_size, 1);
+    config.long_window = std::max<std::uint32_t>(config.long_window, 1);
+    config.smoothing = std::clamp(config.smoothing, 0.0, 1.0);
+    return config;
+  }
+
+  std::uint32_t threshold(const RpcPriority priority) const noexcept
+  {
+    if (priority == RpcPriority::Critical)
+    {
+      return config_.max_limit;
+    }
+
+    const auto share =
+      config_.priority_shares[static_cast<std::size_t>(priority)];
+    return std::max<std::uint32_t>(
+      static_cast<std::uint32_t>(limit() * share),
+      1);
+  }
+
+  void release(const std::chrono::microseconds latency) noexcept
+  {
+    in_flight_.fetch_sub(1, std::memory_order_relaxed);
+
+    window_sum_us_.fetch_add(
+      static_cast<std::uint64_t>(std::max<std::int64_t>(latency.count(), 0)),
+      std::memory_order_relaxed);
+    const auto count =
+      window_count_.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    const auto now = Clock::now().time_since_epoch().count();
+    const auto window_duration =
+      std::chrono::duration_cast<Clock::duration>(
+        config_.window_duration).count();
+    if (count < config_.window_size &&
+        now - window_start_.load(std::memory_order_relaxed) < window_duration)
+    {
+      return;
+    }
+
+    std::unique_lock lock(mutex_, std::try_to_lock);
+    if (lock.owns_lock())
+    {
+      update(now);
+    }
+  }
+
+  // Under mutex_.
+  void update(const Clock::rep now) noexcept
+  {
+    const auto count = window_count_.exchange(0, std::memory_order_relaxed);
+    const auto sum = window_sum_us_.exchange(0, std::memory_order_relaxed);
+    const auto max_in_flight = max_in_flight_.exchange(
+      in_flight_.load(std::memory_order_relaxed),
+      std::memory_order_relaxed);
+    window_start_.store(now, std::memory_order_relaxed);
+    if (count == 0)
+    {
+      return;
+    }
+
+    const double short_rtt = std::max(static_cast<double>(sum) / count, 1.0);
+    double limit = limit_value_;
+
+    if (config_.algorithm == ConcurrencyLimitAlgorithm::Gradient)
+    {
+      if (long_rtt_ == 0)
+      {
+        long_rtt_ = short_rtt;
+      }
+      else
+      {
+        long_rtt_ += (short_rtt - long_rtt_) / config_.long_window;
+      }
+
+      // Latency went down for long: let long_rtt follow it faster.
+      if (long_rtt_ / short_rtt > 2)
+      {
+        long_rtt_ *= 0.95;
+      }
+
+      const double gradient = std::clamp(
+        config_.tolerance * long_rtt_ / short_rtt,
+        0.5,
+        1.0);
+      double new_limit = limit * gradient + std::sqrt(limit);
+
+      // Load is far below the limit: latency says nothing about it.
+      if (max_in_flight < limit / 2 && new_limit > limit)
+      {
+        new_limit = limit;
+      }
+
+      limit = limit * (1 - config_.smoothing) + new_limit * config_.smoothing;
+    }
+    else
+    {
+      if (short_rtt > config_.latency_threshold.count())
+      {
+        limit *= config_.backoff_ratio;
+      }
+      else if (max_in_flight * 2 >= limit)
+      {
+        limit += 1;
+      }
+    }
+
+    limit_value_ = std::clamp(
+      limit,
+      static_cast<double>(config_.min_limit),
+      static_cast<double>(config_.max_limit));
+    limit_.store(
+      static_cast<std::uint32_t>(limit_value_),
+      std::memory_order_relaxed);
+    short_rtt_us_.store(
+      static_cast<std::uint64_t>(short_rtt),
+      std::memory_order_relaxed);
+    long_rtt_us_.store(
+      static_cast<std::uint64_t>(long_rtt_),
+      std::memory_order_relaxed);
+  }
+
+private:
+  const ConcurrencyLimiterConfig config_;
+
+  std::vector<std::string> methods_;
+
+  std::mutex mutex_;
+
+  // Under mutex_.
+  double limit_value_ = 0;
+
+  double long_rtt_ = 0;
+
+  std::atomic<std::uint32_t> limit_;
+
+  std::atomic<std::uint64_t> short_rtt_us_{0};
+
+  std::atomic<std::uint64_t> long_rtt_us_{0};
+
+  alignas(64) std::atomic<std::uint32_t> in_flight_{0};
+
+  std::atomic<std::uint32_t> max_in_flight_{0};
+
+  std::atomic<std::uint64_t> number_accepted_{0};
+
+  std::array<std::atomic<std::uint64_t>, k_number_rpc_priorities>
+    number_rejected_{};
+
+  alignas(64) std::atomic<std::uint64_t> window_sum_us_{0};
+
+  std::atomic<std::uint32_t> window_count_{0};
+
+  std::atomic<Clock::rep> window_start_;
+};
+
+using ConcurrencyLimiterPtr = std::unique_ptr<ConcurrencyLimiter>;
+
+/**
+ * Limiters of a server, one per task processor
+ * (rpc of all methods served by it share the limit).
+ **/
+class ConcurrencyLimiters final : private Generics::Uncopyable
+{
+public:
+  using Stats = std::vector<ConcurrencyLimiterStats>;
+
+public:
+  explicit ConcurrencyLimiters(const ConcurrencyLimiterConfig& config)
+    : config_(config)
+  {
+  }
+
+  // Not thread safe: called while services are added.
+  ConcurrencyLimiter* get(
+    const void* task_processor,
+    const std::string& method)
+  {
+    auto& limiter = limiters_[task_processor];
+    if (!limiter)
+    {
+      limiter = std::make_unique<ConcurrencyLimiter>(config_);
+    }
+
+    limiter->add_method(method);
+    return limiter.get();
+  }
+
+  Stats stats() const
+  {
+    Stats stats;
+    stats.reserve(limiters_.size());
+    for (const auto& [task_processor, limiter] : limiters_)
+    {
+      stats.emplace_back(limiter->stats());
+    }
+
+    return stats;
+  }
+
+private:
+  const ConcurrencyLimiterConfig config_;
+
+  std::unordered_map<const void*, ConcurrencyLimiterPtr> limiters_;
+};
+
+using ConcurrencyLimitersPtr = std::shared_ptr<ConcurrencyLimiters>;
+
+} // namespace UServerUtils::Grpc::Server
+
+#endif // GRPC_SERVER_CONCURRENCY_LIMITER_H_
@@ -6,6 +6,7 @@
 #include <unordered_map>
 
 // THIS
+#include <UServerUtils/Grpc/Common/WriteCoalescing.hpp>
 #include <UServerUtils/Grpc/Server/CommonContext.hpp>
 
 namespace UServerUtils::Grpc::Server
@@ -40,6 +41,18 @@ struct Config final
   // Determines which request handler is called
   // on_request(const Request&) or on_request(std::unique_ptr<RequestPtr>&&)
   RequestHandlerType request_handler_type = RequestHandlerType::Copy;
+
+  // Requests are parsed into a google::protobuf::Arena recycled per rpc
+  // (unary) or per stream message. Used only with RequestHandlerType::Copy:
+  // Move handlers take ownership of the request, so it stays on the heap.
+  bool is_arena_enabled = false;
+
+  // Size of the arena block allocated once per rpc and reused
+  // for all its messages. Should fit a typical request.
+  std::size_t arena_initial_block_size = 8 * 1024;
+
+  // Batching of stream responses (BIDI_STREAMING, SERVER_STREAMING).
+  Common::WriteCoalescingConfig write_coalescing;
 };
 
 } // namespace UServerUtils::Grpc::Server
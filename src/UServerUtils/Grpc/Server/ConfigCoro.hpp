@@ -2,9 +2,13 @@
 #define GRPC_SERVER_CONFIG_CORO_H_
 
 // STD
+#include <optional>
 #include <string>
 #include <unordered_map>
 
+// THIS
+#include <UServerUtils/Grpc/Server/ConcurrencyLimiter.hpp>
+
 namespace UServerUtils::Grpc::Server
 {
 
@@ -27,6 +31,10 @@ struct ConfigCoro final
   std::unordered_map<std::string, std::string> channel_args;
 
   std::optional<std::size_t> max_size_queue = {};
+
+  // If set, rpc started over the adaptive concurrency limit
+  // of a task processor are rejected with RESOURCE_EXHAUSTED.
+  std::optional<ConcurrencyLimiterConfig> concurrency_limiter = {};
 };
 
 } // namespace UServerUtils::Grpc::Server
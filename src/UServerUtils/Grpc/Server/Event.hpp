@@ -6,6 +6,7 @@
 
 // THIS
 #include <UServerUtils/Grpc/Common/Event.hpp>
+#include <UServerUtils/Grpc/Common/EventPool.hpp>
 #include <UServerUtils/Grpc/Server/EventObserver.hpp>
 #include <UServerUtils/Grpc/Server/EventType.hpp>
 
@@ -53,7 +54,7 @@ private:
   bool is_pending_ = false;
 };
 
-class EventQueue final : public Common::Event
+class EventQueue final : public Common::PooledEvent
 {
 public:
   using ObserverPtr = std::weak_ptr<EventQueueObserver>;
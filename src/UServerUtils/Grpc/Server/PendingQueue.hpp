@@ -14,6 +14,9 @@
 // PROTOBUF
 #include <google/protobuf/message.h>
 
+// THIS
+#include <UServerUtils/Grpc/Common/QueueMpmc.hpp>
+
 namespace UServerUtils::Grpc::Server
 {
 
@@ -21,7 +24,9 @@ enum class PendingQueueType
 {
   Write = 0,
   Finish,
-  Stop
+  Stop,
+  // Notification only: move PendingRing content to PendingQueue.
+  Drain
 };
 
 using PendingQueueData = std::tuple<
@@ -33,6 +38,12 @@ using PendingQueue = std::queue<
   PendingQueueData,
   std::deque<PendingQueueData>>;
 
+// Data written by threads other than the completion queue thread
+// of a streaming rpc. One Drain notification serves a whole batch.
+using PendingRing = Common::QueueMpmc<PendingQueueData>;
+
+constexpr std::size_t k_pending_ring_capacity = 64;
+
 } // namespace UServerUtils::Grpc::Server
 
 #endif //GRPC_SERVER_PENDING_QUEUE_H_
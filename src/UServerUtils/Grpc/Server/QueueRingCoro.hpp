@@ -0,0 +1,296 @@
+#ifndef GRPC_SERVER_QUEUE_RING_CORO_H_
+#define GRPC_SERVER_QUEUE_RING_CORO_H_
+
+// STD
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+// USERVER
+#include <userver/engine/deadline.hpp>
+#include <userver/engine/single_consumer_event.hpp>
+
+// THIS
+#include <Generics/Uncopyable.hpp>
+#include <UServerUtils/Grpc/Common/QueueMpmc.hpp>
+
+namespace UServerUtils::Grpc::Server::Internal
+{
+
+/**
+ * Single producer single consumer queue between a rpc (completion
+ * queue thread) and the coroutine serving it. Has the interface of
+ * userver::concurrent::GenericQueue used by generated code
+ * (Create, GetProducer, GetConsumer, PushNoblock, Pop).
+ *
+ * Elements go to a lock-free ring (Common::QueueMpmc). If the coroutine
+ * falls behind and the ring is full, elements go to a mutex protected
+ * overflow list, and keep going there until the consumer drains it,
+ * so the order is preserved. The consumer takes elements from the
+ * ring in batches.
+ **/
+template<class T>
+class QueueRingCoro final
+  : public std::enable_shared_from_this<QueueRingCoro<T>>,
+    private Generics::Uncopyable
+{
+public:
+  using ValueType = T;
+  using QueuePtr = std::shared_ptr<QueueRingCoro<T>>;
+
+  static constexpr std::size_t kUnbounded =
+    std::numeric_limits<std::size_t>::max();
+
+private:
+  static constexpr std::size_t k_ring_capacity = 256;
+  static constexpr std::size_t k_batch_size = 32;
+
+public:
+  class Producer final
+  {
+  public:
+    explicit Producer(const QueuePtr& queue) noexcept
+      : queue_(queue)
+    {
+    }
+
+    Producer(const Producer&) = delete;
+    Producer(Producer&&) noexcept = default;
+    Producer& operator=(const Producer&) = delete;
+    Producer& operator=(Producer&&) noexcept = default;
+
+    ~Producer()
+    {
+      if (queue_)
+      {
+        queue_->close_producer();
+      }
+    }
+
+    bool PushNoblock(T&& value) const
+    {
+      return queue_->push(std::move(value));
+    }
+
+  private:
+    QueuePtr queue_;
+  };
+
+  class Consumer final
+  {
+  public:
+    explicit Consumer(const QueuePtr& queue) noexcept
+      : queue_(queue)
+    {
+    }
+
+    Consumer(const Consumer&) = delete;
+    Consumer(Consumer&&) noexcept = default;
+    Consumer& operator=(const Consumer&) = delete;
+    Consumer& operator=(Consumer&&) noexcept = default;
+
+    ~Consumer()
+    {
+      if (queue_)
+      {
+        queue_->close_consumer();
+      }
+    }
+
+    /**
+     * Returns false if deadline is reached, task is cancelled
+     * or the producer is gone and the queue is empty.
+     **/
+    bool Pop(
+      T& value,
+      userver::engine::Deadline deadline = {}) const
+    {
+      return queue_->pop(value, deadline);
+    }
+
+  private:
+    QueuePtr queue_;
+  };
+
+public:
+  static QueuePtr Create(const std::size_t max_size = kUnbounded)
+  {
+    return QueuePtr(new QueueRingCoro(max_size));
+  }
+
+  Producer GetProducer()
+  {
+    return Producer(this->shared_from_this());
+  }
+
+  Consumer GetConsumer()
+  {
+    return Consumer(this->shared_from_this());
+  }
+
+private:
+  explicit QueueRingCoro(const std::size_t max_size)
+    : max_size_(max_size),
+      ring_(std::min(max_size, k_ring_capacity))
+  {
+    batch_.reserve(k_batch_size);
+  }
+
+  bool push(T&& value)
+  {
+    if (is_consumer_closed_.load(std::memory_order_relaxed))
+    {
+      return false;
+    }
+
+    // Single producer: size_ is only increased here, so the bound is exact.
+    const bool is_bounded = max_size_ != kUnbounded;
+    if (is_bounded)
+    {
+      if (size_.load(std::memory_order_acquire) >= max_size_)
+      {
+        return false;
+      }
+      size_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    try
+    {
+      if (is_overflowed_.load(std::memory_order_acquire) ||
+          !ring_.emplace(std::move(value)))
+      {
+        std::lock_guard lock(mutex_);
+        overflow_.emplace_back(std::move(value));
+        is_overflowed_.store(true, std::memory_order_release);
+      }
+    }
+    catch (...)
+    {
+      if (is_bounded)
+      {
+        size_.fetch_sub(1, std::memory_order_relaxed);
+      }
+      throw;
+    }
+
+    event_.Send();
+    return true;
+  }
+
+  bool pop(
+    T& value,
+    const userver::engine::Deadline deadline)
+  {
+    while (true)
+    {
+      if (batch_position_ < batch_.size())
+      {
+        value = std::move(batch_[batch_position_++]);
+        if (max_size_ != kUnbounded)
+        {
+          size_.fetch_sub(1, std::memory_order_release);
+        }
+        return true;
+      }
+
+      batch_.clear();
+      batch_position_ = 0;
+
+      if (fill_batch())
+      {
+        continue;
+      }
+
+      if (is_producer_closed_.load(std::memory_order_acquire))
+      {
+        // Everything pushed before close is visible now.
+        if (fill_batch())
+        {
+          continue;
+        }
+
+        return false;
+      }
+
+      if (!event_.WaitForEventUntil(deadline))
+      {
+        return false;
+      }
+    }
+  }
+
+  bool fill_batch()
+  {
+    ring_.pop_batch(
+      [this] (T&& data) {
+        batch_.emplace_back(std::move(data));
+      },
+      k_batch_size);
+    if (!batch_.empty())
+    {
+      return true;
+    }
+
+    // Producer writes to the overflow list only while the ring
+    // is not used, so ring elements always precede overflow ones.
+    if (is_overflowed_.load(std::memory_order_acquire))
+    {
+      std::lock_guard lock(mutex_);
+      while (!overflow_.empty() && batch_.size() < k_batch_size)
+      {
+        batch_.emplace_back(std::move(overflow_.front()));
+        overflow_.pop_front();
+      }
+
+      if (overflow_.empty())
+      {
+        is_overflowed_.store(false, std::memory_order_release);
+      }
+    }
+
+    return !batch_.empty();
+  }
+
+  void close_producer() noexcept
+  {
+    is_producer_closed_.store(true, std::memory_order_release);
+    event_.Send();
+  }
+
+  void close_consumer() noexcept
+  {
+    is_consumer_closed_.store(true, std::memory_order_relaxed);
+  }
+
+private:
+  const std::size_t max_size_;
+
+  std::atomic<std::size_t> size_{0};
+
+  Common::QueueMpmc<T> ring_;
+
+  std::atomic<bool> is_overflowed_{false};
+
+  std::mutex mutex_;
+
+  std::deque<T> overflow_;
+
+  userver::engine::SingleConsumerEvent event_;
+
+  std::atomic<bool> is_producer_closed_{false};
+
+  std::atomic<bool> is_consumer_closed_{false};
+
+  // Consumer side only.
+  std::vector<T> batch_;
+
+  std::size_t batch_position_ = 0;
+};
+
+} // namespace UServerUtils::Grpc::Server::Internal
+
+#endif // GRPC_SERVER_QUEUE_RING_CORO_H_
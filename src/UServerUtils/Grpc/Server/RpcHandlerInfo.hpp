@@ -33,13 +33,21 @@ struct RpcHandlerInfo final
     const grpc::internal::RpcMethod::RpcType rpc_type,
     const RequestHandlerType request_handler_type,
     RpcHandlerFactory&& rpc_handler_factory,
-    const std::string_view method_full_name)
+    const std::string_view method_full_name,
+    const bool is_arena_enabled = false,
+    const std::size_t arena_initial_block_size = 0,
+    const Common::WriteCoalescingConfig& write_coalescing = {},
+    const Common::WriteCoalescingCountersPtr& write_coalescing_counters = {})
     : request_descriptor(request_descriptor),
       response_descriptor(response_descriptor),
       rpc_type(rpc_type),
       request_handler_type(request_handler_type),
       rpc_handler_factory(std::move(rpc_handler_factory)),
-      method_full_name(method_full_name) {
+      method_full_name(method_full_name),
+      is_arena_enabled(is_arena_enabled),
+      arena_initial_block_size(arena_initial_block_size),
+      write_coalescing(write_coalescing),
+      write_coalescing_counters(write_coalescing_counters) {
   }
 
   ~RpcHandlerInfo() = default;
@@ -50,6 +58,10 @@ struct RpcHandlerInfo final
   const RequestHandlerType request_handler_type;
   const RpcHandlerFactory rpc_handler_factory;
   const std::string_view method_full_name;
+  const bool is_arena_enabled;
+  const std::size_t arena_initial_block_size;
+  const Common::WriteCoalescingConfig write_coalescing;
+  const Common::WriteCoalescingCountersPtr write_coalescing_counters;
 };
 
 } // UServerUtils::Grpc::Server
@@ -19,6 +19,7 @@
 // THIS
 #include <eh/Exception.hpp>
 #include <Logger/Logger.hpp>
+#include <UServerUtils/Grpc/Common/MessageArena.hpp>
 #include <UServerUtils/Grpc/Server/CommonContext.hpp>
 #include <UServerUtils/Grpc/Server/Event.hpp>
 #include <UServerUtils/Grpc/Server/EventObserver.hpp>
@@ -128,6 +129,16 @@ private:
 
   void read_if_needed() noexcept;
 
+  bool post(PendingQueueData&& data);
+
+  bool notify(PendingQueueData&& data);
+
+  void drain_pending_ring() noexcept;
+
+  bool has_pending_write() noexcept;
+
+  Message* request_message() noexcept;
+
   void try_close() noexcept;
 
   void execute_queue() noexcept;
@@ -172,10 +183,25 @@ private:
 
   grpc::Notifier notifier_;
 
+  // Writes from other threads of streaming rpc (see post).
+  std::unique_ptr<PendingRing> pending_ring_;
+
+  std::atomic<bool> is_ring_notified_{false};
+
+  std::atomic<bool> is_ring_overflowed_{false};
+
+  // Batching of stream writes (see Common::WriteCoalescingConfig).
+  Common::WriteBatch write_batch_;
+
+  std::atomic<std::size_t> number_pending_writes_{0};
+
   const Message* request_message_prototype_;
 
   MessagePtr request_;
 
+  // Set instead of request_ if arena is enabled (Copy handlers only).
+  Common::MessageArenaPtr request_arena_;
+
   MessagePtr response_;
 
   grpc::ServerContext server_context_;
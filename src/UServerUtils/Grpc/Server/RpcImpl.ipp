@@ -56,7 +56,10 @@ inline RpcImpl::RpcImpl(
     read_event_(EventType::Read, *this, false),
     write_event_(EventType::Write, *this, false),
     finish_event_(EventType::Finish, *this, false),
-    done_event_(EventType::Done, *this, false)
+    done_event_(EventType::Done, *this, false),
+    write_batch_(
+      rpc_handler_info_.write_coalescing,
+      rpc_handler_info_.write_coalescing_counters)
 {
 }
 
@@ -82,6 +85,12 @@ inline void RpcImpl::initialize()
       break;
   }
 
+  if (rpc_handler_info_.rpc_type == grpc::internal::RpcMethod::BIDI_STREAMING ||
+      rpc_handler_info_.rpc_type == grpc::internal::RpcMethod::SERVER_STREAMING)
+  {
+    pending_ring_ = std::make_unique<PendingRing>(k_pending_ring_capacity);
+  }
+
   // MessageFactory thread safe
   auto* message_factory = google::protobuf::MessageFactory::generated_factory();
   if (!message_factory)
@@ -103,7 +112,14 @@ inline void RpcImpl::initialize()
     throw Exception(stream);
   }
 
-  if (rpc_handler_info_.request_handler_type == RequestHandlerType::Copy ||
+  if (rpc_handler_info_.is_arena_enabled &&
+      rpc_handler_info_.request_handler_type == RequestHandlerType::Copy)
+  {
+    request_arena_ = std::make_unique<Common::MessageArena>(
+      *request_message_prototype_,
+      rpc_handler_info_.arena_initial_block_size);
+  }
+  else if (rpc_handler_info_.request_handler_type == RequestHandlerType::Copy ||
       rpc_handler_info_.rpc_type == grpc::internal::RpcMethod::NORMAL_RPC ||
       rpc_handler_info_.rpc_type ==  grpc::internal::RpcMethod::SERVER_STREAMING)
   {
@@ -138,7 +154,7 @@ inline void RpcImpl::initialize()
       delegate_.request_async_unary(
         method_index_,
         &server_context_,
-        request_.get(),
+        request_message(),
         server_async_response_writer_.get(),
         server_completion_queue_.get(),
         server_completion_queue_.get(),
@@ -148,7 +164,7 @@ inline void RpcImpl::initialize()
       delegate_.request_async_server_streaming(
         method_index_,
         &server_context_,
-        request_.get(),
+        request_message(),
         server_async_writer_.get(),
         server_completion_queue_.get(),
         server_completion_queue_.get(),
@@ -198,23 +214,59 @@ inline void RpcImpl::on_event_queue(
   const bool ok,
   PendingQueueData&& data) noexcept
 {
+  const bool is_drain = std::get<0>(data) == PendingQueueType::Drain;
+  if (is_drain)
+  {
+    // Must be reset before the ring is read (see post).
+    is_ring_notified_.exchange(false, std::memory_order_acq_rel);
+  }
+
   if (rpc_state_ == RpcState::Stopped
     || rpc_state_ == RpcState::Closed)
   {
     return;
   }
 
-  try
+  if (is_drain)
   {
-    pending_queue_.emplace(std::move(data));
+    drain_pending_ring();
   }
-  catch (...)
+  else
   {
+    try
+    {
+      pending_queue_.emplace(std::move(data));
+    }
+    catch (...)
+    {
+    }
   }
 
   execute_queue();
 }
 
+inline void RpcImpl::drain_pending_ring() noexcept
+{
+  if (!pending_ring_)
+  {
+    return;
+  }
+
+  // Elements are taken off the ring before the callback: as in
+  // on_event_queue, data is lost only if pending_queue_ can't allocate.
+  pending_ring_->pop_batch(
+    [this] (PendingQueueData&& data) noexcept {
+      try
+      {
+        pending_queue_.emplace(std::move(data));
+      }
+      catch (...)
+      {
+      }
+    },
+    pending_ring_->capacity());
+}
+
 inline void RpcImpl::on_connection(const bool ok) noexcept
 {
   try
@@ -337,7 +389,11 @@ inline void RpcImpl::on_read(const bool ok) noexcept
       }
       else
       {
-        handler_->on_request_internal(*request_);
+        handler_->on_request_internal(*request_message());
+        if (request_arena_)
+        {
+          request_arena_->recycle();
+        }
       }
     }
     catch (const eh::Exception& exc)
@@ -461,13 +517,13 @@ inline void RpcImpl::read_if_needed() noexcept
   {
     case grpc::internal::RpcMethod::BIDI_STREAMING:
     {
-      server_async_reader_writer_->Read(request_.get(), &read_event_);
+      server_async_reader_writer_->Read(request_message(), &read_event_);
       read_event_.set_pending(true);
       break;
     }
     case grpc::internal::RpcMethod::CLIENT_STREAMING:
     {
-      server_async_reader_->Read(request_.get(), &read_event_);
+      server_async_reader_->Read(request_message(), &read_event_);
       read_event_.set_pending(true);
       break;
     }
@@ -482,7 +538,7 @@ inline void RpcImpl::read_if_needed() noexcept
         }
         else
         {
-          handler_->on_request_internal(*request_);
+          handler_->on_request_internal(*request_message());
         }
       }
       catch (const eh::Exception& exc)
@@ -526,6 +582,11 @@ inline void RpcImpl::read_if_needed() noexcept
   }
 }
 
+inline google::protobuf::Message* RpcImpl::request_message() noexcept
+{
+  return request_arena_ ? request_arena_->message() : request_.get();
+}
+
 inline void RpcImpl::try_close() noexcept
 {
   if (rpc_state_ != RpcState::Closed)
@@ -546,6 +607,19 @@ inline void RpcImpl::try_close() noexcept
 
 inline bool RpcImpl::write(MessagePtr&& message) noexcept
 {
+  // Bounded pending queue: the writer gets an error instead
+  // of piling up messages the peer does not read.
+  const auto max_pending_writes =
+    rpc_handler_info_.write_coalescing.max_pending_writes;
+  if (max_pending_writes != 0 &&
+      number_pending_writes_.load(std::memory_order_relaxed) >=
+        max_pending_writes)
+  {
+    return false;
+  }
+  number_pending_writes_.fetch_add(1, std::memory_order_relaxed);
+
+  bool is_success = false;
   try
   {
     if (thread_id_ == std::this_thread::get_id())
@@ -555,27 +629,16 @@ inline bool RpcImpl::write(MessagePtr&& message) noexcept
         std::move(message),
         std::nullopt);
       execute_queue();
+      is_success = true;
     }
     else
     {
-      auto event = std::make_unique<EventQueue>(
-        weak_from_this(),
+      is_success = post(
         PendingQueueData(
           PendingQueueType::Write,
           std::move(message),
           std::nullopt));
-      auto* event_ptr = event.release();
-      const bool is_success = notifier_.Notify(
-        server_completion_queue_.get(),
-        event_ptr);
-      if (!is_success)
-      {
-        event.reset(event_ptr);
-        return false;
-      }
     }
-
-    return true;
   }
   catch (const eh::Exception& exc)
   {
@@ -591,7 +654,12 @@ inline bool RpcImpl::write(MessagePtr&& message) noexcept
     }
   }
 
-  return false;
+  if (!is_success)
+  {
+    number_pending_writes_.fetch_sub(1, std::memory_order_relaxed);
+  }
+
+  return is_success;
 }
 
 inline bool RpcImpl::finish(grpc::Status&& status) noexcept
@@ -608,21 +676,11 @@ inline bool RpcImpl::finish(grpc::Status&& status) noexcept
     }
     else
     {
-      auto event = std::make_unique<EventQueue>(
-        weak_from_this(),
+      return post(
         PendingQueueData(
           PendingQueueType::Finish,
           nullptr,
           std::move(status)));
-      auto* event_ptr = event.release();
-      const bool is_success = notifier_.Notify(
-        server_completion_queue_.get(),
-        event_ptr);
-      if (!is_success)
-      {
-        event.reset(event_ptr);
-        return false;
-      }
     }
 
     return true;
@@ -644,6 +702,72 @@ inline bool RpcImpl::finish(grpc::Status&& status) noexcept
   return false;
 }
 
+inline bool RpcImpl::post(PendingQueueData&& data)
+{
+  // Streaming rpc: data goes to the ring, and only the first element
+  // after a drain costs a completion queue notification. If the ring
+  // is ever full, all later data of this rpc goes through EventQueue
+  // one by one to keep the order.
+  if (pending_ring_ &&
+      !is_ring_overflowed_.load(std::memory_order_acquire))
+  {
+    if (pending_ring_->emplace(std::move(data)))
+    {
+      if (is_ring_notified_.exchange(true, std::memory_order_acq_rel))
+      {
+        return true;
+      }
+
+      // Data can't be taken back from the ring, so it is accepted even
+      // if the notification fails (no memory, completion queue is
+      // shutting down): the next post notifies again and the drain
+      // delivers it, or it is dropped with the rpc as any other
+      // accepted write.
+      bool is_notified = false;
+      try
+      {
+        is_notified = notify(
+          PendingQueueData(
+            PendingQueueType::Drain,
+            MessagePtr{},
+            StatusOptional{}));
+      }
+      catch (...)
+      {
+      }
+
+      if (!is_notified)
+      {
+        is_ring_notified_.store(false, std::memory_order_release);
+      }
+
+      return true;
+    }
+
+    is_ring_overflowed_.store(true, std::memory_order_release);
+  }
+
+  return notify(std::move(data));
+}
+
+inline bool RpcImpl::notify(PendingQueueData&& data)
+{
+  auto event = std::make_unique<EventQueue>(
+    weak_from_this(),
+    std::move(data));
+  auto* event_ptr = event.release();
+  const bool is_success = notifier_.Notify(
+    server_completion_queue_.get(),
+    event_ptr);
+  if (!is_success)
+  {
+    event.reset(event_ptr);
+    return false;
+  }
+
+  return true;
+}
+
 inline bool RpcImpl::stop() noexcept
 {
   try
@@ -732,6 +856,10 @@ inline void RpcImpl::execute_queue() noexcept
     const PendingQueueType type = std::get<0>(data);
     auto message = std::move(std::get<1>(data));
     auto status = std::move(std::get<2>(data));
+    if (type == PendingQueueType::Write)
+    {
+      number_pending_writes_.fetch_sub(1, std::memory_order_relaxed);
+    }
 
     if (type == PendingQueueType::Stop)
     {
@@ -786,14 +914,23 @@ inline void RpcImpl::execute_queue_stream(
   {
     case PendingQueueType::Write:
     {
+      const auto options = write_batch_.next(
+        *response_,
+        has_pending_write());
       switch (rpc_handler_info_.rpc_type)
       {
         case grpc::internal::RpcMethod::BIDI_STREAMING:
-          server_async_reader_writer_->Write(*response_, &write_event_);
+          server_async_reader_writer_->Write(
+            *response_,
+            options,
+            &write_event_);
           write_event_.set_pending(true);
           break;
         case grpc::internal::RpcMethod::SERVER_STREAMING:
-          server_async_writer_->Write(*response_, &write_event_);
+          server_async_writer_->Write(
+            *response_,
+            options,
+            &write_event_);
           write_event_.set_pending(true);
           break;
         default:
@@ -845,6 +982,23 @@ inline void RpcImpl::execute_queue_stream(
   }
 }
 
+inline bool RpcImpl::has_pending_write() noexcept
+{
+  if (!rpc_handler_info_.write_coalescing.is_enabled)
+  {
+    return false;
+  }
+
+  // Writes from other threads may still wait in the ring.
+  if (pending_queue_.empty())
+  {
+    drain_pending_ring();
+  }
+
+  return !pending_queue_.empty() &&
+    std::get<0>(pending_queue_.front()) == PendingQueueType::Write;
+}
+
 inline void RpcImpl::execute_unique(
   const StatusOptional& status,
   MessagePtr&& message)
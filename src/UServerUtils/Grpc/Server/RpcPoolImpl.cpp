@@ -15,10 +15,30 @@ const char RPCPOOL[] = "RPCPOOLIMPL";
 
 } // namespace Aspect
 
-RpcPoolImpl::RpcPoolImpl(Logger* logger)
+namespace
+{
+
+const std::size_t RPCS_RESERVE_SIZE = 100000;
+
+} // namespace
+
+RpcPoolImpl::RpcPoolImpl(
+  Logger* logger,
+  const std::size_t number_shards)
   : logger_(ReferenceCounting::add_ref(logger))
 {
-  rpcs_.reserve(100000);
+  std::uint32_t bits = 0;
+  while ((std::size_t(1) << bits) < number_shards)
+  {
+    bits += 1;
+  }
+  shift_ = 64 - bits;
+
+  shards_ = std::vector<Shard>(std::size_t(1) << bits);
+  for (auto& shard : shards_)
+  {
+    shard.rpcs.reserve(RPCS_RESERVE_SIZE / shards_.size());
+  }
 }
 
 RpcPoolImpl::~RpcPoolImpl()
@@ -33,10 +53,29 @@ RpcPoolImpl::~RpcPoolImpl()
   }
 }
 
+RpcPoolImpl::Shard& RpcPoolImpl::shard(Rpc* rpc) noexcept
+{
+  if (shards_.size() == 1)
+  {
+    return shards_.front();
+  }
+
+  // Fibonacci hashing: high bits of the product depend on all
+  // bits of the address, low bits of which are always zero.
+  const std::uint64_t hash =
+    static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(rpc)) *
+    UINT64_C(11400714819323198485);
+  return shards_[hash >> shift_];
+}
+
 void RpcPoolImpl::add(const RpcPtr& rpc)
 {
-  std::lock_guard<std::mutex> lock(mutex_);
-  rpcs_.emplace(rpc.get(), rpc);
+  auto& shard = this->shard(rpc.get());
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  shard.rpcs.emplace(rpc.get(), rpc);
+  shard.size.store(shard.rpcs.size(), std::memory_order_relaxed);
+  // Shard lock orders this check with deactivate_object_:
+  // either the rpc is seen there or inactivity is seen here.
   if (!active())
   {
     rpc->stop();
@@ -47,43 +86,65 @@ void RpcPoolImpl::remove(Rpc* rpc) noexcept
 {
   try
   {
-    std::lock_guard<std::mutex> lock(mutex_);
-    rpcs_.erase(rpc);
+    auto& shard = this->shard(rpc);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    shard.rpcs.erase(rpc);
+    shard.size.store(shard.rpcs.size(), std::memory_order_relaxed);
   }
   catch (...)
   {
   }
 }
 
+RpcPoolStats RpcPoolImpl::stats() const
+{
+  RpcPoolStats stats;
+  stats.number_rpcs.reserve(shards_.size());
+  for (const auto& shard : shards_)
+  {
+    stats.number_rpcs.emplace_back(
+      shard.size.load(std::memory_order_relaxed));
+  }
+
+  return stats;
+}
+
 void RpcPoolImpl::deactivate_object_()
 {
-  std::lock_guard <std::mutex> lock(mutex_);
-  for (auto& rpc: rpcs_)
+  for (auto& shard : shards_)
   {
-    rpc.first->stop();
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto& rpc : shard.rpcs)
+    {
+      rpc.first->stop();
+    }
   }
 }
 
-void RpcPoolImpl::wait_object_()
+bool RpcPoolImpl::is_stopped() noexcept
 {
-  bool is_stopped = false;
-  std::unique_lock lock(mutex_, std::defer_lock);
-  while (!is_stopped)
+  for (auto& shard : shards_)
   {
-    std::this_thread::sleep_for(
-      std::chrono::milliseconds(200));
-    is_stopped = true;
-    lock.lock();
-    for (auto& rpc : rpcs_)
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    for (auto& rpc : shard.rpcs)
     {
       if (!rpc.first->is_stopped())
       {
-        is_stopped = false;
-        break;
+        return false;
       }
     }
-    lock.unlock();
   }
+
+  return true;
+}
+
+void RpcPoolImpl::wait_object_()
+{
+  do
+  {
+    std::this_thread::sleep_for(
+      std::chrono::milliseconds(200));
+  } while (!is_stopped());
 }
 
 } // namespace UServerUtils::Grpc::Server
@@ -7,13 +7,38 @@
 #include <UServerUtils/Grpc/Server/RpcPool.hpp>
 
 // STD
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <condition_variable>
 #include <unordered_map>
+#include <vector>
 
 namespace UServerUtils::Grpc::Server
 {
 
+struct RpcPoolStats final
+{
+  // Live rpc per shard.
+  std::vector<std::size_t> number_rpcs;
+
+  std::size_t total() const noexcept
+  {
+    std::size_t result = 0;
+    for (const auto number : number_rpcs)
+    {
+      result += number;
+    }
+    return result;
+  }
+};
+
+/**
+ * Registry of live rpc. Rpc are spread over shards by the hash
+ * of their address, every shard has its own mutex, so completion
+ * queue threads starting and finishing rpc rarely meet each other.
+ * Shutdown walks through all shards.
+ **/
 class RpcPoolImpl final
   : public RpcPool,
     public Generics::SimpleActiveObject,
@@ -25,13 +50,31 @@ public:
   using RpcPtr = typename RpcPool::RpcPtr;
   using Rpcs = std::unordered_map<Rpc*, RpcPtr>;
 
+private:
+  static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+  struct alignas(CACHE_LINE_SIZE) Shard final
+  {
+    std::mutex mutex;
+    Rpcs rpcs;
+    std::atomic<std::size_t> size{0};
+  };
+
 public:
-  RpcPoolImpl(Logger* logger);
+  /**
+   * number_shards is rounded up to a power of two,
+   * usually it is the number of completion queues.
+   **/
+  RpcPoolImpl(
+    Logger* logger,
+    const std::size_t number_shards = 1);
 
   void add(const RpcPtr& rpc) override;
 
   void remove(Rpc* rpc) noexcept override;
 
+  RpcPoolStats stats() const;
+
 protected:
   ~RpcPoolImpl() override;
 
@@ -39,12 +82,17 @@ protected:
 
   void wait_object_() override;
 
+private:
+  Shard& shard(Rpc* rpc) noexcept;
+
+  bool is_stopped() noexcept;
+
 private:
   Logger_var logger_;
 
-  Rpcs rpcs_;
+  std::uint32_t shift_ = 0;
 
-  mutable std::mutex mutex_;
+  std::vector<Shard> shards_;
 };
 
 using RpcPoolImpl_var = ReferenceCounting::SmartPtr<RpcPoolImpl>;
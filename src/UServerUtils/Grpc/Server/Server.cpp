@@ -20,8 +20,7 @@ Server::Server(
   const Config& config,
   Logger* logger)
   : config_(std::move(config)),
-    logger_(ReferenceCounting::add_ref(logger)),
-    rpc_pool_(new RpcPoolImpl(logger_.in()))
+    logger_(ReferenceCounting::add_ref(logger))
 {
   namespace Logger = UServerUtils::Grpc::Common::Logger;
   Logger::set_logger(logger_.in());
@@ -39,6 +38,12 @@ Server::Server(
     config_.num_threads = best_thread_number ? best_thread_number : 128;
   }
 
+  // One registry shard per completion queue thread.
+  rpc_pool_ = RpcPoolImpl_var(
+    new RpcPoolImpl(
+      logger_.in(),
+      *config_.num_threads));
+
   Common::Scheduler::Queues queues;
   server_completion_queues_.reserve(*config_.num_threads);
   for (std::size_t i = 1; i <= *config_.num_threads; ++i)
@@ -61,6 +66,21 @@ const Common::SchedulerPtr& Server::scheduler() const noexcept
   return scheduler_;
 }
 
+RpcPoolStats Server::rpc_pool_stats() const
+{
+  return rpc_pool_->stats();
+}
+
+Common::WriteCoalescingStats Server::write_coalescing_stats() const noexcept
+{
+  Common::WriteCoalescingStats stats;
+  stats.number_writes = write_coalescing_counters_->number_writes.load(
+    std::memory_order_relaxed);
+  stats.number_flushes = write_coalescing_counters_->number_flushes.load(
+    std::memory_order_relaxed);
+  return stats;
+}
+
 Server::~Server()
 {
   try
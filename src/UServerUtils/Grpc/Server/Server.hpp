@@ -45,6 +45,12 @@ public:
 
   const Common::SchedulerPtr& scheduler() const noexcept;
 
+  // Live rpc per shard of the registry.
+  RpcPoolStats rpc_pool_stats() const;
+
+  // Writes and flushes of streams of all methods.
+  Common::WriteCoalescingStats write_coalescing_stats() const noexcept;
+
   template<class RpcHandlerType>
   void register_handler()
   {
@@ -98,7 +104,11 @@ public:
           rpc_handler->set_common_context(common_context);
           return rpc_handler;
         },
-        method_full_name.data()));
+        method_full_name.data(),
+        config_.is_arena_enabled,
+        config_.arena_initial_block_size,
+        config_.write_coalescing,
+        write_coalescing_counters_));
   }
 
 protected:
@@ -304,6 +314,9 @@ private:
 
   RpcPoolImpl_var rpc_pool_;
 
+  const Common::WriteCoalescingCountersPtr write_coalescing_counters_ =
+    std::make_shared<Common::WriteCoalescingCounters>();
+
   grpc::ServerBuilder server_builder_;
 
   ServerCompletionQueues server_completion_queues_;
@@ -65,7 +65,8 @@ public:
   void add_service(
     Service* service,
     TaskProcessor& task_processor,
-    const ServiceMode service_mode = ServiceMode::RpcToCoroutine)
+    const ServiceMode service_mode = ServiceMode::RpcToCoroutine,
+    const RpcPriority priority = RpcPriority::Normal)
   {
     static_assert(
       std::is_base_of_v<Component, Service>,
@@ -82,7 +83,8 @@ public:
     grpc_server_->add_service(
       service,
       task_processor,
-      service_mode);
+      service_mode,
+      priority);
     services_.emplace_back(
       Component_var(
         ReferenceCounting::add_ref(service)));
@@ -15,9 +15,12 @@ ServerCoro::ServerCoro(
   const ConfigCoro& config,
   Logger* logger)
   : logger_(ReferenceCounting::add_ref(logger)),
+    port_(config.port),
     common_context_coro_(new CommonContextCoro(
       logger,
-      config.max_size_queue))
+      config.max_size_queue,
+      config.concurrency_limiter)),
+    concurrency_limiters_(common_context_coro_->concurrency_limiters())
 {
   Config config_server;
   config_server.ip = config.ip;
@@ -35,6 +38,26 @@ const Common::SchedulerPtr& ServerCoro::scheduler() const noexcept
   return server_->scheduler();
 }
 
+std::size_t ServerCoro::port() const noexcept
+{
+  return port_;
+}
+
+RpcPoolStats ServerCoro::rpc_pool_stats() const
+{
+  return server_->rpc_pool_stats();
+}
+
+ConcurrencyLimiters::Stats ServerCoro::concurrency_limiter_stats() const
+{
+  if (!concurrency_limiters_)
+  {
+    return {};
+  }
+
+  return concurrency_limiters_->stats();
+}
+
 ServerCoro::~ServerCoro()
 {
   try
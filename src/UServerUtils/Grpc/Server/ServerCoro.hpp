@@ -79,11 +79,20 @@ public:
 
   const Common::SchedulerPtr& scheduler() const noexcept;
 
+  std::size_t port() const noexcept;
+
+  // Live rpc per shard of the registry.
+  RpcPoolStats rpc_pool_stats() const;
+
+  // Empty if concurrency limiter is disabled.
+  ConcurrencyLimiters::Stats concurrency_limiter_stats() const;
+
   template<class Service>
   void add_service(
     Service* service,
     TaskProcessor& task_processor,
-    const ServiceMode service_mode)
+    const ServiceMode service_mode,
+    const RpcPriority priority = RpcPriority::Normal)
   {
     static_assert(
       Internal::exist_type_request_v<Service>,
@@ -133,7 +142,8 @@ public:
       service,
       rpc_type,
       service_mode,
-      task_processor);
+      task_processor,
+      priority);
   }
 
 protected:
@@ -147,9 +157,13 @@ private:
 private:
   Logger_var logger_;
 
+  const std::size_t port_;
+
   Server_var server_;
 
   CommonContextCoro_var common_context_coro_;
+
+  ConcurrencyLimitersPtr concurrency_limiters_;
 };
 
 using ServerCoro_var = ReferenceCounting::SmartPtr<ServerCoro>;
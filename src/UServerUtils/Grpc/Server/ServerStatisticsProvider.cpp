@@ -0,0 +1,96 @@
+// THIS
+#include <UServerUtils/Grpc/Server/ServerStatisticsProvider.hpp>
+
+namespace UServerUtils::Grpc::Server
+{
+
+ServerStatisticsProvider::ServerStatisticsProvider(
+  ServerCoro* server,
+  const std::size_t port)
+  : server_(ReferenceCounting::add_ref(server)),
+    port_(std::to_string(port))
+{
+}
+
+void ServerStatisticsProvider::write(Writer& writer)
+{
+  write_rpc_pool(writer);
+  write_concurrency_limiters(writer);
+}
+
+void ServerStatisticsProvider::write_rpc_pool(Writer& writer)
+{
+  const auto rpc_pool_stats = server_->rpc_pool_stats();
+  const auto& number_rpcs = rpc_pool_stats.number_rpcs;
+
+  auto live_rpcs_writer = writer["live_rpcs"];
+  for (std::size_t shard = 0; shard < number_rpcs.size(); ++shard)
+  {
+    const std::string shard_label = std::to_string(shard);
+    live_rpcs_writer.ValueWithLabels(
+      number_rpcs[shard],
+      {LabelView{"port", port_}, LabelView{"shard", shard_label}});
+  }
+
+  writer["live_rpcs_total"].ValueWithLabels(
+    rpc_pool_stats.total(),
+    {LabelView{"port", port_}});
+}
+
+void ServerStatisticsProvider::write_concurrency_limiters(Writer& writer)
+{
+  static const char* const priority_labels[k_number_rpc_priorities] = {
+    "low", "normal", "high", "critical"};
+
+  const auto limiters_stats = server_->concurrency_limiter_stats();
+  for (std::size_t index = 0; index < limiters_stats.size(); ++index)
+  {
+    const auto& stats = limiters_stats[index];
+    const std::string limiter_label = std::to_string(index);
+
+    std::string methods_label;
+    for (const auto& method : stats.methods)
+    {
+      if (!methods_label.empty())
+      {
+        methods_label += ',';
+      }
+      methods_label += method;
+    }
+
+    const LabelView port_label{"port", port_};
+    const LabelView index_label{"limiter", limiter_label};
+    auto limiter_writer = writer["concurrency_limiter"];
+    limiter_writer["limit"].ValueWithLabels(
+      static_cast<std::uint64_t>(stats.limit),
+      {port_label, index_label, LabelView{"methods", methods_label}});
+    limiter_writer["in_flight"].ValueWithLabels(
+      static_cast<std::uint64_t>(stats.in_flight),
+      {port_label, index_label});
+    limiter_writer["accepted"].ValueWithLabels(
+      stats.number_accepted,
+      {port_label, index_label});
+    for (std::size_t priority = 0;
+      priority < k_number_rpc_priorities;
+      ++priority)
+    {
+      limiter_writer["rejected"].ValueWithLabels(
+        stats.number_rejected[priority],
+        {port_label, index_label,
+         LabelView{"priority", priority_labels[priority]}});
+    }
+    limiter_writer["short_rtt_us"].ValueWithLabels(
+      stats.short_rtt_us,
+      {port_label, index_label});
+    limiter_writer["long_rtt_us"].ValueWithLabels(
+      stats.long_rtt_us,
+      {port_label, index_label});
+  }
+}
+
+std::string ServerStatisticsProvider::name()
+{
+  return "grpc_cobrazz_server";
+}
+
+} // namespace UServerUtils::Grpc::Server
@@ -0,0 +1,55 @@
+#ifndef GRPC_SERVER_SERVER_STATISTICS_PROVIDER_H_
+#define GRPC_SERVER_SERVER_STATISTICS_PROVIDER_H_
+
+// STD
+#include <string>
+
+// USERVER
+#include <userver/utils/statistics/labels.hpp>
+
+// THIS
+#include <UServerUtils/Grpc/Server/ServerCoro.hpp>
+#include <UServerUtils/Statistics/StatisticsProvider.hpp>
+
+namespace UServerUtils::Grpc::Server
+{
+
+/**
+ * Metrics of a cobrazz grpc server, labeled by its port:
+ * live rpc per shard of the rpc registry and in total,
+ * state of concurrency limiters (if enabled) per task processor.
+ **/
+class ServerStatisticsProvider final
+  : public UServerUtils::Statistics::StatisticsProvider
+{
+public:
+  using Writer = UServerUtils::Statistics::Writer;
+
+public:
+  ServerStatisticsProvider(
+    ServerCoro* server,
+    const std::size_t port);
+
+  ~ServerStatisticsProvider() override = default;
+
+  void write(Writer& writer) override;
+
+  std::string name() override;
+
+private:
+  using LabelView = userver::utils::statistics::LabelView;
+
+private:
+  void write_rpc_pool(Writer& writer);
+
+  void write_concurrency_limiters(Writer& writer);
+
+private:
+  const ServerCoro_var server_;
+
+  const std::string port_;
+};
+
+} // namespace UServerUtils::Grpc::Server
+
+#endif // GRPC_SERVER_SERVER_STATISTICS_PROVIDER_H_
@@ -4,12 +4,10 @@
 // STD
 #include <memory>
 
-// USERVER
-#include <userver/concurrent/queue.hpp>
-
 // THIS
 #include <Generics/Uncopyable.hpp>
 #include <Logger/Logger.hpp>
+#include <UServerUtils/Grpc/Server/QueueRingCoro.hpp>
 #include <UServerUtils/Grpc/Server/RpcHandlerImpl.hpp>
 #include <UServerUtils/Component.hpp>
 
@@ -114,7 +112,7 @@ struct DataQueueCoro final
     const Type type = Type::Read,
     RequestPtr&& request = {},
     WriterPtr&& writer = {},
-    const IdRpc id_rpc = 0)
+    const IdRpc id_rpc = 0) noexcept
     : type(type),
       request(std::move(request)),
       writer(std::move(writer)),
@@ -123,9 +121,9 @@ struct DataQueueCoro final
   }
 
   DataQueueCoro(const DataQueueCoro&) = delete;
-  DataQueueCoro(DataQueueCoro&&) = default;
+  DataQueueCoro(DataQueueCoro&&) noexcept = default;
   DataQueueCoro& operator=(const DataQueueCoro&) = delete;
-  DataQueueCoro& operator=(DataQueueCoro&&) = default;
+  DataQueueCoro& operator=(DataQueueCoro&&) noexcept = default;
 
   Type type;
   RequestPtr request;
@@ -186,9 +184,7 @@ private:
 };
 
 template<class Request, class Response>
-using QueueCoro = userver::concurrent::GenericQueue<
-  DataQueueCoro<Request, Response>,
-  userver::concurrent::impl::SimpleQueuePolicy<false, false>>;
+using QueueCoro = QueueRingCoro<DataQueueCoro<Request, Response>>;
 
 template<class Request, class Response>
 class QueueReader final : public Reader<Request, Response>
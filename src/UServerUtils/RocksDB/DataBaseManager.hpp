@@ -3,6 +3,8 @@
 
 // Rocksdb
 #include <rocksdb/async_result.h>
+#include <rocksdb/iterator.h>
+#include <rocksdb/write_batch.h>
 
 // POSIX
 #include <liburing.h>
@@ -12,6 +14,7 @@
 #include <boost/thread/scoped_thread.hpp>
 
 // STD
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <thread>
@@ -49,10 +52,27 @@ public:
   using WriteOptions = rocksdb::WriteOptions;
   using PutCallback = Utils::Function<void(Status&&)>;
   using EraseCallback = Utils::Function<void(Status&&)>;
+  using WriteBatch = rocksdb::WriteBatch;
+  using WriteBatchCallback = Utils::Function<void(Status&&)>;
+  using KeyValue = std::pair<std::string, std::string>;
+  using KeyValues = std::vector<KeyValue>;
+  using IterateCallback = Utils::Function<void(Status&&, KeyValues&&)>;
   using DataBasePtr = std::shared_ptr<DataBase>;
 
   DECLARE_EXCEPTION(Exception, eh::DescriptiveException);
 
+  /**
+   * Keys in [begin, end). Empty begin means first key,
+   * empty end means no upper bound.
+   **/
+  struct ScanRange final
+  {
+    std::string begin;
+    std::string end;
+  };
+
+  class Iterator;
+
 private:
   using Semaphore = FileManager::Semaphore;
   using IoUring = FileManager::IoUring;
@@ -69,6 +89,8 @@ private:
     Erase,
     Get,
     MultiGet,
+    WriteBatch,
+    Iterate
   };
 
   struct CloseEventData final
@@ -180,6 +202,79 @@ private:
     MultiGetCallback callback;
   };
 
+  struct WriteBatchEventData final
+  {
+    explicit WriteBatchEventData(
+      const DataBasePtr& db,
+      const WriteOptions& write_options,
+      WriteBatch&& write_batch,
+      WriteBatchCallback&& callback)
+      : db(db),
+        write_options(write_options),
+        write_batch(std::move(write_batch)),
+        callback(std::move(callback))
+    {
+    }
+
+    ~WriteBatchEventData() = default;
+
+    DataBasePtr db;
+    WriteOptions write_options;
+    WriteBatch write_batch;
+    WriteBatchCallback callback;
+  };
+
+  struct IteratorState final : private Generics::Uncopyable
+  {
+    explicit IteratorState(
+      const DataBasePtr& db,
+      ColumnFamilyHandle* column_family,
+      const ReadOptions& read_options,
+      ScanRange&& range,
+      std::string&& prefix,
+      const std::size_t max_chunk_size,
+      const std::size_t max_chunk_bytes);
+
+    ~IteratorState() = default;
+
+    DataBasePtr db;
+    ColumnFamilyHandle* column_family = nullptr;
+    ReadOptions read_options;
+    ScanRange range;
+    // Checked only when prefix has no successor (all bytes are 0xff).
+    std::string prefix;
+    rocksdb::Slice upper_bound;
+    std::size_t max_chunk_size = 0;
+    std::size_t max_chunk_bytes = 0;
+    std::unique_ptr<rocksdb::Iterator> iterator;
+    std::atomic<bool> is_finished{false};
+  };
+
+  using IteratorStatePtr = std::shared_ptr<IteratorState>;
+
+  // Request of chunk, state is null for close of iterator thread.
+  // Status and key_values are set by iterator thread.
+  struct IterateEventData final
+  {
+    explicit IterateEventData(
+      const IteratorStatePtr& state,
+      IterateCallback&& callback)
+      : state(state),
+        callback(std::move(callback))
+    {
+    }
+
+    ~IterateEventData() = default;
+
+    IterateEventData(IterateEventData&&) = default;
+    IterateEventData& operator=(IterateEventData&&) = default;
+
+    IteratorStatePtr state;
+    IterateCallback callback;
+    Status status;
+    KeyValues key_values;
+  };
+
   struct Event final
   {
     using Data = std::variant<
@@ -187,7 +282,9 @@ private:
       GetEventData,
       MultiGetEventData,
       PutEventData,
-      EraseEventData>;
+      EraseEventData,
+      WriteBatchEventData,
+      IterateEventData>;
 
     explicit Event(
       const DataBasePtr& db,
@@ -259,6 +356,29 @@ private:
     {
     }
 
+    explicit Event(
+      const DataBasePtr& db,
+      const WriteOptions& write_options,
+      WriteBatch&& write_batch,
+      WriteBatchCallback&& callback)
+      : type(EventType::WriteBatch),
+        data(
+          std::in_place_type<WriteBatchEventData>,
+          db,
+          write_options,
+          std::move(write_batch),
+          std::move(callback))
+    {
+    }
+
+    explicit Event(IterateEventData&& iterate_data)
+      : type(EventType::Iterate),
+        data(
+          std::in_place_type<IterateEventData>,
+          std::move(iterate_data))
+    {
+    }
+
     explicit Event()
       : type(EventType::Close),
         data(std::in_place_type<CloseEventData>)
@@ -287,6 +407,8 @@ private:
   using EventPtr = std::unique_ptr<Event>;
   using EventQueue = UServerUtils::Grpc::Common::QueueAtomic<Event>;
   using EventQueuePtr = std::shared_ptr<EventQueue>;
+  using IterateQueue = UServerUtils::Grpc::Common::QueueAtomic<IterateEventData>;
+  using IterateQueuePtr = std::shared_ptr<IterateQueue>;
   using SemaphorePtr = std::shared_ptr<Semaphore>;
 
 public:
@@ -389,7 +511,65 @@ public:
     const WriteOptions& write_options,
     const std::string_view key) noexcept;
 
+  /**
+   * All updates of write_batch are applied atomically.
+   * WriteOptions::disableWAL must be true (not implemented).
+   **/
+  void write_batch(
+    const DataBasePtr& db,
+    const WriteOptions& write_options,
+    WriteBatch&& write_batch,
+    WriteBatchCallback&& callback) noexcept;
+
+  /**
+   * If call from coroutine, block coroutine.
+   * Otherwise block thread.
+   **/
+  Status write_batch(
+    const DataBasePtr& db,
+    const WriteOptions& write_options,
+    WriteBatch&& write_batch) noexcept;
+
+  /**
+   * Iterator reads keys of range in chunks of at most max_chunk_size
+   * entries (or max_chunk_bytes of keys and values). Chunks are read
+   * with ReadOptions::async_io by the iterator thread, so a scan never
+   * holds the event thread; callback is called on the event thread.
+   * DataBaseManager must survive the iterator.
+   **/
+  Iterator create_iterator(
+    const DataBasePtr& db,
+    ColumnFamilyHandle& column_family,
+    const ReadOptions& read_options,
+    ScanRange&& range,
+    const std::size_t max_chunk_size = 1000,
+    const std::size_t max_chunk_bytes = 1024 * 1024);
+
+  Iterator create_prefix_iterator(
+    const DataBasePtr& db,
+    ColumnFamilyHandle& column_family,
+    const ReadOptions& read_options,
+    const std::string_view prefix,
+    const std::size_t max_chunk_size = 1000,
+    const std::size_t max_chunk_bytes = 1024 * 1024);
+
 private:
+  void iterate(
+    const IteratorStatePtr& state,
+    IterateCallback&& callback) noexcept;
+
+  static void read_chunk(
+    IteratorState& state,
+    Status& status,
+    KeyValues& key_values);
+
+  void run_iterate() noexcept;
+
+  // Pass read chunk to the event thread
+  void complete_iterate(IterateEventData&& data) noexcept;
+
+  void stop_iterate() noexcept;
+
   void initialize(IoUringPtr&& uring);
 
   void run(
@@ -428,9 +608,52 @@ private:
 
   std::uint32_t max_size_cq_queue_;
 
+  const IterateQueuePtr iterate_queue_;
+
+  const SemaphorePtr iterate_semaphore_;
+
+  ThreadPtr iterate_thread_;
+
   ThreadPtr thread_;
 };
 
+class DataBaseManager::Iterator final
+{
+public:
+  Iterator(Iterator&&) = default;
+  Iterator& operator=(Iterator&&) = default;
+  Iterator(const Iterator&) = delete;
+  Iterator& operator=(const Iterator&) = delete;
+
+  ~Iterator() = default;
+
+  /**
+   * Callback receives next chunk. Empty chunk with ok status means
+   * the end of range. Only one request may be in flight at a time.
+   **/
+  void next(IterateCallback&& callback) noexcept;
+
+  /**
+   * If call from coroutine, block coroutine.
+   * Otherwise block thread.
+   **/
+  Status next(KeyValues& key_values) noexcept;
+
+  bool is_finished() const noexcept;
+
+private:
+  friend class DataBaseManager;
+
+  explicit Iterator(
+    DataBaseManager& db_manager,
+    const IteratorStatePtr& state) noexcept;
+
+private:
+  DataBaseManager* db_manager_ = nullptr;
+
+  IteratorStatePtr state_;
+};
+
 } // namespace UServerUtils::Grpc::RocksDB
 
 #include <UServerUtils/RocksDB/DataBaseManager.ipp>
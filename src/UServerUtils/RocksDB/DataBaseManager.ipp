@@ -1,4 +1,5 @@
 // STD
+#include <algorithm>
 #include <sstream>
 
 // USERVER
@@ -19,13 +20,72 @@ inline constexpr char DATA_BASE_MANAGER[] = "DATA_BASE_MANAGER";
 
 } // namespace Aspect
 
+namespace Internal
+{
+
+/**
+ * Smallest key greater than all keys starting with prefix.
+ * Empty if there is no such key (prefix is empty or consists of 0xff).
+ **/
+inline std::string prefix_successor(const std::string_view prefix)
+{
+  std::string result(prefix);
+  while (!result.empty() && static_cast<unsigned char>(result.back()) == 0xff)
+  {
+    result.pop_back();
+  }
+
+  if (!result.empty())
+  {
+    result.back() = static_cast<char>(
+      static_cast<unsigned char>(result.back()) + 1);
+  }
+
+  return result;
+}
+
+} // namespace Internal
+
+inline DataBaseManager::IteratorState::IteratorState(
+  const DataBasePtr& db,
+  ColumnFamilyHandle* column_family,
+  const ReadOptions& read_options,
+  ScanRange&& range,
+  std::string&& prefix,
+  const std::size_t max_chunk_size,
+  const std::size_t max_chunk_bytes)
+  : db(db),
+    column_family(column_family),
+    read_options(read_options),
+    range(std::move(range)),
+    prefix(std::move(prefix)),
+    max_chunk_size(std::max<std::size_t>(max_chunk_size, 1)),
+    max_chunk_bytes(std::max<std::size_t>(max_chunk_bytes, 1))
+{
+  // Iterator is served by rocksdb's own async prefetching,
+  // not by the io_uring of DataBaseManager.
+  this->read_options.io_uring_option = nullptr;
+  this->read_options.async_io = true;
+  this->read_options.adaptive_readahead = true;
+  if (!this->range.end.empty())
+  {
+    upper_bound = rocksdb::Slice(this->range.end);
+    this->read_options.iterate_upper_bound = &upper_bound;
+  }
+}
+
 inline DataBaseManager::DataBaseManager(
   const Config& config,
   Logger* logger)
   : logger_(ReferenceCounting::add_ref(logger)),
     event_queue_(std::make_shared<EventQueue>(
       config.event_queue_max_size)),
-    semaphore_(std::make_shared<Semaphore>(Semaphore::Type::Blocking, 0))
+    semaphore_(std::make_shared<Semaphore>(Semaphore::Type::Blocking, 0)),
+    iterate_queue_(std::make_shared<IterateQueue>(
+      config.event_queue_max_size)),
+    iterate_semaphore_(std::make_shared<Semaphore>(
+      Semaphore::Type::Blocking,
+      0))
 {
   auto uring = std::make_unique<IoUring>(config);
   uring_fd_ = uring->get()->ring_fd;
@@ -39,7 +99,12 @@ inline DataBaseManager::DataBaseManager(
   : logger_(ReferenceCounting::add_ref(logger)),
     event_queue_(std::make_shared<EventQueue>(
       config.event_queue_max_size)),
-    semaphore_(std::make_shared<Semaphore>(Semaphore::Type::Blocking, 0))
+    semaphore_(std::make_shared<Semaphore>(Semaphore::Type::Blocking, 0)),
+    iterate_queue_(std::make_shared<IterateQueue>(
+      config.event_queue_max_size)),
+    iterate_semaphore_(std::make_shared<Semaphore>(
+      Semaphore::Type::Blocking,
+      0))
 {
   auto uring = std::make_unique<IoUring>(config, uring_fd);
   uring_fd_ = uring_fd;
@@ -48,6 +113,9 @@ inline DataBaseManager::DataBaseManager(
 
 inline DataBaseManager::~DataBaseManager()
 {
+  // Chunks requested before are passed to event queue
+  stop_iterate();
+
   try
   {
     while (!event_queue_->emplace())
@@ -90,11 +158,23 @@ inline void DataBaseManager::initialize(IoUringPtr&& uring)
     throw Exception(stream.str());
   }
 
-  thread_ = std::make_unique<Thread>(
-    &DataBaseManager::run,
-    this,
-    semaphore_,
-    std::move(uring));
+  iterate_thread_ = std::make_unique<Thread>(
+    &DataBaseManager::run_iterate,
+    this);
+
+  try
+  {
+    thread_ = std::make_unique<Thread>(
+      &DataBaseManager::run,
+      this,
+      semaphore_,
+      std::move(uring));
+  }
+  catch (...)
+  {
+    stop_iterate();
+    throw;
+  }
 }
 
 inline void DataBaseManager::run(
@@ -250,6 +330,8 @@ inline void DataBaseManager::on_semaphore_ready(
       case EventType::Erase:
       case EventType::Get:
       case EventType::MultiGet:
+      case EventType::WriteBatch:
+      case EventType::Iterate:
       {
         number_remain_operaions += 1;
         do_async_work(
@@ -403,6 +485,49 @@ inline rocksdb::async_result DataBaseManager::do_async_work(
       *number_remain_operaions -= 1;
       break;
     }
+    case EventType::WriteBatch:
+    {
+      auto& event_data = std::get<WriteBatchEventData>(event->data);
+      auto& db = event_data.db;
+      auto& write_batch = event_data.write_batch;
+      auto& callback = event_data.callback;
+      auto& write_options = event_data.write_options;
+      write_options.io_uring_option = io_uring_options;
+
+      auto async_result = db->get().AsyncWrite(
+        write_options,
+        &write_batch);
+      co_await async_result;
+
+      auto status = async_result.result();
+      try
+      {
+        callback(std::move(status));
+      }
+      catch (...)
+      {
+      }
+
+      *number_remain_operaions -= 1;
+      break;
+    }
+    case EventType::Iterate:
+    {
+      // Chunk is read by iterator thread
+      auto& event_data = std::get<IterateEventData>(event->data);
+      try
+      {
+        event_data.callback(
+          std::move(event_data.status),
+          std::move(event_data.key_values));
+      }
+      catch (...)
+      {
+      }
+
+      *number_remain_operaions -= 1;
+      break;
+    }
     default:
     {
     }
@@ -411,6 +536,71 @@ inline rocksdb::async_result DataBaseManager::do_async_work(
   co_return nullptr;
 }
 
+inline void DataBaseManager::read_chunk(
+  IteratorState& state,
+  Status& status,
+  KeyValues& key_values)
+{
+  if (state.is_finished.load(std::memory_order_acquire))
+  {
+    return;
+  }
+
+  if (!state.iterator)
+  {
+    state.iterator.reset(state.db->get().NewIterator(
+      state.read_options,
+      state.column_family));
+    if (state.range.begin.empty())
+    {
+      state.iterator->SeekToFirst();
+    }
+    else
+    {
+      state.iterator->Seek(state.range.begin);
+    }
+  }
+
+  auto& iterator = *state.iterator;
+  const rocksdb::Slice prefix(state.prefix);
+  bool is_end = false;
+  std::size_t chunk_bytes = 0;
+  key_values.reserve(std::min<std::size_t>(state.max_chunk_size, 1024));
+  while (key_values.size() < state.max_chunk_size
+    && chunk_bytes < state.max_chunk_bytes)
+  {
+    if (!iterator.Valid())
+    {
+      is_end = true;
+      break;
+    }
+
+    const auto key = iterator.key();
+    if (!prefix.empty() && !key.starts_with(prefix))
+    {
+      is_end = true;
+      break;
+    }
+
+    const auto value = iterator.value();
+    chunk_bytes += key.size() + value.size();
+    key_values.emplace_back(key.ToString(), value.ToString());
+    iterator.Next();
+  }
+
+  status = iterator.status();
+  if (is_end || !status.ok())
+  {
+    if (!status.ok())
+    {
+      key_values.clear();
+    }
+
+    state.iterator.reset();
+    state.is_finished.store(true, std::memory_order_release);
+  }
+}
+
 inline void DataBaseManager::get(
   const DataBasePtr& db,
   ColumnFamilyHandle& column_family,
@@ -907,6 +1097,447 @@ inline DataBaseManager::Status DataBaseManager::erase(
   return Status::Corruption();
 }
 
+inline void DataBaseManager::write_batch(
+  const DataBasePtr& db,
+  const WriteOptions& write_options,
+  WriteBatch&& write_batch,
+  WriteBatchCallback&& callback) noexcept
+{
+  add_event_to_queue(
+    db,
+    write_options,
+    std::move(write_batch),
+    std::move(callback));
+}
+
+inline DataBaseManager::Status DataBaseManager::write_batch(
+  const DataBasePtr& db,
+  const WriteOptions& write_options,
+  WriteBatch&& write_batch) noexcept
+{
+  try
+  {
+    const bool is_coroutine_thread =
+      userver::engine::current_task::IsTaskProcessorThread();
+    if (is_coroutine_thread)
+    {
+      userver::engine::Promise<Status> promise;
+      auto future = promise.get_future();
+      WriteBatchCallback callback([promise = std::move(promise)] (
+        Status&& status) mutable {
+          try
+          {
+            promise.set_value(std::move(status));
+          }
+          catch (...)
+          {
+          }
+      });
+
+      this->write_batch(
+        db,
+        write_options,
+        std::move(write_batch),
+        std::move(callback));
+
+      return future.get();
+    }
+    else
+    {
+      std::promise<Status> promise;
+      auto future = promise.get_future();
+      WriteBatchCallback callback([promise = std::move(promise)] (
+        Status&& status) mutable {
+          try
+          {
+            promise.set_value(std::move(status));
+          }
+          catch (...)
+          {
+          }
+      });
+
+      this->write_batch(
+        db,
+        write_options,
+        std::move(write_batch),
+        std::move(callback));
+
+      return future.get();
+    }
+  }
+  catch (const eh::Exception& exc)
+  {
+    try
+    {
+      std::ostringstream stream;
+      stream << FNS
+             << exc.what();
+      logger_->error(stream.str(), Aspect::DATA_BASE_MANAGER);
+    }
+    catch (...)
+    {
+    }
+  }
+  catch (...)
+  {
+    try
+    {
+      std::ostringstream stream;
+      stream << FNS
+             << "Unknown error";
+      logger_->error(stream.str(), Aspect::DATA_BASE_MANAGER);
+    }
+    catch (...)
+    {
+    }
+  }
+
+  return Status::Corruption();
+}
+
+inline DataBaseManager::Iterator DataBaseManager::create_iterator(
+  const DataBasePtr& db,
+  ColumnFamilyHandle& column_family,
+  const ReadOptions& read_options,
+  ScanRange&& range,
+  const std::size_t max_chunk_size,
+  const std::size_t max_chunk_bytes)
+{
+  auto state = std::make_shared<IteratorState>(
+    db,
+    &column_family,
+    read_options,
+    std::move(range),
+    std::string{},
+    max_chunk_size,
+    max_chunk_bytes);
+  return Iterator(*this, state);
+}
+
+inline DataBaseManager::Iterator DataBaseManager::create_prefix_iterator(
+  const DataBasePtr& db,
+  ColumnFamilyHandle& column_family,
+  const ReadOptions& read_options,
+  const std::string_view prefix,
+  const std::size_t max_chunk_size,
+  const std::size_t max_chunk_bytes)
+{
+  ScanRange range{
+    std::string(prefix),
+    Internal::prefix_successor(prefix)};
+  std::string check_prefix;
+  if (range.end.empty())
+  {
+    check_prefix = prefix;
+  }
+
+  auto state = std::make_shared<IteratorState>(
+    db,
+    &column_family,
+    read_options,
+    std::move(range),
+    std::move(check_prefix),
+    max_chunk_size,
+    max_chunk_bytes);
+  return Iterator(*this, state);
+}
+
+inline void DataBaseManager::iterate(
+  const IteratorStatePtr& state,
+  IterateCallback&& callback) noexcept
+{
+  try
+  {
+    if (!iterate_queue_->emplace(state, std::move(callback)))
+    {
+      std::stringstream stream;
+      stream << FNS
+             << "iterate_queue size limit is reached";
+      logger_->error(stream.str(), Aspect::DATA_BASE_MANAGER);
+
+      callback(
+        rocksdb::Status::Aborted("Iterate_queue size limit is reached"),
+        KeyValues{});
+      return;
+    }
+
+    [[maybe_unused]] const bool is_added = iterate_semaphore_->add();
+    assert(is_added);
+  }
+  catch (const eh::Exception& exc)
+  {
+    try
+    {
+      callback(rocksdb::Status::Aborted(exc.what()), KeyValues{});
+
+      std::ostringstream stream;
+      stream << FNS
+             << exc.what();
+      logger_->error(stream.str(), Aspect::DATA_BASE_MANAGER);
+    }
+    catch (...)
+    {
+    }
+  }
+  catch (...)
+  {
+    try
+    {
+      callback(rocksdb::Status::Aborted("Unknown error"), KeyValues{});
+
+      std::ostringstream stream;
+      stream << FNS
+             << "Unknow error";
+      logger_->error(stream.str(), Aspect::DATA_BASE_MANAGER);
+    }
+    catch (...)
+    {
+    }
+  }
+}
+
+inline void DataBaseManager::run_iterate() noexcept
+{
+  while (true)
+  {
+    if (!iterate_semaphore_->consume())
+    {
+      continue;
+    }
+
+    std::unique_ptr<IterateEventData> data;
+    do
+    {
+      data = iterate_queue_->pop();
+    }
+    while (!data);
+
+    if (!data->state)
+    {
+      return;
+    }
+
+    auto& state = *data->state;
+    try
+    {
+      read_chunk(state, data->status, data->key_values);
+    }
+    catch (const std::exception& exc)
+    {
+      data->key_values.clear();
+      state.iterator.reset();
+      state.is_finished.store(true, std::memory_order_release);
+      data->status = Status::Aborted(exc.what());
+    }
+    catch (...)
+    {
+      data->key_values.clear();
+      state.iterator.reset();
+      state.is_finished.store(true, std::memory_order_release);
+      data->status = Status::Aborted("Unknown error");
+    }
+
+    complete_iterate(std::move(*data));
+  }
+}
+
+inline void DataBaseManager::complete_iterate(
+  IterateEventData&& data) noexcept
+{
+  try
+  {
+    // Chunk is read already, completion waits for room in event queue
+    while (!event_queue_->emplace(std::move(data)))
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    [[maybe_unused]] const bool is_added = semaphore_->add();
+    assert(is_added);
+  }
+  catch (...)
+  {
+    try
+    {
+      data.callback(
+        rocksdb::Status::Aborted("Event_queue is failed"),
+        KeyValues{});
+    }
+    catch (...)
+    {
+    }
+  }
+}
+
+inline void DataBaseManager::stop_iterate() noexcept
+{
+  if (!iterate_thread_)
+  {
+    return;
+  }
+
+  try
+  {
+    while (!iterate_queue_->emplace(IteratorStatePtr{}, IterateCallback{}))
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    [[maybe_unused]] const bool is_added = iterate_semaphore_->add();
+    assert(is_added);
+    iterate_thread_.reset();
+  }
+  catch (...)
+  {
+    try
+    {
+      std::ostringstream stream;
+      stream << FNS
+             << "Iterator thread is not stopped";
+      logger_->critical(stream.str(), Aspect::DATA_BASE_MANAGER);
+    }
+    catch (...)
+    {
+    }
+  }
+}
+
+inline DataBaseManager::Iterator::Iterator(
+  DataBaseManager& db_manager,
+  const IteratorStatePtr& state) noexcept
+  : db_manager_(&db_manager),
+    state_(state)
+{
+}
+
+inline bool DataBaseManager::Iterator::is_finished() const noexcept
+{
+  return !state_ || state_->is_finished.load(std::memory_order_acquire);
+}
+
+inline void DataBaseManager::Iterator::next(
+  IterateCallback&& callback) noexcept
+{
+  if (!state_)
+  {
+    try
+    {
+      callback(
+        rocksdb::Status::InvalidArgument("Iterator is moved"),
+        KeyValues{});
+    }
+    catch (...)
+    {
+    }
+
+    return;
+  }
+
+  db_manager_->iterate(state_, std::move(callback));
+}
+
+inline DataBaseManager::Status DataBaseManager::Iterator::next(
+  KeyValues& key_values) noexcept
+{
+  using Data = std::pair<Status, KeyValues>;
+
+  try
+  {
+    const bool is_coroutine_thread =
+      userver::engine::current_task::IsTaskProcessorThread();
+    if (is_coroutine_thread)
+    {
+      userver::engine::Promise<Data> promise;
+      auto future = promise.get_future();
+      IterateCallback callback([promise = std::move(promise)] (
+        Status&& status,
+        KeyValues&& key_values) mutable {
+          try
+          {
+            Data data(std::move(status), std::move(key_values));
+            promise.set_value(std::move(data));
+          }
+          catch (...)
+          {
+            try
+            {
+              promise.set_exception(std::current_exception());
+            }
+            catch (...)
+            {
+            }
+          }
+      });
+
+      next(std::move(callback));
+      auto result = future.get();
+      key_values = std::move(result.second);
+
+      return std::move(result.first);
+    }
+    else
+    {
+      std::promise<Data> promise;
+      auto future = promise.get_future();
+      IterateCallback callback([promise = std::move(promise)] (
+        Status&& status,
+        KeyValues&& key_values) mutable {
+          try
+          {
+            Data data(std::move(status), std::move(key_values));
+            promise.set_value(std::move(data));
+          }
+          catch (...)
+          {
+            try
+            {
+              promise.set_exception(std::current_exception());
+            }
+            catch (...)
+            {
+            }
+          }
+      });
+
+      next(std::move(callback));
+
+      auto result = future.get();
+      key_values = std::move(result.second);
+      return std::move(result.first);
+    }
+  }
+  catch (const eh::Exception& exc)
+  {
+    try
+    {
+      std::ostringstream stream;
+      stream << FNS
+             << exc.what();
+      db_manager_->logger_->error(stream.str(), Aspect::DATA_BASE_MANAGER);
+    }
+    catch (...)
+    {
+    }
+  }
+  catch (...)
+  {
+    try
+    {
+      std::ostringstream stream;
+      stream << FNS
+             << "Unknown error";
+      db_manager_->logger_->error(stream.str(), Aspect::DATA_BASE_MANAGER);
+    }
+    catch (...)
+    {
+    }
+  }
+
+  key_values.clear();
+  return Status::Corruption();
+}
+
 template<class ...Args>
 inline void DataBaseManager::add_event_to_queue(Args&& ...args) noexcept
 {
@@ -1009,6 +1640,18 @@ inline void DataBaseManager::set_error(
         data.callback(rocksdb::Status::Aborted(error_message));
         break;
       }
+      case EventType::WriteBatch:
+      {
+        auto& data = std::get<WriteBatchEventData>(event.data);
+        data.callback(rocksdb::Status::Aborted(error_message));
+        break;
+      }
+      case EventType::Iterate:
+      {
+        auto& data = std::get<IterateEventData>(event.data);
+        data.callback(rocksdb::Status::Aborted(error_message), KeyValues{});
+        break;
+      }
       default:
       {
       }
@@ -30,6 +30,12 @@ public:
   using WriteOptions = DataBaseManager::WriteOptions;
   using PutCallback = DataBaseManager::PutCallback;
   using EraseCallback = DataBaseManager::EraseCallback;
+  using WriteBatch = DataBaseManager::WriteBatch;
+  using WriteBatchCallback = DataBaseManager::WriteBatchCallback;
+  using KeyValues = DataBaseManager::KeyValues;
+  using IterateCallback = DataBaseManager::IterateCallback;
+  using ScanRange = DataBaseManager::ScanRange;
+  using Iterator = DataBaseManager::Iterator;
   using DataBasePtr = DataBaseManager::DataBasePtr;
 
 private:
@@ -107,6 +113,36 @@ public:
     const WriteOptions& write_options,
     const std::string_view key) noexcept;
 
+  void write_batch(
+    const DataBasePtr& db,
+    const WriteOptions& write_options,
+    WriteBatch&& write_batch,
+    WriteBatchCallback&& callback) noexcept;
+
+  Status write_batch(
+    const DataBasePtr& db,
+    const WriteOptions& write_options,
+    WriteBatch&& write_batch) noexcept;
+
+  /**
+   * All chunks of the iterator are read by the same DataBaseManager.
+   **/
+  Iterator create_iterator(
+    const DataBasePtr& db,
+    ColumnFamilyHandle& column_family,
+    const ReadOptions& read_options,
+    ScanRange&& range,
+    const std::size_t max_chunk_size = 1000,
+    const std::size_t max_chunk_bytes = 1024 * 1024);
+
+  Iterator create_prefix_iterator(
+    const DataBasePtr& db,
+    ColumnFamilyHandle& column_family,
+    const ReadOptions& read_options,
+    const std::string_view prefix,
+    const std::size_t max_chunk_size = 1000,
+    const std::size_t max_chunk_bytes = 1024 * 1024);
+
 private:
   Counter counter_{0};
 
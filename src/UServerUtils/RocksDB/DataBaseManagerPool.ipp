@@ -203,4 +203,78 @@ inline DataBaseManagerPool::Status DataBaseManagerPool::erase(
     key);
 }
 
+inline void DataBaseManagerPool::write_batch(
+  const DataBasePtr& db,
+  const WriteOptions& write_options,
+  WriteBatch&& write_batch,
+  WriteBatchCallback&& callback) noexcept
+{
+  const auto index = counter_.fetch_add(
+    1,
+    std::memory_order_relaxed) % db_managers_.size();
+  auto& db_manager = db_managers_[index];
+  db_manager->write_batch(
+    db,
+    write_options,
+    std::move(write_batch),
+    std::move(callback));
+}
+
+inline DataBaseManagerPool::Status DataBaseManagerPool::write_batch(
+  const DataBasePtr& db,
+  const WriteOptions& write_options,
+  WriteBatch&& write_batch) noexcept
+{
+  const auto index = counter_.fetch_add(
+    1,
+    std::memory_order_relaxed) % db_managers_.size();
+  auto& db_manager = db_managers_[index];
+  return db_manager->write_batch(
+    db,
+    write_options,
+    std::move(write_batch));
+}
+
+inline DataBaseManagerPool::Iterator DataBaseManagerPool::create_iterator(
+  const DataBasePtr& db,
+  ColumnFamilyHandle& column_family,
+  const ReadOptions& read_options,
+  ScanRange&& range,
+  const std::size_t max_chunk_size,
+  const std::size_t max_chunk_bytes)
+{
+  const auto index = counter_.fetch_add(
+    1,
+    std::memory_order_relaxed) % db_managers_.size();
+  auto& db_manager = db_managers_[index];
+  return db_manager->create_iterator(
+    db,
+    column_family,
+    read_options,
+    std::move(range),
+    max_chunk_size,
+    max_chunk_bytes);
+}
+
+inline DataBaseManagerPool::Iterator DataBaseManagerPool::create_prefix_iterator(
+  const DataBasePtr& db,
+  ColumnFamilyHandle& column_family,
+  const ReadOptions& read_options,
+  const std::string_view prefix,
+  const std::size_t max_chunk_size,
+  const std::size_t max_chunk_bytes)
+{
+  const auto index = counter_.fetch_add(
+    1,
+    std::memory_order_relaxed) % db_managers_.size();
+  auto& db_manager = db_managers_[index];
+  return db_manager->create_prefix_iterator(
+    db,
+    column_family,
+    read_options,
+    prefix,
+    max_chunk_size,
+    max_chunk_bytes);
+}
+
 } // namespace UServerUtils::Grpc::RocksDB
\ No newline at end of file
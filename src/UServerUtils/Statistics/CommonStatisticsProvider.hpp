@@ -2,7 +2,14 @@
 #define USERVER_STATISTICS_COMMONSTATISTICSPROVIDER_HPP
 
 // STD
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
 #include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <variant>
 #include <vector>
@@ -56,14 +63,6 @@ private:
   using Label = userver::utils::statistics::Label;
   using LabelView = userver::utils::statistics::LabelView;
 
-  struct Counter final
-  {
-    std::atomic<std::uint64_t> uint_value{0};
-    std::atomic<std::int64_t> int_value{0};
-    std::atomic<double> double_value{0.0};
-    std::atomic<bool> bool_value{false};
-  };
-
   using Key = std::variant<std::string_view, std::int64_t>;
   class Visitor final
   {
@@ -83,25 +82,79 @@ private:
     }
   };
 
-  using Counters = Map<Key, Counter>;
+  /**
+   * Counter of one label. Key of a string label points to name_label.
+   * Labels may be many, so the value is a single atomic: uint and int
+   * in two's complement, double as its bits, bool as 0/1.
+   **/
+  struct Node final
+  {
+    Node(
+      std::string&& name_label,
+      const Key& key)
+      : name_label(std::move(name_label)),
+        key(key)
+    {
+    }
+
+    const std::string name_label;
+    Key key;
+    std::atomic<std::uint64_t> value{0};
+  };
+  using NodePtr = std::unique_ptr<Node>;
+
+  /**
+   * Open addressing table of nodes, linear probing. A slot is filled
+   * once and never changes, so lookups need no lock. Load factor is
+   * kept at most 1/2: a full table is replaced by one twice as large.
+   **/
+  struct Index final
+  {
+    explicit Index(const std::size_t number_slots)
+      : slots(std::make_unique<std::atomic<Node*>[]>(number_slots)),
+        mask(number_slots - 1)
+    {
+    }
+
+    std::unique_ptr<std::atomic<Node*>[]> slots;
+    const std::size_t mask;
+    std::size_t size = 0;
+  };
+  using IndexPtr = std::unique_ptr<Index>;
+  using Indexes = std::vector<IndexPtr>;
+
+  using Counters = Map<Key, NodePtr>;
   using Types = std::vector<CommonType>;
   using Names = std::vector<std::string>;
-  using NameLabels = std::vector<std::string>;
 
+  /**
+   * Labels are looked up lock-free in index. The mutex serializes
+   * insertions of new labels and guards counters, which own the nodes
+   * and keep the scrape order. Replaced indexes are kept until
+   * destruction: lookups may still walk them (all of them together
+   * are smaller than the current one).
+   **/
   struct Statistic final
   {
-    Statistic(Counters&& counters)
+    Statistic(
+      Counters&& counters,
+      const std::size_t number_slots)
       : counters(std::move(counters))
     {
+      indexes.emplace_back(std::make_unique<Index>(number_slots));
+      index.store(indexes.back().get(), std::memory_order_relaxed);
     }
 
     Counters counters;
-    NameLabels name_labels;
+    std::atomic<Index*> index{nullptr};
+    Indexes indexes;
     SharedMutex mutex;
   };
   using StatisticPtr = std::unique_ptr<Statistic>;
   using Statistics = std::vector<StatisticPtr>;
 
+  static constexpr std::size_t k_default_initial_size = 32;
+
 public:
   DECLARE_EXCEPTION(Exception, eh::DescriptiveException);
 
@@ -141,22 +194,33 @@ public:
         throw Exception(stream.str());
       }
 
+      const std::size_t number_slots = 2 * std::bit_ceil(
+        std::max<std::size_t>(
+          initial_size_.value_or(k_default_initial_size),
+          1));
       if (initial_size_.has_value())
       {
         if constexpr (std::is_constructible_v<Counters, std::size_t>)
         {
           statistics_.emplace_back(
-            std::make_unique<Statistic>(Counters{*initial_size_}));
+            std::make_unique<Statistic>(
+              Counters{*initial_size_},
+              number_slots));
         }
         else
         {
-          statistics_.emplace_back();
+          statistics_.emplace_back(
+            std::make_unique<Statistic>(
+              Counters{},
+              number_slots));
         }
       }
       else
       {
         statistics_.emplace_back(
-          std::make_unique<Statistic>(Counters{}));
+          std::make_unique<Statistic>(
+            Counters{},
+            number_slots));
       }
 
       types_.emplace_back(data.first);
@@ -173,84 +237,45 @@ public:
   void add(const Enum id, const Label& label, const N n)
   {
     const auto type = types_[static_cast<std::size_t>(id)];
-    auto& statistic = statistics_[static_cast<std::size_t>(id)];
-    auto& mutex = statistic->mutex;
-    auto& counters = statistic->counters;
-    auto& name_labels = statistic->name_labels;
-
-    std::shared_lock shared_lock(mutex);
-    auto it = counters.find(label);
-    if (it != std::end(counters))
-    {
-      auto& counter = it->second;
-      shared_lock.unlock();  // We only add and do not remove elements
-      add(n, counter, type);
-    }
-    else
-    {
-      shared_lock.unlock();
-
-      std::unique_lock unique_lock(mutex);
-      it = counters.find(label);
-      if (it == std::end(counters))
-      {
-        if constexpr (std::is_same_v<Label, std::string_view>)
-        {
-          name_labels.emplace_back(std::begin(label), std::end(label));
-          Key key(std::string_view{name_labels.back()});
-          it = counters.try_emplace(key).first;
-        }
-        else
-        {
-          it = counters.try_emplace(label).first;
-        }
-      }
-
-      auto& counter = it->second;
-      add(n, counter, type);
-    }
+    auto& statistic = *statistics_[static_cast<std::size_t>(id)];
+    add(n, get_counter(statistic, label), type);
   }
 
   template<Internal::Common::LabelConcept Label, NumericConcept N>
   void set(const Enum id, const Label& label, const N n)
   {
     const auto type = types_[static_cast<std::size_t>(id)];
-    auto& statistic = statistics_[static_cast<std::size_t>(id)];
-    auto& mutex = statistic->mutex;
-    auto& counters = statistic->counters;
-    auto& name_labels = statistic->name_labels;
-
-    std::shared_lock shared_lock(mutex);
-    auto it = counters.find(label);
-    if (it != std::end(counters))
+    auto& statistic = *statistics_[static_cast<std::size_t>(id)];
+    set(n, get_counter(statistic, label), type);
+  }
+
+  // Current value of the label, zero if the label is not updated yet.
+  template<NumericConcept N, Internal::Common::LabelConcept Label>
+  N get(const Enum id, const Label& label) const
+  {
+    const auto type = types_[static_cast<std::size_t>(id)];
+    const auto& statistic = *statistics_[static_cast<std::size_t>(id)];
+    const Key key = to_key(label);
+    const auto* node = find(statistic, std::hash<Key>{}(key), key);
+    if (!node)
     {
-      auto& counter = it->second;
-      shared_lock.unlock();  // We only add and do not remove elements
-      set(n, counter, type);
+      return N{};
     }
-    else
-    {
-      shared_lock.unlock();
-
-      std::unique_lock unique_lock(mutex);
-      it = counters.find(label);
-      if (it == std::end(counters))
-      {
-        if constexpr (std::is_same_v<Label, std::string_view>)
-        {
-          name_labels.emplace_back(std::begin(label), std::end(label));
-          Key key(std::string_view{name_labels.back()});
-          it = counters.try_emplace(key).first;
-        }
-        else
-        {
-          it = counters.try_emplace(label).first;
-        }
-      }
 
-      auto& counter = it->second;
-      set(n, counter, type);
+    const auto value = node->value.load(std::memory_order_relaxed);
+    switch (type)
+    {
+    case CommonType::UInt:
+      return static_cast<N>(value);
+    case CommonType::Int:
+      return static_cast<N>(static_cast<std::int64_t>(value));
+    case CommonType::Bool:
+      return static_cast<N>(value != 0);
+    case CommonType::Double:
+      return static_cast<N>(std::bit_cast<double>(value));
     }
+
+    return N{};
   }
 
 private:
@@ -266,31 +291,33 @@ private:
       const auto& name = names_[i];
       const auto type = types_[i];
 
-      std::unique_lock lock(mutex);
-      for (auto& [key, counter] : counters)
+      // Updates of existing labels do not take the mutex.
+      std::shared_lock lock(mutex);
+      for (auto& [key, node] : counters)
       {
         const std::string value = std::visit(visitor, key);
+        auto& counter = node->value;
         switch (type)
         {
         case CommonType::UInt:
           writer.ValueWithLabels(
-            counter.uint_value.load(std::memory_order_relaxed),
+            counter.load(std::memory_order_relaxed),
             {LabelView(name, value)});
           break;
         case CommonType::Int:
           writer.ValueWithLabels(
-            counter.int_value.load(std::memory_order_relaxed),
+            static_cast<std::int64_t>(
+              counter.load(std::memory_order_relaxed)),
             {LabelView(name, value)});
           break;
         case CommonType::Bool:
           writer.ValueWithLabels(
-            counter.bool_value.load(std::memory_order_relaxed),
+            counter.exchange(0, std::memory_order_relaxed) != 0,
             {LabelView(name, value)});
-          counter.bool_value.store(false, std::memory_order_relaxed);
           break;
         case CommonType::Double:
           writer.ValueWithLabels(
-            counter.double_value.load(std::memory_order_relaxed),
+            std::bit_cast<double>(counter.load(std::memory_order_relaxed)),
             {LabelView(name, value)});
           break;
         }
@@ -298,42 +325,173 @@ private:
     }
   }
 
+  template<Internal::Common::LabelConcept Label>
+  static Key to_key(const Label& label) noexcept
+  {
+    if constexpr (std::is_same_v<Label, std::string_view>)
+    {
+      return Key(label);
+    }
+    else
+    {
+      return Key(static_cast<std::int64_t>(label));
+    }
+  }
+
+  static Node* find(
+    const Statistic& statistic,
+    const std::size_t hash,
+    const Key& key) noexcept
+  {
+    const auto* index = statistic.index.load(std::memory_order_acquire);
+    for (std::size_t i = hash & index->mask;; i = (i + 1) & index->mask)
+    {
+      auto* node = index->slots[i].load(std::memory_order_acquire);
+      if (node == nullptr || node->key == key)
+      {
+        return node;
+      }
+    }
+  }
+
+  // Under unique lock of the statistic mutex.
+  static void insert(
+    Index& index,
+    const std::size_t hash,
+    Node* node) noexcept
+  {
+    std::size_t i = hash & index.mask;
+    while (index.slots[i].load(std::memory_order_relaxed) != nullptr)
+    {
+      i = (i + 1) & index.mask;
+    }
+
+    index.slots[i].store(node, std::memory_order_release);
+    index.size += 1;
+  }
+
+  // Under unique lock of the statistic mutex.
+  static void grow(Statistic& statistic)
+  {
+    const auto& index = *statistic.index.load(std::memory_order_relaxed);
+    auto new_index = std::make_unique<Index>(2 * (index.mask + 1));
+    for (auto& [key, node] : statistic.counters)
+    {
+      insert(*new_index, std::hash<Key>{}(key), node.get());
+    }
+
+    statistic.indexes.emplace_back(std::move(new_index));
+    statistic.index.store(
+      statistic.indexes.back().get(),
+      std::memory_order_release);
+  }
+
+  template<Internal::Common::LabelConcept Label>
+  std::atomic<std::uint64_t>& get_counter(
+    Statistic& statistic,
+    const Label& label)
+  {
+    const Key key = to_key(label);
+    const std::size_t hash = std::hash<Key>{}(key);
+    if (auto* node = find(statistic, hash, key))
+    {
+      return node->value;
+    }
+
+    std::unique_lock unique_lock(statistic.mutex);
+    if (auto* node = find(statistic, hash, key))
+    {
+      return node->value;
+    }
+
+    NodePtr node;
+    if constexpr (std::is_same_v<Label, std::string_view>)
+    {
+      std::string name_label(std::begin(label), std::end(label));
+      node = std::make_unique<Node>(std::move(name_label), key);
+      node->key = Key(std::string_view{node->name_label});
+    }
+    else
+    {
+      node = std::make_unique<Node>(std::string{}, key);
+    }
+
+    auto* node_ptr = node.get();
+    statistic.counters.try_emplace(node_ptr->key, std::move(node));
+
+    auto* index = statistic.index.load(std::memory_order_relaxed);
+    if (2 * (index->size + 1) > index->mask + 1)
+    {
+      // New index already contains the node.
+      grow(statistic);
+    }
+    else
+    {
+      insert(*index, hash, node_ptr);
+    }
+
+    return node_ptr->value;
+  }
+
   template<NumericConcept N>
-  void add(const N n, Counter& counter, const CommonType type)
+  void add(
+    const N n,
+    std::atomic<std::uint64_t>& counter,
+    const CommonType type)
   {
     switch (type)
     {
     case CommonType::UInt:
-      counter.uint_value.fetch_add(static_cast<std::uint64_t>(n), std::memory_order_relaxed);
+      counter.fetch_add(
+        static_cast<std::uint64_t>(n),
+        std::memory_order_relaxed);
       break;
     case CommonType::Int:
-      counter.int_value.fetch_add(static_cast<std::int64_t>(n), std::memory_order_relaxed);
+      counter.fetch_add(
+        static_cast<std::uint64_t>(static_cast<std::int64_t>(n)),
+        std::memory_order_relaxed);
       break;
     case CommonType::Bool:
-      counter.bool_value.store(static_cast<bool>(n), std::memory_order_relaxed);
+      counter.store(static_cast<bool>(n), std::memory_order_relaxed);
       break;
     case CommonType::Double:
-      counter.double_value.fetch_add(static_cast<double>(n), std::memory_order_relaxed);
+    {
+      auto expected = counter.load(std::memory_order_relaxed);
+      while (!counter.compare_exchange_weak(
+        expected,
+        std::bit_cast<std::uint64_t>(
+          std::bit_cast<double>(expected) + static_cast<double>(n)),
+        std::memory_order_relaxed))
+      {
+      }
       break;
     }
+    }
   }
 
   template<NumericConcept N>
-  void set(const N n, Counter& counter, const CommonType type)
+  void set(
+    const N n,
+    std::atomic<std::uint64_t>& counter,
+    const CommonType type)
   {
     switch (type)
     {
     case CommonType::UInt:
-      counter.uint_value.store(static_cast<std::uint64_t>(n), std::memory_order_relaxed);
+      counter.store(static_cast<std::uint64_t>(n), std::memory_order_relaxed);
       break;
     case CommonType::Int:
-      counter.int_value.store(static_cast<std::int64_t>(n), std::memory_order_relaxed);
+      counter.store(
+        static_cast<std::uint64_t>(static_cast<std::int64_t>(n)),
+        std::memory_order_relaxed);
       break;
     case CommonType::Bool:
-      counter.bool_value.store(static_cast<bool>(n), std::memory_order_relaxed);
+      counter.store(static_cast<bool>(n), std::memory_order_relaxed);
       break;
     case CommonType::Double:
-      counter.double_value.store(static_cast<double>(n), std::memory_order_relaxed);
+      counter.store(
+        std::bit_cast<std::uint64_t>(static_cast<double>(n)),
+        std::memory_order_relaxed);
       break;
     }
   }
@@ -15,6 +15,7 @@
 #include <eh/Exception.hpp>
 #include <Generics/Function.hpp>
 #include <UServerUtils/Statistics/Concept.hpp>
+#include <UServerUtils/Statistics/ShardedCounter.hpp>
 #include <UServerUtils/Statistics/StatisticsProvider.hpp>
 
 namespace UServerUtils::Statistics
@@ -57,10 +58,6 @@ private:
 
     CounterType type = UServerUtils::Statistics::CounterType::UInt;
     Label label;
-    std::atomic<std::uint64_t> uint_value{0};
-    std::atomic<std::int64_t> int_value{0};
-    std::atomic<double> double_value{0.0};
-    std::atomic<bool> bool_value{false};
   };
   using Statistics = std::vector<Data>;
 
@@ -70,7 +67,8 @@ public:
 public:
   CounterStatisticsProvider(const std::string& provider_name = "counter")
     : provider_name_(provider_name),
-      statistics_(static_cast<std::size_t>(Enum::Max))
+      statistics_(static_cast<std::size_t>(Enum::Max)),
+      counters_(static_cast<std::size_t>(Enum::Max))
   {
     const auto names_with_typed = Converter{}();
     if (names_with_typed.size() != static_cast<std::size_t>(Enum::Max))
@@ -111,20 +109,22 @@ public:
   template<NumericConcept T>
   void add(const Enum id, const T t) noexcept
   {
-    auto& data = statistics_[static_cast<std::size_t>(id)];
-    switch (data.type)
+    const auto index = static_cast<std::size_t>(id);
+    switch (statistics_[index].type)
     {
     case CounterType::UInt:
-      data.uint_value.fetch_add(static_cast<std::uint64_t>(t), std::memory_order_relaxed);
+      counters_.add_integer(index, static_cast<std::uint64_t>(t));
       break;
     case CounterType::Int:
-      data.int_value.fetch_add(static_cast<std::int64_t>(t), std::memory_order_relaxed);
+      counters_.add_integer(
+        index,
+        static_cast<std::uint64_t>(static_cast<std::int64_t>(t)));
       break;
     case CounterType::Double:
-      data.double_value.fetch_add(static_cast<double>(t), std::memory_order_relaxed);
+      counters_.add_double(index, static_cast<double>(t));
       break;
     case CounterType::Bool:
-      data.bool_value.store(static_cast<bool>(t), std::memory_order_relaxed);
+      counters_.store(index, static_cast<bool>(t));
       break;
     }
   }
@@ -132,24 +132,47 @@ public:
   template<NumericConcept T>
   void set(const Enum id, const T t) noexcept
   {
-    auto& data = statistics_[static_cast<std::size_t>(id)];
-    switch (data.type)
+    const auto index = static_cast<std::size_t>(id);
+    switch (statistics_[index].type)
     {
     case CounterType::UInt:
-      data.uint_value.store(static_cast<std::uint64_t>(t), std::memory_order_relaxed);
+      counters_.set_integer(index, static_cast<std::uint64_t>(t));
       break;
     case CounterType::Int:
-      data.int_value.store(static_cast<std::int64_t>(t), std::memory_order_relaxed);
+      counters_.set_integer(
+        index,
+        static_cast<std::uint64_t>(static_cast<std::int64_t>(t)));
       break;
     case CounterType::Double:
-      data.double_value.store(static_cast<double>(t), std::memory_order_relaxed);
+      counters_.set_double(index, static_cast<double>(t));
       break;
     case CounterType::Bool:
-      data.bool_value.store(static_cast<bool>(t), std::memory_order_relaxed);
+      counters_.store(index, static_cast<bool>(t));
       break;
     }
   }
 
+  // Current value summed over shards.
+  template<NumericConcept T>
+  T get(const Enum id) const noexcept
+  {
+    const auto index = static_cast<std::size_t>(id);
+    switch (statistics_[index].type)
+    {
+    case CounterType::UInt:
+      return static_cast<T>(counters_.sum_integer(index));
+    case CounterType::Int:
+      return static_cast<T>(
+        static_cast<std::int64_t>(counters_.sum_integer(index)));
+    case CounterType::Double:
+      return static_cast<T>(counters_.sum_double(index));
+    case CounterType::Bool:
+      return static_cast<T>(counters_.sum_integer(index) != 0);
+    }
+
+    return T{};
+  }
+
   std::string name() override
   {
     return provider_name_;
@@ -158,31 +181,31 @@ public:
 private:
   void write(Writer& writer) override
   {
-    for (auto& statistic : statistics_)
+    const auto size = statistics_.size();
+    for (std::size_t index = 0; index < size; ++index)
     {
-      const auto type = statistic.type;
-      switch (type)
+      const auto& statistic = statistics_[index];
+      switch (statistic.type)
       {
       case CounterType::UInt:
         writer.ValueWithLabels(
-          statistic.uint_value.load(std::memory_order_relaxed),
+          counters_.sum_integer(index),
           {LabelView(statistic.label)});
         break;
       case CounterType::Int:
         writer.ValueWithLabels(
-          statistic.int_value.load(std::memory_order_relaxed),
+          static_cast<std::int64_t>(counters_.sum_integer(index)),
           {LabelView(statistic.label)});
         break;
       case CounterType::Double:
         writer.ValueWithLabels(
-          statistic.double_value.load(std::memory_order_relaxed),
+          counters_.sum_double(index),
           {LabelView(statistic.label)});
         break;
       case CounterType::Bool:
         writer.ValueWithLabels(
-          statistic.bool_value.load(std::memory_order_relaxed),
+          counters_.exchange(index, false) != 0,
           {LabelView(statistic.label)});
-        statistic.double_value.store(false, std::memory_order_relaxed);
         break;
       }
     }
@@ -192,6 +215,8 @@ private:
   const std::string provider_name_;
 
   Statistics statistics_;
+
+  ShardedCounters counters_;
 };
 
 template<
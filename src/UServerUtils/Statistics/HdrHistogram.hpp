@@ -0,0 +1,139 @@
+#ifndef USERVER_STATISTICS_HDRHISTOGRAM_HPP
+#define USERVER_STATISTICS_HDRHISTOGRAM_HPP
+
+// STD
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+namespace UServerUtils::Statistics
+{
+
+/**
+ * Log-linear (HDR-like) histogram of values in microseconds.
+ * Values below 2 * k_sub_bucket_count have own buckets, every
+ * following power of two is split into k_sub_bucket_count buckets,
+ * so a bucket is at most 1/k_sub_bucket_count of its values wide.
+ * Values above k_max_value (~134 seconds) fall into the last bucket.
+ *
+ * The static part maps values to buckets for the hot path,
+ * an instance merges counts at scrape time.
+ **/
+class HdrHistogram final
+{
+public:
+  static constexpr std::size_t k_sub_bucket_bits = 4;
+
+  static constexpr std::uint64_t k_sub_bucket_count =
+    std::uint64_t{1} << k_sub_bucket_bits;
+
+  static constexpr std::size_t k_max_value_bits = 27;
+
+  static constexpr std::uint64_t k_max_value =
+    (std::uint64_t{1} << k_max_value_bits) - 1;
+
+  static constexpr std::size_t k_number_buckets =
+    (k_max_value_bits - k_sub_bucket_bits + 1) * k_sub_bucket_count;
+
+  static constexpr std::size_t index(std::uint64_t value) noexcept
+  {
+    value = std::min(value, k_max_value);
+    if (value < 2 * k_sub_bucket_count)
+    {
+      return static_cast<std::size_t>(value);
+    }
+
+    const std::size_t shift =
+      std::bit_width(value) - (k_sub_bucket_bits + 1);
+    return shift * k_sub_bucket_count +
+      static_cast<std::size_t>(value >> shift);
+  }
+
+  static constexpr std::uint64_t lower_bound(const std::size_t index) noexcept
+  {
+    if (index < 2 * k_sub_bucket_count)
+    {
+      return index;
+    }
+
+    const std::size_t shift = index / k_sub_bucket_count - 1;
+    const std::uint64_t mantissa =
+      index % k_sub_bucket_count + k_sub_bucket_count;
+    return mantissa << shift;
+  }
+
+  static constexpr std::uint64_t upper_bound(const std::size_t index) noexcept
+  {
+    if (index < 2 * k_sub_bucket_count)
+    {
+      return index;
+    }
+
+    const std::size_t shift = index / k_sub_bucket_count - 1;
+    return lower_bound(index) + (std::uint64_t{1} << shift) - 1;
+  }
+
+public:
+  HdrHistogram() = default;
+
+  ~HdrHistogram() = default;
+
+  void add(const std::size_t index, const std::uint64_t count) noexcept
+  {
+    counts_[index] += count;
+    total_count_ += count;
+  }
+
+  std::uint64_t total_count() const noexcept
+  {
+    return total_count_;
+  }
+
+  /**
+   * Highest value of the bucket holding the quantile
+   * (0 if the histogram is empty).
+   **/
+  std::uint64_t value_at_quantile(const double quantile) const noexcept
+  {
+    if (total_count_ == 0)
+    {
+      return 0;
+    }
+
+    const auto rank = std::max<std::uint64_t>(
+      static_cast<std::uint64_t>(
+        std::ceil(std::clamp(quantile, 0.0, 1.0) * total_count_)),
+      1);
+
+    std::uint64_t count = 0;
+    for (std::size_t i = 0; i < k_number_buckets; ++i)
+    {
+      count += counts_[i];
+      if (count >= rank)
+      {
+        return upper_bound(i);
+      }
+    }
+
+    return k_max_value;
+  }
+
+private:
+  std::array<std::uint64_t, k_number_buckets> counts_{};
+
+  std::uint64_t total_count_ = 0;
+};
+
+static_assert(
+  HdrHistogram::index(HdrHistogram::k_max_value) + 1 ==
+    HdrHistogram::k_number_buckets);
+static_assert(HdrHistogram::index(31) == 31);
+static_assert(HdrHistogram::index(32) == 32);
+static_assert(HdrHistogram::lower_bound(HdrHistogram::index(1000)) <= 1000);
+static_assert(HdrHistogram::upper_bound(HdrHistogram::index(1000)) >= 1000);
+
+} // namespace UServerUtils::Statistics
+
+#endif //USERVER_STATISTICS_HDRHISTOGRAM_HPP
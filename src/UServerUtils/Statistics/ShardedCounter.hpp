@@ -0,0 +1,211 @@
+#ifndef USERVER_STATISTICS_SHARDEDCOUNTER_HPP
+#define USERVER_STATISTICS_SHARDEDCOUNTER_HPP
+
+// STD
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+namespace UServerUtils::Statistics
+{
+
+inline constexpr std::size_t k_cache_line_size = 64;
+
+namespace Internal::Shard
+{
+
+/**
+ * Slot of the calling thread. Threads get consecutive numbers,
+ * so up to number_shards threads never share a shard.
+ **/
+inline std::size_t thread_index() noexcept
+{
+  static std::atomic<std::size_t> counter{0};
+  thread_local const std::size_t index =
+    counter.fetch_add(1, std::memory_order_relaxed);
+  return index;
+}
+
+inline std::size_t default_number_shards() noexcept
+{
+  constexpr std::size_t max_number_shards = 64;
+  const std::size_t number_threads =
+    std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+  return std::min(std::bit_ceil(number_threads), max_number_shards);
+}
+
+} // namespace Internal::Shard
+
+/**
+ * Counters split into per-thread shards. A thread updates its own
+ * cache lines only, the value is summed over all shards when
+ * the provider is scraped.
+ *
+ * Every shard starts at a cache line boundary, counters of one shard
+ * are contiguous. Row 0 is the base written by set()/store(),
+ * rows 1..number_shards receive add().
+ **/
+class ShardedCounters final
+{
+private:
+  static constexpr std::size_t k_cells_per_line =
+    k_cache_line_size / sizeof(std::atomic<std::uint64_t>);
+
+  struct alignas(k_cache_line_size) Line final
+  {
+    std::atomic<std::uint64_t> cells[k_cells_per_line] = {};
+  };
+  using Lines = std::vector<Line>;
+
+public:
+  explicit ShardedCounters(
+    const std::size_t number_counters,
+    const std::size_t number_shards =
+      Internal::Shard::default_number_shards())
+    : number_shards_(std::bit_ceil(std::max<std::size_t>(number_shards, 1))),
+      lines_per_shard_(
+        (number_counters + k_cells_per_line - 1) / k_cells_per_line),
+      lines_(lines_per_shard_ * (number_shards_ + 1))
+  {
+  }
+
+  ~ShardedCounters() = default;
+
+  ShardedCounters(const ShardedCounters&) = delete;
+  ShardedCounters(ShardedCounters&&) = delete;
+  ShardedCounters& operator=(const ShardedCounters&) = delete;
+  ShardedCounters& operator=(ShardedCounters&&) = delete;
+
+  std::size_t number_shards() const noexcept
+  {
+    return number_shards_;
+  }
+
+  // Signed values are added in two's complement.
+  void add_integer(
+    const std::size_t index,
+    const std::uint64_t value) noexcept
+  {
+    shard_cell(index).fetch_add(value, std::memory_order_relaxed);
+  }
+
+  void add_double(
+    const std::size_t index,
+    const double value) noexcept
+  {
+    auto& cell = shard_cell(index);
+    auto expected = cell.load(std::memory_order_relaxed);
+    while (!cell.compare_exchange_weak(
+      expected,
+      std::bit_cast<std::uint64_t>(
+        std::bit_cast<double>(expected) + value),
+      std::memory_order_relaxed))
+    {
+    }
+  }
+
+  /**
+   * O(number_shards): the base gets the value, shards are reset.
+   * add() racing with set() may be lost, as with a plain atomic.
+   **/
+  void set_integer(
+    const std::size_t index,
+    const std::uint64_t value) noexcept
+  {
+    reset_shards(index);
+    store(index, value);
+  }
+
+  void set_double(
+    const std::size_t index,
+    const double value) noexcept
+  {
+    reset_shards(index);
+    store(index, std::bit_cast<std::uint64_t>(value));
+  }
+
+  // Base only, for values which are never added (flags).
+  void store(
+    const std::size_t index,
+    const std::uint64_t value) noexcept
+  {
+    cell(0, index).store(value, std::memory_order_relaxed);
+  }
+
+  std::uint64_t exchange(
+    const std::size_t index,
+    const std::uint64_t value) noexcept
+  {
+    return cell(0, index).exchange(value, std::memory_order_relaxed);
+  }
+
+  std::uint64_t sum_integer(const std::size_t index) const noexcept
+  {
+    std::uint64_t result = 0;
+    for (std::size_t row = 0; row <= number_shards_; row += 1)
+    {
+      result += cell(row, index).load(std::memory_order_relaxed);
+    }
+
+    return result;
+  }
+
+  double sum_double(const std::size_t index) const noexcept
+  {
+    double result = 0;
+    for (std::size_t row = 0; row <= number_shards_; row += 1)
+    {
+      result += std::bit_cast<double>(
+        cell(row, index).load(std::memory_order_relaxed));
+    }
+
+    return result;
+  }
+
+private:
+  std::atomic<std::uint64_t>& cell(
+    const std::size_t row,
+    const std::size_t index) noexcept
+  {
+    return lines_[row * lines_per_shard_ + index / k_cells_per_line]
+      .cells[index % k_cells_per_line];
+  }
+
+  const std::atomic<std::uint64_t>& cell(
+    const std::size_t row,
+    const std::size_t index) const noexcept
+  {
+    return lines_[row * lines_per_shard_ + index / k_cells_per_line]
+      .cells[index % k_cells_per_line];
+  }
+
+  std::atomic<std::uint64_t>& shard_cell(const std::size_t index) noexcept
+  {
+    const std::size_t shard =
+      Internal::Shard::thread_index() & (number_shards_ - 1);
+    return cell(shard + 1, index);
+  }
+
+  // Zero bits are 0 and 0.0 alike.
+  void reset_shards(const std::size_t index) noexcept
+  {
+    for (std::size_t row = 1; row <= number_shards_; row += 1)
+    {
+      cell(row, index).store(0, std::memory_order_relaxed);
+    }
+  }
+
+private:
+  const std::size_t number_shards_;
+
+  const std::size_t lines_per_shard_;
+
+  Lines lines_;
+};
+
+} // namespace UServerUtils::Statistics
+
+#endif //USERVER_STATISTICS_SHARDEDCOUNTER_HPP
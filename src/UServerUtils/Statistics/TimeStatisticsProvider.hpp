@@ -2,9 +2,14 @@
 #define USERVER_STATISTICS_TIMESTATISTICSPROVIDER_HPP
 
 // STD
+#include <algorithm>
 #include <array>
 #include <atomic>
 #include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <new>
 #include <sstream>
 #include <vector>
 
@@ -12,6 +17,8 @@
 #include <eh/Exception.hpp>
 #include <Generics/Function.hpp>
 #include <UServerUtils/Statistics/Concept.hpp>
+#include <UServerUtils/Statistics/HdrHistogram.hpp>
+#include <UServerUtils/Statistics/ShardedCounter.hpp>
 #include <UServerUtils/Statistics/StatisticsProvider.hpp>
 
 namespace UServerUtils::Statistics
@@ -28,6 +35,21 @@ concept EnumConverterConcept =
 
 } // namespace Internal::Time
 
+/**
+ * Every measure is counted twice: in the linear interval of
+ * time_interval_ms (label "time") and in the HDR histogram with
+ * microsecond resolution, exported as percentiles in microseconds
+ * (label "percentile"). Both live in per-thread shards summed
+ * at scrape time.
+ *
+ * Intervals are cumulative. Percentiles cover the measures since
+ * the previous scrape only (0 if there were none), so they follow
+ * the current latency. With several scrapers every scrape starts
+ * a new window for all of them.
+ *
+ * Histogram of an id is allocated on its first measure and uses
+ * at most k_max_histogram_shards shards (~3 KB each).
+ **/
 template<
   EnumConcept Enum,
   Internal::Time::EnumConverterConcept<Enum> Converter,
@@ -36,48 +58,53 @@ template<
 class TimeStatisticsProvider final : public StatisticsProvider
 {
 public:
-  using CounterArray = std::array<std::atomic<std::uint64_t>, number_intervals>;
-  using Statistics = std::vector<CounterArray>;
-  using StatisticsPtr = std::shared_ptr<Statistics>;
   using LabelView = userver::utils::statistics::LabelView;
   using Label = userver::utils::statistics::Label;
   using EnumLabels = std::vector<Label>;
   using TimeLabels = std::vector<Label>;
+  using PercentileLabels = std::vector<Label>;
 
+private:
+  static constexpr std::size_t k_max_histogram_shards = 4;
+
+  static constexpr std::array<std::pair<double, const char*>, 4>
+    k_percentiles{{
+      {0.5, "p50"},
+      {0.9, "p90"},
+      {0.99, "p99"},
+      {0.999, "p999"}}};
+
+public:
+  /**
+   * Holds a raw pointer to the provider: the provider must outlive
+   * its measures (get_time_statistics_provider keeps it forever).
+   **/
   class Measure final : private Generics::Uncopyable
   {
   private:
-    using TimePoint = std::chrono::time_point<std::chrono::high_resolution_clock>;
+    using Clock = std::chrono::steady_clock;
+    using TimePoint = Clock::time_point;
 
   public:
     explicit Measure(
-      const StatisticsPtr& statistics,
+      TimeStatisticsProvider* provider,
       const Enum id) noexcept
-      : statistics_(statistics),
+      : provider_(provider),
         id_(id),
-        begin_time_point_(std::chrono::high_resolution_clock::now())
+        begin_time_point_(Clock::now())
     {
     }
 
     ~Measure()
     {
-      if (statistics_->empty())
-        return;
-
-      const auto end_time_point = std::chrono::high_resolution_clock::now();
-      const std::size_t elapsed_time_ms = std::chrono::duration<double, std::milli>(
-        end_time_point - begin_time_point_).count();
-
-      std::size_t index = elapsed_time_ms / time_interval_ms;
-      if (index >= number_intervals)
-      {
-        index = number_intervals - 1;
-      }
-      (*statistics_)[static_cast<std::size_t>(id_)][index].fetch_add(1, std::memory_order_relaxed);
+      const auto elapsed_time_us =
+        std::chrono::duration_cast<std::chrono::microseconds>(
+          Clock::now() - begin_time_point_).count();
+      provider_->add(id_, static_cast<std::uint64_t>(elapsed_time_us));
     }
 
   private:
-    const StatisticsPtr statistics_;
+    TimeStatisticsProvider* const provider_;
 
     const Enum id_;
 
@@ -86,11 +113,32 @@ public:
 
   DECLARE_EXCEPTION(Exception, eh::DescriptiveException);
 
+private:
+  struct Histogram final
+  {
+    explicit Histogram(const std::size_t number_shards)
+      : counters(HdrHistogram::k_number_buckets, number_shards),
+        previous(HdrHistogram::k_number_buckets, 0)
+    {
+    }
+
+    ShardedCounters counters;
+
+    // Bucket sums at the previous scrape, guarded by histogram_mutex_.
+    std::vector<std::uint64_t> previous;
+  };
+  using Histograms = std::unique_ptr<std::atomic<Histogram*>[]>;
+
 public:
   TimeStatisticsProvider(const std::string& name_provider = "time_statistic")
    : name_provider_(name_provider),
-     statistics_(std::make_shared<Statistics>(
-       static_cast<std::size_t>(Enum::Max)))
+     counters_(static_cast<std::size_t>(Enum::Max) * number_intervals),
+     histogram_number_shards_(std::min(
+       Internal::Shard::default_number_shards(),
+       k_max_histogram_shards)),
+     histograms_(
+       std::make_unique<std::atomic<Histogram*>[]>(
+         static_cast<std::size_t>(Enum::Max)))
   {
     const auto names = Converter{}();
 
@@ -111,14 +159,6 @@ public:
       return;
     }
 
-    for (auto& array : *statistics_)
-    {
-      for (auto& v : array)
-      {
-        std::atomic_init(&v, std::uint64_t(0));
-      }
-    }
-
     enum_labels_.reserve(names.size());
     int expected_value = 0;
     for (const auto& [enum_id, name] : names)
@@ -152,13 +192,68 @@ public:
            << "ms; "
            << "infinity)";
     time_labels_.emplace_back("time", stream.str());
+
+    percentile_labels_.reserve(k_percentiles.size());
+    for (const auto& [quantile, name] : k_percentiles)
+    {
+      percentile_labels_.emplace_back("percentile", name);
+    }
   }
 
-  ~TimeStatisticsProvider() override = default;
+  ~TimeStatisticsProvider() override
+  {
+    for (std::size_t i = 0; i < static_cast<std::size_t>(Enum::Max); ++i)
+    {
+      delete histograms_[i].load(std::memory_order_relaxed);
+    }
+  }
 
   Measure make_measure(const Enum id) noexcept
   {
-    return Measure(statistics_, id);
+    return Measure(this, id);
+  }
+
+  void add(const Enum id, const std::uint64_t elapsed_time_us) noexcept
+  {
+    const std::size_t offset = static_cast<std::size_t>(id) * number_intervals;
+    const std::size_t interval = std::min<std::size_t>(
+      elapsed_time_us / (time_interval_ms * 1000),
+      number_intervals - 1);
+    counters_.add_integer(offset + interval, 1);
+
+    // Out of memory loses the measure in percentiles only.
+    if (auto* histogram = get_histogram(id))
+    {
+      histogram->counters.add_integer(
+        HdrHistogram::index(elapsed_time_us),
+        1);
+    }
+  }
+
+  /**
+   * Measures since the previous call (or scrape),
+   * starts the next window.
+   **/
+  HdrHistogram take_histogram(const Enum id)
+  {
+    HdrHistogram result;
+    auto* histogram = histograms_[static_cast<std::size_t>(id)].load(
+      std::memory_order_acquire);
+    if (!histogram)
+    {
+      return result;
+    }
+
+    std::lock_guard lock(histogram_mutex_);
+    for (std::size_t k = 0; k < HdrHistogram::k_number_buckets; ++k)
+    {
+      // Buckets only grow: the difference is the window.
+      const auto sum = histogram->counters.sum_integer(k);
+      result.add(k, sum - histogram->previous[k]);
+      histogram->previous[k] = sum;
+    }
+
+    return result;
   }
 
   std::string name() override
@@ -169,32 +264,80 @@ public:
 private:
   void write(Writer& writer) override
   {
-    auto& statistics = *statistics_;
-    const auto size_statistics = statistics.size();
-    const auto array_size = number_intervals;
-
+    const auto size_statistics = enum_labels_.size();
     for (std::size_t i = 0; i < size_statistics; ++i)
     {
-      for (std::size_t k = 0; k < array_size; ++k)
+      const std::size_t offset = i * number_intervals;
+      for (std::size_t k = 0; k < number_intervals; ++k)
       {
         writer.ValueWithLabels(
-          statistics[i][k].load(std::memory_order_relaxed),
+          counters_.sum_integer(offset + k),
           {
             LabelView(enum_labels_[i]),
             LabelView(time_labels_[k])
           });
       }
+
+      const auto histogram = take_histogram(static_cast<Enum>(i));
+      for (std::size_t k = 0; k < k_percentiles.size(); ++k)
+      {
+        writer.ValueWithLabels(
+          histogram.value_at_quantile(k_percentiles[k].first),
+          {
+            LabelView(enum_labels_[i]),
+            LabelView(percentile_labels_[k])
+          });
+      }
+    }
+  }
+
+  Histogram* get_histogram(const Enum id) noexcept
+  {
+    auto& slot = histograms_[static_cast<std::size_t>(id)];
+    auto* histogram = slot.load(std::memory_order_acquire);
+    if (histogram)
+    {
+      return histogram;
+    }
+
+    try
+    {
+      auto* created = new Histogram(histogram_number_shards_);
+      if (slot.compare_exchange_strong(
+        histogram,
+        created,
+        std::memory_order_acq_rel,
+        std::memory_order_acquire))
+      {
+        return created;
+      }
+
+      // Another thread was first.
+      delete created;
+      return histogram;
+    }
+    catch (...)
+    {
+      return nullptr;
     }
   }
 
 private:
   const std::string name_provider_;
 
-  StatisticsPtr statistics_;
+  ShardedCounters counters_;
+
+  const std::size_t histogram_number_shards_;
+
+  Histograms histograms_;
+
+  std::mutex histogram_mutex_;
 
   EnumLabels enum_labels_;
 
   TimeLabels time_labels_;
+
+  PercentileLabels percentile_labels_;
 };
 
 template<
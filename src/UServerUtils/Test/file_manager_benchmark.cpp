@@ -1,8 +1,15 @@
+// POSIX
+#include <sys/resource.h>
+
 // STD
 #include <atomic>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <optional>
 #include <random>
+#include <string>
+#include <string_view>
 
 // USERVER
 #include <userver/engine/task/task_processor_fwd.hpp>
@@ -68,6 +75,7 @@ public:
     const std::size_t file_size,
     const std::size_t block_size,
     const bool is_direct,
+    const bool is_registered,
     Statistics& statistics)
     : test_type_(test_type),
       operation_type_(operation_type),
@@ -77,6 +85,7 @@ public:
       file_size_(file_size),
       block_size_(block_size),
       is_direct_(is_direct),
+      is_registered_(is_registered),
       config_(config),
       file_manager_pool_(config, logger_.in()),
       statistics_(statistics)
@@ -209,6 +218,35 @@ private:
       file_manager_pool_.write(file, write_buffer_view, 0);
     }
 
+    // Registered resources are used for fixed operations
+    // (read_fixed/write_fixed) to save per-operation CPU.
+    UServerUtils::FileManager::RegisteredBuffer read_fixed_buffer;
+    UServerUtils::FileManager::RegisteredBuffer write_fixed_buffer;
+    std::optional<UServerUtils::FileManager::RegisteredFile> registered_file;
+    if (is_registered_)
+    {
+      auto read_buffer = file_manager_pool_.acquire_buffer();
+      auto write_buffer = file_manager_pool_.acquire_buffer();
+      registered_file = file_manager_pool_.register_file(file);
+      if (!read_buffer || !write_buffer || !registered_file)
+      {
+        std::ostringstream stream;
+        stream << FNS
+               << "acquire of registered resources is failed";
+        logger_->emergency(stream.str());
+        return;
+      }
+
+      read_fixed_buffer = *read_buffer;
+      read_fixed_buffer.size = block_size_;
+      write_fixed_buffer = *write_buffer;
+      write_fixed_buffer.size = block_size_;
+      std::memcpy(
+        write_fixed_buffer.data,
+        write_data.data(),
+        block_size_);
+    }
+
     const auto length = file.length();
     if (!length)
     {
@@ -242,7 +280,9 @@ private:
 
       if (operation_type_ == OperationType::Write || operation_type_ == OperationType::ReadWrite)
       {
-        int result = file_manager_pool_.write(file, write_buffer_view, offset);
+        const int result = is_registered_ ?
+          file_manager_pool_.write_fixed(*registered_file, write_fixed_buffer, offset) :
+          file_manager_pool_.write(file, write_buffer_view, offset);
         if (result == static_cast<int>(block_size_))
         {
           statistics_.success_write.fetch_add(1, std::memory_order_relaxed);
@@ -268,7 +308,9 @@ private:
 
       if (operation_type_ == OperationType::Read || operation_type_ == OperationType::ReadWrite)
       {
-        int result = file_manager_pool_.read(file, read_buffer_view, offset);
+        const int result = is_registered_ ?
+          file_manager_pool_.read_fixed(*registered_file, read_fixed_buffer, offset) :
+          file_manager_pool_.read(file, read_buffer_view, offset);
         if (result == static_cast<int>(block_size_))
         {
           statistics_.success_read.fetch_add(1, std::memory_order_relaxed);
@@ -280,6 +322,13 @@ private:
       }
     }
 
+    if (is_registered_)
+    {
+      file_manager_pool_.unregister_file(*registered_file);
+      file_manager_pool_.release_buffer(read_fixed_buffer);
+      file_manager_pool_.release_buffer(write_fixed_buffer);
+    }
+
     if (test_type_ == TestType::FileToCoro)
     {
       std::remove(path.c_str());
@@ -307,6 +356,8 @@ private:
 
   const bool is_direct_;
 
+  const bool is_registered_;
+
   FileManagerConfig config_;
 
   UServerUtils::FileManager::FileManagerPool file_manager_pool_;
@@ -335,7 +386,8 @@ public:
     const std::size_t number_coroutines,
     const std::size_t file_size,
     const std::size_t block_size,
-    const bool is_direct)
+    const bool is_direct,
+    const bool is_registered)
     : test_type_(test_type),
       operation_type_(operation_type),
       time_interval_(time_interval),
@@ -360,6 +412,10 @@ public:
            << config.number_io_urings
            << "\nNumber coroutines = "
            << number_coroutines
+           << "\nSQPOLL = "
+           << ((config.io_uring_flags & IORING_SETUP_SQPOLL) != 0)
+           << "\nRegistered buffers and files = "
+           << is_registered
            << "\nBlock size = "
            << block_size
            << " Bytes\n"
@@ -404,6 +460,7 @@ public:
       file_size,
       block_size,
       is_direct,
+      is_registered,
       statistics_);
   }
 
@@ -462,10 +519,15 @@ public:
       &is_cancel] () {
       try
       {
+        std::uint64_t cpu_time = process_cpu_time();
         while (!is_cancel.load(std::memory_order_relaxed))
         {
           std::this_thread::sleep_for(std::chrono::milliseconds(time_interval_ * 1000));
 
+          const std::uint64_t current_cpu_time = process_cpu_time();
+          const std::uint64_t interval_cpu_time = current_cpu_time - cpu_time;
+          cpu_time = current_cpu_time;
+
           const auto success_read =
             statistics_.success_read.exchange(0, std::memory_order_relaxed);
           const auto error_read =
@@ -478,6 +540,14 @@ public:
           logger_->info(std::string("--------------------"));
           std::ostringstream stream;
 
+          const std::uint64_t number_operations =
+            success_read + error_read + success_write + error_write;
+          stream << "\n"
+                 << "CPU per operation[us] = "
+                 << (number_operations ?
+                       static_cast<double>(interval_cpu_time) / number_operations : 0)
+                 << "\n";
+
           if (operation_type_ == OperationType::Read || operation_type_ == OperationType::ReadWrite)
           {
             stream << "\n"
@@ -526,6 +596,19 @@ public:
   }
 
 private:
+  // User and system time of process in microseconds
+  static std::uint64_t process_cpu_time() noexcept
+  {
+    rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+      return 0;
+    }
+
+    return (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000ull +
+      usage.ru_utime.tv_usec + usage.ru_stime.tv_usec;
+  }
+
   void wait() noexcept
   {
     try
@@ -587,15 +670,48 @@ private:
   Benchmark_var benchmark_;
 };
 
-int main(int /*argc*/, char** /*argv*/)
+// Usage: File_Manager_Benchmark [--sqpoll] [--registered]
+int main(int argc, char** argv)
 {
   try
   {
+    bool is_sqpoll = false;
+    bool is_registered = false;
+    for (int i = 1; i < argc; ++i)
+    {
+      const std::string_view option(argv[i]);
+      if (option == "--sqpoll")
+      {
+        is_sqpoll = true;
+      }
+      else if (option == "--registered")
+      {
+        is_registered = true;
+      }
+      else
+      {
+        std::cerr << "Unknown option="
+                  << option
+                  << "\nUsage: "
+                  << argv[0]
+                  << " [--sqpoll] [--registered]"
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
     UServerUtils::FileManager::Config config;
     config.number_io_urings = std::thread::hardware_concurrency();
     config.io_uring_size = 10000;
     config.event_queue_max_size = 1000000;
     config.io_uring_flags = IORING_SETUP_ATTACH_WQ; // | IORING_SETUP_IOPOLL
+    // Kernel thread polls submission queue, io_uring_submit doesn't
+    // enter kernel while it is active
+    if (is_sqpoll)
+    {
+      config.io_uring_flags |= IORING_SETUP_SQPOLL;
+      config.sq_thread_idle = 2000;
+    }
 
     const OperationType operation_type = OperationType::ReadWrite;
     const TestType test_type = TestType::SingleFile;
@@ -609,6 +725,14 @@ int main(int /*argc*/, char** /*argv*/)
     const std::size_t size_file = 10;
     // Read/write block in bytes
     const std::size_t block_size = 32 * 1024;
+    // Use read_fixed/write_fixed with registered buffers and files
+    // (require RLIMIT_MEMLOCK for registered buffers)
+    if (is_registered)
+    {
+      config.number_registered_buffers = 2 * number_coroutines;
+      config.registered_buffer_size = block_size;
+      config.number_registered_files = number_coroutines;
+    }
 
     Application application(
       test_type,
@@ -620,7 +744,8 @@ int main(int /*argc*/, char** /*argv*/)
       number_coroutines,
       size_file,
       block_size,
-      is_direct);
+      is_direct,
+      is_registered);
     application.run();
     return EXIT_SUCCESS;
   }
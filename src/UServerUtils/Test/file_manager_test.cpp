@@ -9,6 +9,7 @@
 #include <string>
 #include <vector>
 #include <coroutine>
+#include <cstring>
 
 // THIS
 #include <Logger/StreamLogger.hpp>
@@ -757,6 +758,237 @@ TEST(FileManagerTest, Flag_IORING_SETUP_ATTACH_WQ)
   }
 }
 
+TEST(FileManagerTest, RegisteredBuffersAndFiles)
+{
+  const std::string directory = "/tmp/";
+  const std::string file_name = "test_file_fixed";
+  const std::string path = directory + file_name;
+  const std::string data("qwerty");
+  remove_file(path);
+
+  Logging::Logger_var logger(
+    new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::CRITICAL)));
+
+  UServerUtils::FileManager::Config config;
+  config.io_uring_size = 10;
+  config.event_queue_max_size = 10000;
+  config.number_io_urings = 2;
+  config.io_uring_flags = IORING_SETUP_ATTACH_WQ;
+  config.number_registered_buffers = 2;
+  config.registered_buffer_size = 4096;
+  config.number_registered_files = 1;
+
+  UServerUtils::FileManager::FileManagerPool file_manager_pool(config, logger.in());
+
+  auto buffer = file_manager_pool.acquire_buffer();
+  ASSERT_TRUE(buffer.has_value());
+  auto other_buffer = file_manager_pool.acquire_buffer();
+  ASSERT_TRUE(other_buffer.has_value());
+  EXPECT_NE(buffer->index, other_buffer->index);
+  EXPECT_FALSE(file_manager_pool.acquire_buffer().has_value());
+
+  UServerUtils::FileManager::File file(path, O_CREAT | O_RDWR);
+  EXPECT_TRUE(file.is_valid());
+  auto registered_file = file_manager_pool.register_file(file);
+  ASSERT_TRUE(registered_file.has_value());
+  EXPECT_FALSE(file_manager_pool.register_file(file).has_value());
+
+  for (std::size_t i = 1; i <= 10; ++i)
+  {
+    auto write_buffer = *buffer;
+    std::memcpy(write_buffer.data, data.data(), data.size());
+    write_buffer.size = data.size();
+    EXPECT_EQ(
+      file_manager_pool.write_fixed(*registered_file, write_buffer, 0),
+      data.size());
+    EXPECT_EQ(data, read_file(path));
+
+    auto read_buffer = *other_buffer;
+    read_buffer.size = data.size();
+    EXPECT_EQ(
+      file_manager_pool.read_fixed(file, read_buffer, 0),
+      data.size());
+    EXPECT_EQ(read_buffer.view(), data);
+  }
+
+  file_manager_pool.unregister_file(*registered_file);
+  EXPECT_TRUE(file_manager_pool.release_buffer(*buffer));
+  EXPECT_TRUE(file_manager_pool.release_buffer(*other_buffer));
+
+  // Double release and foreign buffers are rejected
+  EXPECT_FALSE(file_manager_pool.release_buffer(*buffer));
+  auto foreign_buffer = *buffer;
+  foreign_buffer.index = static_cast<int>(config.number_registered_buffers);
+  EXPECT_FALSE(file_manager_pool.release_buffer(foreign_buffer));
+  foreign_buffer = *buffer;
+  foreign_buffer.data = other_buffer->data;
+  foreign_buffer.index = buffer->index;
+  EXPECT_FALSE(file_manager_pool.release_buffer(foreign_buffer));
+
+  auto new_registered_file = file_manager_pool.register_file(file);
+  ASSERT_TRUE(new_registered_file.has_value());
+  EXPECT_TRUE(file_manager_pool.acquire_buffer().has_value());
+  EXPECT_TRUE(file_manager_pool.acquire_buffer().has_value());
+  EXPECT_FALSE(file_manager_pool.acquire_buffer().has_value());
+
+  // Stale handle doesn't unregister slot reused by other file
+  file_manager_pool.unregister_file(*registered_file);
+  EXPECT_FALSE(file_manager_pool.register_file(file).has_value());
+  file_manager_pool.unregister_file(*new_registered_file);
+
+  remove_file(path);
+}
+
+TEST(FileManagerTest, VectoredReadWrite)
+{
+  const std::string path = "/tmp/test_file_vectored";
+  remove_file(path);
+
+  Logging::Logger_var logger(
+    new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::CRITICAL)));
+
+  UServerUtils::FileManager::Config config;
+  config.io_uring_size = 10;
+  config.event_queue_max_size = 10000;
+  config.number_io_urings = 2;
+  config.io_uring_flags = IORING_SETUP_ATTACH_WQ;
+
+  UServerUtils::FileManager::FileManagerPool file_manager_pool(config, logger.in());
+
+  UServerUtils::FileManager::File file(path, O_CREAT | O_RDWR);
+  EXPECT_TRUE(file.is_valid());
+
+  std::string part1 = "qwe";
+  std::string part2 = "rty";
+  const iovec write_iovecs[] = {
+    {part1.data(), part1.size()},
+    {part2.data(), part2.size()}};
+  EXPECT_EQ(file_manager_pool.writev(file, write_iovecs, 0), 6);
+  EXPECT_EQ(read_file(path), "qwerty");
+
+  std::string buffer1(2, ' ');
+  std::string buffer2(4, ' ');
+  const iovec read_iovecs[] = {
+    {buffer1.data(), buffer1.size()},
+    {buffer2.data(), buffer2.size()}};
+  EXPECT_EQ(file_manager_pool.readv(file, read_iovecs, 0), 6);
+  EXPECT_EQ(buffer1, "qw");
+  EXPECT_EQ(buffer2, "erty");
+
+  remove_file(path);
+}
+
+TEST(FileManagerTest, Batch)
+{
+  const std::string path = "/tmp/test_file_batch";
+  remove_file(path);
+
+  Logging::Logger_var logger(
+    new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::CRITICAL)));
+
+  UServerUtils::FileManager::Config config;
+  config.io_uring_size = 16;
+  config.event_queue_max_size = 10000;
+  config.number_io_urings = 2;
+  config.io_uring_flags = IORING_SETUP_ATTACH_WQ;
+
+  UServerUtils::FileManager::FileManagerPool file_manager_pool(config, logger.in());
+
+  using BatchOperation = UServerUtils::FileManager::BatchOperation;
+  using BatchOperations = UServerUtils::FileManager::BatchOperations;
+
+  UServerUtils::FileManager::File file(path, O_CREAT | O_RDWR);
+  EXPECT_TRUE(file.is_valid());
+
+  // Concurrent batches overflow completion queue if they are
+  // submitted without waiting for completions
+  const std::size_t count = 100;
+  const std::size_t batch_size = 10;
+  std::vector<std::string> records;
+  std::vector<BatchOperation> operations;
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    records.emplace_back(10, 'a' + i % 26);
+  }
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    operations.emplace_back(
+      BatchOperation::Type::Write,
+      file,
+      records[i],
+      i * 10);
+  }
+
+  auto submit_concurrently = [&file_manager_pool, &operations, batch_size] () {
+    std::vector<std::future<int>> results;
+    for (std::size_t i = 0; i < operations.size(); i += batch_size)
+    {
+      results.emplace_back(std::async(
+        std::launch::async,
+        [&file_manager_pool, &operations, i, batch_size] () {
+          return file_manager_pool.submit_batch(
+            BatchOperations(operations.data() + i, batch_size));
+        }));
+    }
+    for (auto& result : results)
+    {
+      EXPECT_EQ(result.get(), 0);
+    }
+  };
+
+  submit_concurrently();
+  for (const auto& operation : operations)
+  {
+    EXPECT_EQ(operation.result, 10);
+  }
+
+  std::vector<std::string> buffers(count, std::string(10, ' '));
+  operations.clear();
+  for (std::size_t i = 0; i < count; ++i)
+  {
+    operations.emplace_back(
+      BatchOperation::Type::Read,
+      file,
+      buffers[i],
+      i * 10);
+  }
+  submit_concurrently();
+  EXPECT_EQ(buffers, records);
+
+  // Linked: short read breaks chain
+  std::string buffer1(10, ' ');
+  std::string buffer2(20, ' ');
+  std::string buffer3(10, ' ');
+  BatchOperation linked_operations[] = {
+    BatchOperation(BatchOperation::Type::Read, file, buffer1, 0),
+    BatchOperation(BatchOperation::Type::Read, file, buffer2, count * 10 - 10),
+    BatchOperation(BatchOperation::Type::Read, file, buffer3, 10)};
+  EXPECT_EQ(file_manager_pool.submit_batch(linked_operations, true), -ECANCELED);
+  EXPECT_EQ(linked_operations[0].result, 10);
+  EXPECT_EQ(linked_operations[1].result, 10);
+  EXPECT_EQ(linked_operations[2].result, -ECANCELED);
+  EXPECT_EQ(buffer1, records[0]);
+
+  // Batch must fit submission queue
+  EXPECT_EQ(file_manager_pool.submit_batch(operations), -EINVAL);
+  for (const auto& operation : operations)
+  {
+    EXPECT_EQ(operation.result, -EINVAL);
+  }
+  EXPECT_EQ(file_manager_pool.submit_batch(operations, true), -EINVAL);
+
+  remove_file(path);
+}
+
 namespace
 {
 
@@ -1265,4 +1497,90 @@ TEST(FileReaderTest, StringView_Test4)
   EXPECT_EQ(result, "abcd");
   EXPECT_TRUE(reader.eof());
   EXPECT_FALSE(reader.bad());
-}
\ No newline at end of file
+}
+namespace
+{
+
+void file_reader_readahead_test(const bool is_direct)
+{
+  Logging::Logger_var logger = new Logging::OStream::Logger(
+    Logging::OStream::Config(
+      std::cerr,
+      Logging::Logger::CRITICAL));
+
+  UServerUtils::FileManager::Config config;
+  config.io_uring_size = 16;
+  config.event_queue_max_size = 10000;
+  config.number_io_urings = 2;
+  config.io_uring_flags = IORING_SETUP_ATTACH_WQ;
+
+  UServerUtils::FileManager::FileManagerPoolPtr file_manager_pool =
+    std::make_shared<UServerUtils::FileManager::FileManagerPool>(config, logger.in());
+
+  const std::string path = "/tmp/test_file";
+  remove_file(path);
+
+  const std::size_t count = 3000;
+  std::string data;
+  std::string check_result;
+  for (std::size_t i = 1; i <= count; ++i)
+  {
+    std::string line(i % 97, '0' + i % 9);
+    check_result += line;
+    data += line;
+    data.push_back('\n');
+  }
+  write_file(path, data);
+
+  if (is_direct &&
+      !UServerUtils::FileManager::File(path, O_RDONLY | O_DIRECT).is_valid())
+  {
+    GTEST_SKIP() << "O_DIRECT is not supported by file system";
+  }
+
+  for (const std::size_t number_buffers : {1, 2, 5})
+  {
+    for (const std::size_t buffer_size : {1, 7, 4096, 10000})
+    {
+      UServerUtils::FileManager::File file(path, O_RDONLY);
+      EXPECT_TRUE(file.is_valid());
+
+      UServerUtils::FileManager::ReadaheadConfig readahead_config;
+      readahead_config.number_buffers = number_buffers;
+      readahead_config.buffer_size = buffer_size;
+      readahead_config.is_direct = is_direct;
+
+      UServerUtils::FileManager::FileReader reader(
+        file,
+        '\n',
+        buffer_size,
+        file_manager_pool,
+        readahead_config);
+
+      std::string result;
+      std::size_t result_count = 0;
+      for (std::string_view line; reader.getline(line);)
+      {
+        result += line;
+        result_count += 1;
+      }
+
+      EXPECT_EQ(result_count, count);
+      EXPECT_EQ(result, check_result);
+      EXPECT_TRUE(reader.eof());
+      EXPECT_FALSE(reader.bad());
+    }
+  }
+}
+
+} // namespace
+
+TEST(FileReaderTest, Readahead)
+{
+  file_reader_readahead_test(false);
+}
+
+TEST(FileReaderTest, ReadaheadDirect)
+{
+  file_reader_readahead_test(true);
+}
@@ -9,11 +9,21 @@
 // THIS
 #include <eh/Exception.hpp>
 #include <Generics/Function.hpp>
+#include <Logger/Logger.hpp>
+#include <Logger/StreamLogger.hpp>
+#include <UServerUtils/FileManager/Config.hpp>
 #include <UServerUtils/FileManager/File.hpp>
+#include <UServerUtils/FileManager/FileManagerPool.hpp>
 #include <UServerUtils/FileManager/FileReader.hpp>
 
 class Application final
 {
+public:
+  using FileManagerConfig = UServerUtils::FileManager::Config;
+  using FileManagerPool = UServerUtils::FileManager::FileManagerPool;
+  using FileManagerPoolPtr = UServerUtils::FileManager::FileManagerPoolPtr;
+  using ReadaheadConfig = UServerUtils::FileManager::ReadaheadConfig;
+
 public:
   Application(
     const std::size_t number_line,
@@ -39,6 +49,8 @@ public:
       file_path_);
     std::cout << "Test file is created success\n" << std::endl;
 
+    const auto file_size = file_length();
+
     {
       std::cout << "Start benchmark istream" << std::endl;
 
@@ -107,10 +119,124 @@ public:
                 << std::endl;
     }
 
+    Logging::Logger_var logger = new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::ERROR));
+
+    FileManagerConfig config;
+    config.number_io_urings = 2;
+    config.io_uring_size = 1024;
+    config.event_queue_max_size = 10000;
+    config.io_uring_flags = IORING_SETUP_ATTACH_WQ;
+
+    const auto file_manager_pool =
+      std::make_shared<FileManagerPool>(config, logger.in());
+
+    benchmark_file_reader_pool(
+      "FileReader[file_manager]",
+      file_manager_pool,
+      ReadaheadConfig{},
+      file_size);
+
+    for (const std::size_t number_buffers : {2, 4, 8})
+    {
+      ReadaheadConfig readahead_config;
+      readahead_config.number_buffers = number_buffers;
+      readahead_config.buffer_size = size_buffer_;
+
+      benchmark_file_reader_pool(
+        "FileReader[readahead=" + std::to_string(number_buffers) + "]",
+        file_manager_pool,
+        readahead_config,
+        file_size);
+
+      readahead_config.is_direct = true;
+      benchmark_file_reader_pool(
+        "FileReader[readahead=" + std::to_string(number_buffers) + ", O_DIRECT]",
+        file_manager_pool,
+        readahead_config,
+        file_size);
+    }
+
     return EXIT_SUCCESS;
   }
 
 private:
+  std::uint64_t file_length()
+  {
+    UServerUtils::FileManager::File file(file_path_, O_RDONLY);
+    const auto length = file.length();
+    if (!length)
+    {
+      std::ostringstream stream;
+      stream << FNS
+             << "Can't get length of file="
+             << file_path_;
+      throw std::runtime_error(stream.str());
+    }
+
+    return *length;
+  }
+
+  void benchmark_file_reader_pool(
+    const std::string& name,
+    const FileManagerPoolPtr& file_manager_pool,
+    const ReadaheadConfig& readahead_config,
+    const std::uint64_t file_size)
+  {
+    std::cout << "Start benchmark " << name << std::endl;
+
+    const auto time_start = std::chrono::high_resolution_clock::now();
+
+    UServerUtils::FileManager::File file(file_path_, O_RDONLY);
+    if (!file)
+    {
+      std::ostringstream stream;
+      stream << FNS
+             << "Can't open file="
+             << file_path_
+             << ", reason: "
+             << file.error_message();
+      throw std::runtime_error(stream.str());
+    }
+
+    UServerUtils::FileManager::FileReader reader(
+      file,
+      '\n',
+      size_buffer_,
+      file_manager_pool,
+      readahead_config);
+    std::string_view line;
+    std::size_t count_line = 0;
+    while (reader.getline(line))
+    {
+      count_line += 1;
+    }
+
+    if (reader.bad())
+    {
+      std::ostringstream stream;
+      stream << FNS
+             << "Bad file="
+             << file_path_;
+      throw std::runtime_error(stream.str());
+    }
+
+    const auto time_end = std::chrono::high_resolution_clock::now();
+    double elapsed_time_ms = std::chrono::duration<double, std::milli>(time_end - time_start).count();
+
+    std::cout << "Benchmark " << name << " is success finish: \n"
+              << "Time[ms]: "
+              << elapsed_time_ms
+              << "\nMb/s: "
+              << (file_size / 1048576.0) / (elapsed_time_ms / 1000)
+              << "\nNumber line: "
+              << count_line
+              << "\n\n"
+              << std::endl;
+  }
+
   std::uint64_t benchmark_read()
   {
     const int file = ::open(file_path_.c_str(), O_RDONLY);
@@ -0,0 +1,191 @@
+// STD
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+
+// PROTO
+#include "test2.pb.h"
+
+// THIS
+#include <eh/Exception.hpp>
+#include <Generics/Uncopyable.hpp>
+#include <Stream/MemoryStream.hpp>
+#include <UServerUtils/Grpc/Common/MessageArena.hpp>
+
+namespace
+{
+
+// Allocations are counted only inside of ArenaBenchmark::measure
+std::atomic<bool> is_counting{false};
+std::atomic<std::size_t> number_allocations{0};
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+  if (is_counting.load(std::memory_order_relaxed))
+  {
+    number_allocations.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  if (void* ptr = std::malloc(size == 0 ? 1 : size))
+  {
+    return ptr;
+  }
+
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept
+{
+  std::free(ptr);
+}
+
+namespace
+{
+
+/**
+ * Parses the same large nested message on the heap
+ * (what RpcImpl/ClientImpl do by default) and on a recycled
+ * arena (is_arena_enabled = true).
+ **/
+class ArenaBenchmark final : Generics::Uncopyable
+{
+public:
+  DECLARE_EXCEPTION(Exception, eh::DescriptiveException);
+
+public:
+  ArenaBenchmark(
+    const std::size_t number_items,
+    const std::size_t number_tags,
+    const std::size_t number_iterations)
+    : number_iterations_(number_iterations)
+  {
+    UServerUtils::Grpc::Test2::BulkRequest request;
+    for (std::size_t i = 0; i < number_items; ++i)
+    {
+      auto* item = request.add_items();
+      item->set_id(i);
+      item->set_name("item_name_" + std::to_string(i));
+      for (std::size_t j = 0; j < number_tags; ++j)
+      {
+        item->add_tags("tag_value_" + std::to_string(j));
+      }
+    }
+
+    data_ = request.SerializeAsString();
+  }
+
+  void run()
+  {
+    using BulkRequest = UServerUtils::Grpc::Test2::BulkRequest;
+
+    std::cout << "Arena benchmark: message size = "
+              << data_.size()
+              << " bytes, iterations = "
+              << number_iterations_
+              << std::endl;
+
+    print("Heap", measure([this] () {
+      std::unique_ptr<google::protobuf::Message> message(
+        BulkRequest::default_instance().New());
+      return message->ParseFromString(data_);
+    }));
+
+    UServerUtils::Grpc::Common::MessageArena arena(
+      BulkRequest::default_instance(),
+      2 * data_.size());
+    print("Arena", measure([this, &arena] () {
+      const bool result = arena.message()->ParseFromString(data_);
+      arena.recycle();
+      return result;
+    }));
+  }
+
+private:
+  struct Result final
+  {
+    double allocations_per_message = 0;
+    double messages_per_second = 0;
+  };
+
+  template<class Function>
+  Result measure(Function&& function)
+  {
+    number_allocations.store(0, std::memory_order_relaxed);
+    is_counting.store(true, std::memory_order_relaxed);
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < number_iterations_; ++i)
+    {
+      if (!function())
+      {
+        is_counting.store(false, std::memory_order_relaxed);
+        Stream::Error stream;
+        stream << FNS
+               << "ParseFromString is failed";
+        throw Exception(stream);
+      }
+    }
+    const std::chrono::duration<double> duration =
+      std::chrono::steady_clock::now() - start;
+    is_counting.store(false, std::memory_order_relaxed);
+    const auto allocations =
+      number_allocations.load(std::memory_order_relaxed);
+
+    Result result;
+    result.allocations_per_message =
+      static_cast<double>(allocations) / number_iterations_;
+    result.messages_per_second = number_iterations_ / duration.count();
+    return result;
+  }
+
+  static void print(const char* name, const Result& result)
+  {
+    std::cout << std::fixed << std::setprecision(1)
+              << "  " << name
+              << ": allocations/message = "
+              << result.allocations_per_message
+              << ", messages/s = "
+              << result.messages_per_second
+              << std::endl;
+  }
+
+private:
+  const std::size_t number_iterations_;
+
+  std::string data_;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  try
+  {
+    const std::size_t number_items =
+      argc > 1 ? std::stoul(argv[1]) : 1000;
+    const std::size_t number_tags =
+      argc > 2 ? std::stoul(argv[2]) : 8;
+    const std::size_t number_iterations =
+      argc > 3 ? std::stoul(argv[3]) : 2000;
+
+    ArenaBenchmark(number_items, number_tags, number_iterations).run();
+    return EXIT_SUCCESS;
+  }
+  catch (const std::exception& exc)
+  {
+    std::cerr << "Benchmark is failed: " << exc.what() << std::endl;
+  }
+
+  return EXIT_FAILURE;
+}
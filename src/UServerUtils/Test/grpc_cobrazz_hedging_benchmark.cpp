@@ -0,0 +1,311 @@
+// PROTO
+#include "test_coro_client_client.cobrazz.pb.hpp"
+#include "test_coro_client_service.cobrazz.pb.hpp"
+
+// STD
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <vector>
+
+// USERVER
+#include <userver/engine/async.hpp>
+#include <userver/engine/sleep.hpp>
+
+// THIS
+#include <Logger/Logger.hpp>
+#include <Logger/StreamLogger.hpp>
+#include <UServerUtils/Grpc/Client/PoolClientFactory.hpp>
+#include <UServerUtils/Grpc/Common/ThreadGuard.hpp>
+#include <UServerUtils/Grpc/Server/ConfigCoro.hpp>
+#include <UServerUtils/Grpc/Server/ServerBuilder.hpp>
+#include <UServerUtils/ComponentsBuilder.hpp>
+#include <UServerUtils/Manager.hpp>
+
+using namespace UServerUtils;
+
+namespace
+{
+
+// Every SLOW_PERIOD-th request is answered after SLOW_DELAY.
+constexpr std::size_t SLOW_PERIOD = 100;
+constexpr std::chrono::milliseconds SLOW_DELAY{50};
+
+/**
+ * Echo service with an artificial latency tail.
+ **/
+class TailService final
+  : public test_coro::TestCoroService_Handler_Service,
+    public ReferenceCounting::AtomicImpl
+{
+public:
+  TailService() = default;
+
+  ~TailService() override = default;
+
+  void handle(const Reader& reader) override
+  {
+    while (true)
+    {
+      auto data = reader.read();
+      const auto status = data.status;
+      if (status == ReadStatus::Finish)
+      {
+        break;
+      }
+      else if (status != ReadStatus::Read)
+      {
+        continue;
+      }
+
+      auto& request = data.request;
+      auto& writer = data.writer;
+      if (!request || !writer)
+      {
+        continue;
+      }
+
+      auto response = std::make_unique<Response>();
+      response->set_message(request->message());
+      response->set_id_request_grpc(request->id_request_grpc());
+
+      const auto number = counter_.fetch_add(1, std::memory_order_relaxed);
+      if (number % SLOW_PERIOD == 0)
+      {
+        userver::engine::AsyncNoSpan(
+          [writer = std::move(writer),
+           response = std::move(response)] () mutable {
+            userver::engine::SleepFor(SLOW_DELAY);
+            writer->write(std::move(response));
+          }
+        ).Detach();
+      }
+      else
+      {
+        writer->write(std::move(response));
+      }
+    }
+  }
+
+private:
+  std::atomic<std::size_t> counter_{0};
+};
+
+using TailService_var = ReferenceCounting::SmartPtr<TailService>;
+
+double percentile(
+  const std::vector<std::uint64_t>& sorted,
+  const double value)
+{
+  if (sorted.empty())
+  {
+    return 0;
+  }
+
+  const auto index = std::min(
+    sorted.size() - 1,
+    static_cast<std::size_t>(value * sorted.size()));
+  return sorted[index] / 1000.0;
+}
+
+void run_benchmark(
+  const std::string& name,
+  Logging::Logger* logger,
+  TaskProcessor& task_processor,
+  const std::size_t port,
+  const Grpc::Client::HedgingConfig& hedging_config)
+{
+  using ConfigPoolCoro = Grpc::Client::ConfigPoolCoro;
+  using PoolClientFactory = Grpc::Client::PoolClientFactory;
+
+  const std::size_t number_threads = 16;
+  const std::size_t number_request = 5000;
+
+  ConfigPoolCoro config;
+  config.endpoint = "127.0.0.1:" + std::to_string(port);
+  config.number_async_client = 32;
+  config.number_threads = 4;
+  config.balancing_policy = Grpc::Client::BalancingPolicy::PowerOfTwoChoices;
+  config.hedging = hedging_config;
+
+  PoolClientFactory pool_factory(logger, config);
+  auto pool = pool_factory.create<test_coro::TestCoroService_Handler_ClientPool>(
+    task_processor);
+
+  std::mutex mutex;
+  std::vector<std::uint64_t> latencies;
+  latencies.reserve(number_threads * number_request);
+  std::atomic<std::size_t> number_errors{0};
+
+  const auto start = std::chrono::steady_clock::now();
+  {
+    Grpc::Common::ThreadsGuard threads_guard;
+    for (std::size_t i = 0; i < number_threads; ++i)
+    {
+      threads_guard.add([&] () {
+        std::vector<std::uint64_t> thread_latencies;
+        thread_latencies.reserve(number_request);
+        for (std::size_t j = 0; j < number_request; ++j)
+        {
+          auto request = std::make_unique<test_coro::Request>();
+          request->set_message("hedging");
+
+          const auto request_start = std::chrono::steady_clock::now();
+          auto result = pool->write(std::move(request), 1000);
+          thread_latencies.emplace_back(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+              std::chrono::steady_clock::now() - request_start).count());
+          if (result.status != Grpc::Client::Status::Ok)
+          {
+            number_errors.fetch_add(1, std::memory_order_relaxed);
+          }
+        }
+
+        std::lock_guard lock(mutex);
+        latencies.insert(
+          latencies.end(),
+          thread_latencies.begin(),
+          thread_latencies.end());
+      });
+    }
+  }
+  const std::chrono::duration<double> duration =
+    std::chrono::steady_clock::now() - start;
+
+  std::sort(latencies.begin(), latencies.end());
+  const auto hedging_stats = pool->hedging_stats();
+
+  std::cout << std::fixed << std::setprecision(3)
+            << name << ":\n"
+            << "  rps=" << static_cast<std::size_t>(
+                 latencies.size() / duration.count())
+            << ", errors=" << number_errors.load()
+            << "\n  p50=" << percentile(latencies, 0.5) << "us"
+            << ", p90=" << percentile(latencies, 0.9) << "us"
+            << ", p99=" << percentile(latencies, 0.99) << "us"
+            << ", p999=" << percentile(latencies, 0.999) << "us"
+            << "\n  hedged=" << hedging_stats.number_hedged
+            << ", hedge_won=" << hedging_stats.number_hedge_won
+            << ", budget_exhausted=" << hedging_stats.number_budget_exhausted
+            << ", delay=" << hedging_stats.delay_us << "us"
+            << std::endl;
+}
+
+} // namespace
+
+int main(int /*argc*/, char** /*argv*/)
+{
+  try
+  {
+    const std::size_t port = 7781;
+
+    Logging::Logger_var logger(
+      new Logging::OStream::Logger(
+        Logging::OStream::Config(
+          std::cerr,
+          Logging::Logger::ERROR)));
+
+    CoroPoolConfig coro_pool_config;
+    coro_pool_config.initial_size = 1000;
+    coro_pool_config.max_size = 20000;
+
+    EventThreadPoolConfig event_thread_pool_config;
+    event_thread_pool_config.threads = 2;
+
+    TaskProcessorConfig main_task_processor_config;
+    main_task_processor_config.name = "main_task_processor";
+    main_task_processor_config.worker_threads = 8;
+    main_task_processor_config.thread_name = "main_tskpr";
+
+    auto task_processor_container_builder =
+      std::make_unique<TaskProcessorContainerBuilder>(
+        logger.in(),
+        coro_pool_config,
+        event_thread_pool_config,
+        main_task_processor_config);
+
+    auto init_func = [logger, port] (
+      TaskProcessorContainer& task_processor_container) {
+      auto& main_task_processor =
+        task_processor_container.get_main_task_processor();
+      auto components_builder = std::make_unique<ComponentsBuilder>();
+
+      Grpc::Server::ConfigCoro config;
+      config.num_threads = 4;
+      config.port = port;
+      config.max_size_queue = {};
+
+      auto grpc_builder = std::make_unique<Grpc::Server::ServerBuilder>(
+        config,
+        logger.in());
+      TailService_var service(new TailService);
+      grpc_builder->add_service(
+        service.in(),
+        main_task_processor);
+
+      components_builder->add_grpc_cobrazz_server(
+        std::move(grpc_builder));
+
+      return components_builder;
+    };
+
+    Manager_var manager(
+      new Manager(
+        std::move(task_processor_container_builder),
+        std::move(init_func),
+        logger.in()));
+    manager->activate_object();
+
+    auto& task_processor = manager->get_main_task_processor();
+
+    Grpc::Client::HedgingConfig hedging_config;
+    run_benchmark(
+      "Without hedging",
+      logger.in(),
+      task_processor,
+      port,
+      hedging_config);
+
+    hedging_config.enabled = true;
+    hedging_config.delay = 5;
+    run_benchmark(
+      "Hedging [delay=5ms]",
+      logger.in(),
+      task_processor,
+      port,
+      hedging_config);
+
+    hedging_config.delay = {};
+    hedging_config.percentile = 0.95;
+    run_benchmark(
+      "Hedging [delay=p95]",
+      logger.in(),
+      task_processor,
+      port,
+      hedging_config);
+
+    hedging_config.tokens_per_request = 0.001;
+    hedging_config.max_tokens = 1;
+    run_benchmark(
+      "Hedging [delay=p95, small budget]",
+      logger.in(),
+      task_processor,
+      port,
+      hedging_config);
+
+    manager->deactivate_object();
+    manager->wait_object();
+  }
+  catch (const std::exception& exc)
+  {
+    std::cerr << "Benchmark is failed. Reason: "
+              << exc.what();
+  }
+  catch (...)
+  {
+    std::cerr << "Benchmark is failed. Unknown error";
+  }
+}
@@ -10,11 +10,16 @@
 
 // STD
 #include <atomic>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
 
 // THIS
 #include <Logger/Logger.hpp>
 #include <Logger/StreamLogger.hpp>
 #include <UServerUtils/Grpc/Common/ShutdownManager.hpp>
+#include <UServerUtils/Grpc/Common/ThreadGuard.hpp>
 #include <UServerUtils/Grpc/Client/Config.hpp>
 #include <UServerUtils/Grpc/Server/Config.hpp>
 #include <UServerUtils/Grpc/Server/Server.hpp>
@@ -557,4 +562,426 @@ TEST_F(GrpcFixtureStreamStream_Client_ClientFinish, TestStreamStream_Client_NoAc
   server_->wait_object();
 
   EXPECT_EQ(kNumberRequest + 1, kCounterClientStreamStream.exchange(0));
-}
\ No newline at end of file
+}
+
+namespace
+{
+
+const std::size_t kNumberThroughputRequest = 10000;
+
+class StreamStreamHandler_Throughput final
+  : public test::TestService_HandlerStreamStream_Handler
+{
+public:
+  StreamStreamHandler_Throughput() = default;
+
+  ~StreamStreamHandler_Throughput() = default;
+
+  void on_request(const test::Request& request) override
+  {
+    auto response = std::make_unique<test::Reply>();
+    response->set_message(request.message());
+    send(std::move(response));
+  }
+
+  void initialize() override
+  {
+  }
+
+  void on_reads_done() override
+  {
+    finish(grpc::Status::OK);
+  }
+
+  void on_finish() override
+  {
+  }
+};
+
+class StreamStreamClient_ThroughputImpl final:
+  public test::TestService_HandlerStreamStream_ClientObserver
+{
+public:
+  StreamStreamClient_ThroughputImpl(
+    const Common::ShutdownManagerPtr& shutdown_manager)
+    : shutdown_manager_(shutdown_manager)
+  {
+  }
+
+  ~StreamStreamClient_ThroughputImpl() override = default;
+
+  std::size_t number_read() const noexcept
+  {
+    return number_read_.load();
+  }
+
+private:
+  void on_initialize(const bool ok) override
+  {
+    EXPECT_TRUE(ok);
+  }
+
+  void on_read(test::Reply&& /*response*/) override
+  {
+    number_read_.fetch_add(1);
+  }
+
+  void on_finish(grpc::Status&& status) override
+  {
+    EXPECT_TRUE(status.ok());
+    shutdown_manager_->shutdown();
+  }
+
+private:
+  const Common::ShutdownManagerPtr shutdown_manager_;
+
+  std::atomic<std::size_t> number_read_{0};
+};
+
+class GrpcFixtureStreamStream_Client_Throughput : public testing::Test
+{
+public:
+  using WriterStatus = Client::WriterStatus;
+  using Factory = test::TestService_HandlerStreamStream_Factory;
+  using Impl = StreamStreamClient_ThroughputImpl;
+  using WriteCoalescingConfig = Common::WriteCoalescingConfig;
+  using WriteCoalescingStats = Common::WriteCoalescingStats;
+
+  struct Result final
+  {
+    // Messages per second of echo stream (request and response).
+    double throughput = 0;
+    // Responses written by the server.
+    WriteCoalescingStats stats;
+  };
+
+public:
+  void SetUp() override
+  {
+    logger_ = new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::CRITICAL));
+  }
+
+  Result run(const WriteCoalescingConfig& write_coalescing)
+  {
+    UServerUtils::Grpc::Server::Config config;
+    config.num_threads = 3;
+    config.port = port_;
+    config.write_coalescing = write_coalescing;
+
+    UServerUtils::Grpc::Server::Server_var server(
+      new UServerUtils::Grpc::Server::Server(
+        config,
+        logger_.in()));
+    server->register_handler<StreamStreamHandler_Throughput>();
+    server->activate_object();
+
+    Client::Config client_config;
+    client_config.endpoint = "127.0.0.1:" + std::to_string(port_);
+    client_config.write_coalescing = write_coalescing;
+
+    Result result;
+    {
+      Common::ShutdownManagerPtr shutdown_manager =
+        std::make_shared<Common::ShutdownManager>();
+      auto factory = std::make_unique<Factory>(client_config, logger_);
+      auto observer = std::make_shared<Impl>(shutdown_manager);
+
+      const auto time_start = std::chrono::steady_clock::now();
+      auto writer = factory->create(observer);
+      for (std::size_t i = 0; i < kNumberThroughputRequest; ++i)
+      {
+        auto request = std::make_unique<test::Request>();
+        request->set_message(kMessageRequest + std::to_string(i));
+        EXPECT_EQ(writer->write(std::move(request)), WriterStatus::Ok);
+      }
+      EXPECT_EQ(writer->writes_done(), WriterStatus::Ok);
+      shutdown_manager->wait();
+      const auto time_end = std::chrono::steady_clock::now();
+
+      EXPECT_EQ(observer->number_read(), kNumberThroughputRequest);
+      result.throughput = kNumberThroughputRequest /
+        std::chrono::duration<double>(time_end - time_start).count();
+    }
+
+    server->deactivate_object();
+    server->wait_object();
+    result.stats = server->write_coalescing_stats();
+
+    return result;
+  }
+
+  const std::size_t port_ = 7779;
+
+  Logging::Logger_var logger_;
+};
+
+} // namespace
+
+TEST_F(GrpcFixtureStreamStream_Client_Throughput, TestStreamStream_WriteCoalescing)
+{
+  WriteCoalescingConfig disabled;
+  const auto result_disabled = run(disabled);
+  EXPECT_EQ(result_disabled.stats.number_writes, kNumberThroughputRequest);
+  EXPECT_EQ(
+    result_disabled.stats.number_flushes,
+    result_disabled.stats.number_writes);
+
+  WriteCoalescingConfig enabled;
+  enabled.is_enabled = true;
+  const auto result_enabled = run(enabled);
+  EXPECT_EQ(result_enabled.stats.number_writes, kNumberThroughputRequest);
+  EXPECT_LT(
+    result_enabled.stats.number_flushes,
+    result_enabled.stats.number_writes);
+
+  std::cout << "Echo stream of "
+            << kNumberThroughputRequest
+            << " messages, msg/s: write coalescing disabled="
+            << static_cast<std::uint64_t>(result_disabled.throughput)
+            << ", enabled="
+            << static_cast<std::uint64_t>(result_enabled.throughput)
+            << ", flushes: disabled="
+            << result_disabled.stats.number_flushes
+            << ", enabled="
+            << result_enabled.stats.number_flushes
+            << std::endl;
+}
+
+namespace
+{
+
+class GrpcFixtureStreamStream_Client_Arena : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    logger_ = new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::CRITICAL));
+
+    UServerUtils::Grpc::Server::Config config;
+    config.num_threads = 3;
+    config.port = port_;
+    config.is_arena_enabled = true;
+    config.arena_initial_block_size = 64;
+
+    server_ = UServerUtils::Grpc::Server::Server_var(
+      new UServerUtils::Grpc::Server::Server(
+        config,
+        logger_));
+    server_->register_handler<StreamStreamHandler_ClientFinish>();
+  }
+
+  void TearDown() override
+  {
+  }
+
+  const std::size_t port_ = 7779;
+
+  Logging::Logger_var logger_;
+
+  UServerUtils::Grpc::Server::Server_var server_;
+};
+
+} // namespace
+
+TEST_F(GrpcFixtureStreamStream_Client_Arena, TestStreamStream_Client_Arena)
+{
+  server_->activate_object();
+
+  Client::Config client_config;
+  client_config.endpoint =
+    "127.0.0.1:" + std::to_string(port_);
+  client_config.is_arena_enabled = true;
+  client_config.arena_initial_block_size = 64;
+  kCounterClientStreamStream.exchange(0);
+
+  // Each message of the stream is parsed into the arena
+  // recycled by client and server
+  Common::ShutdownManagerPtr shutdown_manager =
+    std::make_shared<Common::ShutdownManager>();
+  {
+    StreamStreamClient_ClientFinish client(
+      client_config,
+      logger_,
+      shutdown_manager,
+      kMessageRequest);
+    client.start();
+    shutdown_manager->wait();
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  }
+
+  server_->deactivate_object();
+  server_->wait_object();
+
+  EXPECT_EQ(kNumberRequest + 1, kCounterClientStreamStream.exchange(0));
+}
+
+namespace
+{
+
+// More than the pending ring of rpc, so a burst overflows it.
+const std::size_t kNumberForeignWrite = 10000;
+const std::string kModePaced = "paced";
+
+// Writers of handlers, joined by the test before the server stops.
+Common::ThreadsGuard kForeignWriters;
+
+class StreamStreamHandler_ForeignThread final
+  : public test::TestService_HandlerStreamStream_Handler
+{
+public:
+  StreamStreamHandler_ForeignThread() = default;
+
+  ~StreamStreamHandler_ForeignThread() = default;
+
+  void on_request(const test::Request& request) override
+  {
+    // Writes of other threads go through RpcImpl::post: paced writes
+    // fit the pending ring, a burst overflows it.
+    std::shared_ptr<Writer> writer = get_writer();
+    kForeignWriters.add(
+      [writer, is_paced = request.message() == kModePaced] () {
+        for (std::size_t i = 0; i < kNumberForeignWrite; ++i)
+        {
+          auto response = std::make_unique<test::Reply>();
+          response->set_message(std::to_string(i));
+          EXPECT_EQ(
+            writer->write(std::move(response)),
+            UServerUtils::Grpc::Server::WriterStatus::Ok);
+          if (is_paced && i % 32 == 31)
+          {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+          }
+        }
+
+        EXPECT_EQ(
+          writer->finish(grpc::Status::OK),
+          UServerUtils::Grpc::Server::WriterStatus::Ok);
+      });
+  }
+
+  void initialize() override
+  {
+  }
+
+  void on_reads_done() override
+  {
+  }
+
+  void on_finish() override
+  {
+  }
+
+private:
+  using Writer = UServerUtils::Grpc::Server::Writer<test::Reply>;
+};
+
+class StreamStreamClient_ForeignThreadImpl final:
+  public test::TestService_HandlerStreamStream_ClientObserver
+{
+public:
+  StreamStreamClient_ForeignThreadImpl(
+    const Common::ShutdownManagerPtr& shutdown_manager)
+    : shutdown_manager_(shutdown_manager)
+  {
+  }
+
+  ~StreamStreamClient_ForeignThreadImpl() override = default;
+
+private:
+  void on_initialize(const bool ok) override
+  {
+    EXPECT_TRUE(ok);
+  }
+
+  void on_read(test::Reply&& response) override
+  {
+    EXPECT_EQ(response.message(), std::to_string(counter_));
+    counter_ += 1;
+  }
+
+  void on_finish(grpc::Status&& status) override
+  {
+    EXPECT_TRUE(status.ok());
+    EXPECT_EQ(counter_, kNumberForeignWrite);
+    shutdown_manager_->shutdown();
+  }
+
+private:
+  const Common::ShutdownManagerPtr shutdown_manager_;
+
+  std::size_t counter_ = 0;
+};
+
+class GrpcFixtureStreamStream_Client_ForeignThread : public testing::Test
+{
+public:
+  using Factory = test::TestService_HandlerStreamStream_Factory;
+  using Impl = StreamStreamClient_ForeignThreadImpl;
+  using WriterStatus = Client::WriterStatus;
+
+public:
+  void SetUp() override
+  {
+    logger_ = new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::CRITICAL));
+
+    UServerUtils::Grpc::Server::Config config;
+    config.num_threads = 3;
+    config.port = port_;
+
+    server_ = UServerUtils::Grpc::Server::Server_var(
+      new UServerUtils::Grpc::Server::Server(
+        config,
+        logger_.in()));
+    server_->register_handler<StreamStreamHandler_ForeignThread>();
+  }
+
+  void TearDown() override
+  {
+  }
+
+  void run(const std::string& mode)
+  {
+    Client::Config client_config;
+    client_config.endpoint = "127.0.0.1:" + std::to_string(port_);
+
+    Common::ShutdownManagerPtr shutdown_manager =
+      std::make_shared<Common::ShutdownManager>();
+    auto factory = std::make_unique<Factory>(client_config, logger_);
+    auto writer = factory->create(std::make_shared<Impl>(shutdown_manager));
+    auto request = std::make_unique<test::Request>();
+    request->set_message(mode);
+    EXPECT_EQ(writer->write(std::move(request)), WriterStatus::Ok);
+    shutdown_manager->wait();
+
+    kForeignWriters.clear();
+  }
+
+  const std::size_t port_ = 7779;
+
+  Logging::Logger_var logger_;
+
+  UServerUtils::Grpc::Server::Server_var server_;
+};
+
+} // namespace
+
+TEST_F(GrpcFixtureStreamStream_Client_ForeignThread, TestStreamStream_ForeignThreadWrites)
+{
+  server_->activate_object();
+
+  run(kModePaced);
+  run("burst");
+
+  server_->deactivate_object();
+  server_->wait_object();
+}
@@ -284,6 +284,80 @@ TEST_F(GrpcFixtureStreamStreamCoro_ClientTest_Success, Success_MultiThread)
   EXPECT_EQ(kCountCreateService.exchange(0), kCountDestroyService.exchange(0));
 }
 
+TEST_F(GrpcFixtureStreamStreamCoro_ClientTest_Success, BalancingPolicy)
+{
+  using BalancingPolicy = UServerUtils::Grpc::Client::BalancingPolicy;
+  using ConfigPoolCoro = UServerUtils::Grpc::Client::ConfigPoolCoro;
+  using PoolClientFactory = UServerUtils::Grpc::Client::PoolClientFactory;
+
+  manager_->activate_object();
+
+  auto& task_processor = manager_->get_main_task_processor();
+
+  const std::size_t number_request = 300;
+  const std::size_t number_threads = 10;
+  for (const auto policy : {
+    BalancingPolicy::RoundRobin,
+    BalancingPolicy::LeastOutstanding,
+    BalancingPolicy::PowerOfTwoChoices,
+    BalancingPolicy::EwmaLatency})
+  {
+    ConfigPoolCoro config;
+    config.endpoint = "127.0.0.1:" + std::to_string(port_);
+    config.number_async_client = 14;
+    config.number_threads = 7;
+    config.balancing_policy = policy;
+
+    PoolClientFactory pool_factory(
+      logger_.in(),
+      config);
+    auto pool = pool_factory.create<test_coro::TestCoroService_Handler_ClientPool>(
+      task_processor);
+
+    {
+      UServerUtils::Grpc::Common::ThreadsGuard threads_guard;
+      for (std::size_t i = 1; i <= number_threads; ++i)
+      {
+        threads_guard.add([number_request, pool] () {
+          for (std::size_t i = 1; i <= number_request; ++i)
+          {
+            auto request = std::make_unique<test_coro::Request>();
+            const auto message = kMessageRequest + std::to_string(i);
+            request->set_message(message);
+            auto result = pool->write(std::move(request), 2000);
+            EXPECT_EQ(result.status, UServerUtils::Grpc::Client::Status::Ok);
+          }
+        });
+      }
+    }
+
+    const auto stats = pool->stats();
+    EXPECT_EQ(stats.size(), 14);
+
+    std::size_t number_requests = 0;
+    std::size_t number_used_clients = 0;
+    for (const auto& client_stats : stats)
+    {
+      EXPECT_EQ(client_stats.in_flight, 0);
+      EXPECT_EQ(client_stats.number_errors, 0);
+      number_requests += client_stats.number_requests;
+      if (client_stats.number_requests != 0)
+      {
+        number_used_clients += 1;
+        EXPECT_GT(client_stats.ewma_latency_us, 0);
+      }
+    }
+    EXPECT_EQ(number_requests, number_threads * number_request);
+    EXPECT_GT(number_used_clients, 1);
+  }
+
+  manager_->deactivate_object();
+  manager_->wait_object();
+  manager_.reset();
+
+  EXPECT_EQ(kCountCreateService.exchange(0), kCountDestroyService.exchange(0));
+}
+
 namespace
 {
 
@@ -3,7 +3,10 @@
 
 // STD
 #include <atomic>
+#include <chrono>
+#include <thread>
 #include <unordered_map>
+#include <vector>
 
 // PROTO
 #include "test_service.cobrazz.pb.hpp"
@@ -786,4 +789,192 @@ TEST_F(GrpcFixtureStreamStream_Exception, EventToCoroutine_Exception)
   EXPECT_EQ(
     kCountEvent.exchange(0),
     number_cycle * (6 + kNumberExceptionRequest));
-}
\ No newline at end of file
+}
+namespace
+{
+
+// Limit of a task processor is fixed at kConcurrencyLimit.
+const std::uint32_t kConcurrencyLimit = 2;
+
+class StreamStreamClient_Limit final
+{
+public:
+  explicit StreamStreamClient_Limit(
+    const std::shared_ptr<::grpc::Channel>& channel)
+    : stub_(test::TestService::NewStub(channel)),
+      reader_writer_(stub_->HandlerStreamStream(&context_))
+  {
+    EXPECT_TRUE(reader_writer_);
+  }
+
+  // More requests than the limit: admitted stream answers all of them.
+  void exchange()
+  {
+    for (std::size_t i = 1; i <= kNumberOkRequest; ++i)
+    {
+      test::Request request;
+      request.set_message(kRequestOk);
+      EXPECT_TRUE(reader_writer_->Write(request));
+
+      test::Reply reply;
+      ASSERT_TRUE(reader_writer_->Read(&reply));
+      EXPECT_EQ(kRequestOk + std::to_string(i), reply.message());
+    }
+  }
+
+  grpc::Status finish()
+  {
+    reader_writer_->WritesDone();
+    return reader_writer_->Finish();
+  }
+
+private:
+  grpc::ClientContext context_;
+
+  std::unique_ptr<test::TestService::Stub> stub_;
+
+  std::unique_ptr<grpc::ClientReaderWriter<test::Request, test::Reply>>
+    reader_writer_;
+};
+
+class GrpcFixtureStreamStream_ConcurrencyLimit : public testing::Test
+{
+public:
+  void SetUp(const UServerUtils::Grpc::Server::ServiceMode service_mode)
+  {
+    logger_ = new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::CRITICAL));
+
+    CoroPoolConfig coro_pool_config;
+    EventThreadPoolConfig event_thread_pool_config;
+    TaskProcessorConfig main_task_processor_config;
+    main_task_processor_config.name = "main_task_processor";
+    main_task_processor_config.worker_threads = 3;
+    main_task_processor_config.thread_name = "main_tskpr";
+
+    auto task_processor_container_builder =
+      std::make_unique<TaskProcessorContainerBuilder>(
+        logger_.in(),
+        coro_pool_config,
+        event_thread_pool_config,
+        main_task_processor_config);
+
+    auto init_func = [logger = logger_, port = port_, service_mode] (
+      TaskProcessorContainer& task_processor_container) {
+      auto& main_task_processor =
+        task_processor_container.get_main_task_processor();
+
+      auto components_builder = std::make_unique<ComponentsBuilder>();
+
+      Grpc::Server::ConcurrencyLimiterConfig limiter_config;
+      limiter_config.initial_limit = kConcurrencyLimit;
+      limiter_config.min_limit = kConcurrencyLimit;
+      limiter_config.max_limit = kConcurrencyLimit;
+
+      Grpc::Server::ConfigCoro config;
+      config.num_threads = 3;
+      config.port = port;
+      config.max_size_queue = {};
+      config.concurrency_limiter = limiter_config;
+
+      auto grpc_builder = std::make_unique<Grpc::Server::ServerBuilder>(
+        config,
+        logger);
+      auto service = StreamStreamService_Ok_var(
+        new StreamStreamService_Ok);
+      // High priority may use the whole limit.
+      grpc_builder->add_service(
+        service.in(),
+        main_task_processor,
+        service_mode,
+        Grpc::Server::RpcPriority::High);
+
+      components_builder->add_grpc_cobrazz_server(
+        std::move(grpc_builder));
+
+      return components_builder;
+    };
+
+    manager_ = new Manager(
+      std::move(task_processor_container_builder),
+      std::move(init_func),
+      logger_.in());
+  }
+
+  void TearDown() override
+  {
+  }
+
+  void check_concurrency_limit()
+  {
+    manager_->activate_object();
+
+    auto channel = grpc::CreateChannel(
+      "127.0.0.1:" + std::to_string(port_),
+      grpc::InsecureChannelCredentials());
+
+    {
+      std::vector<std::unique_ptr<StreamStreamClient_Limit>> clients;
+      for (std::size_t i = 0; i < kConcurrencyLimit; ++i)
+      {
+        clients.emplace_back(
+          std::make_unique<StreamStreamClient_Limit>(channel));
+        clients.back()->exchange();
+      }
+
+      // Limit is saturated by open streams: a new one is rejected
+      // at its start, the admitted ones go on.
+      StreamStreamClient_Limit rejected_client(channel);
+      EXPECT_EQ(
+        rejected_client.finish().error_code(),
+        grpc::StatusCode::RESOURCE_EXHAUSTED);
+
+      for (auto& client : clients)
+      {
+        client->exchange();
+        EXPECT_TRUE(client->finish().ok());
+      }
+    }
+
+    // Slots are freed when the server sees the streams done.
+    grpc::StatusCode status_code = grpc::StatusCode::RESOURCE_EXHAUSTED;
+    for (std::size_t i = 0;
+      i < 100 && status_code == grpc::StatusCode::RESOURCE_EXHAUSTED;
+      ++i)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      status_code = StreamStreamClient_Limit(channel).finish().error_code();
+    }
+    EXPECT_EQ(status_code, grpc::StatusCode::OK);
+
+    StreamStreamClient_Ok client(channel);
+    client.request(kRequestOk);
+
+    manager_->deactivate_object();
+    manager_->wait_object();
+
+    kCountEvent.exchange(0);
+  }
+
+  std::size_t port_ = 7778;
+
+  Logging::Logger_var logger_;
+
+  Manager_var manager_;
+};
+
+} // namespace
+
+TEST_F(GrpcFixtureStreamStream_ConcurrencyLimit, RpcToCoroutine_ConcurrencyLimit)
+{
+  SetUp(UServerUtils::Grpc::Server::ServiceMode::RpcToCoroutine);
+  check_concurrency_limit();
+}
+
+TEST_F(GrpcFixtureStreamStream_ConcurrencyLimit, EventToCoroutine_ConcurrencyLimit)
+{
+  SetUp(UServerUtils::Grpc::Server::ServiceMode::EventToCoroutine);
+  check_concurrency_limit();
+}
@@ -9,7 +9,11 @@
 #include <grpcpp/grpcpp.h>
 
 // STD
+#include <algorithm>
 #include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
 
 // THIS
 #include <Logger/Logger.hpp>
@@ -285,4 +289,133 @@ TEST_F(GrpcFixtureUnaryUnary_Client, UnaryUnary_Client_NoAction)
       logger_);
   }
   EXPECT_TRUE(true);
-}
\ No newline at end of file
+}
+namespace
+{
+
+class UnaryUnaryClient_ArenaImpl final :
+  public test::TestService_HandlerUnaryUnary_ClientObserver
+{
+public:
+  UnaryUnaryClient_ArenaImpl(
+    const Common::ShutdownManagerPtr& shutdown_manager)
+    : shutdown_manager_(shutdown_manager),
+      is_received_(kNumberRequest + 1, false)
+  {
+  }
+
+  ~UnaryUnaryClient_ArenaImpl() override = default;
+
+  std::size_t number_received() const
+  {
+    std::lock_guard lock(mutex_);
+    return std::count(is_received_.begin(), is_received_.end(), true);
+  }
+
+private:
+  void on_finish(
+    grpc::Status&& status,
+    test::Reply&& response) override
+  {
+    EXPECT_EQ(status.error_code(), grpc::StatusCode::OK);
+
+    const auto& message = response.message();
+    EXPECT_EQ(message.rfind(kRequestOk, 0), 0);
+    if (message.rfind(kRequestOk, 0) == 0)
+    {
+      const auto index = std::stoul(message.substr(kRequestOk.size()));
+      std::lock_guard lock(mutex_);
+      EXPECT_TRUE(index <= kNumberRequest && !is_received_[index]);
+      if (index <= kNumberRequest)
+      {
+        is_received_[index] = true;
+      }
+    }
+
+    const auto count = counter_.fetch_add(1, std::memory_order_acq_rel);
+    if (count == kNumberRequest - 1)
+    {
+      shutdown_manager_->shutdown();
+    }
+  }
+
+private:
+  const Common::ShutdownManagerPtr shutdown_manager_;
+
+  mutable std::mutex mutex_;
+
+  std::vector<bool> is_received_;
+
+  std::atomic<std::size_t> counter_{0};
+};
+
+class GrpcFixtureUnaryUnary_Client_Arena
+  : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    logger_ = new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::CRITICAL));
+
+    UServerUtils::Grpc::Server::Config config;
+    config.num_threads = 3;
+    config.port = port_;
+    config.is_arena_enabled = true;
+    config.arena_initial_block_size = 256;
+
+    server_ = new UServerUtils::Grpc::Server::Server(
+      config,
+      logger_.in());
+    server_->register_handler<UnaryUnaryHandler>();
+  }
+
+  void TearDown() override
+  {
+  }
+
+  std::size_t port_ = 7778;
+
+  Logging::Logger_var logger_;
+
+  UServerUtils::Grpc::Server::Server_var server_;
+};
+
+} // namespace
+
+TEST_F(GrpcFixtureUnaryUnary_Client_Arena, UnaryUnary_Client_Arena)
+{
+  using Factory = test::TestService_HandlerUnaryUnary_Factory;
+
+  server_->activate_object();
+
+  Common::ShutdownManagerPtr shutdown_manager =
+    std::make_shared<Common::ShutdownManager>();
+  Client::Config client_config;
+  client_config.endpoint =
+    "127.0.0.1:" + std::to_string(port_);
+  client_config.is_arena_enabled = true;
+  client_config.arena_initial_block_size = 256;
+
+  {
+    Factory factory(client_config, logger_.in());
+    auto impl = std::make_shared<UnaryUnaryClient_ArenaImpl>(
+      shutdown_manager);
+    for (std::size_t i = 1; i <= kNumberRequest; ++i)
+    {
+      // Messages larger than the initial arena block
+      auto request = std::make_unique<test::Request>();
+      request->set_message(
+        kRequestOk + std::to_string(i) + std::string(1000, ' '));
+      factory.create(impl, std::move(request));
+    }
+    shutdown_manager->wait();
+
+    EXPECT_EQ(impl->number_received(), kNumberRequest);
+  }
+
+  server_->deactivate_object();
+  server_->wait_object();
+}
@@ -0,0 +1,138 @@
+// GTEST
+#include "gtest/gtest.h"
+
+// STD
+#include <chrono>
+#include <vector>
+
+// THIS
+#include <UServerUtils/Grpc/Server/ConcurrencyLimiter.hpp>
+
+namespace
+{
+
+using namespace UServerUtils::Grpc::Server;
+
+using Permit = ConcurrencyLimiter::Permit;
+using Permits = std::vector<Permit>;
+
+ConcurrencyLimiterConfig create_config(
+  const ConcurrencyLimitAlgorithm algorithm)
+{
+  ConcurrencyLimiterConfig config;
+  config.algorithm = algorithm;
+  config.initial_limit = 100;
+  config.min_limit = 10;
+  config.max_limit = 1000;
+  config.window_size = 10;
+  // Windows are closed by the number of samples only.
+  config.window_duration = std::chrono::hours(1);
+  return config;
+}
+
+// Runs concurrency rpc at a time, all of them with the given latency.
+void run_window(
+  ConcurrencyLimiter& limiter,
+  const std::size_t concurrency,
+  const std::chrono::microseconds latency)
+{
+  Permits permits;
+  for (std::size_t i = 0; i < concurrency; ++i)
+  {
+    auto permit = limiter.try_acquire(RpcPriority::High);
+    ASSERT_TRUE(permit);
+    permits.emplace_back(std::move(permit));
+  }
+
+  for (auto& permit : permits)
+  {
+    permit.release(latency);
+  }
+}
+
+} // namespace
+
+TEST(GrpcConcurrencyLimiterTest, Priorities)
+{
+  ConcurrencyLimiter limiter(
+    create_config(ConcurrencyLimitAlgorithm::Gradient));
+  EXPECT_EQ(limiter.limit(), 100);
+
+  Permits permits;
+  while (auto permit = limiter.try_acquire(RpcPriority::Low))
+  {
+    permits.emplace_back(std::move(permit));
+  }
+  EXPECT_EQ(permits.size(), 50);
+
+  while (auto permit = limiter.try_acquire(RpcPriority::Normal))
+  {
+    permits.emplace_back(std::move(permit));
+  }
+  EXPECT_EQ(permits.size(), 80);
+
+  while (auto permit = limiter.try_acquire(RpcPriority::High))
+  {
+    permits.emplace_back(std::move(permit));
+  }
+  EXPECT_EQ(permits.size(), 100);
+  EXPECT_EQ(limiter.in_flight(), 100);
+
+  EXPECT_TRUE(limiter.try_acquire(RpcPriority::Critical));
+
+  const auto stats = limiter.stats();
+  EXPECT_EQ(stats.number_accepted, 101);
+  EXPECT_EQ(stats.number_rejected[static_cast<std::size_t>(RpcPriority::Low)], 1);
+  EXPECT_EQ(stats.number_rejected[static_cast<std::size_t>(RpcPriority::High)], 1);
+
+  permits.clear();
+  EXPECT_EQ(limiter.in_flight(), 0);
+}
+
+TEST(GrpcConcurrencyLimiterTest, Gradient)
+{
+  ConcurrencyLimiter limiter(
+    create_config(ConcurrencyLimitAlgorithm::Gradient));
+
+  // Stable latency with load near the limit: limit grows.
+  for (std::size_t i = 0; i < 20; ++i)
+  {
+    run_window(limiter, limiter.limit() * 9 / 10, std::chrono::milliseconds(1));
+  }
+  const auto grown_limit = limiter.limit();
+  EXPECT_GT(grown_limit, 100);
+
+  // Load far below the limit: limit does not grow.
+  run_window(limiter, 10, std::chrono::milliseconds(1));
+  EXPECT_EQ(limiter.limit(), grown_limit);
+
+  // Latency grows: limit goes down.
+  for (std::size_t i = 0; i < 20; ++i)
+  {
+    run_window(limiter, 10, std::chrono::milliseconds(10));
+  }
+  EXPECT_LT(limiter.limit(), grown_limit / 2);
+
+  const auto stats = limiter.stats();
+  EXPECT_EQ(stats.short_rtt_us, 10000);
+  EXPECT_GT(stats.long_rtt_us, 1000);
+}
+
+TEST(GrpcConcurrencyLimiterTest, Aimd)
+{
+  auto config = create_config(ConcurrencyLimitAlgorithm::Aimd);
+  config.latency_threshold = std::chrono::milliseconds(5);
+  ConcurrencyLimiter limiter(config);
+
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    run_window(limiter, 60, std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(limiter.limit(), 110);
+
+  for (std::size_t i = 0; i < 100; ++i)
+  {
+    run_window(limiter, 10, std::chrono::milliseconds(20));
+  }
+  EXPECT_EQ(limiter.limit(), 10);
+}
@@ -0,0 +1,166 @@
+// GTEST
+#include "gtest/gtest.h"
+
+// GRPC
+#include <grpcpp/grpcpp.h>
+#include <grpcpp/notifier.h>
+
+// STD
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+
+// THIS
+#include <Logger/Logger.hpp>
+#include <Logger/StreamLogger.hpp>
+#include <UServerUtils/Grpc/Common/EventPool.hpp>
+#include <UServerUtils/Grpc/Common/Scheduler.hpp>
+
+namespace
+{
+
+using namespace UServerUtils::Grpc::Common;
+
+class CountEvent final : public PooledEvent
+{
+public:
+  explicit CountEvent(std::atomic<std::size_t>& counter)
+    : counter_(counter)
+  {
+  }
+
+  ~CountEvent() override = default;
+
+  void handle(const bool /*ok*/) noexcept override
+  {
+    counter_.fetch_add(1, std::memory_order_relaxed);
+    delete this;
+  }
+
+private:
+  std::atomic<std::size_t>& counter_;
+};
+
+} // namespace
+
+TEST(GrpcEventPoolTest, SameThread)
+{
+  const auto stats_before = EventPool::stats();
+
+  std::atomic<std::size_t> counter{0};
+  const std::size_t number_events = 10000;
+  for (std::size_t i = 0; i < number_events; ++i)
+  {
+    auto* event = new CountEvent(counter);
+    event->handle(true);
+  }
+  EXPECT_EQ(counter.load(), number_events);
+
+  const auto stats_after = EventPool::stats();
+  EXPECT_EQ(
+    stats_after.number_outstanding,
+    stats_before.number_outstanding);
+  EXPECT_GE(
+    stats_after.number_hits - stats_before.number_hits,
+    number_events - 1);
+}
+
+TEST(GrpcEventPoolTest, CompletionQueueThreads)
+{
+  Logging::Logger_var logger(
+    new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::ERROR)));
+
+  const auto stats_before = EventPool::stats();
+
+  std::atomic<std::size_t> counter{0};
+  const std::size_t number_events = 100000;
+  {
+    Scheduler::Queues queues;
+    queues.emplace_back(std::make_shared<grpc::CompletionQueue>());
+    queues.emplace_back(std::make_shared<grpc::CompletionQueue>());
+    auto scheduler = std::make_shared<Scheduler>(logger.in(), std::move(queues));
+
+    grpc::Notifier notifier;
+    for (std::size_t i = 0; i < number_events; ++i)
+    {
+      auto event = std::make_unique<CountEvent>(counter);
+      const auto& queue = scheduler->queues()[i % scheduler->size()];
+      ASSERT_TRUE(notifier.Notify(queue.get(), event.get()));
+      event.release();
+
+      // Let the queue threads keep up with the writer.
+      while (i + 1 - counter.load(std::memory_order_relaxed) > 1000)
+      {
+        std::this_thread::yield();
+      }
+    }
+
+    while (counter.load() != number_events)
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  // Queue threads are joined, every event is deleted.
+  const auto stats = EventPool::stats();
+  EXPECT_EQ(counter.load(), number_events);
+  EXPECT_EQ(stats.number_outstanding, stats_before.number_outstanding);
+  // Blocks freed by the queue threads come back to the writer.
+  EXPECT_GT(stats.number_hits, stats_before.number_hits);
+  EXPECT_GT(stats.hit_rate(), 0.5);
+}
+
+namespace
+{
+
+/**
+ * Constructed before the event pool cache of the thread,
+ * so destroyed after it.
+ **/
+struct LateEventDeleter final
+{
+  ~LateEventDeleter()
+  {
+    if (event)
+    {
+      event->handle(true);
+    }
+
+    auto* late_event = new CountEvent(*counter);
+    late_event->handle(true);
+  }
+
+  std::atomic<std::size_t>* counter = nullptr;
+
+  CountEvent* event = nullptr;
+};
+
+thread_local LateEventDeleter late_event_deleter;
+
+} // namespace
+
+TEST(GrpcEventPoolTest, ThreadExit)
+{
+  const auto stats_before = EventPool::stats();
+
+  std::atomic<std::size_t> counter{0};
+  std::thread thread([&counter] () {
+    late_event_deleter.counter = &counter;
+    for (std::size_t i = 0; i < 1000; ++i)
+    {
+      auto* event = new CountEvent(counter);
+      event->handle(true);
+    }
+    late_event_deleter.event = new CountEvent(counter);
+  });
+  thread.join();
+
+  EXPECT_EQ(counter.load(), 1002);
+  EXPECT_EQ(
+    EventPool::stats().number_outstanding,
+    stats_before.number_outstanding);
+}
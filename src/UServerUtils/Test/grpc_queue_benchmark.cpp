@@ -0,0 +1,226 @@
+// STD
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+// THIS
+#include <UServerUtils/Grpc/Common/Queue.hpp>
+#include <UServerUtils/Grpc/Common/QueueGranular.hpp>
+#include <UServerUtils/Grpc/Common/QueueMpmc.hpp>
+
+namespace
+{
+
+struct Data final
+{
+  std::uint64_t value = 0;
+  std::uint64_t producer = 0;
+};
+
+template<class Queue>
+struct QueueTraits final
+{
+  static bool push(Queue& queue, const Data& data)
+  {
+    return queue.emplace(data);
+  }
+
+  static std::size_t pop(Queue& queue, std::uint64_t& sum)
+  {
+    auto data = queue.pop();
+    if (!data)
+    {
+      return 0;
+    }
+
+    sum += data->value;
+    return 1;
+  }
+};
+
+template<>
+struct QueueTraits<UServerUtils::Grpc::Common::QueueMpmc<Data>> final
+{
+  using Queue = UServerUtils::Grpc::Common::QueueMpmc<Data>;
+
+  static constexpr std::size_t k_batch_size = 32;
+
+  static bool push(Queue& queue, const Data& data)
+  {
+    return queue.emplace(data);
+  }
+
+  static std::size_t pop(Queue& queue, std::uint64_t& sum)
+  {
+    return queue.pop_batch(
+      [&sum] (Data&& data) {
+        sum += data.value;
+      },
+      k_batch_size);
+  }
+};
+
+class Application final
+{
+public:
+  Application(
+    const std::size_t number_messages,
+    const std::size_t capacity)
+    : number_messages_(number_messages),
+      capacity_(capacity)
+  {
+  }
+
+  int run()
+  {
+    using namespace UServerUtils::Grpc::Common;
+
+    const std::vector<std::pair<std::size_t, std::size_t>> configs{
+      {1, 1}, {4, 1}, {1, 4}, {4, 4}, {8, 8}};
+
+    std::cout << "Messages per run: " << number_messages_
+              << ", capacity: " << capacity_ << "\n"
+              << std::endl;
+
+    for (const auto& [number_producers, number_consumers] : configs)
+    {
+      std::cout << number_producers << " producers x "
+                << number_consumers << " consumers" << std::endl;
+
+      benchmark<Queue<Data>>(
+        "Queue (mutex, deque)",
+        number_producers,
+        number_consumers);
+      benchmark<QueueGranular<Data>>(
+        "QueueGranular (two mutexes, list)",
+        number_producers,
+        number_consumers);
+      benchmark<QueueMpmc<Data>>(
+        "QueueMpmc (ring, batch pop)",
+        number_producers,
+        number_consumers);
+
+      std::cout << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+private:
+  template<class QueueT>
+  void benchmark(
+    const std::string& name,
+    const std::size_t number_producers,
+    const std::size_t number_consumers)
+  {
+    using Traits = QueueTraits<QueueT>;
+
+    QueueT queue(capacity_);
+    const std::size_t per_producer = number_messages_ / number_producers;
+    const std::size_t total = per_producer * number_producers;
+
+    std::atomic<std::size_t> number_popped{0};
+    std::atomic<std::uint64_t> number_full{0};
+    std::atomic<std::uint64_t> number_empty{0};
+    std::atomic<std::uint64_t> total_sum{0};
+
+    std::vector<std::thread> threads;
+    threads.reserve(number_producers + number_consumers);
+
+    const auto time_start = std::chrono::high_resolution_clock::now();
+
+    for (std::size_t i = 0; i < number_consumers; ++i)
+    {
+      threads.emplace_back([&] () {
+        std::uint64_t sum = 0;
+        std::uint64_t empty = 0;
+        while (number_popped.load(std::memory_order_relaxed) < total)
+        {
+          const auto count = Traits::pop(queue, sum);
+          if (count == 0)
+          {
+            empty += 1;
+            std::this_thread::yield();
+            continue;
+          }
+
+          number_popped.fetch_add(count, std::memory_order_relaxed);
+        }
+
+        total_sum.fetch_add(sum, std::memory_order_relaxed);
+        number_empty.fetch_add(empty, std::memory_order_relaxed);
+      });
+    }
+
+    for (std::size_t i = 0; i < number_producers; ++i)
+    {
+      threads.emplace_back([&, i] () {
+        std::uint64_t full = 0;
+        for (std::size_t j = 1; j <= per_producer; ++j)
+        {
+          const Data data{j, i};
+          while (!Traits::push(queue, data))
+          {
+            full += 1;
+            std::this_thread::yield();
+          }
+        }
+
+        number_full.fetch_add(full, std::memory_order_relaxed);
+      });
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+
+    const auto time_end = std::chrono::high_resolution_clock::now();
+    const double elapsed_time_ms = std::chrono::duration<double, std::milli>(
+      time_end - time_start).count();
+
+    const std::uint64_t expected_sum =
+      number_producers * (per_producer * (per_producer + 1) / 2);
+
+    std::cout << "  " << std::left << std::setw(36) << name
+              << std::right << std::fixed << std::setprecision(1)
+              << std::setw(10) << total / elapsed_time_ms * 1000
+              << " msg/s, full=" << number_full.load()
+              << ", empty=" << number_empty.load()
+              << (total_sum.load() == expected_sum ? "" : " [SUM MISMATCH]")
+              << std::endl;
+  }
+
+private:
+  const std::size_t number_messages_;
+
+  const std::size_t capacity_;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  try
+  {
+    const std::size_t number_messages =
+      argc > 1 ? std::stoul(argv[1]) : 2000000;
+    const std::size_t capacity =
+      argc > 2 ? std::stoul(argv[2]) : 1024;
+
+    Application application(number_messages, capacity);
+    return application.run();
+  }
+  catch (const std::exception& exc)
+  {
+    std::cerr << "Benchmark is failed: " << exc.what() << std::endl;
+  }
+
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,125 @@
+// GTEST
+#include "gtest/gtest.h"
+
+// STD
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// THIS
+#include <UServerUtils/Grpc/Common/QueueMpmc.hpp>
+
+using UServerUtils::Grpc::Common::QueueMpmc;
+
+TEST(GrpcQueueMpmcTest, ExactCapacity)
+{
+  QueueMpmc<std::unique_ptr<int>> queue(100);
+  EXPECT_EQ(queue.capacity(), 100);
+
+  for (int i = 0; i < 100; ++i)
+  {
+    EXPECT_TRUE(queue.emplace(std::make_unique<int>(i)));
+  }
+
+  auto value = std::make_unique<int>(100);
+  EXPECT_FALSE(queue.emplace(std::move(value)));
+  // Arguments are untouched if the queue is full.
+  ASSERT_TRUE(value);
+  EXPECT_EQ(queue.size(), 100);
+
+  auto data = queue.pop();
+  ASSERT_TRUE(data);
+  EXPECT_EQ(**data, 0);
+  EXPECT_TRUE(queue.emplace(std::move(value)));
+}
+
+TEST(GrpcQueueMpmcTest, BatchOrder)
+{
+  QueueMpmc<int> queue(64);
+  for (int i = 0; i < 50; ++i)
+  {
+    EXPECT_TRUE(queue.emplace(i));
+  }
+
+  std::vector<int> result;
+  EXPECT_EQ(
+    queue.pop_batch([&result] (int&& value) {
+      result.emplace_back(value);
+    }, 32),
+    32);
+  EXPECT_EQ(
+    queue.pop_batch([&result] (int&& value) {
+      result.emplace_back(value);
+    }, 32),
+    18);
+  EXPECT_FALSE(queue.pop());
+
+  ASSERT_EQ(result.size(), 50);
+  for (int i = 0; i < 50; ++i)
+  {
+    EXPECT_EQ(result[i], i);
+  }
+}
+
+TEST(GrpcQueueMpmcTest, Concurrent)
+{
+  const std::size_t number_producers = 4;
+  const std::size_t number_consumers = 4;
+  const std::size_t per_producer = 100000;
+  const std::size_t total = number_producers * per_producer;
+
+  QueueMpmc<std::size_t> queue(128);
+  std::atomic<std::size_t> number_popped{0};
+  std::atomic<std::size_t> sum{0};
+
+  std::vector<std::thread> threads;
+  for (std::size_t i = 0; i < number_consumers; ++i)
+  {
+    threads.emplace_back([&, i] () {
+      while (number_popped.load() < total)
+      {
+        std::size_t count = 0;
+        if (i % 2 == 0)
+        {
+          count = queue.pop_batch([&sum] (std::size_t&& value) {
+            sum.fetch_add(value, std::memory_order_relaxed);
+          }, 16);
+        }
+        else if (auto value = queue.pop())
+        {
+          sum.fetch_add(*value, std::memory_order_relaxed);
+          count = 1;
+        }
+
+        if (count == 0)
+        {
+          std::this_thread::yield();
+        }
+        number_popped.fetch_add(count);
+      }
+    });
+  }
+
+  for (std::size_t i = 0; i < number_producers; ++i)
+  {
+    threads.emplace_back([&] () {
+      for (std::size_t j = 1; j <= per_producer; ++j)
+      {
+        while (!queue.emplace(j))
+        {
+          std::this_thread::yield();
+        }
+      }
+    });
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(number_popped.load(), total);
+  EXPECT_EQ(sum.load(), number_producers * per_producer * (per_producer + 1) / 2);
+  EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,211 @@
+// GTEST
+#include "gtest/gtest.h"
+
+// STD
+#include <chrono>
+#include <memory>
+#include <thread>
+
+// USERVER
+#include <userver/engine/deadline.hpp>
+
+// THIS
+#include <Logger/Logger.hpp>
+#include <Logger/StreamLogger.hpp>
+#include <UServerUtils/ComponentsBuilder.hpp>
+#include <UServerUtils/Grpc/Server/QueueRingCoro.hpp>
+#include <UServerUtils/Manager.hpp>
+#include <UServerUtils/Utils.hpp>
+
+namespace
+{
+
+using Queue = UServerUtils::Grpc::Server::Internal::QueueRingCoro<
+  std::unique_ptr<std::size_t>>;
+
+// More than the ring capacity, so the overflow list is used.
+const std::size_t kNumberElements = 1000;
+
+class GrpcFixtureQueueRingCoro : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    using namespace UServerUtils;
+
+    logger_ = new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::CRITICAL));
+
+    CoroPoolConfig coro_pool_config;
+    EventThreadPoolConfig event_thread_pool_config;
+    TaskProcessorConfig main_task_processor_config;
+    main_task_processor_config.name = "main_task_processor";
+    main_task_processor_config.worker_threads = 3;
+    main_task_processor_config.thread_name = "main_tskpr";
+
+    auto task_processor_container_builder =
+      std::make_unique<TaskProcessorContainerBuilder>(
+        logger_.in(),
+        coro_pool_config,
+        event_thread_pool_config,
+        main_task_processor_config);
+
+    auto init_func = [] (
+      TaskProcessorContainer& /*task_processor_container*/) {
+      return std::make_unique<ComponentsBuilder>();
+    };
+
+    manager_ = new Manager(
+      std::move(task_processor_container_builder),
+      std::move(init_func),
+      logger_.in());
+    manager_->activate_object();
+  }
+
+  void TearDown() override
+  {
+    manager_->deactivate_object();
+    manager_->wait_object();
+  }
+
+  template<class Function>
+  void run_in_coro(Function&& function)
+  {
+    UServerUtils::Utils::run_in_coro(
+      manager_->get_main_task_processor(),
+      UServerUtils::Utils::Importance::kNormal,
+      {},
+      std::forward<Function>(function));
+  }
+
+  Logging::Logger_var logger_;
+
+  UServerUtils::Manager_var manager_;
+};
+
+} // namespace
+
+TEST_F(GrpcFixtureQueueRingCoro, RingAndOverflowOrder)
+{
+  auto queue = Queue::Create();
+  auto consumer = queue->GetConsumer();
+  {
+    auto producer = queue->GetProducer();
+    for (std::size_t i = 0; i < kNumberElements; ++i)
+    {
+      EXPECT_TRUE(producer.PushNoblock(std::make_unique<std::size_t>(i)));
+    }
+  }
+
+  run_in_coro([&consumer] () {
+    // Ring elements go first, then the overflow list, in batches.
+    for (std::size_t i = 0; i < kNumberElements; ++i)
+    {
+      std::unique_ptr<std::size_t> value;
+      ASSERT_TRUE(consumer.Pop(value));
+      ASSERT_TRUE(value);
+      EXPECT_EQ(*value, i);
+    }
+
+    // Producer is gone and the queue is empty.
+    std::unique_ptr<std::size_t> value;
+    EXPECT_FALSE(consumer.Pop(value));
+  });
+}
+
+TEST_F(GrpcFixtureQueueRingCoro, Bounded)
+{
+  const std::size_t max_size = 10;
+  auto queue = Queue::Create(max_size);
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  for (std::size_t i = 0; i < max_size; ++i)
+  {
+    EXPECT_TRUE(producer.PushNoblock(std::make_unique<std::size_t>(i)));
+  }
+  EXPECT_FALSE(producer.PushNoblock(std::make_unique<std::size_t>(max_size)));
+
+  run_in_coro([&consumer] () {
+    std::unique_ptr<std::size_t> value;
+    ASSERT_TRUE(consumer.Pop(value));
+    EXPECT_EQ(*value, 0);
+  });
+
+  // Popped element frees a place even if the rest is in the consumer batch.
+  EXPECT_TRUE(producer.PushNoblock(std::make_unique<std::size_t>(max_size)));
+  EXPECT_FALSE(producer.PushNoblock(std::make_unique<std::size_t>(max_size)));
+
+  run_in_coro([&consumer] () {
+    for (std::size_t i = 1; i <= max_size; ++i)
+    {
+      std::unique_ptr<std::size_t> value;
+      ASSERT_TRUE(consumer.Pop(value));
+      EXPECT_EQ(*value, i);
+    }
+  });
+}
+
+TEST_F(GrpcFixtureQueueRingCoro, Deadline)
+{
+  auto queue = Queue::Create();
+  auto producer = queue->GetProducer();
+  auto consumer = queue->GetConsumer();
+
+  run_in_coro([&consumer] () {
+    std::unique_ptr<std::size_t> value;
+    EXPECT_FALSE(consumer.Pop(
+      value,
+      userver::engine::Deadline::FromDuration(
+        std::chrono::milliseconds(10))));
+    EXPECT_FALSE(value);
+  });
+}
+
+TEST_F(GrpcFixtureQueueRingCoro, ConsumerClosed)
+{
+  auto queue = Queue::Create();
+  auto producer = queue->GetProducer();
+  {
+    auto consumer = queue->GetConsumer();
+  }
+
+  EXPECT_FALSE(producer.PushNoblock(std::make_unique<std::size_t>(0)));
+}
+
+TEST_F(GrpcFixtureQueueRingCoro, ConcurrentProducer)
+{
+  const std::size_t number_elements = 200000;
+
+  auto queue = Queue::Create();
+  auto consumer = queue->GetConsumer();
+
+  // Producer runs on a completion queue thread, outside of coroutines.
+  std::thread thread(
+    [producer = queue->GetProducer(), number_elements] () {
+      for (std::size_t i = 0; i < number_elements; ++i)
+      {
+        EXPECT_TRUE(producer.PushNoblock(std::make_unique<std::size_t>(i)));
+        if (i % 10000 == 0)
+        {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+      }
+    });
+
+  run_in_coro([&consumer, number_elements] () {
+    std::size_t number_popped = 0;
+    std::unique_ptr<std::size_t> value;
+    while (consumer.Pop(value))
+    {
+      ASSERT_TRUE(value);
+      EXPECT_EQ(*value, number_popped);
+      number_popped += 1;
+    }
+    EXPECT_EQ(number_popped, number_elements);
+  });
+
+  thread.join();
+}
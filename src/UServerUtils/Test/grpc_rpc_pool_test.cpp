@@ -0,0 +1,189 @@
+// GTEST
+#include "gtest/gtest.h"
+
+// STD
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// THIS
+#include <Logger/Logger.hpp>
+#include <Logger/StreamLogger.hpp>
+#include <UServerUtils/Grpc/Server/RpcPoolImpl.hpp>
+
+namespace
+{
+
+using namespace UServerUtils::Grpc::Server;
+
+class TestRpc final : public Rpc
+{
+public:
+  TestRpc() = default;
+
+  ~TestRpc() override = default;
+
+  bool write(MessagePtr&& /*message*/) noexcept override
+  {
+    return false;
+  }
+
+  bool finish(grpc::Status&& /*status*/) noexcept override
+  {
+    return false;
+  }
+
+  bool stop() noexcept override
+  {
+    is_stopped_.store(true, std::memory_order_relaxed);
+    return true;
+  }
+
+  bool is_stopped() noexcept override
+  {
+    return is_stopped_.load(std::memory_order_relaxed);
+  }
+
+  std::weak_ptr<Rpc> get_weak_ptr() noexcept override
+  {
+    return {};
+  }
+
+private:
+  std::atomic<bool> is_stopped_{false};
+};
+
+using Rpcs = std::vector<std::shared_ptr<TestRpc>>;
+
+class GrpcFixtureRpcPool : public testing::Test
+{
+public:
+  void SetUp() override
+  {
+    logger_ = new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::CRITICAL));
+  }
+
+  RpcPoolImpl_var create_pool(const std::size_t number_shards)
+  {
+    RpcPoolImpl_var pool(new RpcPoolImpl(logger_.in(), number_shards));
+    pool->activate_object();
+    return pool;
+  }
+
+  Logging::Logger_var logger_;
+};
+
+} // namespace
+
+TEST_F(GrpcFixtureRpcPool, NumberShards)
+{
+  EXPECT_EQ(create_pool(1)->stats().number_rpcs.size(), 1);
+  EXPECT_EQ(create_pool(3)->stats().number_rpcs.size(), 4);
+  EXPECT_EQ(create_pool(8)->stats().number_rpcs.size(), 8);
+}
+
+TEST_F(GrpcFixtureRpcPool, ConcurrentAddRemove)
+{
+  const std::size_t number_threads = 8;
+  const std::size_t number_rpcs = 10000;
+
+  auto pool = create_pool(number_threads);
+
+  std::vector<Rpcs> rpcs(number_threads);
+  for (auto& thread_rpcs : rpcs)
+  {
+    thread_rpcs.reserve(number_rpcs);
+    for (std::size_t i = 0; i < number_rpcs; ++i)
+    {
+      thread_rpcs.emplace_back(std::make_shared<TestRpc>());
+    }
+  }
+
+  // Every thread adds its rpcs and removes the even ones.
+  std::vector<std::thread> threads;
+  threads.reserve(number_threads);
+  for (auto& thread_rpcs : rpcs)
+  {
+    threads.emplace_back([&pool, &thread_rpcs] () {
+      for (std::size_t i = 0; i < thread_rpcs.size(); ++i)
+      {
+        pool->add(thread_rpcs[i]);
+        if (i % 2 == 1)
+        {
+          pool->remove(thread_rpcs[i - 1].get());
+        }
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  auto stats = pool->stats();
+  EXPECT_EQ(stats.number_rpcs.size(), number_threads);
+  EXPECT_EQ(stats.total(), number_threads * number_rpcs / 2);
+
+  std::size_t number_used_shards = 0;
+  for (const auto number : stats.number_rpcs)
+  {
+    number_used_shards += number != 0;
+  }
+  EXPECT_GT(number_used_shards, number_threads / 2);
+
+  threads.clear();
+  for (auto& thread_rpcs : rpcs)
+  {
+    threads.emplace_back([&pool, &thread_rpcs] () {
+      for (std::size_t i = 1; i < thread_rpcs.size(); i += 2)
+      {
+        pool->remove(thread_rpcs[i].get());
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  EXPECT_EQ(pool->stats().total(), 0);
+}
+
+TEST_F(GrpcFixtureRpcPool, Deactivate)
+{
+  const std::size_t number_rpcs = 1000;
+
+  auto pool = create_pool(4);
+
+  Rpcs rpcs;
+  rpcs.reserve(number_rpcs);
+  for (std::size_t i = 0; i < number_rpcs; ++i)
+  {
+    rpcs.emplace_back(std::make_shared<TestRpc>());
+    pool->add(rpcs.back());
+  }
+  EXPECT_EQ(pool->stats().total(), number_rpcs);
+
+  pool->deactivate_object();
+  pool->wait_object();
+  for (const auto& rpc : rpcs)
+  {
+    EXPECT_TRUE(rpc->is_stopped());
+  }
+
+  // Rpc started after the shutdown is stopped at once.
+  auto late_rpc = std::make_shared<TestRpc>();
+  pool->add(late_rpc);
+  EXPECT_TRUE(late_rpc->is_stopped());
+
+  for (const auto& rpc : rpcs)
+  {
+    pool->remove(rpc.get());
+  }
+  pool->remove(late_rpc.get());
+  EXPECT_EQ(pool->stats().total(), 0);
+}
@@ -553,35 +553,37 @@ public:
     EXPECT_TRUE(array.IsArray());
     if (array.IsArray())
     {
+      // Intervals and percentiles of Test1 and Test2.
+      EXPECT_EQ(array.GetSize(), 16);
+
       std::list<int> value_list;
       std::list<std::string> name_list;
-      EXPECT_EQ(array.GetSize(), 8);
-      if (array.GetSize() == 8)
+      std::list<std::string> percentile_name_list;
+      for (std::size_t i = 0; i < array.GetSize(); ++i)
       {
-        value_list.emplace_back(array[0]["value"].As<int>());
-        value_list.emplace_back(array[1]["value"].As<int>());
-        value_list.emplace_back(array[2]["value"].As<int>());
-        value_list.emplace_back(array[3]["value"].As<int>());
-        value_list.emplace_back(array[4]["value"].As<int>());
-        value_list.emplace_back(array[5]["value"].As<int>());
-        value_list.emplace_back(array[6]["value"].As<int>());
-        value_list.emplace_back(array[7]["value"].As<int>());
-        value_list.sort();
+        const auto labels = array[i]["labels"];
+        if (labels.HasMember("percentile"))
+        {
+          // Every id was measured since the previous scrape.
+          EXPECT_GT(array[i]["value"].As<int>(), 0);
+          percentile_name_list.emplace_back(
+            labels["name"].As<std::string>());
+          continue;
+        }
 
-        EXPECT_EQ(value_list, std::list<int>({0, 0, 0, 1, 2, 3, 4, 5}));
+        value_list.emplace_back(array[i]["value"].As<int>());
+        name_list.emplace_back(labels["name"].As<std::string>());
+      }
 
-        name_list.emplace_back(array[0]["labels"]["name"].As<std::string>());
-        name_list.emplace_back(array[1]["labels"]["name"].As<std::string>());
-        name_list.emplace_back(array[2]["labels"]["name"].As<std::string>());
-        name_list.emplace_back(array[3]["labels"]["name"].As<std::string>());
-        name_list.emplace_back(array[4]["labels"]["name"].As<std::string>());
-        name_list.emplace_back(array[5]["labels"]["name"].As<std::string>());
-        name_list.emplace_back(array[6]["labels"]["name"].As<std::string>());
-        name_list.emplace_back(array[7]["labels"]["name"].As<std::string>());
-        name_list.sort();
+      value_list.sort();
+      EXPECT_EQ(value_list, std::list<int>({0, 0, 0, 1, 2, 3, 4, 5}));
 
-        EXPECT_EQ(name_list, std::list<std::string>({"Test1", "Test1", "Test1", "Test1", "Test2", "Test2", "Test2", "Test2"}));
-      }
+      const std::list<std::string> expected_name_list(
+        {"Test1", "Test1", "Test1", "Test1", "Test2", "Test2", "Test2", "Test2"});
+      name_list.sort();
+      EXPECT_EQ(name_list, expected_name_list);
+      percentile_name_list.sort();
+      EXPECT_EQ(percentile_name_list, expected_name_list);
     }
   }
 
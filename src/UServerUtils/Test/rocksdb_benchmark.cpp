@@ -0,0 +1,271 @@
+// STD
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+// THIS
+#include <Logger/Logger.hpp>
+#include <Logger/StreamLogger.hpp>
+#include <UServerUtils/RocksDB/DataBase.hpp>
+#include <UServerUtils/RocksDB/DataBaseManager.hpp>
+
+using namespace UServerUtils::Grpc::RocksDB;
+
+namespace
+{
+
+const std::string kPathDb = "/tmp/rocks_db_benchmark";
+const std::string kColumnFamilyName = "column";
+
+std::shared_ptr<DataBase> create_rocksdb(
+  Logging::Logger* logger,
+  const bool need_recreate)
+{
+  if (need_recreate)
+  {
+    std::filesystem::remove_all(std::filesystem::path(kPathDb));
+  }
+
+  rocksdb::DBOptions db_options;
+  db_options.IncreaseParallelism(5);
+  db_options.create_if_missing = true;
+
+  rocksdb::ColumnFamilyOptions column_family_options;
+  column_family_options.OptimizeForPointLookup(10);
+
+  std::vector<rocksdb::ColumnFamilyDescriptor> descriptors{
+    {kColumnFamilyName, column_family_options}};
+  return std::make_shared<DataBase>(
+    logger,
+    kPathDb,
+    db_options,
+    descriptors,
+    true);
+}
+
+std::string make_key(const std::size_t i)
+{
+  std::ostringstream stream;
+  stream << "key" << std::setw(10) << std::setfill('0') << i;
+  return stream.str();
+}
+
+class Application final
+{
+public:
+  explicit Application(const std::size_t count)
+    : count_(count),
+      value_(100, 'v'),
+      logger_(new Logging::OStream::Logger(
+        Logging::OStream::Config(
+          std::cerr,
+          Logging::Logger::CRITICAL)))
+  {
+    Config config;
+    config.io_uring_flags = 0;
+    config.io_uring_size = 1024;
+    config.event_queue_max_size = 1000000;
+    data_base_manager_ = std::make_unique<DataBaseManager>(
+      config,
+      logger_.in());
+
+    write_options_.disableWAL = true;
+  }
+
+  int run()
+  {
+    bulk_load_put();
+    for (const std::size_t batch_size : {100, 1000, 10000})
+    {
+      bulk_load_write_batch(batch_size);
+    }
+
+    auto data_base = create_rocksdb(logger_.in(), false);
+    auto& column_family_handle = data_base->column_family(kColumnFamilyName);
+    if (!data_base->get().Flush({}, &column_family_handle).ok())
+    {
+      std::cerr << "Flush is failed" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    bool is_success = number_errors_ == 0;
+    for (const std::size_t chunk_size : {10, 100, 1000, 10000})
+    {
+      is_success &= scan(data_base, chunk_size);
+    }
+
+    std::filesystem::remove_all(std::filesystem::path(kPathDb));
+
+    if (!is_success)
+    {
+      std::cerr << "Benchmark is failed, number errors="
+                << number_errors_
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+private:
+  void bulk_load_put()
+  {
+    auto data_base = create_rocksdb(logger_.in(), true);
+    auto& column_family_handle = data_base->column_family(kColumnFamilyName);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count_; ++i)
+    {
+      const auto status = data_base_manager_->put(
+        data_base,
+        column_family_handle,
+        write_options_,
+        make_key(i),
+        value_);
+      if (!status.ok())
+      {
+        number_errors_ += 1;
+      }
+    }
+    const std::chrono::duration<double> duration =
+      std::chrono::steady_clock::now() - start;
+
+    std::cout << "Bulk load [put]: "
+              << static_cast<std::size_t>(count_ / duration.count())
+              << " keys/s"
+              << std::endl;
+  }
+
+  void bulk_load_write_batch(const std::size_t batch_size)
+  {
+    auto data_base = create_rocksdb(logger_.in(), true);
+    auto& column_family_handle = data_base->column_family(kColumnFamilyName);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (std::size_t i = 0; i < count_; i += batch_size)
+    {
+      rocksdb::WriteBatch write_batch;
+      for (std::size_t j = i; j < std::min(i + batch_size, count_); ++j)
+      {
+        write_batch.Put(&column_family_handle, make_key(j), value_);
+      }
+
+      const auto status = data_base_manager_->write_batch(
+        data_base,
+        write_options_,
+        std::move(write_batch));
+      if (!status.ok())
+      {
+        number_errors_ += 1;
+      }
+    }
+    const std::chrono::duration<double> duration =
+      std::chrono::steady_clock::now() - start;
+
+    std::cout << "Bulk load [write_batch, batch_size="
+              << batch_size
+              << "]: "
+              << static_cast<std::size_t>(count_ / duration.count())
+              << " keys/s"
+              << std::endl;
+  }
+
+  bool scan(
+    const std::shared_ptr<DataBase>& data_base,
+    const std::size_t chunk_size)
+  {
+    auto& column_family_handle = data_base->column_family(kColumnFamilyName);
+
+    rocksdb::ReadOptions read_options;
+    read_options.readahead_size = 2 * 1024 * 1024;
+    auto iterator = data_base_manager_->create_prefix_iterator(
+      data_base,
+      column_family_handle,
+      read_options,
+      "key",
+      chunk_size);
+
+    std::size_t number_keys = 0;
+    std::size_t number_bytes = 0;
+    const auto start = std::chrono::steady_clock::now();
+    while (true)
+    {
+      DataBaseManager::KeyValues key_values;
+      const auto status = iterator.next(key_values);
+      if (!status.ok())
+      {
+        std::cerr << "Scan is failed: " << status.ToString() << std::endl;
+        return false;
+      }
+
+      if (key_values.empty())
+      {
+        break;
+      }
+
+      number_keys += key_values.size();
+      for (const auto& [key, value] : key_values)
+      {
+        number_bytes += key.size() + value.size();
+      }
+    }
+    const std::chrono::duration<double> duration =
+      std::chrono::steady_clock::now() - start;
+
+    std::cout << "Scan [chunk_size="
+              << chunk_size
+              << "]: "
+              << static_cast<std::size_t>(number_keys / duration.count())
+              << " keys/s, "
+              << number_bytes / duration.count() / (1024 * 1024)
+              << " MB/s"
+              << std::endl;
+
+    if (number_keys != count_)
+    {
+      std::cerr << "Scan is failed: number keys="
+                << number_keys
+                << ", expected="
+                << count_
+                << std::endl;
+      return false;
+    }
+
+    return true;
+  }
+
+private:
+  const std::size_t count_;
+
+  const std::string value_;
+
+  Logging::Logger_var logger_;
+
+  rocksdb::WriteOptions write_options_;
+
+  std::unique_ptr<DataBaseManager> data_base_manager_;
+
+  std::size_t number_errors_ = 0;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  try
+  {
+    const std::size_t count = argc > 1 ? std::stoul(argv[1]) : 200000;
+    return Application(count).run();
+  }
+  catch (const std::exception& exc)
+  {
+    std::cerr << "Benchmark is failed: " << exc.what() << std::endl;
+  }
+
+  return EXIT_FAILURE;
+}
@@ -2,10 +2,15 @@
 #include <gtest/gtest.h>
 
 // STD
+#include <chrono>
 #include <cstdio>
 #include <filesystem>
 #include <future>
+#include <iomanip>
+#include <iostream>
+#include <iterator>
 #include <memory>
+#include <sstream>
 #include <string>
 
 // THIS
@@ -706,4 +711,211 @@ TEST(DataBaseManagerTest, Pool)
 {
   test_Pool({});
   test_Pool(50);
-}
\ No newline at end of file
+}
+
+TEST(DataBaseManagerTest, WriteBatch)
+{
+  Logging::Logger_var logger(
+    new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::CRITICAL)));
+
+  const std::string column_family_name = "column";
+  const std::size_t count = 1000;
+
+  Config config;
+  config.io_uring_flags = 0;
+  config.io_uring_size = 64;
+  DataBaseManager data_base_manager(config, logger.in());
+
+  auto data_base = create_rocksdb(column_family_name, logger.in(), true);
+  auto& column_family_handle = data_base->column_family(column_family_name);
+
+  rocksdb::WriteOptions write_options;
+  write_options.disableWAL = true;
+
+  {
+    rocksdb::WriteBatch write_batch;
+    for (std::size_t i = 1; i <= count; ++i)
+    {
+      write_batch.Put(
+        &column_family_handle,
+        "key" + std::to_string(i),
+        "value" + std::to_string(i));
+    }
+
+    const auto status = data_base_manager.write_batch(
+      data_base,
+      write_options,
+      std::move(write_batch));
+    EXPECT_TRUE(status.ok());
+  }
+
+  {
+    rocksdb::WriteBatch write_batch;
+    write_batch.Delete(&column_family_handle, "key1");
+    write_batch.Put(&column_family_handle, "key2", "new_value2");
+
+    std::promise<rocksdb::Status> promise;
+    auto future = promise.get_future();
+    data_base_manager.write_batch(
+      data_base,
+      write_options,
+      std::move(write_batch),
+      [promise = std::move(promise)] (rocksdb::Status&& status) mutable {
+        promise.set_value(std::move(status));
+      });
+    EXPECT_TRUE(future.get().ok());
+  }
+
+  std::string result;
+  auto status = data_base_manager.get(
+    data_base,
+    column_family_handle,
+    rocksdb::ReadOptions{},
+    "key1",
+    result);
+  EXPECT_EQ(status.code(), rocksdb::Status::kNotFound);
+
+  status = data_base_manager.get(
+    data_base,
+    column_family_handle,
+    rocksdb::ReadOptions{},
+    "key2",
+    result);
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(result, "new_value2");
+
+  for (std::size_t i = 3; i <= count; ++i)
+  {
+    status = data_base_manager.get(
+      data_base,
+      column_family_handle,
+      rocksdb::ReadOptions{},
+      "key" + std::to_string(i),
+      result);
+    EXPECT_TRUE(status.ok());
+    EXPECT_EQ(result, "value" + std::to_string(i));
+  }
+}
+
+namespace
+{
+
+std::size_t read_all(
+  DataBaseManager::Iterator& iterator,
+  DataBaseManager::KeyValues& result)
+{
+  std::size_t number_chunks = 0;
+  while (true)
+  {
+    DataBaseManager::KeyValues key_values;
+    const auto status = iterator.next(key_values);
+    EXPECT_TRUE(status.ok());
+    if (!status.ok() || key_values.empty())
+    {
+      break;
+    }
+
+    number_chunks += 1;
+    std::move(
+      key_values.begin(),
+      key_values.end(),
+      std::back_inserter(result));
+  }
+
+  EXPECT_TRUE(iterator.is_finished());
+  return number_chunks;
+}
+
+} // namespace
+
+TEST(DataBaseManagerTest, Iterator)
+{
+  Logging::Logger_var logger(
+    new Logging::OStream::Logger(
+      Logging::OStream::Config(
+        std::cerr,
+        Logging::Logger::CRITICAL)));
+
+  const std::string column_family_name = "column";
+
+  Config config;
+  config.io_uring_flags = 0;
+  config.io_uring_size = 64;
+  DataBaseManager data_base_manager(config, logger.in());
+
+  auto data_base = create_rocksdb(column_family_name, logger.in(), true);
+  auto& column_family_handle = data_base->column_family(column_family_name);
+
+  rocksdb::WriteBatch write_batch;
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    std::ostringstream stream;
+    stream << std::setw(4) << std::setfill('0') << i;
+    write_batch.Put(&column_family_handle, "a" + stream.str(), stream.str());
+    write_batch.Put(&column_family_handle, "b" + stream.str(), stream.str());
+  }
+  write_batch.Put(&column_family_handle, std::string("\xff\xff") + "1", "1");
+  write_batch.Put(&column_family_handle, std::string("\xff\xff") + "2", "2");
+
+  rocksdb::WriteOptions write_options;
+  write_options.disableWAL = true;
+  EXPECT_TRUE(data_base_manager.write_batch(
+    data_base,
+    write_options,
+    std::move(write_batch)).ok());
+  EXPECT_TRUE(data_base->get().Flush({}, &column_family_handle).ok());
+
+  {
+    auto iterator = data_base_manager.create_prefix_iterator(
+      data_base,
+      column_family_handle,
+      rocksdb::ReadOptions{},
+      "b",
+      100);
+    DataBaseManager::KeyValues result;
+    EXPECT_EQ(read_all(iterator, result), 10);
+    ASSERT_EQ(result.size(), 1000);
+    EXPECT_EQ(result.front().first, "b0000");
+    EXPECT_EQ(result.back().first, "b0999");
+  }
+
+  {
+    auto iterator = data_base_manager.create_iterator(
+      data_base,
+      column_family_handle,
+      rocksdb::ReadOptions{},
+      {"a0990", "b0010"},
+      7);
+    DataBaseManager::KeyValues result;
+    read_all(iterator, result);
+    ASSERT_EQ(result.size(), 20);
+    EXPECT_EQ(result.front().first, "a0990");
+    EXPECT_EQ(result.back().first, "b0009");
+  }
+
+  {
+    auto iterator = data_base_manager.create_prefix_iterator(
+      data_base,
+      column_family_handle,
+      rocksdb::ReadOptions{},
+      "\xff\xff");
+    DataBaseManager::KeyValues result;
+    read_all(iterator, result);
+    ASSERT_EQ(result.size(), 2);
+    EXPECT_EQ(result[1].second, "2");
+  }
+
+  {
+    auto iterator = data_base_manager.create_prefix_iterator(
+      data_base,
+      column_family_handle,
+      rocksdb::ReadOptions{},
+      "c");
+    DataBaseManager::KeyValues result;
+    EXPECT_EQ(read_all(iterator, result), 0);
+    EXPECT_TRUE(result.empty());
+  }
+}
@@ -0,0 +1,339 @@
+// STD
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// THIS
+#include <UServerUtils/Statistics/CommonStatisticsProvider.hpp>
+#include <UServerUtils/Statistics/CounterStatisticsProvider.hpp>
+#include <UServerUtils/Statistics/ShardedCounter.hpp>
+
+namespace
+{
+
+enum class CounterEnumId
+{
+  Test1,
+  Test2,
+  Test3,
+  Test4,
+  Max
+};
+
+struct EnumCounterConverter final
+{
+  auto operator()()
+  {
+    using UServerUtils::Statistics::CounterType;
+    return std::map<CounterEnumId, std::pair<CounterType, std::string>>{
+      {CounterEnumId::Test1, {CounterType::UInt, "Test1"}},
+      {CounterEnumId::Test2, {CounterType::UInt, "Test2"}},
+      {CounterEnumId::Test3, {CounterType::Int, "Test3"}},
+      {CounterEnumId::Test4, {CounterType::Double, "Test4"}}};
+  }
+};
+
+enum class CommonEnumId
+{
+  Test1,
+  Max
+};
+
+struct EnumCommonConverter final
+{
+  auto operator()()
+  {
+    using UServerUtils::Statistics::CommonType;
+    return std::map<CommonEnumId, std::pair<CommonType, std::string>>{
+      {CommonEnumId::Test1, {CommonType::UInt, "Test1"}}};
+  }
+};
+
+const std::vector<std::string> kLabels{
+  "label1", "label2", "label3", "label4",
+  "label5", "label6", "label7", "label8"};
+
+constexpr std::size_t kNumberCounters =
+  static_cast<std::size_t>(CounterEnumId::Max);
+
+// Layout of CounterStatisticsProvider before sharding:
+// neighbouring counters in one cache line, shared by all threads.
+class ContiguousCounters final
+{
+public:
+  ContiguousCounters()
+    : counters_(kNumberCounters)
+  {
+  }
+
+  void add(const std::size_t index, const std::uint64_t value) noexcept
+  {
+    counters_[index].fetch_add(value, std::memory_order_relaxed);
+  }
+
+  std::uint64_t sum() const noexcept
+  {
+    std::uint64_t result = 0;
+    for (const auto& counter : counters_)
+    {
+      result += counter.load(std::memory_order_relaxed);
+    }
+
+    return result;
+  }
+
+private:
+  std::vector<std::atomic<std::uint64_t>> counters_;
+};
+
+// Label lookup of CommonStatisticsProvider before the lock-free index.
+class LockedLabelCounters final
+{
+public:
+  void add(const std::string_view label, const std::uint64_t value)
+  {
+    std::shared_lock shared_lock(mutex_);
+    auto it = counters_.find(label);
+    if (it != std::end(counters_))
+    {
+      auto& counter = it->second;
+      shared_lock.unlock();
+      counter.fetch_add(value, std::memory_order_relaxed);
+      return;
+    }
+    shared_lock.unlock();
+
+    std::unique_lock unique_lock(mutex_);
+    auto& counter = counters_.try_emplace(std::string(label)).first->second;
+    counter.fetch_add(value, std::memory_order_relaxed);
+  }
+
+  std::uint64_t sum() const
+  {
+    std::shared_lock shared_lock(mutex_);
+    std::uint64_t result = 0;
+    for (const auto& [label, counter] : counters_)
+    {
+      result += counter.load(std::memory_order_relaxed);
+    }
+
+    return result;
+  }
+
+private:
+  mutable std::shared_mutex mutex_;
+
+  std::map<std::string, std::atomic<std::uint64_t>, std::less<>> counters_;
+};
+
+class Application final
+{
+public:
+  explicit Application(const std::size_t number_operations)
+    : number_operations_(number_operations)
+  {
+  }
+
+  int run()
+  {
+    using namespace UServerUtils::Statistics;
+
+    const std::size_t hardware_threads =
+      std::max(std::thread::hardware_concurrency(), 1U);
+    std::vector<std::size_t> numbers_threads{1, 2, 4, 8};
+    if (hardware_threads > 8)
+    {
+      numbers_threads.emplace_back(hardware_threads);
+    }
+
+    std::cout << "Increments per thread: " << number_operations_
+              << ", shards: "
+              << Internal::Shard::default_number_shards() << "\n"
+              << std::endl;
+
+    for (const auto number_threads : numbers_threads)
+    {
+      std::cout << number_threads << " threads" << std::endl;
+
+      {
+        ContiguousCounters counters;
+        benchmark(
+          "atomic (contiguous)",
+          number_threads,
+          [&counters] (const std::size_t i) {
+            counters.add(i % kNumberCounters, 1);
+          },
+          [&counters] () {
+            return counters.sum();
+          });
+      }
+
+      {
+        ShardedCounters counters(kNumberCounters);
+        benchmark(
+          "ShardedCounters",
+          number_threads,
+          [&counters] (const std::size_t i) {
+            counters.add_integer(i % kNumberCounters, 1);
+          },
+          [&counters] () {
+            std::uint64_t result = 0;
+            for (std::size_t i = 0; i < kNumberCounters; ++i)
+            {
+              result += counters.sum_integer(i);
+            }
+            return result;
+          });
+      }
+
+      {
+        using Provider = CounterStatisticsProvider<
+          CounterEnumId,
+          EnumCounterConverter>;
+        Provider provider;
+        benchmark(
+          "CounterStatisticsProvider",
+          number_threads,
+          [&provider] (const std::size_t i) {
+            provider.add(CounterEnumId::Test1, i & 1);
+            provider.add(CounterEnumId::Test2, 1 - (i & 1));
+          },
+          [&provider] () {
+            return provider.get<std::uint64_t>(CounterEnumId::Test1) +
+              provider.get<std::uint64_t>(CounterEnumId::Test2);
+          });
+      }
+
+      {
+        LockedLabelCounters counters;
+        benchmark(
+          "shared_mutex + map (labels)",
+          number_threads,
+          [&counters] (const std::size_t i) {
+            counters.add(kLabels[i % kLabels.size()], 1);
+          },
+          [&counters] () {
+            return counters.sum();
+          });
+      }
+
+      {
+        using Provider = CommonStatisticsProvider<
+          CommonEnumId,
+          EnumCommonConverter>;
+        Provider provider;
+        benchmark(
+          "CommonStatisticsProvider (labels)",
+          number_threads,
+          [&provider] (const std::size_t i) {
+            provider.add(
+              CommonEnumId::Test1,
+              std::string_view(kLabels[i % kLabels.size()]),
+              1);
+          },
+          [&provider] () {
+            std::uint64_t result = 0;
+            for (const auto& label : kLabels)
+            {
+              result += provider.get<std::uint64_t>(
+                CommonEnumId::Test1,
+                std::string_view(label));
+            }
+            return result;
+          });
+      }
+
+      std::cout << std::endl;
+    }
+
+    if (number_mismatches_ != 0)
+    {
+      std::cerr << "Benchmark is failed: number sum mismatches="
+                << number_mismatches_
+                << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+  }
+
+private:
+  // sum must be equal to the number of increments.
+  template<class Increment, class Sum>
+  void benchmark(
+    const std::string& name,
+    const std::size_t number_threads,
+    Increment&& increment,
+    Sum&& sum)
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(number_threads);
+
+    const auto time_start = std::chrono::high_resolution_clock::now();
+    for (std::size_t i = 0; i < number_threads; ++i)
+    {
+      threads.emplace_back([this, &increment] () {
+        for (std::size_t j = 0; j < number_operations_; ++j)
+        {
+          increment(j);
+        }
+      });
+    }
+
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+    const auto time_end = std::chrono::high_resolution_clock::now();
+
+    const double elapsed_time_ns = std::chrono::duration<double, std::nano>(
+      time_end - time_start).count();
+    const std::size_t total = number_operations_ * number_threads;
+    const std::uint64_t result = sum();
+    if (result != total)
+    {
+      number_mismatches_ += 1;
+    }
+
+    std::cout << "  " << std::left << std::setw(36) << name
+              << std::right << std::fixed << std::setprecision(2)
+              << std::setw(10) << elapsed_time_ns / total
+              << " ns/op, "
+              << std::setw(12) << std::setprecision(0)
+              << total / elapsed_time_ns * 1e9
+              << " op/s"
+              << (result == total ? "" : " [SUM MISMATCH]")
+              << std::endl;
+  }
+
+private:
+  const std::size_t number_operations_;
+
+  std::size_t number_mismatches_ = 0;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+  try
+  {
+    const std::size_t number_operations =
+      argc > 1 ? std::stoul(argv[1]) : 10000000;
+
+    Application application(number_operations);
+    return application.run();
+  }
+  catch (const std::exception& exc)
+  {
+    std::cerr << "Benchmark is failed: " << exc.what() << std::endl;
+  }
+
+  return EXIT_FAILURE;
+}
@@ -0,0 +1,223 @@
+// GTEST
+#include "gtest/gtest.h"
+
+// STD
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+// THIS
+#include <UServerUtils/Statistics/CommonStatisticsProvider.hpp>
+#include <UServerUtils/Statistics/CounterStatisticsProvider.hpp>
+#include <UServerUtils/Statistics/ShardedCounter.hpp>
+
+namespace
+{
+
+using namespace UServerUtils::Statistics;
+
+const std::size_t kNumberThreads = 8;
+const std::size_t kNumberOperations = 100000;
+
+enum class CounterEnumId
+{
+  UInt,
+  Int,
+  Double,
+  Max
+};
+
+struct EnumCounterConverter final
+{
+  auto operator()()
+  {
+    return std::map<CounterEnumId, std::pair<CounterType, std::string>>{
+      {CounterEnumId::UInt, {CounterType::UInt, "uint"}},
+      {CounterEnumId::Int, {CounterType::Int, "int"}},
+      {CounterEnumId::Double, {CounterType::Double, "double"}}};
+  }
+};
+
+enum class CommonEnumId
+{
+  UInt,
+  Int,
+  Double,
+  Max
+};
+
+struct EnumCommonConverter final
+{
+  auto operator()()
+  {
+    return std::map<CommonEnumId, std::pair<CommonType, std::string>>{
+      {CommonEnumId::UInt, {CommonType::UInt, "uint"}},
+      {CommonEnumId::Int, {CommonType::Int, "int"}},
+      {CommonEnumId::Double, {CommonType::Double, "double"}}};
+  }
+};
+
+template<class Function>
+void run_threads(Function&& function)
+{
+  std::vector<std::thread> threads;
+  threads.reserve(kNumberThreads);
+  for (std::size_t i = 0; i < kNumberThreads; ++i)
+  {
+    threads.emplace_back([&function, i] () {
+      function(i);
+    });
+  }
+
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+}
+
+} // namespace
+
+TEST(ShardedCounters, NumberShards)
+{
+  EXPECT_EQ(ShardedCounters(1, 0).number_shards(), 1);
+  EXPECT_EQ(ShardedCounters(1, 3).number_shards(), 4);
+  EXPECT_EQ(ShardedCounters(1, 8).number_shards(), 8);
+}
+
+TEST(ShardedCounters, ConcurrentAdd)
+{
+  // Fewer shards than threads: some of them share a shard.
+  const std::size_t number_counters = 10;
+  // The last counter is double.
+  ShardedCounters counters(number_counters + 1, 4);
+
+  run_threads([&counters, number_counters] (const std::size_t) {
+    for (std::size_t i = 0; i < kNumberOperations; ++i)
+    {
+      counters.add_integer(i % number_counters, 1);
+      counters.add_double(number_counters, 0.5);
+    }
+  });
+
+  const std::uint64_t total = kNumberThreads * kNumberOperations;
+  for (std::size_t i = 0; i < number_counters; ++i)
+  {
+    EXPECT_EQ(counters.sum_integer(i), total / number_counters);
+  }
+  EXPECT_EQ(counters.sum_double(number_counters), 0.5 * total);
+}
+
+TEST(ShardedCounters, Set)
+{
+  ShardedCounters counters(2, 4);
+  run_threads([&counters] (const std::size_t) {
+    counters.add_integer(0, 5);
+    counters.add_integer(1, static_cast<std::uint64_t>(std::int64_t{-1}));
+  });
+  EXPECT_EQ(counters.sum_integer(0), 5 * kNumberThreads);
+  EXPECT_EQ(
+    static_cast<std::int64_t>(counters.sum_integer(1)),
+    -static_cast<std::int64_t>(kNumberThreads));
+
+  counters.set_integer(0, 7);
+  EXPECT_EQ(counters.sum_integer(0), 7);
+  counters.add_integer(0, 1);
+  EXPECT_EQ(counters.sum_integer(0), 8);
+
+  counters.set_double(1, 1.5);
+  counters.add_double(1, 1.0);
+  EXPECT_EQ(counters.sum_double(1), 2.5);
+}
+
+TEST(CounterStatisticsProvider, ConcurrentAdd)
+{
+  CounterStatisticsProvider<CounterEnumId, EnumCounterConverter> provider;
+
+  run_threads([&provider] (const std::size_t) {
+    for (std::size_t i = 0; i < kNumberOperations; ++i)
+    {
+      provider.add(CounterEnumId::UInt, 1);
+      provider.add(CounterEnumId::Int, -2);
+      provider.add(CounterEnumId::Double, 0.25);
+    }
+  });
+
+  const std::size_t total = kNumberThreads * kNumberOperations;
+  EXPECT_EQ(provider.get<std::uint64_t>(CounterEnumId::UInt), total);
+  EXPECT_EQ(
+    provider.get<std::int64_t>(CounterEnumId::Int),
+    -2 * static_cast<std::int64_t>(total));
+  EXPECT_EQ(provider.get<double>(CounterEnumId::Double), 0.25 * total);
+
+  provider.set(CounterEnumId::UInt, 3);
+  EXPECT_EQ(provider.get<std::uint64_t>(CounterEnumId::UInt), 3);
+}
+
+TEST(CommonStatisticsProvider, ConcurrentAddNewLabels)
+{
+  // Index starts with 4 slots and grows while threads add labels.
+  CommonStatisticsProvider<CommonEnumId, EnumCommonConverter> provider(
+    "common",
+    2);
+
+  const std::size_t number_labels = 1000;
+  std::vector<std::string> labels;
+  labels.reserve(number_labels);
+  for (std::size_t i = 0; i < number_labels; ++i)
+  {
+    labels.emplace_back("label" + std::to_string(i));
+  }
+
+  // Every thread walks the labels from its own offset.
+  run_threads([&provider, &labels, number_labels] (const std::size_t thread) {
+    for (std::size_t i = 0; i < kNumberOperations; ++i)
+    {
+      const std::size_t label = (thread * 131 + i) % number_labels;
+      provider.add(CommonEnumId::UInt, std::string_view(labels[label]), 1);
+      provider.add(CommonEnumId::Int, label, -1);
+      provider.add(CommonEnumId::Double, label, 0.5);
+    }
+  });
+
+  std::uint64_t total_uint = 0;
+  std::int64_t total_int = 0;
+  double total_double = 0;
+  for (std::size_t i = 0; i < number_labels; ++i)
+  {
+    const auto value = provider.get<std::uint64_t>(
+      CommonEnumId::UInt,
+      std::string_view(labels[i]));
+    // Operations of a thread hit every label equally.
+    EXPECT_EQ(value, kNumberThreads * kNumberOperations / number_labels);
+    total_uint += value;
+    total_int += provider.get<std::int64_t>(CommonEnumId::Int, i);
+    total_double += provider.get<double>(CommonEnumId::Double, i);
+  }
+
+  const std::size_t total = kNumberThreads * kNumberOperations;
+  EXPECT_EQ(total_uint, total);
+  EXPECT_EQ(total_int, -static_cast<std::int64_t>(total));
+  EXPECT_EQ(total_double, 0.5 * total);
+
+  EXPECT_EQ(
+    provider.get<std::uint64_t>(CommonEnumId::UInt, std::string_view("none")),
+    0);
+}
+
+TEST(CommonStatisticsProvider, Set)
+{
+  CommonStatisticsProvider<CommonEnumId, EnumCommonConverter> provider;
+
+  provider.add(CommonEnumId::UInt, std::string_view("label"), 5);
+  provider.set(CommonEnumId::UInt, std::string_view("label"), 2);
+  provider.add(CommonEnumId::UInt, std::string_view("label"), 1);
+  EXPECT_EQ(
+    provider.get<std::uint64_t>(CommonEnumId::UInt, std::string_view("label")),
+    3);
+
+  provider.set(CommonEnumId::Double, 1, 1.5);
+  provider.add(CommonEnumId::Double, 1, 1.0);
+  EXPECT_EQ(provider.get<double>(CommonEnumId::Double, 1), 2.5);
+}
@@ -0,0 +1,167 @@
+// GTEST
+#include "gtest/gtest.h"
+
+// STD
+#include <cstdint>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+// THIS
+#include <UServerUtils/Statistics/HdrHistogram.hpp>
+#include <UServerUtils/Statistics/TimeStatisticsProvider.hpp>
+
+namespace
+{
+
+using namespace UServerUtils::Statistics;
+
+enum class TimeEnumId
+{
+  Test1,
+  Test2,
+  Max
+};
+
+struct EnumToStringConverter final
+{
+  auto operator()()
+  {
+    return std::map<TimeEnumId, std::string>{
+      {TimeEnumId::Test1, "Test1"},
+      {TimeEnumId::Test2, "Test2"}};
+  }
+};
+
+using Provider = TimeStatisticsProvider<
+  TimeEnumId,
+  EnumToStringConverter,
+  4,
+  50>;
+
+// Quantile of the uniform distribution 1..number_values.
+void expect_quantile(
+  const HdrHistogram& histogram,
+  const double quantile,
+  const std::uint64_t number_values)
+{
+  const auto expected = static_cast<std::uint64_t>(quantile * number_values);
+  const auto value = histogram.value_at_quantile(quantile);
+  // Upper bound of the bucket: never less, at most a bucket more.
+  EXPECT_GE(value, expected) << "quantile=" << quantile;
+  EXPECT_LE(value, expected + expected / HdrHistogram::k_sub_bucket_count)
+    << "quantile=" << quantile;
+}
+
+} // namespace
+
+TEST(HdrHistogram, Index)
+{
+  const std::uint64_t number_linear = 2 * HdrHistogram::k_sub_bucket_count;
+  for (std::uint64_t value = 0; value < number_linear; ++value)
+  {
+    EXPECT_EQ(HdrHistogram::index(value), value);
+  }
+
+  for (std::uint64_t value = 1;
+    value < HdrHistogram::k_max_value;
+    value = value * 3 + 1)
+  {
+    const auto index = HdrHistogram::index(value);
+    EXPECT_LE(HdrHistogram::lower_bound(index), value);
+    EXPECT_GE(HdrHistogram::upper_bound(index), value);
+    EXPECT_EQ(
+      HdrHistogram::index(HdrHistogram::upper_bound(index) + 1),
+      index + 1);
+  }
+
+  EXPECT_EQ(
+    HdrHistogram::index(10 * HdrHistogram::k_max_value),
+    HdrHistogram::k_number_buckets - 1);
+}
+
+TEST(HdrHistogram, Percentiles)
+{
+  HdrHistogram histogram;
+  EXPECT_EQ(histogram.value_at_quantile(0.5), 0);
+
+  const std::uint64_t number_values = 100000;
+  for (std::uint64_t value = 1; value <= number_values; ++value)
+  {
+    histogram.add(HdrHistogram::index(value), 1);
+  }
+  EXPECT_EQ(histogram.total_count(), number_values);
+
+  for (const double quantile : {0.5, 0.9, 0.99, 0.999})
+  {
+    expect_quantile(histogram, quantile, number_values);
+  }
+  EXPECT_EQ(histogram.value_at_quantile(0), 1);
+  EXPECT_GE(histogram.value_at_quantile(1), number_values);
+}
+
+TEST(TimeStatisticsProvider, Percentiles)
+{
+  Provider provider;
+  EXPECT_EQ(provider.take_histogram(TimeEnumId::Test1).total_count(), 0);
+
+  const std::size_t number_threads = 4;
+  const std::uint64_t number_values = 100000;
+  std::vector<std::thread> threads;
+  threads.reserve(number_threads);
+  for (std::size_t i = 0; i < number_threads; ++i)
+  {
+    threads.emplace_back([&provider, i, number_threads] () {
+      for (std::uint64_t value = i + 1;
+        value <= number_values;
+        value += number_threads)
+      {
+        provider.add(TimeEnumId::Test1, value);
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+
+  const auto histogram = provider.take_histogram(TimeEnumId::Test1);
+  EXPECT_EQ(histogram.total_count(), number_values);
+  for (const double quantile : {0.5, 0.9, 0.99, 0.999})
+  {
+    expect_quantile(histogram, quantile, number_values);
+  }
+
+  // Other id is not touched.
+  EXPECT_EQ(provider.take_histogram(TimeEnumId::Test2).total_count(), 0);
+}
+
+TEST(TimeStatisticsProvider, Window)
+{
+  Provider provider;
+
+  for (std::size_t i = 0; i < 1000; ++i)
+  {
+    provider.add(TimeEnumId::Test1, 1000000);
+  }
+  auto histogram = provider.take_histogram(TimeEnumId::Test1);
+  EXPECT_EQ(histogram.total_count(), 1000);
+  EXPECT_GE(histogram.value_at_quantile(0.5), 1000000);
+
+  // Nothing was measured since the previous window.
+  histogram = provider.take_histogram(TimeEnumId::Test1);
+  EXPECT_EQ(histogram.total_count(), 0);
+  EXPECT_EQ(histogram.value_at_quantile(0.5), 0);
+
+  // Slow measures of the previous window do not affect the next one.
+  for (std::size_t i = 0; i < 10; ++i)
+  {
+    provider.add(TimeEnumId::Test1, 100);
+  }
+  histogram = provider.take_histogram(TimeEnumId::Test1);
+  EXPECT_EQ(histogram.total_count(), 10);
+  EXPECT_EQ(
+    histogram.value_at_quantile(0.999),
+    HdrHistogram::upper_bound(HdrHistogram::index(100)));
+}
@@ -1,3 +1,7 @@
+#include <iostream>
+#include <map>
+#include <set>
+
 #include <CORBACommons/ObjectPool.hpp>
 
 
@@ -20,6 +24,15 @@ struct ConfigInt : public CORBACommons::ObjectPoolConfiguration<int, int>
 typedef CORBACommons::ObjectPool<int, ConfigInt,
   CORBACommons::ObjectPlainVar<int>> Pool;
 
+struct StatsMap : public std::map<std::string, unsigned long>
+{
+  void
+  set(const std::string& key, unsigned long value) /*throw (eh::Exception)*/
+  {
+    (*this)[key] = value;
+  }
+};
+
 void
 test() /*throw (eh::Exception)*/
 {
@@ -68,8 +81,9 @@ test2() /*throw (eh::Exception)*/
       Pool::ObjectHandlerType o1 = pool.get_object(0);
       assert(false);
     }
-    catch (const Pool::NoGoodReference&)
+    catch (const Pool::BadObject&)
     {
+      // PT_PRECISE doesn't switch to another reference
     }
     Pool::ObjectHandlerType o2 = pool.get_object(1);
     assert(*o2 == -2);
@@ -88,6 +102,109 @@ test2() /*throw (eh::Exception)*/
   }
 }
 
+void
+test_least_loaded() /*throw (eh::Exception)*/
+{
+  ConfigInt conf;
+
+  conf.timeout = Generics::Time::ONE_HOUR;
+  conf.object_once = false;
+  conf.iors_list.push_back(ConfigInt::RefAndNumber(1));
+  conf.iors_list.push_back(ConfigInt::RefAndNumber(2));
+  conf.iors_list.push_back(ConfigInt::RefAndNumber(3));
+
+  Pool pool(conf, CORBACommons::ChoosePolicyType::PT_LEAST_LOADED);
+
+  {
+    // Objects in flight are avoided
+    Pool::ObjectHandlerType o1 = pool.get_object();
+    Pool::ObjectHandlerType o2 = pool.get_object();
+    Pool::ObjectHandlerType o3 = pool.get_object();
+    std::set<int> objects;
+    objects.insert(*o1);
+    objects.insert(*o2);
+    objects.insert(*o3);
+    assert(objects.size() == 3);
+
+    Pool::ObjectHandlerType* handlers[] = { &o1, &o2, &o3 };
+    Pool::ObjectHandlerType* slow = 0;
+    for (unsigned i = 0; i < 3; ++i)
+    {
+      if (**handlers[i] == -2)
+      {
+        slow = handlers[i];
+      }
+      else
+      {
+        handlers[i]->release();
+      }
+    }
+    usleep(20000);
+    slow->release();
+  }
+
+  // Slow object is avoided
+  for (int i = 0; i < 10; ++i)
+  {
+    Pool::ObjectHandlerType o = pool.get_object();
+    assert(*o != -2);
+  }
+
+  StatsMap stats;
+  pool.fill_stats(stats, String::SubString("pool."));
+  assert(stats.size() == 15);
+  assert(stats["pool.1.uses"] == 1);
+  assert(stats["pool.1.latency_us"] >= 20000);
+  assert(stats["pool.0.uses"] + stats["pool.2.uses"] == 12);
+  assert(stats["pool.0.in_flight"] == 0);
+  assert(stats["pool.2.failures"] == 0);
+}
+
+void
+test_background_resolve() /*throw (eh::Exception)*/
+{
+  ConfigInt conf;
+
+  conf.timeout = Generics::Time::ONE_SECOND;
+  conf.background_resolve = true;
+  conf.iors_list.push_back(ConfigInt::RefAndNumber(1));
+  conf.iors_list.push_back(ConfigInt::RefAndNumber(2));
+
+  Pool pool(conf);
+
+  int bad;
+  {
+    Pool::ObjectHandlerType o1 = pool.get_object();
+    bad = *o1;
+    o1.release_bad();
+  }
+
+  for (int i = 0; i < 4; ++i)
+  {
+    Pool::ObjectHandlerType o = pool.get_object();
+    assert(*o != bad);
+  }
+
+  StatsMap stats;
+  pool.fill_stats(stats, String::SubString());
+  const std::string BAD_INDEX = std::to_string(-bad - 1);
+  assert(stats[BAD_INDEX + ".bad"] == 1);
+  assert(stats[BAD_INDEX + ".failures"] == 1);
+
+  // Badness status is removed without get_object calls
+  usleep(1500000);
+  pool.fill_stats(stats, String::SubString());
+  assert(stats[BAD_INDEX + ".bad"] == 0);
+
+  std::set<int> objects;
+  for (int i = 0; i < 2; ++i)
+  {
+    Pool::ObjectHandlerType o = pool.get_object();
+    objects.insert(*o);
+  }
+  assert(objects.count(bad) == 1);
+}
+
 int
 main()
 {
@@ -95,6 +212,9 @@ main()
   {
     test();
     test2();
+    test_least_loaded();
+    test_background_resolve();
+    return 0;
   }
   catch (const CORBA::Exception& e)
   {
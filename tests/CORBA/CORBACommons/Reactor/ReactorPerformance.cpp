@@ -0,0 +1,269 @@
+// ReactorPerformance.cpp :
+//   Dispatch throughput of the select and epoll custom reactors
+//   depending on the number of connections.
+//
+
+#include <fcntl.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <memory>
+#include <vector>
+
+#include <ace/TP_Reactor.h>
+
+#include <Generics/Rand.hpp>
+#include <Generics/ThreadRunner.hpp>
+#include <Generics/Time.hpp>
+#include <Stream/MemoryStream.hpp>
+
+#include <CORBACommons/CorbaAdaptersInternal.hpp>
+
+namespace
+{
+  DECLARE_EXCEPTION(TestException, eh::DescriptiveException);
+
+  std::size_t MessageCount = 200000;
+  // The select reactor waits by PARTS threads, others dispatch
+  unsigned ThreadCount = CORBACommons::PARTS * 2;
+
+  typedef ACE_Reactor_Impl* (*CreateReactor)(ACE_Timer_Queue*);
+
+  /**
+   * Reads all available bytes of one end of a socket pair
+   */
+  class Connection : public ACE_Event_Handler
+  {
+  public:
+    explicit
+    Connection(std::atomic<std::size_t>& received)
+      /*throw (eh::Exception)*/;
+
+    virtual
+    ~Connection() throw ();
+
+    virtual
+    ACE_HANDLE
+    get_handle() const;
+
+    virtual
+    int
+    handle_input(ACE_HANDLE fd);
+
+    void
+    send() /*throw (eh::Exception)*/;
+
+  private:
+    int fds_[2];
+    std::atomic<std::size_t>& received_;
+  };
+
+  Connection::Connection(std::atomic<std::size_t>& received)
+    /*throw (eh::Exception)*/
+    : received_(received)
+  {
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds_) < 0)
+    {
+      eh::throw_errno_exception<TestException>(FNE,
+        "socketpair() failed");
+    }
+    ::fcntl(fds_[0], F_SETFL, O_NONBLOCK);
+  }
+
+  Connection::~Connection() throw ()
+  {
+    ::close(fds_[0]);
+    ::close(fds_[1]);
+  }
+
+  ACE_HANDLE
+  Connection::get_handle() const
+  {
+    return fds_[0];
+  }
+
+  int
+  Connection::handle_input(ACE_HANDLE fd)
+  {
+    char buf[256];
+    ssize_t size;
+    while ((size = ::read(fd, buf, sizeof(buf))) > 0)
+    {
+      received_ += size;
+    }
+    return 0;
+  }
+
+  void
+  Connection::send() /*throw (eh::Exception)*/
+  {
+    const char MESSAGE = 0;
+    if (::write(fds_[1], &MESSAGE, 1) != 1)
+    {
+      eh::throw_errno_exception<TestException>(FNE, "write() failed");
+    }
+  }
+
+  class Dispatcher : public Generics::ThreadJob
+  {
+  public:
+    explicit
+    Dispatcher(ACE_Reactor_Impl* reactor) throw ();
+
+    virtual
+    void
+    work() throw ();
+
+  protected:
+    virtual
+    ~Dispatcher() throw () = default;
+
+  private:
+    ACE_Reactor_Impl* reactor_;
+  };
+
+  Dispatcher::Dispatcher(ACE_Reactor_Impl* reactor) throw ()
+    : reactor_(reactor)
+  {
+  }
+
+  void
+  Dispatcher::work() throw ()
+  {
+    reactor_->handle_events();
+  }
+
+  // @return messages per second
+  double
+  measure(CreateReactor create_reactor, std::size_t connection_count)
+    /*throw (eh::Exception)*/
+  {
+    std::unique_ptr<ACE_Reactor_Impl> reactor(create_reactor(0));
+    if (!reactor.get())
+    {
+      throw TestException("reactor creation failed");
+    }
+
+    std::atomic<std::size_t> received(0);
+    std::vector<std::unique_ptr<Connection>> connections;
+    connections.reserve(connection_count);
+    for (std::size_t i = 0; i < connection_count; ++i)
+    {
+      connections.emplace_back(new Connection(received));
+      if (reactor->register_handler(connections.back().get(),
+        ACE_Event_Handler::READ_MASK) < 0)
+      {
+        eh::throw_errno_exception<TestException>(FNE,
+          "register_handler() failed");
+      }
+    }
+
+    Generics::ThreadRunner runner(
+      Generics::ThreadJob_var(new Dispatcher(reactor.get())), ThreadCount);
+    runner.start();
+
+    Generics::Timer timer;
+    timer.start();
+    for (std::size_t i = 0; i < MessageCount; ++i)
+    {
+      connections[Generics::safe_rand(connection_count)]->send();
+    }
+    while (received < MessageCount)
+    {
+      ::usleep(100);
+    }
+    timer.stop();
+
+    reactor->deactivate(1);
+    runner.wait_for_completion();
+
+    for (std::size_t i = 0; i < connection_count; ++i)
+    {
+      reactor->remove_handler(connections[i]->get_handle(),
+        ACE_Event_Handler::READ_MASK);
+    }
+
+    const double SECONDS =
+      static_cast<double>(timer.elapsed_time().microseconds()) / 1000000;
+    return SECONDS > 0 ? MessageCount / SECONDS : 0;
+  }
+
+  void
+  performance_test(const std::vector<std::size_t>& connection_counts)
+    /*throw (eh::Exception)*/
+  {
+    rlimit limit;
+    if (::getrlimit(RLIMIT_NOFILE, &limit) == 0)
+    {
+      limit.rlim_cur = limit.rlim_max;
+      ::setrlimit(RLIMIT_NOFILE, &limit);
+      ::getrlimit(RLIMIT_NOFILE, &limit);
+    }
+
+    std::cout << "Messages: " << MessageCount << ", threads: " <<
+      ThreadCount << std::endl;
+
+    for (std::size_t i = 0; i < connection_counts.size(); ++i)
+    {
+      const std::size_t CONNECTIONS = connection_counts[i];
+      if (CONNECTIONS * 2 + 64 > limit.rlim_cur ||
+        CONNECTIONS * 2 + 64 > CORBACommons::DESCRIPTORS)
+      {
+        std::cout << '\t' << CONNECTIONS <<
+          " connections: skipped, not enough descriptors" << std::endl;
+        continue;
+      }
+
+      const double SELECT =
+        measure(CORBACommons::create_reactor_impl, CONNECTIONS);
+      const double EPOLL =
+        measure(CORBACommons::create_epoll_reactor_impl, CONNECTIONS);
+
+      std::cout << std::fixed << std::setprecision(0) <<
+        '\t' << std::setw(6) << CONNECTIONS << " connections: select=" <<
+        std::setw(9) << SELECT << " msg/s, epoll=" <<
+        std::setw(9) << EPOLL << " msg/s (x" << std::setprecision(2) <<
+        (SELECT > 0 ? EPOLL / SELECT : 0) << ")" << std::endl;
+    }
+  }
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::cout << "Reactor performance test started..." << std::endl;
+  try
+  {
+    std::vector<std::size_t> connection_counts;
+    if (argc > 1)
+    {
+      MessageCount = std::atoi(argv[1]);
+    }
+    for (int i = 2; i < argc; ++i)
+    {
+      connection_counts.push_back(std::atoi(argv[i]));
+    }
+    if (connection_counts.empty())
+    {
+      connection_counts = { 10, 100, 1000, 10000 };
+    }
+
+    performance_test(connection_counts);
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+  }
+  catch (const eh::Exception& e)
+  {
+    std::cerr << "Exception raised: " << e.what() << std::endl;
+  }
+  catch (...)
+  {
+    std::cerr << "Unknown exception occurred" << std::endl;
+  }
+
+  return 1;
+}
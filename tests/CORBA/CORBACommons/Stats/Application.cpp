@@ -102,6 +102,15 @@ private:
   void
   mt_test_() /*throw (eh::Exception, CORBA::Exception)*/;
 
+  static
+  void
+  check_delta_(const char* name, const CORBACommons::StatsDelta& delta,
+    bool reset, CORBA::ULong new_keys, CORBA::ULong removed,
+    CORBA::ULong values) /*throw (eh::Exception)*/;
+
+  void
+  delta_test_() /*throw (eh::Exception, CORBA::Exception)*/;
+
 
   Generics::Values_var stat_, stat2_;
   volatile sig_atomic_t counters_[P_LAST];
@@ -274,6 +283,7 @@ Test::test() /*throw (eh::Exception, CORBA::Exception)*/
 {
   func_test_();
   mt_test_();
+  delta_test_();
 }
 
 void
@@ -349,6 +359,109 @@ Test::mt_test_() /*throw (eh::Exception, CORBA::Exception)*/
     CORBACommons::ValuesConverter::get_stats(*stat_));
 }
 
+void
+Test::check_delta_(const char* name, const CORBACommons::StatsDelta& delta,
+  bool reset, CORBA::ULong new_keys, CORBA::ULong removed,
+  CORBA::ULong values) /*throw (eh::Exception)*/
+{
+  const CORBA::ULong VALUES = delta.signed_int_ids.length() +
+    delta.unsigned_int_ids.length() + delta.floating_ids.length() +
+    delta.string_ids.length();
+
+  if (static_cast<bool>(delta.reset) != reset ||
+    delta.new_keys.length() != new_keys ||
+    delta.removed.length() != removed || VALUES != values)
+  {
+    std::cerr << name << ": unexpected delta: reset=" << delta.reset <<
+      ", new keys " << delta.new_keys.length() << ", removed " <<
+      delta.removed.length() << ", values " << VALUES <<
+      " expected reset=" << reset << ", new keys " << new_keys <<
+      ", removed " << removed << ", values " << values << std::endl;
+  }
+}
+
+void
+Test::delta_test_() /*throw (eh::Exception, CORBA::Exception)*/
+{
+  Generics::Values_var values(new Generics::Values);
+  values->set("signed", 1l);
+  values->set("unsigned", 2lu);
+  values->set("floating", 4.0);
+  values->set("string", "8");
+
+  CORBACommons::ValuesDelta values_delta;
+  CORBACommons::StatsCursor cursor;
+  cursor.epoch = 0;
+  cursor.version = 0;
+
+  CORBACommons::StatsDelta_var delta(
+    values_delta.get_stats_delta(*values, cursor));
+  check_delta_("initial", *delta, true, 4, 0, 4);
+  if (delta->string_values.length() != 1 ||
+    strcmp(delta->string_values[0], "8") ||
+    delta->signed_int_values.length() != 1 ||
+    delta->signed_int_values[0] != 1)
+  {
+    std::cerr << "initial: unexpected values" << std::endl;
+  }
+
+  const CORBACommons::StatsCursor INITIAL = delta->cursor;
+  delta = values_delta.get_stats_delta(*values, INITIAL);
+  check_delta_("unchanged", *delta, false, 0, 0, 0);
+
+  values->add("signed", 1l);
+  values->set("floating", 4.0);
+  values->set("new", 16lu);
+  delta = values_delta.get_stats_delta(*values, delta->cursor);
+  check_delta_("changed", *delta, false, 1, 0, 2);
+  if (delta->signed_int_values.length() != 1 ||
+    delta->signed_int_values[0] != 2)
+  {
+    std::cerr << "changed: unexpected values" << std::endl;
+  }
+
+  // Older cursor receives all changes since it
+  CORBACommons::StatsDelta_var old_delta(
+    values_delta.get_stats_delta(*values, INITIAL));
+  check_delta_("old cursor", *old_delta, false, 1, 0, 2);
+
+  Generics::Values_var replacement(new Generics::Values);
+  replacement->set("signed", 2l);
+  replacement->set("unsigned", 2lu);
+  replacement->set("string", "8");
+  values->swap(*replacement);
+  delta = values_delta.get_stats_delta(*values, delta->cursor);
+  check_delta_("removed", *delta, false, 0, 2, 0);
+
+  // Key removed, re-added and removed again after a cursor
+  const CORBACommons::StatsCursor KNOWN = delta->cursor;
+  replacement = new Generics::Values;
+  replacement->set("unsigned", 2lu);
+  replacement->set("string", "8");
+  values->swap(*replacement);
+  delta = values_delta.get_stats_delta(*values, KNOWN);
+  check_delta_("removed once", *delta, false, 0, 1, 0);
+
+  values->set("signed", 3l);
+  delta = values_delta.get_stats_delta(*values, delta->cursor);
+  check_delta_("re-added", *delta, false, 1, 0, 1);
+
+  replacement = new Generics::Values;
+  replacement->set("unsigned", 2lu);
+  replacement->set("string", "8");
+  values->swap(*replacement);
+  delta = values_delta.get_stats_delta(*values, delta->cursor);
+  check_delta_("removed twice", *delta, false, 0, 1, 0);
+
+  delta = values_delta.get_stats_delta(*values, KNOWN);
+  check_delta_("removed since known", *delta, false, 0, 1, 0);
+
+  CORBACommons::StatsCursor foreign = delta->cursor;
+  foreign.epoch += 1;
+  delta = values_delta.get_stats_delta(*values, foreign);
+  check_delta_("foreign", *delta, true, 2, 0, 2);
+}
+
 std::string
 Test::name_(Prefix prefix, sig_atomic_t index)
   /*throw (eh::Exception)*/
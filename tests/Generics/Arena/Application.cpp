@@ -0,0 +1,361 @@
+// Application.cpp :
+//   Checks of Generics::Arena and request throughput of the arena
+//   against malloc (run with LD_PRELOAD=libjemalloc.so to measure
+//   jemalloc) and std::pmr::monotonic_buffer_resource.
+//
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <limits>
+#include <memory_resource>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <Generics/Arena.hpp>
+#include <Generics/MemBuf.hpp>
+#include <Generics/Time.hpp>
+#include <Stream/MemoryStream.hpp>
+
+namespace
+{
+  DECLARE_EXCEPTION(TestException, eh::DescriptiveException);
+
+  std::size_t RequestCount = 100000;
+
+  const std::size_t BLOCKS = 64;
+
+  /**
+   * Stores the thread chunk cache size at the thread exit, constructed
+   * before Arena cleaner so destroyed after it
+   */
+  struct CacheProbe
+  {
+    ~CacheProbe() throw ();
+
+    static std::atomic<std::size_t> cached_on_exit;
+  };
+
+  std::atomic<std::size_t> CacheProbe::cached_on_exit(0);
+
+  thread_local CacheProbe cache_probe;
+
+  CacheProbe::~CacheProbe() throw ()
+  {
+    cached_on_exit = Generics::Arena::cached_chunks();
+  }
+
+  /**
+   * Not inlined to keep calls through opaque memory_resource: devirtualized
+   * calls of monotonic_buffer_resource members do not link at -O3 with
+   * gcc 12
+   */
+  std::size_t
+  request(std::pmr::memory_resource* resource, std::size_t seed)
+    /*throw (eh::Exception)*/ __attribute__((__noinline__));
+
+  void
+  check(bool condition, const char* what) /*throw (TestException)*/
+  {
+    if (!condition)
+    {
+      Stream::Error ostr;
+      ostr << "check failed: " << what;
+      throw TestException(ostr);
+    }
+  }
+
+  void
+  allocation_test() /*throw (eh::Exception)*/
+  {
+    Generics::Arena arena;
+    std::vector<std::pair<unsigned char*, std::size_t> > blocks;
+
+    for (std::size_t i = 0; i < 10000; ++i)
+    {
+      const std::size_t SIZE = i % 7 ? i % 300 : i * 10;
+      const std::size_t ALIGNMENT = std::size_t(1) << (i % 8);
+      unsigned char* ptr =
+        static_cast<unsigned char*>(arena.allocate(SIZE, ALIGNMENT));
+      check(ptr, "non null pointer");
+      check(!(reinterpret_cast<std::uintptr_t>(ptr) & (ALIGNMENT - 1)),
+        "alignment");
+      std::memset(ptr, i & 0xFF, SIZE);
+      blocks.push_back(std::make_pair(ptr, SIZE));
+    }
+
+    for (std::size_t i = 0; i < blocks.size(); ++i)
+    {
+      for (std::size_t j = 0; j < blocks[i].second; ++j)
+      {
+        check(blocks[i].first[j] == (i & 0xFF), "blocks do not overlap");
+      }
+    }
+
+    void* last = arena.allocate(100);
+    const std::size_t ALLOCATED = arena.allocated();
+    arena.deallocate(last, 100);
+    check(arena.allocated() == ALLOCATED - 100, "allocated decreased");
+    check(arena.allocate(100) == last, "last block is reused");
+
+    arena.release();
+    check(!arena.allocated(), "nothing allocated after release");
+
+    void* first = arena.allocate(100);
+    arena.release();
+    check(arena.allocate(100) == first, "cached chunk is reused");
+
+    try
+    {
+      static_cast<void>(
+        arena.allocate(std::numeric_limits<std::size_t>::max() - 8));
+      check(false, "huge block is not allocated");
+    }
+    catch (const std::bad_alloc&)
+    {}
+  }
+
+  void
+  users_test() /*throw (eh::Exception)*/
+  {
+    Generics::Allocator::Arena_var allocator(
+      new Generics::Allocator::Arena());
+    Generics::Arena& arena = allocator->arena();
+
+    {
+      std::pmr::vector<int> values(&arena);
+      for (int i = 0; i < 100000; ++i)
+      {
+        values.push_back(i);
+      }
+      std::pmr::string str("arena string is longer than SSO", &arena);
+      for (int i = 0; i < 10; ++i)
+      {
+        str += str;
+      }
+      check(values[99999] == 99999 && str.size() == 31 * 1024 &&
+        arena.allocated() >= 100000 * sizeof(int) + str.size(),
+        "pmr containers");
+
+      Stream::PolymorphicDynamic ostr(16, &arena);
+      for (int i = 0; i < 1000; ++i)
+      {
+        ostr << i << ' ';
+      }
+      check(ostr.str().size() == 3890, "stream");
+    }
+
+    {
+      Generics::MemBuf buffer(1000, allocator.in());
+      std::memset(buffer.data(), 1, buffer.size());
+      Generics::MemBuf copy(buffer, allocator.in());
+      check(std::memcmp(copy.data(), buffer.data(), buffer.size()) == 0,
+        "MemBuf");
+    }
+
+    check(!arena.allocated(), "all blocks are deallocated");
+    arena.release();
+
+    // Chunks of exited threads are freed by thread cache
+    std::size_t cached = 0;
+    std::thread thread([&cached] ()
+      {
+        static_cast<void>(&cache_probe);
+        {
+          Generics::Arena arena;
+          for (int i = 0; i < 1000; ++i)
+          {
+            std::memset(arena.allocate(1000), 0, 1000);
+          }
+        }
+        cached = Generics::Arena::cached_chunks();
+      });
+    thread.join();
+    check(cached > 0, "chunks are cached by thread");
+    check(CacheProbe::cached_on_exit == 0, "chunks are freed on thread exit");
+  }
+
+  /**
+   * Typical request: scattered small blocks, growing containers
+   * and formatting, all freed at the end
+   */
+  std::size_t
+  request(std::pmr::memory_resource* resource, std::size_t seed)
+    /*throw (eh::Exception)*/
+  {
+    void* blocks[BLOCKS];
+    std::size_t sizes[BLOCKS];
+    for (std::size_t i = 0; i < BLOCKS; ++i)
+    {
+      sizes[i] = 16 + (seed * 2654435761u + i * 40503) % 497;
+      blocks[i] = resource->allocate(sizes[i]);
+      *static_cast<char*>(blocks[i]) = i;
+    }
+
+    std::size_t result = 0;
+    {
+      std::pmr::vector<std::size_t> values(resource);
+      for (std::size_t i = 0; i < 256; ++i)
+      {
+        values.push_back(seed + i);
+      }
+
+      std::pmr::string str(resource);
+      for (std::size_t i = 0; i < 16; ++i)
+      {
+        str += "segment ";
+      }
+
+      Stream::PolymorphicDynamic ostr(64, resource);
+      for (std::size_t i = 0; i < 32; ++i)
+      {
+        ostr << values[i] << ',';
+      }
+
+      result = values.size() + str.size() + ostr.str().size();
+    }
+
+    for (std::size_t i = BLOCKS; i--;)
+    {
+      resource->deallocate(blocks[i], sizes[i]);
+    }
+
+    return result;
+  }
+
+  void
+  report(const char* name, const Generics::Timer& timer,
+    double reference) /*throw (eh::Exception)*/
+  {
+    const double SECONDS = timer.elapsed_time().as_double();
+    std::cout << '\t' << std::left << std::setw(24) << name << std::right <<
+      std::fixed << std::setprecision(3) << std::setw(8) << SECONDS <<
+      " s, " << std::setw(10) << std::setprecision(0) <<
+      (SECONDS > 0 ? RequestCount / SECONDS : 0) << " requests/s";
+    if (reference > 0 && SECONDS > 0)
+    {
+      std::cout << ", x" << std::setprecision(2) << reference / SECONDS;
+    }
+    std::cout << std::endl;
+  }
+
+  void
+  performance_test() /*throw (eh::Exception)*/
+  {
+    std::cout << "Requests: " << RequestCount << std::endl;
+
+    std::size_t malloc_sum = 0;
+    Generics::Timer malloc_timer;
+    malloc_timer.start();
+    for (std::size_t i = 0; i < RequestCount; ++i)
+    {
+      malloc_sum += request(std::pmr::new_delete_resource(), i);
+    }
+    malloc_timer.stop();
+    report("malloc", malloc_timer, 0);
+    const double MALLOC = malloc_timer.elapsed_time().as_double();
+
+    std::size_t monotonic_sum = 0;
+    Generics::Timer monotonic_timer;
+    monotonic_timer.start();
+    for (std::size_t i = 0; i < RequestCount; ++i)
+    {
+      std::pmr::monotonic_buffer_resource resource;
+      monotonic_sum += request(&resource, i);
+    }
+    monotonic_timer.stop();
+    report("monotonic_buffer", monotonic_timer, MALLOC);
+
+    std::size_t arena_sum = 0;
+    Generics::Timer arena_timer;
+    arena_timer.start();
+    for (std::size_t i = 0; i < RequestCount; ++i)
+    {
+      Generics::Arena arena;
+      arena_sum += request(&arena, i);
+    }
+    arena_timer.stop();
+    report("Generics::Arena", arena_timer, MALLOC);
+
+    check(malloc_sum == monotonic_sum && malloc_sum == arena_sum,
+      "equal results");
+
+    // MemBuf through Allocator::Base
+    Generics::Allocator::Base_var universal(
+      new Generics::Allocator::Universal());
+    Generics::Allocator::Base* const ALLOCATORS[] =
+    {
+      Generics::Allocator::Base::get_default_allocator(),
+      universal.in()
+    };
+    const char* const NAMES[] = { "MemBuf Default", "MemBuf Universal" };
+    double membuf_reference = 0;
+    for (std::size_t i = 0; i < sizeof(NAMES) / sizeof(*NAMES); ++i)
+    {
+      Generics::Timer timer;
+      timer.start();
+      for (std::size_t j = 0; j < RequestCount; ++j)
+      {
+        std::vector<Generics::MemBuf> buffers;
+        buffers.reserve(BLOCKS);
+        for (std::size_t k = 0; k < BLOCKS; ++k)
+        {
+          buffers.emplace_back(16 + (j + k * 40503) % 497, ALLOCATORS[i]);
+        }
+      }
+      timer.stop();
+      report(NAMES[i], timer, membuf_reference);
+      if (!i)
+      {
+        membuf_reference = timer.elapsed_time().as_double();
+      }
+    }
+
+    Generics::Timer timer;
+    timer.start();
+    for (std::size_t j = 0; j < RequestCount; ++j)
+    {
+      Generics::Allocator::Arena_var allocator(
+        new Generics::Allocator::Arena());
+      std::vector<Generics::MemBuf> buffers;
+      buffers.reserve(BLOCKS);
+      for (std::size_t k = 0; k < BLOCKS; ++k)
+      {
+        buffers.emplace_back(16 + (j + k * 40503) % 497, allocator.in());
+      }
+    }
+    timer.stop();
+    report("MemBuf Allocator::Arena", timer, membuf_reference);
+  }
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::cout << "Arena test started..." << std::endl;
+  try
+  {
+    if (argc > 1)
+    {
+      RequestCount = std::atoi(argv[1]);
+    }
+    allocation_test();
+    users_test();
+    performance_test();
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+  }
+  catch (const eh::Exception& e)
+  {
+    std::cerr << "Exception raised: " << e.what() << std::endl;
+  }
+  catch (...)
+  {
+    std::cerr << "Unknown exception occurred" << std::endl;
+  }
+
+  return 1;
+}
@@ -1,9 +1,13 @@
 #include <iostream>
 #include <set>
+#include <utility>
+#include <vector>
 #include <assert.h>
 #include <stdlib.h>
 
 #include <Generics/CompressedSet.hpp>
+#include <Generics/FlatCompressedSet.hpp>
+#include <Generics/Time.hpp>
 
 
 template <typename Integer>
@@ -111,10 +115,300 @@ public:
       Generics::CompressedSet<Integer>::CS_ALL;
   }
 
-private:
   std::set<Integer> holder_;
 };
 
+template <typename Integer>
+bool
+check_flat(const Generics::FlatCompressedSet<Integer>& set1,
+  const SimpleSet<Integer>& set2, Integer min, Integer max,
+  const char* operation) /*throw (eh::Exception)*/
+{
+  for (std::size_t i = 0; i < set1.size(); ++i)
+  {
+    assert(set1.low(i) <= set1.high(i));
+    assert(!i || set1.low(i) > set1.high(i - 1) + 1);
+  }
+
+  bool fail = false;
+  for (Integer i = min; i < max; i++)
+  {
+    bool res1 = set1.belongs(i);
+    bool res2 = set2.belongs(i);
+    if (res1 != res2)
+    {
+      std::cerr << operation << ": for " << i << " flat = " << res1 <<
+        " but normal = " << res2 << std::endl;
+      fail = true;
+    }
+
+    for (Integer j = i; j < max; j++)
+    {
+      typename Generics::CompressedSet<Integer>::CheckStatus res1 =
+        set1.check_presence(i, j);
+      typename Generics::CompressedSet<Integer>::CheckStatus res2 =
+        set2.check_presence(i, j);
+      if (res1 != res2)
+      {
+        std::cerr << operation << ": for " << i << ", " << j <<
+          " flat = " << res1 << " but normal = " << res2 << std::endl;
+        fail = true;
+      }
+    }
+  }
+
+  return !fail;
+}
+
+template <typename Integer>
+void
+random_flat(Integer min, Integer max,
+  Generics::FlatCompressedSet<Integer>& set1, SimpleSet<Integer>& set2)
+  /*throw (eh::Exception)*/
+{
+  std::vector<std::pair<Integer, Integer> > intervals;
+  for (int j = rand() % 10; j > 0; j--)
+  {
+    Integer low = rand() % (max - min) + min;
+    Integer high = rand() % (max - low) + low;
+    intervals.push_back(std::make_pair(high, low)); // ignored
+    intervals.push_back(std::make_pair(low, high));
+    set2.add(low, high);
+  }
+  set1.assign_intervals(intervals.begin(), intervals.end());
+}
+
+/**
+ * Differential test of FlatCompressedSet against SimpleSet
+ */
+template <typename Integer>
+bool
+flat_test(Integer min, Integer max) /*throw (eh::Exception)*/
+{
+  for (int i = 0; i < 300; i++)
+  {
+    Generics::FlatCompressedSet<Integer> set1;
+    Generics::FlatCompressedSet<Integer> other1;
+    SimpleSet<Integer> set2;
+    SimpleSet<Integer> other2;
+    random_flat(min, max, set1, set2);
+    random_flat(min, max, other1, other2);
+
+    bool includes = true;
+    bool intersects = false;
+    for (Integer j = min; j < max; j++)
+    {
+      includes = includes && (!other2.belongs(j) || set2.belongs(j));
+      intersects = intersects || (other2.belongs(j) && set2.belongs(j));
+    }
+    if (set1.includes(other1) != includes ||
+      set1.intersects(other1) != intersects)
+    {
+      std::cerr << "includes or intersects mismatch" << std::endl;
+      return false;
+    }
+
+    for (int j = rand() % 10; j > 0; j--)
+    {
+      Integer low = rand() % (max - min) + min;
+      Integer high = rand() % (max - low) + low;
+      if (rand() % 2)
+      {
+        set1.add(low, high);
+        set2.add(low, high);
+      }
+      else
+      {
+        set1.remove(low, high);
+        set2.remove(low, high);
+      }
+    }
+    if (!check_flat(set1, set2, min, max, "add/remove"))
+    {
+      return false;
+    }
+
+    Generics::FlatCompressedSet<Integer> result1(set1);
+    SimpleSet<Integer> result2(set2);
+    switch (i % 3)
+    {
+    case 0:
+      result1.add(other1);
+      result2.holder_.insert(other2.holder_.begin(), other2.holder_.end());
+      break;
+    case 1:
+      result1.intersect(other1);
+      for (Integer j = min; j < max; j++)
+      {
+        if (!other2.belongs(j))
+        {
+          result2.remove(j);
+        }
+      }
+      break;
+    case 2:
+      result1.remove(other1);
+      for (Integer j = min; j < max; j++)
+      {
+        if (other2.belongs(j))
+        {
+          result2.remove(j);
+        }
+      }
+      break;
+    }
+    if (!check_flat(result1, result2, min, max, "set operation"))
+    {
+      return false;
+    }
+
+    std::vector<Integer> values(result2.holder_.rbegin(),
+      result2.holder_.rend());
+    Generics::FlatCompressedSet<Integer> assigned;
+    assigned.assign(values.begin(), values.end());
+    if (assigned != result1)
+    {
+      std::cerr << "assign mismatch" << std::endl;
+      return false;
+    }
+
+    Generics::MemBuf buffer;
+    result1.save(buffer);
+    Generics::FlatCompressedSet<Integer> loaded;
+    loaded.load(buffer.data(), buffer.size());
+    if (loaded != result1)
+    {
+      std::cerr << "load mismatch" << std::endl;
+      return false;
+    }
+
+    if (buffer.size() > 1)
+    {
+      try
+      {
+        loaded.load(buffer.data(), buffer.size() - 1);
+        std::cerr << "truncated data loaded" << std::endl;
+        return false;
+      }
+      catch (const typename Generics::FlatCompressedSet<Integer>::
+        CorruptedData&)
+      {}
+    }
+  }
+
+  return true;
+}
+
+bool
+flat_bounds_test() /*throw (eh::Exception)*/
+{
+  Generics::FlatCompressedSet<int> set;
+  set.add(std::numeric_limits<int>::min(), -1000);
+  set.add(7);
+  set.add(std::numeric_limits<int>::max() - 10,
+    std::numeric_limits<int>::max());
+
+  Generics::MemBuf buffer;
+  set.save(buffer);
+  Generics::FlatCompressedSet<int> loaded;
+  loaded.load(buffer.data(), buffer.size());
+  if (loaded != set || !loaded.belongs(std::numeric_limits<int>::max()) ||
+    !loaded.belongs(std::numeric_limits<int>::min()) ||
+    loaded.belongs(-999))
+  {
+    std::cerr << "bounds mismatch" << std::endl;
+    return false;
+  }
+
+  // gap after the last interval overflows int
+  const unsigned char BIG_GAP[] =
+    { 2, 0, 0, 0xFF, 0xFF, 0xFF, 0xFF, 0x0F, 0 };
+  try
+  {
+    loaded.load(BIG_GAP, sizeof(BIG_GAP));
+    std::cerr << "overflowed data loaded" << std::endl;
+    return false;
+  }
+  catch (const Generics::FlatCompressedSet<int>::CorruptedData& ex)
+  {
+    std::cout << "Expected: " << ex.what() << std::endl;
+  }
+
+  Generics::CompressedSet<unsigned char> cset;
+  cset.add(0, 10);
+  cset.add(255);
+  Generics::FlatCompressedSet<unsigned char> flat(cset);
+  flat.save(buffer);
+  Generics::FlatCompressedSet<unsigned char> loaded_flat;
+  loaded_flat.load(buffer.data(), buffer.size());
+  return flat.size() == 2 && loaded_flat == flat && flat.belongs(255) &&
+    !flat.belongs(254);
+}
+
+/**
+ * Prints time of union and lookup for tree based and flat sets
+ */
+void
+flat_performance_test() /*throw (eh::Exception)*/
+{
+  const int SETS = 100, INTERVALS = 1000, LOOKUPS = 1000000;
+
+  std::vector<std::pair<unsigned, unsigned> > intervals;
+  for (int i = 0; i < SETS * INTERVALS; i++)
+  {
+    unsigned low = rand();
+    intervals.push_back(std::make_pair(low, low + rand() % 1000));
+  }
+
+  Generics::CPUTimer timer;
+  timer.start();
+  Generics::CompressedSet<unsigned> tree;
+  for (int i = 0; i < SETS; i++)
+  {
+    Generics::CompressedSet<unsigned> part;
+    for (int j = 0; j < INTERVALS; j++)
+    {
+      part.add(intervals[i * INTERVALS + j].first,
+        intervals[i * INTERVALS + j].second);
+    }
+    tree.add(part);
+  }
+  timer.stop();
+  std::cout << "Tree build and union: " << timer.elapsed_time() << std::endl;
+
+  timer.start();
+  Generics::FlatCompressedSet<unsigned> flat;
+  for (int i = 0; i < SETS; i++)
+  {
+    Generics::FlatCompressedSet<unsigned> part;
+    part.assign_intervals(intervals.begin() + i * INTERVALS,
+      intervals.begin() + (i + 1) * INTERVALS);
+    flat.add(part);
+  }
+  timer.stop();
+  std::cout << "Flat build and union: " << timer.elapsed_time() << std::endl;
+
+  std::size_t found1 = 0, found2 = 0;
+  timer.start();
+  for (int i = 0; i < LOOKUPS; i++)
+  {
+    found1 += tree.belongs(i * 2654435761u);
+  }
+  timer.stop();
+  std::cout << "Tree lookup: " << timer.elapsed_time() << std::endl;
+
+  timer.start();
+  for (int i = 0; i < LOOKUPS; i++)
+  {
+    found2 += flat.belongs(i * 2654435761u);
+  }
+  timer.stop();
+  std::cout << "Flat lookup: " << timer.elapsed_time() << std::endl;
+
+  assert(found1 == found2);
+  assert(flat == Generics::FlatCompressedSet<unsigned>(tree));
+}
+
 int
 main()
 {
@@ -178,6 +472,15 @@ main()
     }
   }
 
+  if (!flat_test<int>(MIN, MAX) || !flat_test<int>(-MAX, -MIN) ||
+    !flat_test<unsigned char>(200, 255) ||
+    !flat_test<unsigned>(1, 40) || !flat_bounds_test())
+  {
+    return -1;
+  }
+
+  flat_performance_test();
+
   std::cout << "Test complete" << std::endl;
 
   return 0;
@@ -1568,6 +1568,204 @@ test_float() /*throw (eh::Exception)*/
   }
 }
 
+DECLARE_EXCEPTION(TestException, eh::DescriptiveException);
+
+/**
+ * Random decimal string with random digit count in each part
+ */
+template <typename DecimalType>
+std::string
+random_decimal_string() /*throw (eh::Exception)*/
+{
+  std::string str(random() % 2 ? "-" : "");
+  const unsigned INTEGER_DIGITS = random() % (DecimalType::INTEGER_RANK + 1);
+  str += '0' + random() % 10;
+  for (unsigned i = 1; i < INTEGER_DIGITS; ++i)
+  {
+    str += '0' + random() % 10;
+  }
+  const unsigned FRACTION_DIGITS = random() % (DecimalType::FRACTION_RANK + 1);
+  if (FRACTION_DIGITS)
+  {
+    str += '.';
+    for (unsigned i = 0; i < FRACTION_DIGITS; ++i)
+    {
+      str += '0' + random() % 10;
+    }
+  }
+  return str;
+}
+
+template <typename DecimalType, typename Operation>
+std::string
+int128_result(Operation operation) /*throw (eh::Exception)*/
+{
+  try
+  {
+    return operation().str();
+  }
+  catch (const typename DecimalType::Overflow&)
+  {
+    return "Overflow";
+  }
+}
+
+/**
+ * Compare UInt128 arithmetic of Fast with element-wise one of Reference
+ */
+template <typename Fast, typename Reference>
+void
+test_int128(const char* name) /*throw (eh::Exception)*/
+{
+  std::vector<std::string> values;
+  values.push_back(Fast::ZERO.str());
+  values.push_back(std::string("-").append(Fast::ZERO.str()));
+  values.push_back(Fast::EPSILON.str());
+  values.push_back(std::string("-").append(Fast::EPSILON.str()));
+  values.push_back(Fast::MAXIMUM.str());
+  values.push_back(std::string("-").append(Fast::MAXIMUM.str()));
+  values.push_back("1");
+  values.push_back("-1");
+  if (Fast::FRACTION_RANK)
+  {
+    values.push_back("0.5");
+  }
+  for (unsigned i = 0; i < 200; ++i)
+  {
+    values.push_back(random_decimal_string<Fast>());
+  }
+
+  std::vector<Fast> column;
+  std::vector<Reference> reference_column;
+  unsigned failures = 0;
+
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    const Fast fa(String::SubString(values[i]));
+    const Reference ra(String::SubString(values[i]));
+    column.push_back(fa);
+    reference_column.push_back(ra);
+
+    for (std::size_t j = 0; j < values.size(); ++j)
+    {
+      const Fast fb(String::SubString(values[j]));
+      const Reference rb(String::SubString(values[j]));
+
+      const std::string RESULTS[][2] =
+      {
+        {
+          int128_result<Fast>([&] { return fa + fb; }),
+          int128_result<Reference>([&] { return ra + rb; })
+        },
+        {
+          int128_result<Fast>([&] { return fa - fb; }),
+          int128_result<Reference>([&] { return ra - rb; })
+        },
+        {
+          int128_result<Fast>(
+            [&] { return Fast::mul(fa, fb, Generics::DMR_FLOOR); }),
+          int128_result<Reference>(
+            [&] { return Reference::mul(ra, rb, Generics::DMR_FLOOR); })
+        },
+        {
+          int128_result<Fast>(
+            [&] { return Fast::mul(fa, fb, Generics::DMR_ROUND); }),
+          int128_result<Reference>(
+            [&] { return Reference::mul(ra, rb, Generics::DMR_ROUND); })
+        },
+        {
+          int128_result<Fast>(
+            [&] { return Fast::mul(fa, fb, Generics::DMR_CEIL); }),
+          int128_result<Reference>(
+            [&] { return Reference::mul(ra, rb, Generics::DMR_CEIL); })
+        },
+        {
+          int128_result<Fast>(
+            [&] { return Fast::div(fa, fb, Generics::DDR_FLOOR); }),
+          int128_result<Reference>(
+            [&] { return Reference::div(ra, rb, Generics::DDR_FLOOR); })
+        },
+        {
+          int128_result<Fast>(
+            [&] { return Fast::div(fa, fb, Generics::DDR_CEIL); }),
+          int128_result<Reference>(
+            [&] { return Reference::div(ra, rb, Generics::DDR_CEIL); })
+        },
+        {
+          int128_result<Fast>(
+            [&]
+            {
+              Fast remainder;
+              Fast::div(fa, fb, remainder);
+              return remainder;
+            }),
+          int128_result<Reference>(
+            [&]
+            {
+              Reference remainder;
+              Reference::div(ra, rb, remainder);
+              return remainder;
+            })
+        },
+      };
+
+      for (std::size_t k = 0; k < sizeof(RESULTS) / sizeof(*RESULTS); ++k)
+      {
+        if (RESULTS[k][0] != RESULTS[k][1])
+        {
+          std::cerr << name << ": operation " << k << " on " << values[i] <<
+            " and " << values[j] << " gives " << RESULTS[k][0] <<
+            " instead of " << RESULTS[k][1] << std::endl;
+          ++failures;
+        }
+      }
+    }
+  }
+
+  // values are random, so summing of all could overflow
+  for (std::size_t size = 0; size <= column.size(); size += 17)
+  {
+    const std::string SUM = int128_result<Fast>(
+      [&] { return Fast::sum(column.begin(), column.begin() + size); });
+    const std::string REFERENCE_SUM = int128_result<Reference>(
+      [&]
+      {
+        Reference sum(Reference::ZERO);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+          sum += reference_column[i];
+        }
+        return sum.is_zero() ? Reference::ZERO : sum;
+      });
+    if (SUM != REFERENCE_SUM)
+    {
+      std::cerr << name << ": sum of " << size << " gives " << SUM <<
+        " instead of " << REFERENCE_SUM << std::endl;
+      ++failures;
+    }
+  }
+
+  if (failures)
+  {
+    Stream::Error ostr;
+    ostr << name << ": " << failures << " UInt128 results differ";
+    throw TestException(ostr);
+  }
+}
+
+void
+test_int128() /*throw (eh::Exception)*/
+{
+  test_int128<Decimal<uint64_t, 18, 8>,
+    Decimal<unsigned long long, 18, 8> >("Decimal<uint64_t,18,8>");
+  test_int128<Decimal<uint64_t, 19, 0>,
+    Decimal<unsigned long long, 19, 0> >("Decimal<uint64_t,19,0>");
+  test_int128<Decimal<uint64_t, 36, 16>,
+    Decimal<unsigned long long, 36, 16> >("Decimal<uint64_t,36,16>");
+  test_int128<Decimal<uint64_t, 38, 19>,
+    Decimal<unsigned long long, 38, 19> >("Decimal<uint64_t,38,19>");
+}
+
 int
 main()
 {
@@ -1608,6 +1806,7 @@ main()
     test_input();
     test_narrow();
     test_float();
+    test_int128();
 
     perfomance_test();
 
@@ -1,10 +1,25 @@
 #include <iostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include <Generics/Time.hpp>
 #include <Generics/ArrayAutoPtr.hpp>
 
+// Decimal<unsigned long long, ...> keeps element-wise arithmetic
+// as the reference for UInt128 one of Decimal<uint64_t, ...>
+namespace Generics
+{
+  template <const unsigned TOTAL, const unsigned FRACTION>
+  struct DecimalInt128<unsigned long long, TOTAL, FRACTION>
+  {
+    static const bool ENABLED = false;
+  };
+}
+
+static_assert(!std::is_same<uint64_t, unsigned long long>::value,
+  "uint64_t must differ from unsigned long long");
+
 template<typename DecimalType>
 class PerformanceTestSuite
 {
@@ -116,6 +131,34 @@ private:
     }
   };
 
+  struct ColumnAdd
+  {
+    static
+    void
+    func(DecimalType& res, const DecimalType* begin, const DecimalType* end)
+      /*throw (eh::Exception)*/
+      __attribute__((always_inline))
+    {
+      res = DecimalType::ZERO;
+      for (; begin != end; ++begin)
+      {
+        res += *begin;
+      }
+    }
+  };
+
+  struct ColumnSum
+  {
+    static
+    void
+    func(DecimalType& res, const DecimalType* begin, const DecimalType* end)
+      /*throw (eh::Exception)*/
+      __attribute__((always_inline))
+    {
+      res = DecimalType::sum(begin, end);
+    }
+  };
+
   struct Ceil
   {
     static
@@ -145,6 +188,12 @@ public:
     add_test_case_<DivC>("Division ceil");
     add_test_case_<DivR>("Division reminder");
     add_test_case_<Ceil>("Ceil");
+    add_column_test_case_<ColumnAdd>("Column one by one");
+    if constexpr (requires(const DecimalType* column)
+      { DecimalType::sum(column, column); })
+    {
+      add_column_test_case_<ColumnSum>("Column sum");
+    }
   }
 
   void
@@ -160,7 +209,34 @@ public:
     }
   }
 
+  /**
+   * Print speedup of the last run over the last run of reference
+   */
+  template <typename ReferenceType>
+  void
+  compare(const PerformanceTestSuite<ReferenceType>& reference) const
+    /*throw (eh::Exception)*/
+  {
+    std::cout << "Speedup of " << name_ << " over " << reference.name_ <<
+      std::endl;
+    for (std::size_t i = 0; i < test_cases_.size(); ++i)
+    {
+      const double ELAPSED = test_cases_[i].elapsed.as_double();
+      std::cout << "\t" << test_cases_[i].name;
+      for (size_t j = max_length_ + 1 - test_cases_[i].name.size(); j--;)
+      {
+        std::cout << ' ';
+      }
+      std::cout << 'x' << (ELAPSED > 0 ?
+        reference.test_cases_[i].elapsed.as_double() / ELAPSED : 0) <<
+        std::endl;
+    }
+  }
+
 private:
+  template <typename OtherType>
+  friend class PerformanceTestSuite;
+
   const std::string name_;
 
   typedef void (*test_func)(const DecimalType* data, DecimalType* sample);
@@ -168,6 +244,8 @@ private:
   {
     test_func func;
     std::string name;
+    bool column;
+    Generics::Time elapsed;
   };
   typedef std::vector<TestCase> Cases;
 
@@ -177,9 +255,11 @@ private:
   static const int DATA_SIZE = 5;
   static const int SAMPLE_SIZE = DATA_SIZE * DATA_SIZE;
   static const int SAMPLE_RUNS = 10000000;
+  static const int COLUMN_SIZE = 1000;
 
   DecimalType test_data_[DATA_SIZE];
   DecimalType sample_[SAMPLE_SIZE];
+  DecimalType column_[COLUMN_SIZE];
 
 private:
 
@@ -197,11 +277,32 @@ private:
     }
   }
 
+  template <typename Op>
+  static
+  void
+  column_wrapper_(const DecimalType* column, DecimalType* sample)
+    /*throw (eh::Exception)*/
+  {
+    for (int i = 0; i < SAMPLE_RUNS / COLUMN_SIZE; ++i)
+    {
+      Op::func(sample[i % SAMPLE_SIZE], column, column + COLUMN_SIZE);
+    }
+  }
+
   template <typename Op>
   void
   add_test_case_(const char* case_name) /*throw (eh::Exception)*/
   {
-    TestCase test_case = { wrapper_<Op>, case_name };
+    TestCase test_case = { wrapper_<Op>, case_name, false, Generics::Time::ZERO };
+    max_length_ = std::max(test_case.name.size(), max_length_);
+    test_cases_.push_back(test_case);
+  }
+
+  template <typename Op>
+  void
+  add_column_test_case_(const char* case_name) /*throw (eh::Exception)*/
+  {
+    TestCase test_case = { column_wrapper_<Op>, case_name, true, Generics::Time::ZERO };
     max_length_ = std::max(test_case.name.size(), max_length_);
     test_cases_.push_back(test_case);
   }
@@ -211,14 +312,15 @@ private:
   {
     Generics::CPUTimer timer;
     timer.start();
-    test_case.func(test_data_, sample_);
+    test_case.func(test_case.column ? column_ : test_data_, sample_);
     timer.stop();
+    test_case.elapsed = timer.elapsed_time();
     std::cout << "\t" << test_case.name;
     for (size_t i = max_length_ + 1 - test_case.name.size(); i--;)
     {
       std::cout << ' ';
     }
-    std::cout << timer.elapsed_time() << std::endl;
+    std::cout << test_case.elapsed << std::endl;
   }
 
   void
@@ -229,6 +331,15 @@ private:
     test_data_[2] = DecimalType(false, 2, 7182818);
     test_data_[3] = DecimalType(true, 0, 1717);
     test_data_[4] = DecimalType(false, 3, 1415926);
+
+    for (int i = 0; i < COLUMN_SIZE; ++i)
+    {
+      column_[i] = test_data_[i % DATA_SIZE];
+      if (i % 2)
+      {
+        column_[i].negate();
+      }
+    }
   }
 };
 
@@ -241,13 +352,27 @@ perfomance_test(const char* name) /*throw (eh::Exception)*/
   test.run();
 }
 
+template <typename DecimalType, typename ReferenceType>
+void
+perfomance_test(const char* name, const char* reference_name)
+  /*throw (eh::Exception)*/
+{
+  PerformanceTestSuite<ReferenceType> reference(reference_name);
+  reference.run();
+  PerformanceTestSuite<DecimalType> test(name);
+  test.run();
+  test.compare(reference);
+}
+
 void
 perfomance_test() /*throw (eh::Exception)*/
 {
-  perfomance_test<Generics::Decimal<uint64_t, 36, 16> >(
-    "Decimal<uint64_t,36,16>");
-  perfomance_test<Generics::Decimal<uint64_t, 18, 8> >(
-    "Decimal<uint64_t,18,8>");
+  perfomance_test<Generics::Decimal<uint64_t, 36, 16>,
+    Generics::Decimal<unsigned long long, 36, 16> >(
+      "Decimal<uint64_t,36,16>", "element-wise");
+  perfomance_test<Generics::Decimal<uint64_t, 18, 8>,
+    Generics::Decimal<unsigned long long, 18, 8> >(
+      "Decimal<uint64_t,18,8>", "element-wise");
   perfomance_test<Generics::SimpleDecimal<uint64_t, 18, 8> >(
     "SimpleDecimal<uint64_t,18,8>");
 }
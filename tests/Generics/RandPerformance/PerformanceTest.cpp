@@ -0,0 +1,126 @@
+// PerformanceTest.cpp :
+//   Scaling of locked and per-thread safe_rand and speed of
+//   safe_rand_fill.
+//
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <Sync/PosixLock.hpp>
+
+#include <Generics/ISAAC.hpp>
+#include <Generics/Rand.hpp>
+#include <Generics/Time.hpp>
+
+namespace
+{
+  unsigned long CallsPerThread = 1000000;
+  std::size_t FillSize = 64 * 1024 * 1024;
+
+  Sync::PosixMutex shared_mutex;
+  Generics::ISAAC shared_generator;
+
+  uint32_t
+  shared_rand()
+  {
+    Sync::PosixGuard lock(shared_mutex);
+    return shared_generator.rand() >> 1;
+  }
+
+  template <typename Fun>
+  void
+  call_loop(Fun fun, uint32_t* result)
+  {
+    uint32_t sum = 0;
+    for (unsigned long i = 0; i < CallsPerThread; ++i)
+    {
+      sum += fun();
+    }
+    *result = sum;
+  }
+
+  template <typename Fun>
+  Generics::Time
+  measure(Fun fun, unsigned long threads_number)
+  {
+    std::vector<uint32_t> results(threads_number);
+    std::vector<std::thread> threads;
+
+    Generics::Timer timer;
+    timer.start();
+    for (unsigned long i = 0; i < threads_number; ++i)
+    {
+      threads.emplace_back(call_loop<Fun>, fun, &results[i]);
+    }
+    for (auto it = threads.begin(); it != threads.end(); ++it)
+    {
+      it->join();
+    }
+    timer.stop();
+
+    return timer.elapsed_time();
+  }
+
+  void
+  scaling()
+  {
+    const unsigned long MAX_THREADS =
+      std::max(2u, std::min(std::thread::hardware_concurrency(), 8u));
+
+    std::cout << "safe_rand scaling (" << CallsPerThread <<
+      " calls per thread):" << std::endl;
+    for (unsigned long threads = 1; threads <= MAX_THREADS; threads *= 2)
+    {
+      std::cout << "  threads: " << threads <<
+        ", locked: " << measure(shared_rand, threads) <<
+        ", per-thread: " << measure(
+          static_cast<uint32_t (*)()>(Generics::safe_rand), threads) <<
+        std::endl;
+    }
+  }
+
+  void
+  fill()
+  {
+    FillSize -= FillSize % sizeof(uint32_t);
+    std::vector<unsigned char> buffer(FillSize);
+    Generics::Time loop_time;
+    {
+      Generics::ScopedTimer timer(loop_time);
+      for (std::size_t i = 0; i < FillSize; i += sizeof(uint32_t))
+      {
+        uint32_t value = Generics::safe_rand();
+        std::memcpy(&buffer[i], &value, sizeof(value));
+      }
+    }
+    Generics::Time fill_time;
+    {
+      Generics::ScopedTimer timer(fill_time);
+      Generics::safe_rand_fill(buffer.data(), FillSize);
+    }
+    std::cout << FillSize << " bytes buffer: safe_rand loop: " <<
+      loop_time << ", safe_rand_fill: " << fill_time << std::endl;
+  }
+}
+
+int
+main(int argc, char* argv[])
+{
+  if (argc > 1)
+  {
+    CallsPerThread = std::atol(argv[1]);
+  }
+  if (argc > 2)
+  {
+    FillSize = std::atol(argv[2]);
+  }
+
+  scaling();
+  fill();
+
+  return 0;
+}
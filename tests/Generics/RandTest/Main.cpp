@@ -1,7 +1,10 @@
+#include <algorithm>
 #include <iostream>
 #include <vector>
 #include <list>
 #include <map>
+#include <set>
+#include <thread>
 
 #include <Generics/Rand.hpp>
 #include <Generics/RandomSelect.hpp>
@@ -14,6 +17,77 @@ struct Weight
   }
 };
 
+void
+thread_sequence(std::vector<uint32_t>* sequence)
+{
+  for (auto it = sequence->begin(); it != sequence->end(); ++it)
+  {
+    *it = Generics::safe_rand();
+  }
+}
+
+int
+check_threads()
+{
+  const unsigned long THREADS = 4;
+  std::vector<std::vector<uint32_t> > sequences(
+    THREADS, std::vector<uint32_t>(16));
+  std::vector<std::thread> threads;
+  for (unsigned long i = 0; i < THREADS; ++i)
+  {
+    threads.emplace_back(thread_sequence, &sequences[i]);
+  }
+  for (auto it = threads.begin(); it != threads.end(); ++it)
+  {
+    it->join();
+  }
+
+  std::set<std::vector<uint32_t> > unique(
+    sequences.begin(), sequences.end());
+  if (unique.size() != THREADS)
+  {
+    std::cerr << "Threads got equal random sequences." << std::endl;
+    return 1;
+  }
+
+  return 0;
+}
+
+int
+check_fill()
+{
+  unsigned char buffer[4099];
+  for (size_t size = 0; size < sizeof(buffer); size = size * 2 + 1)
+  {
+    std::fill(buffer, buffer + sizeof(buffer), 0);
+    Generics::safe_rand_fill(buffer, size);
+
+    size_t zeroes = 0;
+    for (size_t i = 0; i < size; ++i)
+    {
+      zeroes += !buffer[i];
+    }
+    if (zeroes > size / 16 + 2)
+    {
+      std::cerr << "safe_rand_fill: too many zeroes (" << zeroes <<
+        ") in " << size << " bytes." << std::endl;
+      return 1;
+    }
+
+    for (size_t i = size; i < sizeof(buffer); ++i)
+    {
+      if (buffer[i])
+      {
+        std::cerr << "safe_rand_fill: overrun for " << size <<
+          " bytes." << std::endl;
+        return 1;
+      }
+    }
+  }
+
+  return 0;
+}
+
 int main()
 {
   typedef std::list<int> IntList;
@@ -59,6 +133,11 @@ int main()
       return 1;
     }
   }
-  
+
+  if (check_threads() || check_fill())
+  {
+    return 1;
+  }
+
   return 0;
 }
@@ -0,0 +1,382 @@
+// PerformanceTest.cpp :
+//   Local time conversions by the time zone table against libc and
+//   formatting with the per-thread cache of the last formatted second.
+//
+
+#include <unistd.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <Generics/Rand.hpp>
+#include <Generics/ThreadRunner.hpp>
+#include <Generics/Time.hpp>
+#include <Stream/MemoryStream.hpp>
+
+namespace
+{
+  DECLARE_EXCEPTION(TestException, eh::DescriptiveException);
+
+  std::size_t ConversionCount = 1000000;
+
+  // 1970 .. 2100
+  const time_t TIME_END = 4102444800l;
+
+  typedef std::vector<time_t> Times;
+
+  void
+  generate(std::size_t count, Times& times) /*throw (eh::Exception)*/
+  {
+    const time_t NOW = Generics::Time::get_time_of_day().tv_sec;
+    times.resize(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      // Half of the times are around now, half are anywhere
+      times[i] = i & 1 ?
+        NOW + static_cast<time_t>(Generics::safe_rand(2 * 366 * 86400)) -
+          366 * 86400 :
+        static_cast<time_t>(Generics::safe_rand()) *
+          Generics::safe_rand(4) % TIME_END;
+    }
+  }
+
+  double
+  elapsed(const Generics::Timer& timer) throw ()
+  {
+    return static_cast<double>(timer.elapsed_time().microseconds()) /
+      1000000;
+  }
+
+  void
+  report(const char* name, double seconds, std::size_t count)
+    /*throw (eh::Exception)*/
+  {
+    std::cout << std::fixed << std::setprecision(3) <<
+      '\t' << std::left << std::setw(28) << name << std::right <<
+      std::setw(8) << seconds << " s, " <<
+      std::setw(8) << std::setprecision(1) <<
+      (count ? seconds * 1000000000 / count : 0) << " ns/call" <<
+      std::endl;
+  }
+
+  void
+  compare(const char* name, time_t time, const tm& expected,
+    const tm& result) /*throw (eh::Exception)*/
+  {
+    if (expected.tm_sec != result.tm_sec ||
+      expected.tm_min != result.tm_min ||
+      expected.tm_hour != result.tm_hour ||
+      expected.tm_mday != result.tm_mday ||
+      expected.tm_mon != result.tm_mon ||
+      expected.tm_year != result.tm_year ||
+      expected.tm_wday != result.tm_wday ||
+      expected.tm_yday != result.tm_yday ||
+      expected.tm_isdst != result.tm_isdst ||
+      expected.tm_gmtoff != result.tm_gmtoff ||
+      strcmp(expected.tm_zone, result.tm_zone))
+    {
+      char expected_str[64];
+      char result_str[64];
+      strftime(expected_str, sizeof(expected_str), "%F %T %z %Z",
+        &expected);
+      strftime(result_str, sizeof(result_str), "%F %T %z %Z", &result);
+      Stream::Error ostr;
+      ostr << name << " of " << time << ": " << result_str <<
+        " instead of " << expected_str;
+      throw TestException(ostr);
+    }
+  }
+
+  void
+  check(const Times& times) /*throw (eh::Exception)*/
+  {
+    for (std::size_t i = 0; i < times.size(); ++i)
+    {
+      const time_t TIME = times[i];
+      tm expected;
+      tm result;
+      localtime_r(&TIME, &expected);
+      if (!Generics::time_to_local(TIME, result))
+      {
+        Stream::Error ostr;
+        ostr << "time_to_local of " << TIME << " failed";
+        throw TestException(ostr);
+      }
+      compare("time_to_local", TIME, expected, result);
+
+      // Denormalized fields with and without DST hint
+      tm local = expected;
+      local.tm_mday -= 40;
+      local.tm_hour += 40 * 24;
+      local.tm_isdst = i & 2 ? -1 : expected.tm_isdst;
+      tm libc_local = local;
+      const time_t LIBC_TIME = mktime(&libc_local);
+      const time_t LOCAL_TIME = Generics::local_to_time(local);
+      if (LIBC_TIME != LOCAL_TIME)
+      {
+        Stream::Error ostr;
+        ostr << "local_to_time of " << TIME << ": " << LOCAL_TIME <<
+          " instead of " << LIBC_TIME;
+        throw TestException(ostr);
+      }
+      compare("local_to_time", TIME, libc_local, local);
+    }
+  }
+
+  void
+  check_format() /*throw (eh::Exception)*/
+  {
+    const Generics::Time TIME(1700000000, 123456);
+    const Generics::Time NEXT(1700000000, 654321);
+
+    // Cached results of the same second must not leak into others
+    const char* const EXPECTED[][2] =
+    {
+      { "%F %T", "2023-11-14 22:13:20" },
+      { "%F %T", "2023-11-14 22:13:20" },
+      { "%F %T.%q", "2023-11-14 22:13:20.123456" },
+      { "%F %T", "2023-11-14 22:13:20" },
+      { "%Y%m%d", "20231114" }
+    };
+
+    for (std::size_t i = 0; i < sizeof(EXPECTED) / sizeof(*EXPECTED); ++i)
+    {
+      const std::string RESULT = TIME.get_gm_time().format(EXPECTED[i][0]);
+      if (RESULT != EXPECTED[i][1])
+      {
+        Stream::Error ostr;
+        ostr << "format '" << EXPECTED[i][0] << "': " << RESULT <<
+          " instead of " << EXPECTED[i][1];
+        throw TestException(ostr);
+      }
+    }
+
+    if (NEXT.get_gm_time().format("%T.%q") != "22:13:20.654321" ||
+      (TIME + 1).gm_ft() != "2023-11-14 22:13:21")
+    {
+      throw TestException("cached format result leaked");
+    }
+  }
+
+  class LocalTimeJob : public Generics::ThreadJob
+  {
+  public:
+    LocalTimeJob(const Times& times, bool libc) throw ()
+      : times_(times), libc_(libc), check_(0)
+    {
+    }
+
+    virtual
+    void
+    work() throw ()
+    {
+      tm et;
+      int sum = 0;
+      for (std::size_t i = 0; i < times_.size(); ++i)
+      {
+        if (libc_)
+        {
+          localtime_r(&times_[i], &et);
+        }
+        else
+        {
+          Generics::time_to_local(times_[i], et);
+        }
+        sum += et.tm_hour;
+      }
+      check_ += sum;
+    }
+
+  protected:
+    virtual
+    ~LocalTimeJob() throw ()
+    {
+    }
+
+  private:
+    const Times& times_;
+    const bool libc_;
+    std::atomic<int> check_;
+  };
+
+  double
+  measure_threads(const Times& times, bool libc, unsigned threads)
+    /*throw (eh::Exception)*/
+  {
+    Generics::ThreadJob_var job(new LocalTimeJob(times, libc));
+    Generics::ThreadRunner runner(job, threads);
+    Generics::Timer timer;
+    timer.start();
+    runner.start();
+    runner.wait_for_completion();
+    timer.stop();
+    return elapsed(timer);
+  }
+
+  void
+  performance_test() /*throw (eh::Exception)*/
+  {
+    Times times;
+    generate(ConversionCount, times);
+
+    const char* const TZ = getenv("TZ");
+    std::cout << "Conversions: " << ConversionCount << ", TZ: " <<
+      (TZ ? TZ : "default") << std::endl;
+
+    {
+      // The table is built on the first call
+      Generics::Timer timer;
+      timer.start();
+      tm et;
+      Generics::time_to_local(0, et);
+      timer.stop();
+      std::cout << std::fixed << std::setprecision(1) <<
+        "\ttable build " << elapsed(timer) * 1000 << " ms" << std::endl;
+    }
+
+    check(times);
+    check_format();
+
+    int check_sum = 0;
+    {
+      Generics::Timer timer;
+      timer.start();
+      tm et;
+      for (std::size_t i = 0; i < times.size(); ++i)
+      {
+        localtime_r(&times[i], &et);
+        check_sum += et.tm_hour;
+      }
+      timer.stop();
+      report("localtime_r", elapsed(timer), times.size());
+    }
+
+    {
+      Generics::Timer timer;
+      timer.start();
+      tm et;
+      for (std::size_t i = 0; i < times.size(); ++i)
+      {
+        Generics::time_to_local(times[i], et);
+        check_sum += et.tm_hour;
+      }
+      timer.stop();
+      report("time_to_local", elapsed(timer), times.size());
+    }
+
+    std::vector<tm> locals(times.size());
+    for (std::size_t i = 0; i < times.size(); ++i)
+    {
+      localtime_r(&times[i], &locals[i]);
+    }
+
+    {
+      Generics::Timer timer;
+      timer.start();
+      for (std::size_t i = 0; i < locals.size(); ++i)
+      {
+        tm et = locals[i];
+        check_sum += mktime(&et);
+      }
+      timer.stop();
+      report("mktime", elapsed(timer), locals.size());
+    }
+
+    {
+      Generics::Timer timer;
+      timer.start();
+      for (std::size_t i = 0; i < locals.size(); ++i)
+      {
+        tm et = locals[i];
+        check_sum += Generics::local_to_time(et);
+      }
+      timer.stop();
+      report("local_to_time", elapsed(timer), locals.size());
+    }
+
+    {
+      // Every call formats a new second
+      Generics::Timer timer;
+      timer.start();
+      for (std::size_t i = 0; i < times.size(); ++i)
+      {
+        check_sum += Generics::Time(i).gm_ft().size();
+      }
+      timer.stop();
+      report("gm_ft (new second)", elapsed(timer), times.size());
+    }
+
+    {
+      // Logger pattern: many records in the same second
+      const Generics::Time NOW = Generics::Time::get_time_of_day();
+      Generics::Timer timer;
+      timer.start();
+      for (std::size_t i = 0; i < times.size(); ++i)
+      {
+        check_sum += (NOW + Generics::Time(i / 10000)).gm_ft().size();
+      }
+      timer.stop();
+      report("gm_ft (same second)", elapsed(timer), times.size());
+    }
+
+    {
+      const Generics::Time NOW = Generics::Time::get_time_of_day();
+      Generics::Timer timer;
+      timer.start();
+      for (std::size_t i = 0; i < times.size(); ++i)
+      {
+        check_sum += (NOW + Generics::Time(i / 10000)).get_local_time().
+          format("%F %T").size();
+      }
+      timer.stop();
+      report("local format (same second)", elapsed(timer), times.size());
+    }
+
+    const long CPUS = sysconf(_SC_NPROCESSORS_ONLN);
+    const unsigned THREADS = CPUS > 1 ? CPUS : 2;
+    Times part(times.begin(), times.begin() + times.size() / THREADS);
+
+    std::cout << "Threads: " << THREADS << std::endl;
+    report("localtime_r (threads)", measure_threads(part, true, THREADS),
+      part.size() * THREADS);
+    report("time_to_local (threads)", measure_threads(part, false, THREADS),
+      part.size() * THREADS);
+
+    std::cout << "Check sum: " << check_sum << std::endl;
+  }
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::cout << "Time performance test started..." << std::endl;
+  try
+  {
+    if (argc > 1)
+    {
+      ConversionCount = std::atoi(argv[1]);
+    }
+    if (argc > 2)
+    {
+      setenv("TZ", argv[2], 1);
+      tzset();
+    }
+    performance_test();
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+  }
+  catch (const eh::Exception& e)
+  {
+    std::cerr << "Exception raised: " << e.what() << std::endl;
+  }
+  catch (...)
+  {
+    std::cerr << "Unknown exception occurred" << std::endl;
+  }
+
+  return 1;
+}
@@ -0,0 +1,226 @@
+// PerformanceTest.cpp :
+//   Throughput of one by one and batch trigger normalization.
+//
+
+#include <unistd.h>
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <Generics/Rand.hpp>
+#include <Generics/Time.hpp>
+#include <Stream/MemoryStream.hpp>
+
+#include <TestCommons/ActiveObjectCallback.hpp>
+
+#include <Language/BLogic/NormalizeTrigger.hpp>
+
+namespace
+{
+  DECLARE_EXCEPTION(TestException, eh::DescriptiveException);
+
+  std::size_t TriggerCount = 1000000;
+
+  const char* const WORDS[] =
+  {
+    "cheap", "Flights", "hotel", "BOOKING", "used", "cars", "sale",
+    "pizza", "near", "me", "weather", "tomorrow", "credit", "card",
+    "дешевые", "Авиабилеты", "отели", "Москва", "погода", "кредит",
+    "항공권", "예약", "café", "Straße", "ＡＢＣ", "iPhone", "2024",
+    "new-york", "o'neil", "c++"
+  };
+
+  const std::size_t WORDS_COUNT = sizeof(WORDS) / sizeof(*WORDS);
+
+  typedef std::vector<std::string> StringArray;
+  typedef std::vector<String::SubString> SubStringArray;
+
+  /**
+   * Triggers of 1..5 words, some with phrases in quotes, some exact
+   */
+  void
+  generate(std::size_t count, StringArray& triggers)
+    /*throw (eh::Exception)*/
+  {
+    triggers.clear();
+    triggers.reserve(count);
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+      const unsigned WORD_COUNT = Generics::safe_rand(1, 5);
+      const bool EXACT = !Generics::safe_rand(10);
+      const unsigned QUOTE_AT = EXACT ? WORD_COUNT : Generics::safe_rand(4);
+
+      std::string trigger;
+      if (EXACT)
+      {
+        trigger.push_back('[');
+      }
+      for (unsigned j = 0; j < WORD_COUNT; ++j)
+      {
+        if (j)
+        {
+          trigger.push_back(' ');
+        }
+        if (j == QUOTE_AT && j + 1 < WORD_COUNT)
+        {
+          trigger.push_back('"');
+        }
+        trigger += WORDS[Generics::safe_rand(WORDS_COUNT)];
+        if (j == QUOTE_AT + 1)
+        {
+          trigger.push_back('"');
+        }
+      }
+      if (EXACT)
+      {
+        trigger.push_back(']');
+      }
+
+      triggers.push_back(trigger);
+    }
+  }
+
+  double
+  elapsed(const Generics::Timer& timer) throw ()
+  {
+    return static_cast<double>(timer.elapsed_time().microseconds()) /
+      1000000;
+  }
+
+  void
+  report(const char* name, double seconds, std::size_t count,
+    std::size_t bytes) /*throw (eh::Exception)*/
+  {
+    std::cout << std::fixed << std::setprecision(2) <<
+      '\t' << std::left << std::setw(24) << name << std::right <<
+      std::setw(8) << seconds << " s, " <<
+      std::setw(10) << std::setprecision(0) <<
+      (seconds > 0 ? count / seconds : 0) << " triggers/s, " <<
+      std::setw(6) << std::setprecision(1) <<
+      (seconds > 0 ? bytes / seconds / (1024 * 1024) : 0) << " MB/s" <<
+      std::endl;
+  }
+
+  void
+  check_equal(const StringArray& expected,
+    const Language::Trigger::Batch& batch)
+    /*throw (eh::Exception)*/
+  {
+    if (batch.size() != expected.size())
+    {
+      Stream::Error ostr;
+      ostr << "batch size " << batch.size() << " instead of " <<
+        expected.size();
+      throw TestException(ostr);
+    }
+
+    for (std::size_t i = 0; i < expected.size(); ++i)
+    {
+      if (batch[i] != String::SubString(expected[i]))
+      {
+        Stream::Error ostr;
+        ostr << "batch result >" << batch[i] << "< instead of >" <<
+          expected[i] << "<";
+        throw TestException(ostr);
+      }
+    }
+  }
+
+  void
+  performance_test() /*throw (eh::Exception)*/
+  {
+    StringArray triggers;
+    generate(TriggerCount, triggers);
+    const SubStringArray SUBSTRINGS(triggers.begin(), triggers.end());
+
+    std::size_t bytes = 0;
+    for (std::size_t i = 0; i < triggers.size(); ++i)
+    {
+      bytes += triggers[i].size();
+    }
+
+    const long CPUS = sysconf(_SC_NPROCESSORS_ONLN);
+    const unsigned THREADS = CPUS > 1 ? CPUS : 2;
+
+    std::cout << "Triggers: " << TriggerCount << ", threads: " <<
+      THREADS << std::endl;
+
+    StringArray expected(triggers.size());
+    {
+      Generics::Timer timer;
+      timer.start();
+      for (std::size_t i = 0; i < triggers.size(); ++i)
+      {
+        Language::Trigger::normalize(SUBSTRINGS[i], expected[i]);
+      }
+      timer.stop();
+      report("one by one", elapsed(timer), triggers.size(), bytes);
+    }
+
+    Language::Trigger::Batch batch;
+    for (unsigned pass = 0; pass < 2; ++pass)
+    {
+      Generics::Timer timer;
+      timer.start();
+      Language::Trigger::normalize(&*SUBSTRINGS.begin(),
+        &*SUBSTRINGS.begin() + SUBSTRINGS.size(), batch);
+      timer.stop();
+      report(pass ? "batch (reused)" : "batch", elapsed(timer),
+        triggers.size(), bytes);
+    }
+    check_equal(expected, batch);
+
+    Generics::ActiveObjectCallback_var callback(
+      new TestCommons::ActiveObjectCallbackStreamImpl(
+        std::cerr, "TriggerNormPerformance"));
+    Generics::TaskRunner_var task_runner(
+      new Generics::TaskRunner(callback, THREADS - 1));
+    task_runner->activate_object();
+
+    {
+      Generics::Timer timer;
+      timer.start();
+      Language::Trigger::normalize(&*SUBSTRINGS.begin(),
+        &*SUBSTRINGS.begin() + SUBSTRINGS.size(), batch, 0, task_runner);
+      timer.stop();
+      report("batch (task runner)", elapsed(timer), triggers.size(),
+        bytes);
+    }
+
+    task_runner->deactivate_object();
+    task_runner->wait_object();
+
+    check_equal(expected, batch);
+  }
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::cout << "Trigger normalization performance test started..." <<
+    std::endl;
+  try
+  {
+    if (argc > 1)
+    {
+      TriggerCount = std::atoi(argv[1]);
+    }
+    performance_test();
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+  }
+  catch (const eh::Exception& e)
+  {
+    std::cerr << "Exception raised: " << e.what() << std::endl;
+  }
+  catch (...)
+  {
+    std::cerr << "Unknown exception occurred" << std::endl;
+  }
+
+  return 1;
+}
@@ -0,0 +1,255 @@
+// PerformanceTest.cpp :
+//   Throughput of UTF-8 and wide string normalization on trigger corpora.
+//
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+
+#include <Generics/Time.hpp>
+#include <Stream/MemoryStream.hpp>
+#include <String/UnicodeNormalizer.hpp>
+#include <String/UTF8Handler.hpp>
+
+namespace
+{
+  DECLARE_EXCEPTION(TestException, eh::DescriptiveException);
+
+  std::size_t RepetitionCount = 2000;
+
+  struct Corpus
+  {
+    const char* NAME;
+    std::vector<std::string> triggers;
+  };
+
+  const Corpus CORPORA[] =
+  {
+    {
+      "ascii lower",
+      {
+        "cheap flights", "hotel booking", "used cars for sale",
+        "best pizza near me", "\"new york\" hotels", "[buy iphone]",
+        "running shoes", "weather tomorrow", "credit card",
+        "online courses python", "football results", "garden tools"
+      }
+    },
+    {
+      "ascii mixed case",
+      {
+        "Cheap Flights", "Hotel BOOKING", "Used Cars For Sale",
+        "Best Pizza near me", "\"New York\" Hotels", "[Buy iPhone]",
+        "Running Shoes", "Weather Tomorrow", "Credit Card",
+        "Online Courses Python", "Football Results", "Garden Tools"
+      }
+    },
+    {
+      "cyrillic lower",
+      {
+        "дешевые авиабилеты", "бронирование отелей",
+        "купить автомобиль", "пицца рядом", "\"москва сити\" отели",
+        "погода на завтра", "кредитная карта", "курсы английского",
+        "результаты футбола", "садовый инструмент"
+      }
+    },
+    {
+      "korean",
+      {
+        "항공권 예약", "호텔 검색", "중고차 판매", "피자 배달",
+        "서울 날씨", "신용 카드", "온라인 강좌", "축구 결과"
+      }
+    },
+    {
+      "latin decomposed",
+      {
+        "cafe\xcc\x81" " paris",
+        "cre\xcc\x80" "me bru\xcc\x82" "le\xcc\x81" "e",
+        "pin\xcc\x83" "a colada", "ni\xcc\x83" "o", "fac\xcc\xa7" "ade",
+        "u\xcc\x88" "ber uns", "smo\xcc\x88" "rga\xcc\x8a" "sbord"
+      }
+    },
+    {
+      "fullwidth",
+      {
+        "\xef\xbc\xa1\xef\xbc\xa2\xef\xbc\xa3 shop",
+        "\xef\xbd\x88\xef\xbd\x8f\xef\xbd\x94\xef\xbd\x85\xef\xbd\x8c",
+        "\xef\xbc\x91\xef\xbc\x92\xef\xbc\x93 street"
+      }
+    }
+  };
+
+  std::wstring
+  to_wide(const std::string& str) /*throw (eh::Exception)*/
+  {
+    std::wstring result;
+    result.reserve(str.size());
+    for (const char* cur = str.data(); cur != str.data() + str.size();)
+    {
+      const unsigned long OCTETS =
+        String::UTF8Handler::get_octet_count(*cur);
+      wchar_t wch;
+      if (!String::UTF8Handler::utf8_char_to_wchar(cur, OCTETS, wch))
+      {
+        throw TestException("ill-formed UTF-8 in corpus");
+      }
+      result.push_back(wch);
+      cur += OCTETS;
+    }
+    return result;
+  }
+
+  void
+  to_utf8(const std::wstring& wstr, std::string& result)
+    /*throw (eh::Exception)*/
+  {
+    result.clear();
+    char buf[8];
+    for (std::size_t i = 0; i < wstr.size(); ++i)
+    {
+      unsigned long octets = 0;
+      String::UTF8Handler::wchar_to_utf8_char(wstr[i], buf, octets);
+      result.append(buf, octets);
+    }
+  }
+
+  // UTF-8 -> std::wstring -> lower_and_normalize -> UTF-8
+  std::size_t
+  normalize_wide(const std::string& trigger, std::string& result)
+    /*throw (eh::Exception)*/
+  {
+    std::wstring normalized;
+    if (!String::lower_and_normalize(to_wide(trigger), normalized, true))
+    {
+      return 0;
+    }
+    to_utf8(normalized, result);
+    return result.size();
+  }
+
+  std::size_t
+  normalize_utf8(const std::string& trigger, std::string& result)
+    /*throw (eh::Exception)*/
+  {
+    bool changed;
+    if (!String::lower_and_normalize(trigger, result, true, changed))
+    {
+      return 0;
+    }
+    return changed ? result.size() : trigger.size();
+  }
+
+  typedef std::size_t (*Normalize)(const std::string&, std::string&);
+
+  // @return MB/s of input
+  double
+  measure(const Corpus& corpus, Normalize normalize, std::size_t& check)
+    /*throw (eh::Exception)*/
+  {
+    std::size_t bytes = 0;
+    std::string result;
+
+    Generics::CPUTimer timer;
+    timer.start();
+    for (std::size_t i = 0; i < RepetitionCount; ++i)
+    {
+      for (std::size_t j = 0; j < corpus.triggers.size(); ++j)
+      {
+        check += normalize(corpus.triggers[j], result);
+        bytes += corpus.triggers[j].size();
+      }
+    }
+    timer.stop();
+
+    const double SECONDS =
+      static_cast<double>(timer.elapsed_time().microseconds()) / 1000000;
+    return SECONDS > 0 ? bytes / SECONDS / (1024 * 1024) : 0;
+  }
+
+  void
+  check_equal(const Corpus& corpus) /*throw (eh::Exception)*/
+  {
+    for (std::size_t j = 0; j < corpus.triggers.size(); ++j)
+    {
+      std::string wide_result;
+      std::string utf8_result;
+      bool changed;
+      normalize_wide(corpus.triggers[j], wide_result);
+      if (!String::lower_and_normalize(corpus.triggers[j], utf8_result,
+        true, changed))
+      {
+        throw TestException("normalization failed");
+      }
+      if (!changed)
+      {
+        utf8_result = corpus.triggers[j];
+      }
+      if (utf8_result != wide_result)
+      {
+        Stream::Error ostr;
+        ostr << "results differ for >" << corpus.triggers[j] << "<: >" <<
+          utf8_result << "< and >" << wide_result << "<";
+        throw TestException(ostr);
+      }
+    }
+  }
+
+  void
+  performance_test() /*throw (eh::Exception)*/
+  {
+    std::cout << "Repetitions: " << RepetitionCount << std::endl;
+
+    for (std::size_t i = 0; i < sizeof(CORPORA) / sizeof(*CORPORA); ++i)
+    {
+      const Corpus& corpus = CORPORA[i];
+      check_equal(corpus);
+
+      std::size_t normalized = 0;
+      for (std::size_t j = 0; j < corpus.triggers.size(); ++j)
+      {
+        normalized += String::Normalizer::is_normalized(
+          corpus.triggers[j], true);
+      }
+
+      std::size_t check = 0;
+      const double WIDE = measure(corpus, normalize_wide, check);
+      const double UTF8 = measure(corpus, normalize_utf8, check);
+
+      std::cout << std::fixed << std::setprecision(1) <<
+        '\t' << std::left << std::setw(20) << corpus.NAME <<
+        std::right << " normalized " << normalized << '/' <<
+        corpus.triggers.size() <<
+        ": wide=" << std::setw(8) << WIDE << " MB/s" <<
+        ", utf8=" << std::setw(8) << UTF8 << " MB/s" <<
+        " (x" << std::setprecision(2) << (WIDE > 0 ? UTF8 / WIDE : 0) <<
+        ")" << std::endl;
+    }
+  }
+}
+
+int
+main(int argc, char* argv[])
+{
+  std::cout << "Normalization performance test started..." << std::endl;
+  try
+  {
+    if (argc > 1)
+    {
+      RepetitionCount = std::atoi(argv[1]);
+    }
+    performance_test();
+    std::cout << "SUCCESS" << std::endl;
+    return 0;
+  }
+  catch (const eh::Exception& e)
+  {
+    std::cerr << "Exception raised: " << e.what() << std::endl;
+  }
+  catch (...)
+  {
+    std::cerr << "Unknown exception occurred" << std::endl;
+  }
+
+  return 1;
+}
@@ -12,8 +12,10 @@
 #include <sstream>
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include <Generics/FileCache.hpp>
+#include <Generics/Time.hpp>
 
 #include <String/TextTemplate.hpp>
 
@@ -86,6 +88,104 @@ public:
   end_lexeme() const /*throw (eh::Exception)*/;
 };
 
+/**
+ * Compares rendering with TextTemplate::String and TextTemplate::Compiled
+ * @param file_name template file
+ * @param args values of the keys
+ * @param renders number of renders to measure
+ * @return false if results differ
+ */
+bool
+render_benchmark(const char* file_name,
+  const TextTemplate::ArgsCallback& args, unsigned long renders)
+  /*throw (eh::Exception)*/
+{
+  std::string text;
+  {
+    std::ifstream file(file_name);
+    std::getline(file, text, '\0');
+  }
+
+  const TextTemplate::String BASIC(text);
+  const TextTemplate::Compiled COMPILED(text);
+
+  std::vector<std::string> values;
+  COMPILED.resolve(args, values);
+
+  const std::string EXPECTED(BASIC.instantiate(args));
+  std::vector<char> buffer(COMPILED.size(values.data()));
+  std::vector<iovec> iov(COMPILED.pieces());
+
+  std::cout << "Rendering " << renders << " times, " <<
+    COMPILED.pieces() << " pieces, " << COMPILED.slots() << " slots, " <<
+    EXPECTED.size() << " bytes:" << std::endl;
+
+  bool result = true;
+  std::size_t check = 0;
+
+  for (unsigned int variant = 0; variant < 4; ++variant)
+  {
+    const char* const NAMES[] =
+    {
+      "Basic::instantiate",
+      "Compiled::resolve + buffer",
+      "Compiled, buffer",
+      "Compiled, iovec"
+    };
+
+    Generics::CPUTimer timer;
+    timer.start();
+    for (unsigned long i = 0; i < renders; ++i)
+    {
+      switch (variant)
+      {
+      case 0:
+        check += BASIC.instantiate(args).size();
+        break;
+      case 1:
+        COMPILED.resolve(args, values);
+        check += COMPILED.instantiate(values.data(), buffer.data(),
+          buffer.size());
+        break;
+      case 2:
+        check += COMPILED.instantiate(values.data(), buffer.data(),
+          buffer.size());
+        break;
+      default:
+        check += COMPILED.instantiate(values.data(), iov.data());
+        break;
+      }
+    }
+    timer.stop();
+
+    std::cout << "  " << NAMES[variant] << ": " <<
+      (renders ? timer.elapsed_time().microseconds() * 1000 / renders : 0) <<
+      " ns/render" << std::endl;
+  }
+
+  std::string str;
+  COMPILED.instantiate(values.data(), str);
+
+  std::string joined;
+  const std::size_t FILLED = COMPILED.instantiate(values.data(), iov.data());
+  for (std::size_t i = 0; i < FILLED; ++i)
+  {
+    joined.append(static_cast<const char*>(iov[i].iov_base),
+      iov[i].iov_len);
+  }
+
+  if (str != EXPECTED ||
+    std::string(buffer.data(), buffer.size()) != EXPECTED ||
+    joined != EXPECTED)
+  {
+    std::cerr << "Compiled template result differs" << std::endl;
+    result = false;
+  }
+
+  std::cout << "  (" << check << ")" << std::endl << std::endl;
+  return result;
+}
+
 
 int
 main(int argc, char* argv[])
@@ -93,7 +193,7 @@ main(int argc, char* argv[])
   if(argc < 2)
   {
     std::cerr << "Usage:\n" << argv[0] <<
-      " filename [iterations] [keys_filename]\n";
+      " filename [iterations] [keys_filename] [output_filename] [renders]\n";
     return 1;
   }
 
@@ -152,6 +252,12 @@ main(int argc, char* argv[])
       std::getline(in, output, '\0');
     }
 
+    if (argc > 3 && !render_benchmark(file_name, callback,
+      argc > 5 ? atol(argv[5]) : 100000))
+    {
+      return -1;
+    }
+
     for (unsigned int i = 0; iterations ? (i < iterations) : true; i++)
     {
       TextTemplateCacheManager::BufferHolder_var text_template =